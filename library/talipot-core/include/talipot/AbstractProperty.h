@@ -120,6 +120,48 @@ public:
    **/
   virtual void setEdgeValue(const edge e, TYPE_CONST_REFERENCE(EdgeType) v);
 
+  /**
+   * @brief Sets the values of several nodes and notify the observers of a single modification.
+   *
+   * The values are directly written in the underlying storage and only one
+   * TLP_BEFORE_SET_NODES_VALUES/TLP_AFTER_SET_NODES_VALUES pair of events is sent,
+   * so this is faster than successive calls to setNodeValue.
+   *
+   * @param nodes The nodes to set the value of. They must belong to the graph of the property.
+   * @param values The values to affect, values[i] being the value of nodes[i].
+   **/
+  virtual void setNodeValues(const std::vector<node> &nodes,
+                             const std::vector<REAL_TYPE(NodeType)> &values);
+
+  /**
+   * @brief Sets the same value to several nodes and notify the observers of a single modification.
+   *
+   * @param nodes The nodes to set the value of. They must belong to the graph of the property.
+   * @param v The value to affect for these nodes.
+   **/
+  virtual void setNodeValues(const std::vector<node> &nodes, TYPE_CONST_REFERENCE(NodeType) v);
+
+  /**
+   * @brief Sets the values of several edges and notify the observers of a single modification.
+   *
+   * The values are directly written in the underlying storage and only one
+   * TLP_BEFORE_SET_EDGES_VALUES/TLP_AFTER_SET_EDGES_VALUES pair of events is sent,
+   * so this is faster than successive calls to setEdgeValue.
+   *
+   * @param edges The edges to set the value of. They must belong to the graph of the property.
+   * @param values The values to affect, values[i] being the value of edges[i].
+   **/
+  virtual void setEdgeValues(const std::vector<edge> &edges,
+                             const std::vector<REAL_TYPE(EdgeType)> &values);
+
+  /**
+   * @brief Sets the same value to several edges and notify the observers of a single modification.
+   *
+   * @param edges The edges to set the value of. They must belong to the graph of the property.
+   * @param v The value to affect for these edges.
+   **/
+  virtual void setEdgeValues(const std::vector<edge> &edges, TYPE_CONST_REFERENCE(EdgeType) v);
+
   /**
    * @brief Sets the value of all nodes and notify the observers.
    *
@@ -232,6 +274,7 @@ public:
   tlp::Iterator<edge> *getNonDefaultValuatedEdges(const Graph *g = nullptr) const override;
   bool hasNonDefaultValuatedEdges(const Graph *g = nullptr) const override;
   uint numberOfNonDefaultValuatedEdges(const Graph * = nullptr) const override;
+  size_t memoryUsage() const override;
   uint edgeValueSize() const override;
   void writeEdgeDefaultValue(std::ostream &) const override;
   void writeEdgeValue(std::ostream &, edge) const override;
@@ -241,6 +284,8 @@ public:
             bool ifNotDefault = false) override;
   bool copy(const edge destination, const edge source, PropertyInterface *property,
             bool ifNotDefault = false) override;
+  void copy(const std::vector<node> &nodes, PropertyInterface *property) override;
+  void copy(const std::vector<edge> &edges, PropertyInterface *property) override;
   void copy(PropertyInterface *property) override;
   // for performance reason and use in GraphUpdatesRecorder
   DataMem *getNodeDefaultDataMemValue() const override;
@@ -0,0 +1,136 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef TALIPOT_ALGORITHM_RESULTS_CACHE_H
+#define TALIPOT_ALGORITHM_RESULTS_CACHE_H
+
+#include <cstdint>
+#include <string>
+
+#include <talipot/config.h>
+
+namespace tlp {
+
+class DataSet;
+class Graph;
+class PropertyInterface;
+
+/**
+ * @ingroup Plugins
+ * @brief An opt-in cache of the results of the property algorithms.
+ *
+ * When enabled, the values computed by a successful call to Graph::applyPropertyAlgorithm are
+ * stored, and an identical later call (same algorithm, same graph, same parameters) copies them
+ * to the result property instead of running the algorithm again.
+ *
+ * A cached result is keyed by the name of the algorithm, the serialized values of its declared
+ * in and in/out parameters and the modification counters of the graph and of the properties
+ * given as parameters. Those counters are maintained by listening to the graph structure
+ * updates and to the properties values updates, so a cached result is invalidated as soon as
+ * one of them is modified. The values of the out and in/out parameters are cached with the
+ * result and restored with it. The calls of an algorithm with an out property parameter,
+ * other than its result, are never cached.
+ *
+ * The graph properties that an algorithm may read without receiving them as parameters
+ * (e.g. "viewLayout") are not tracked, so the cache must only be enabled when the
+ * algorithms that will be called only depend on their parameters and on the graph structure.
+ * Calls with a parameter whose type cannot be serialized are never cached, nor the calls
+ * reading the initial values of their result (see addResultInputParameter()).
+ **/
+class TLP_SCOPE AlgorithmResultsCache {
+public:
+  /**
+   * @brief Enables or disables the cache. It is disabled by default.
+   * Disabling the cache clears it.
+   **/
+  static void setEnabled(bool enabled);
+
+  /**
+   * @brief Returns whether the cache is enabled.
+   **/
+  static bool isEnabled();
+
+  /**
+   * @brief Sets the maximum number of cached results (64 by default).
+   * When this number is reached, the least recently used result is discarded.
+   **/
+  static void setMaximumNumberOfResults(uint maxResults);
+
+  /**
+   * @brief Returns the maximum number of cached results.
+   **/
+  static uint maximumNumberOfResults();
+
+  /**
+   * @brief Returns the number of currently cached results.
+   **/
+  static uint numberOfResults();
+
+  /**
+   * @brief Discards all the cached results.
+   **/
+  static void clear();
+
+  /**
+   * @brief Returns the number of algorithm calls whose result was found in the cache.
+   **/
+  static uint64_t numberOfHits();
+
+  /**
+   * @brief Returns the number of cacheable algorithm calls whose result was not found in the
+   * cache.
+   **/
+  static uint64_t numberOfMisses();
+
+  /**
+   * @brief Resets the hits and misses counters.
+   **/
+  static void resetStatistics();
+
+  /**
+   * @brief Declares that when the property parameter named parameter is given to algorithm,
+   * the algorithm reads the initial values of its result, as an incremental layout does.
+   * Those calls are then never cached.
+   **/
+  static void addResultInputParameter(const std::string &algorithm, const std::string &parameter);
+
+  /**
+   * @brief Computes the key identifying a call to a property algorithm on graph with the given
+   * parameters, according to the current modification counters.
+   *
+   * @param key The computed key.
+   * @return false if the call cannot be cached (because the cache is disabled, a parameter
+   * cannot be serialized or the algorithm reads the initial values of its result).
+   **/
+  static bool computeKey(const Graph *graph, const std::string &algorithm,
+                         const DataSet *parameters, std::string &key);
+
+  /**
+   * @brief If a result is cached for key, copies its values for the elements of graph to result,
+   * sets the cached values of the out parameters in parameters and returns true.
+   * Updates the hits and misses counters.
+   **/
+  static bool restoreResult(const std::string &key, const Graph *graph, PropertyInterface *result,
+                            DataSet *parameters = nullptr);
+
+  /**
+   * @brief Stores the values of result for the elements of graph and the values of the out
+   * parameters, computed by the call identified by key. Nothing is stored if the graph or
+   * one of the property parameters has been modified since key was computed.
+   **/
+  static void storeResult(const std::string &key, const Graph *graph, const std::string &algorithm,
+                          const DataSet *parameters, PropertyInterface *result);
+};
+}
+
+#endif // TALIPOT_ALGORITHM_RESULTS_CACHE_H
@@ -0,0 +1,199 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef TALIPOT_CHUNKED_VECTOR_H
+#define TALIPOT_CHUNKED_VECTOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tlp {
+
+/**
+ * @class ChunkedVector
+ * @brief A double ended sequence of values stored in fixed size chunks of contiguous memory.
+ *
+ * It is used as the vector storage of a MutableContainer in place of a std::deque,
+ * whose block size is implementation defined (as small as 16 bytes with some compilers).
+ * Growing a ChunkedVector never moves the stored values, so there is no peak memory usage
+ * due to a reallocation, and the last chunk grows geometrically until it is full
+ * to keep the small sequences small.
+ * The exact number of bytes allocated is given by memoryUsage().
+ */
+template <typename TYPE>
+class ChunkedVector {
+public:
+  // the number of values of a full chunk
+  static constexpr size_t CHUNK_SIZE = (size_t(1) << 10);
+
+  // the average number of bytes used to store a value
+  static constexpr double valueSize = double(sizeof(TYPE));
+
+  ChunkedVector() = default;
+  ChunkedVector(const ChunkedVector &) = delete;
+  ChunkedVector &operator=(const ChunkedVector &) = delete;
+
+  size_t size() const {
+    return count;
+  }
+
+  bool empty() const {
+    return count == 0;
+  }
+
+  TYPE get(size_t i) const {
+    assert(i < count);
+    size_t pos = first + i;
+    return chunks[pos / CHUNK_SIZE][pos % CHUNK_SIZE];
+  }
+
+  void set(size_t i, const TYPE &value) {
+    assert(i < count);
+    size_t pos = first + i;
+    chunks[pos / CHUNK_SIZE][pos % CHUNK_SIZE] = value;
+  }
+
+  void push_back(const TYPE &value) {
+    size_t pos = first + count;
+
+    if (pos / CHUNK_SIZE == chunks.size()) {
+      chunks.emplace_back();
+
+      if (chunks.size() > 1) {
+        chunks.back().reserve(CHUNK_SIZE);
+      }
+    }
+
+    chunks.back().push_back(value);
+    ++count;
+  }
+
+  void push_front(const TYPE &value) {
+    if (first == 0) {
+      // the values of the new first chunk are filled from its end
+      chunks.emplace(chunks.begin(), CHUNK_SIZE);
+      first = CHUNK_SIZE;
+    }
+
+    chunks.front()[--first] = value;
+    ++count;
+  }
+
+  void clear() {
+    chunks.clear();
+    chunks.shrink_to_fit();
+    first = count = 0;
+  }
+
+  /**
+   * @brief Returns the number of bytes allocated to store the values.
+   */
+  size_t memoryUsage() const {
+    size_t bytes = chunks.capacity() * sizeof(std::vector<TYPE>);
+
+    for (const auto &chunk : chunks) {
+      bytes += chunk.capacity() * sizeof(TYPE);
+    }
+
+    return bytes;
+  }
+
+private:
+  std::vector<std::vector<TYPE>> chunks;
+  // the position of the first value in the first chunk
+  size_t first = 0;
+  size_t count = 0;
+};
+
+/**
+ * @brief The boolean values are packed in a bitset.
+ */
+template <>
+class ChunkedVector<bool> {
+public:
+  static constexpr double valueSize = 1.0 / 8;
+
+  ChunkedVector() = default;
+  ChunkedVector(const ChunkedVector &) = delete;
+  ChunkedVector &operator=(const ChunkedVector &) = delete;
+
+  size_t size() const {
+    return count;
+  }
+
+  bool empty() const {
+    return count == 0;
+  }
+
+  bool get(size_t i) const {
+    assert(i < count);
+    size_t pos = first + i;
+    return (words[pos / WORD_BITS] >> (pos % WORD_BITS)) & 1;
+  }
+
+  void set(size_t i, bool value) {
+    assert(i < count);
+    size_t pos = first + i;
+    uint64_t mask = uint64_t(1) << (pos % WORD_BITS);
+
+    if (value) {
+      words[pos / WORD_BITS] |= mask;
+    } else {
+      words[pos / WORD_BITS] &= ~mask;
+    }
+  }
+
+  void push_back(bool value) {
+    if ((first + count) / WORD_BITS == words.size()) {
+      words.push_back(0);
+    }
+
+    ++count;
+    set(count - 1, value);
+  }
+
+  void push_front(bool value) {
+    if (first == 0) {
+      // double the free space at the front to keep push_front amortized constant
+      size_t nbWords = std::max<size_t>(1, words.size());
+      words.insert(words.begin(), nbWords, 0);
+      first = nbWords * WORD_BITS;
+    }
+
+    --first;
+    ++count;
+    set(0, value);
+  }
+
+  void clear() {
+    words.clear();
+    words.shrink_to_fit();
+    first = count = 0;
+  }
+
+  size_t memoryUsage() const {
+    return words.capacity() * sizeof(uint64_t);
+  }
+
+private:
+  static constexpr size_t WORD_BITS = 64;
+  std::vector<uint64_t> words;
+  size_t first = 0;
+  size_t count = 0;
+};
+}
+
+#endif // TALIPOT_CHUNKED_VECTOR_H
@@ -58,6 +58,27 @@ public:
    **/
   static uint numberOfConnectedComponents(const Graph *const graph);
 
+  /**
+   * @brief Gets an identifier of the connected component a node belongs to.
+   * Two nodes are in the same connected component if and only if they have the same identifier.
+   * The identifiers are only valid until the next modification of the graph.
+   *
+   * @param graph The graph containing the node.
+   * @param n The node whose component is queried.
+   * @return uint The identifier of the connected component of n.
+   **/
+  static uint componentId(const Graph *const graph, const node n);
+
+  /**
+   * @brief Checks if there is a path between two nodes of a graph.
+   *
+   * @param graph The graph containing the nodes.
+   * @param n1 The first node.
+   * @param n2 The second node.
+   * @return bool True if n1 and n2 are in the same connected component, false otherwise.
+   **/
+  static bool areConnected(const Graph *const graph, const node n1, const node n2);
+
   /**
    * @brief Computes the set of connected components.
    *
@@ -1,6 +1,6 @@
 /**
  *
- * Copyright (C) 2019-2020  The Talipot developers
+ * Copyright (C) 2019-2021  The Talipot developers
  *
  * Talipot is a fork of Tulip, created by David Auber
  * and the Tulip development Team from LaBRI, University of Bordeaux
@@ -15,22 +15,96 @@
 #define TALIPOT_CONNECTED_TEST_LISTENER_H
 
 #include <unordered_map>
+#include <vector>
 
 #include <talipot/Graph.h>
 #include <talipot/Observable.h>
+#include <talipot/ParallelTools.h>
 
 namespace tlp {
 
+/**
+ * @brief Union-find structure over the positions of the nodes of a graph
+ * describing its connected components.
+ **/
+class ConnectedComponentsUnionFind {
+public:
+  /**
+   * @brief Computes the connected components of graph from scratch.
+   **/
+  void init(const Graph *graph);
+
+  /**
+   * @brief Adds the nodes of graph that have been added since the last update,
+   * each one in its own component.
+   **/
+  void addNodes(const Graph *graph);
+
+  /**
+   * @brief Merges the components of the ends of an edge of graph.
+   **/
+  void addEdge(const Graph *graph, edge e);
+
+  /**
+   * @brief Flags the structure as outdated because the node n or the edge e of the graph
+   * is being deleted or, when both are invalid, because the ends of an edge have changed.
+   * As the deletion events are sent before the removal of the element, the structure is
+   * computed again by init() until that element is no longer in the graph.
+   **/
+  void invalidate(node n = node(), edge e = edge());
+
+  /**
+   * @brief Returns whether the structure has not been invalidated since its last computation.
+   **/
+  bool isUpToDate() const {
+    return upToDate;
+  }
+
+  /**
+   * @brief Returns the position of the representative node of the component
+   * the node at position pos belongs to.
+   **/
+  uint find(uint pos);
+
+  /**
+   * @brief Merges the components of the nodes at positions pos1 and pos2.
+   **/
+  void unite(uint pos1, uint pos2);
+
+  uint numberOfComponents() const {
+    return nbComponents;
+  }
+
+private:
+  std::vector<uint> parents;
+  std::vector<uint> sizes;
+  uint nbComponents = 0;
+  bool upToDate = false;
+  // the element whose deletion invalidated the structure
+  node deletedNode;
+  edge deletedEdge;
+};
+
 class ConnectedTestListener : public Observable {
 public:
-  // override of Observable::treatEvent to remove the cached result for a graph if it is modified.
+  // override of Observable::treatEvent to update or remove
+  // the cached components for a graph if it is modified.
   void treatEvent(const Event &) override;
 
   /**
-   * @brief Stored results for graphs. When a graph is updated, its entry is removed from the map.
+   * @brief Returns the connected components of graph, computing them
+   * if they are not already cached.
+   **/
+  ConnectedComponentsUnionFind &getComponents(const Graph *graph);
+
+  /**
+   * @brief Cached components for graphs. They are incrementally updated when nodes or edges
+   * are added in a graph, and invalidated when one of its nodes or edges is deleted or when
+   * the ends of one of its edges change.
    **/
-  std::unordered_map<const Graph *, bool> resultsBuffer;
+  std::unordered_map<const Graph *, ConnectedComponentsUnionFind> componentsBuffer;
 };
 
+TLP_DECLARE_GLOBAL_LOCK(ConnectedTestBuffer);
 }
 #endif // TALIPOT_CONNECTED_TEST_LISTENER_H
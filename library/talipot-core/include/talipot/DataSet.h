@@ -26,6 +26,7 @@
 namespace tlp {
 
 class Graph;
+class PropertyInterface;
 
 // basic interface to embed a data of any type
 struct TLP_SCOPE DataMem {
@@ -72,6 +73,19 @@ struct TLP_SCOPE DataType : public DataMem {
     return isTalipotProperty(getTypeName());
   }
 
+  /**
+   * @brief Returns the property pointed by the stored pointer of a Talipot property type,
+   * nullptr if the stored element is not such a pointer.
+   */
+  PropertyInterface *getProperty() const;
+
+  /**
+   * @brief Replaces the property pointed by the stored pointer of a Talipot property type,
+   * prop must be of the pointed property type.
+   * @return false if the stored element is not a pointer on a Talipot property.
+   */
+  bool setProperty(PropertyInterface *prop);
+
   /**
    * @brief The actual pointer to the element's data
    */
@@ -60,6 +60,10 @@ public:
   void setNodeValue(const node n, StoredType<GraphType::RealType>::ConstReference g) override;
   void setAllNodeValue(StoredType<GraphType::RealType>::ConstReference g,
                        const Graph *graph = nullptr) override;
+  void setNodeValues(const std::vector<node> &nodes,
+                     const std::vector<GraphType::RealType> &values) override;
+  void setNodeValues(const std::vector<node> &nodes,
+                     StoredType<GraphType::RealType>::ConstReference g) override;
   bool readNodeDefaultValue(std::istream &iss) override;
   bool readNodeValue(std::istream &iss, node n) override;
   // GraphType encapsulates a Graph pointer but that is the graph id
@@ -129,6 +129,15 @@ public:
    **/
   void updateAllEdgesValues(TYPE_CONST_REFERENCE(EdgeType) newValue);
 
+  // redefinition of the bulk setters of AbstractProperty
+  // to keep the cached minimal/maximal values up to date
+  void setNodeValues(const std::vector<node> &nodes,
+                     const std::vector<REAL_TYPE(NodeType)> &values) override;
+  void setNodeValues(const std::vector<node> &nodes, TYPE_CONST_REFERENCE(NodeType) v) override;
+  void setEdgeValues(const std::vector<edge> &edges,
+                     const std::vector<REAL_TYPE(EdgeType)> &values) override;
+  void setEdgeValues(const std::vector<edge> &edges, TYPE_CONST_REFERENCE(EdgeType) v) override;
+
 protected:
   MINMAX_MAP(NodeType) _minMaxNode;
   MINMAX_MAP(EdgeType) _minMaxEdge;
@@ -14,7 +14,6 @@
 #ifndef TALIPOT_MUTABLE_CONTAINER_H
 #define TALIPOT_MUTABLE_CONTAINER_H
 
-#include <deque>
 #include <iostream>
 #include <string>
 #include <cassert>
@@ -24,6 +23,7 @@
 #include <parallel_hashmap/phmap_fwd_decl.h>
 
 #include <talipot/config.h>
+#include <talipot/ChunkedVector.h>
 #include <talipot/PropertyTypes.h>
 #include <talipot/DataSet.h>
 #include <talipot/Iterator.h>
@@ -107,6 +107,25 @@ public:
    */
   void invertBooleanValue(const INDEX_TYPE i);
 
+  /**
+   * set whether the string values are interned in the StringPool,
+   * the values already stored are converted (do nothing for non string values)
+   */
+  void setInternedValues(bool interned);
+
+  /**
+   * return whether the string values are interned in the StringPool
+   */
+  bool hasInternedValues() const {
+    return internedValues;
+  }
+
+  /**
+   * return the number of bytes allocated by the container to store its values,
+   * the size of the container object itself and the interned strings excepted
+   */
+  size_t memoryUsage() const;
+
 private:
   MutableContainer(const MutableContainer<TYPE> &) {}
   void operator=(const MutableContainer<TYPE> &) {}
@@ -115,11 +134,14 @@ private:
   void hashtovect();
   void compress(INDEX_TYPE min, INDEX_TYPE max, uint nbElements);
   void vectset(const INDEX_TYPE i, typename StoredType<TYPE>::Value value);
+  typename StoredType<TYPE>::Value
+  cloneValue(typename StoredType<TYPE>::ConstReference value) const;
+  void destroyValue(typename StoredType<TYPE>::Value value) const;
   IteratorValue<INDEX_TYPE> *findAllValues(typename StoredType<TYPE>::ConstReference value,
                                            bool equal = true) const;
 
 private:
-  std::deque<typename StoredType<TYPE>::Value> *vData;
+  ChunkedVector<typename StoredType<TYPE>::Value> *vData;
   phmap::flat_hash_map<INDEX_TYPE, typename StoredType<TYPE>::Value> *hData;
   INDEX_TYPE minIndex, maxIndex;
   typename StoredType<TYPE>::Value defaultValue;
@@ -128,6 +150,7 @@ private:
   uint elementInserted;
   double ratio;
   bool compressing;
+  bool internedValues;
 };
 
 DECLARE_DLL_TEMPLATE_INSTANCE(SINGLE_ARG(MutableContainer<edge>), TLP_TEMPLATE_DECLARE_SCOPE)
@@ -0,0 +1,167 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef TALIPOT_PLUGIN_PROFILER_H
+#define TALIPOT_PLUGIN_PROFILER_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <talipot/config.h>
+
+namespace tlp {
+
+class Graph;
+class PropertyInterface;
+
+/**
+ * @ingroup Plugins
+ * @brief The measures recorded for a plugin invocation by the PluginProfiler.
+ **/
+struct TLP_SCOPE PluginProfile {
+  /**
+   * @brief The name of the plugin.
+   **/
+  std::string pluginName;
+  /**
+   * @brief The kind of invocation: "Algorithm", "PropertyAlgorithm", "Import" or "Export".
+   **/
+  std::string category;
+  /**
+   * @brief The id of the graph the plugin was applied to.
+   **/
+  uint graphId = 0;
+  /**
+   * @brief The nesting level of the invocation, 0 if the plugin was not called by another one.
+   **/
+  uint depth = 0;
+  /**
+   * @brief The index of the thread the plugin was run in, in order of first profiled
+   * invocation.
+   **/
+  uint threadIndex = 0;
+  /**
+   * @brief Whether the plugin succeeded.
+   **/
+  bool success = false;
+  /**
+   * @brief The start of the invocation, in seconds since the profiler was enabled.
+   **/
+  double startTime = 0;
+  /**
+   * @brief The elapsed real time of the invocation, in seconds.
+   **/
+  double wallTime = 0;
+  /**
+   * @brief The cpu time consumed by the process (all threads) during the invocation, in seconds.
+   **/
+  double cpuTime = 0;
+  /**
+   * @brief The growth of the peak resident set size of the process during the invocation,
+   * in bytes. It is 0 when the plugin did not raise the peak memory usage.
+   **/
+  int64_t peakMemoryDelta = 0;
+  /**
+   * @brief The number of events sent by the graph and its descendant graphs
+   * (elements and subgraphs addition or deletion, properties addition, ...).
+   **/
+  uint64_t graphEvents = 0;
+  /**
+   * @brief The number of node or edge values written in the properties of the graph
+   * and in the result property. A setAllNodeValue or setAllEdgeValue call counts
+   * for the number of elements of the property graph.
+   **/
+  uint64_t valuesWritten = 0;
+};
+
+/**
+ * @ingroup Plugins
+ * @brief An opt-in profiler of the plugins invocations.
+ *
+ * When enabled, each call to Graph::applyAlgorithm, Graph::applyPropertyAlgorithm,
+ * tlp::importGraph and tlp::exportGraph records a PluginProfile holding its wall time,
+ * cpu time, peak memory growth and the numbers of graph events and property values
+ * written. The recorded profiles can be retrieved or written as a trace in the Chrome
+ * trace event format, which can be loaded in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * The graph events and the values written are counted by listening to the graph,
+ * its descendant graphs and its properties during the invocation, so the profiled plugins
+ * run slower than usual. Nothing is measured when the profiler is disabled (the default).
+ *
+ * Setting the TALIPOT_PLUGINS_PROFILE_TRACE environment variable to a file path enables
+ * the profiler at startup and writes the trace to that file at exit, which allows to profile
+ * a whole pipeline without modifying it.
+ **/
+class TLP_SCOPE PluginProfiler {
+public:
+  /**
+   * @brief Enables or disables the profiler. It is disabled by default.
+   * Enabling the profiler clears the previously recorded profiles.
+   **/
+  static void setEnabled(bool enabled);
+
+  /**
+   * @brief Returns whether the profiler is enabled.
+   **/
+  static bool isEnabled();
+
+  /**
+   * @brief Returns the profiles recorded since the profiler was enabled,
+   * in order of completion of the invocations.
+   **/
+  static std::vector<PluginProfile> profiles();
+
+  /**
+   * @brief Discards the recorded profiles.
+   **/
+  static void clear();
+
+  /**
+   * @brief Writes the recorded profiles in the Chrome trace event format.
+   **/
+  static void writeTrace(std::ostream &os);
+
+  /**
+   * @brief Writes the recorded profiles in the Chrome trace event format to a file.
+   * @return false if the file cannot be written.
+   **/
+  static bool writeTrace(const std::string &filename);
+
+  /**
+   * @brief Measures a plugin invocation from its construction to its destruction
+   * and records the resulting profile if the profiler is enabled.
+   **/
+  class TLP_SCOPE Scope {
+  public:
+    Scope(const std::string &pluginName, const std::string &category, Graph *graph,
+          PropertyInterface *result = nullptr);
+    ~Scope();
+
+    /**
+     * @brief Sets whether the invocation succeeded.
+     **/
+    void setSuccess(bool success);
+
+  private:
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    struct Measure;
+    Measure *measure;
+  };
+};
+}
+
+#endif // TALIPOT_PLUGIN_PROFILER_H
@@ -105,6 +105,26 @@ protected:
   ///
   LayoutAlgorithm(const tlp::PluginContext *);
 
+  /**
+   * @brief Lays out separately each connected component of the graph then packs them
+   * with the "Connected Component Packing" algorithm.
+   *
+   * This is intended to be called from the run method of the layout plugins which
+   * only handle connected graphs. Each connected component is copied in a standalone graph,
+   * along with the values of the property parameters of the plugin, and a new instance
+   * of the plugin is run on it. The resulting layouts are then written back in result.
+   * The values of the other properties modified by the plugin are not written back.
+   * If the plugin has a "time budget" parameter, in milliseconds, it bounds the layout
+   * of all the components: each instance gets the time remaining when it starts.
+   *
+   * @param concurrent If true, the components are laid out in parallel, with the events
+   * notification disabled. The run method of the plugin must then be thread safe,
+   * which notably excludes the use of the global random number generator and
+   * the creation or deletion of graphs and properties.
+   * @return true if the layout succeeded, false otherwise.
+   */
+  bool layoutConnectedComponents(bool concurrent = false);
+
 public:
   std::string category() const override {
     return LAYOUT_ALGORITHM_CATEGORY;
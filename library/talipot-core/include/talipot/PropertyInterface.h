@@ -17,6 +17,7 @@
 #include <string>
 #include <iostream>
 #include <functional>
+#include <vector>
 
 #include <talipot/config.h>
 #include <talipot/Observable.h>
@@ -99,6 +100,24 @@ public:
   virtual bool copy(const edge destination, const edge source, PropertyInterface *property,
                     bool ifNotDefault = false) = 0;
 
+  /**
+   * @brief Copies the values of some nodes in another property of the same type
+   * to the same nodes in this property.
+   * Only one event is sent for all the nodes.
+   * @param nodes The nodes whose values will be copied.
+   * @param property The property from which to copy the nodes values.
+   */
+  virtual void copy(const std::vector<node> &nodes, PropertyInterface *property) = 0;
+
+  /**
+   * @brief Copies the values of some edges in another property of the same type
+   * to the same edges in this property.
+   * Only one event is sent for all the edges.
+   * @param edges The edges whose values will be copied.
+   * @param property The property from which to copy the edges values.
+   */
+  virtual void copy(const std::vector<edge> &edges, PropertyInterface *property) = 0;
+
   /**
    * @brief Copies the values of the source property to this property.
    * @param source The property from which to copy values.
@@ -401,6 +420,15 @@ public:
    */
   virtual uint numberOfNonDefaultValuatedEdges(const Graph * = nullptr) const = 0;
 
+  /**
+   * @brief Returns the number of bytes allocated to store the nodes and edges values.
+   * It includes the memory allocated by the values stored by pointer (vectors, ...)
+   * but not the one of the interned string values, which are shared in the StringPool.
+   * @return the memory usage of the values of the property.
+   *
+   */
+  virtual size_t memoryUsage() const = 0;
+
   /**
    * @brief Returns the size in bytes of a node's value.
    * @return the size of a node's value (0 means the size is not fixed)
@@ -538,6 +566,10 @@ protected:
   void notifyAfterSetAllNodeValue();
   void notifyBeforeSetAllEdgeValue();
   void notifyAfterSetAllEdgeValue();
+  void notifyBeforeSetNodesValues(const std::vector<node> &nodes);
+  void notifyAfterSetNodesValues(const std::vector<node> &nodes);
+  void notifyBeforeSetEdgesValues(const std::vector<edge> &edges);
+  void notifyAfterSetEdgesValues(const std::vector<edge> &edges);
   void notifyDestroy();
   void notifyRename(const std::string &newName);
 };
@@ -639,11 +671,31 @@ public:
     TLP_BEFORE_SET_ALL_EDGE_VALUE,
     TLP_AFTER_SET_ALL_EDGE_VALUE,
     TLP_BEFORE_SET_EDGE_VALUE,
-    TLP_AFTER_SET_EDGE_VALUE
+    TLP_AFTER_SET_EDGE_VALUE,
+    TLP_BEFORE_SET_NODES_VALUES,
+    TLP_AFTER_SET_NODES_VALUES,
+    TLP_BEFORE_SET_EDGES_VALUES,
+    TLP_AFTER_SET_EDGES_VALUES
   };
   PropertyEvent(const PropertyInterface &prop, PropertyEventType propEvtType,
                 Event::EventType evtType = Event::TLP_MODIFICATION, uint id = UINT_MAX)
-      : Event(prop, evtType), evtType(propEvtType), eltId(id) {}
+      : Event(prop, evtType), evtType(propEvtType), eltId(id) {
+    elts.nodes = nullptr;
+  }
+
+  // constructor for nodes values events
+  PropertyEvent(const PropertyInterface &prop, PropertyEventType propEvtType,
+                Event::EventType evtType, const std::vector<node> &nodes)
+      : Event(prop, evtType), evtType(propEvtType), eltId(UINT_MAX) {
+    elts.nodes = &nodes;
+  }
+
+  // constructor for edges values events
+  PropertyEvent(const PropertyInterface &prop, PropertyEventType propEvtType,
+                Event::EventType evtType, const std::vector<edge> &edges)
+      : Event(prop, evtType), evtType(propEvtType), eltId(UINT_MAX) {
+    elts.edges = &edges;
+  }
 
   PropertyInterface *getProperty() const {
     return static_cast<PropertyInterface *>(sender());
@@ -655,10 +707,38 @@ public:
   }
 
   edge getEdge() const {
-    assert(evtType > TLP_AFTER_SET_ALL_EDGE_VALUE);
+    assert(evtType == TLP_BEFORE_SET_EDGE_VALUE || evtType == TLP_AFTER_SET_EDGE_VALUE);
     return edge(eltId);
   }
 
+  /**
+   * @brief Returns the nodes whose values are modified by a TLP_BEFORE_SET_NODES_VALUES
+   * or TLP_AFTER_SET_NODES_VALUES event, an empty vector for the other events.
+   */
+  const std::vector<node> &getNodes() const {
+    static const std::vector<node> noNodes;
+
+    if (evtType != TLP_BEFORE_SET_NODES_VALUES && evtType != TLP_AFTER_SET_NODES_VALUES) {
+      return noNodes;
+    }
+
+    return *elts.nodes;
+  }
+
+  /**
+   * @brief Returns the edges whose values are modified by a TLP_BEFORE_SET_EDGES_VALUES
+   * or TLP_AFTER_SET_EDGES_VALUES event, an empty vector for the other events.
+   */
+  const std::vector<edge> &getEdges() const {
+    static const std::vector<edge> noEdges;
+
+    if (evtType != TLP_BEFORE_SET_EDGES_VALUES && evtType != TLP_AFTER_SET_EDGES_VALUES) {
+      return noEdges;
+    }
+
+    return *elts.edges;
+  }
+
   PropertyEventType getType() const {
     return evtType;
   }
@@ -666,6 +746,10 @@ public:
 protected:
   PropertyEventType evtType;
   uint eltId;
+  union {
+    const std::vector<node> *nodes;
+    const std::vector<edge> *edges;
+  } elts;
 };
 }
 
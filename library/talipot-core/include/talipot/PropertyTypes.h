@@ -204,10 +204,54 @@ DECL_STORED_STRUCT(tlp::LineType::RealType)
 DECL_STORED_STRUCT(tlp::PointType::RealType)
 DECL_STORED_STRUCT(tlp::SizeType::RealType)
 DECL_STORED_STRUCT(tlp::SizeVectorType::RealType)
-DECL_STORED_STRUCT(tlp::StringType::RealType)
 DECL_STORED_STRUCT(tlp::StringVectorType::RealType)
 DECL_STORED_STRUCT(tlp::ColorVectorType::RealType)
 
+// the stored strings are returned as constant references as they may be
+// interned in the StringPool (see MutableContainer::setInternedValues),
+// the default value of a container is always a private copy
+// to be distinguished from the stored values
+template <>
+struct StoredType<std::string> {
+  typedef std::string *Value;
+  typedef const std::string &Reference;
+  typedef const std::string &ConstReference;
+
+  enum { isPointer = 1 };
+
+  static const std::string &get(const Value &val) {
+    return *val;
+  }
+
+  static bool equal(Value val1, const std::string &val2) {
+    return val2 == *val1;
+  }
+
+  static bool equal(const std::string &val2, Value val1) {
+    return val2 == *val1;
+  }
+
+  static Value clone(const std::string &val) {
+    return new std::string(val);
+  }
+
+  static void destroy(Value val) {
+    delete val;
+  }
+
+  static Value cloneDefault(const std::string &val) {
+    return new std::string(val);
+  }
+
+  static void destroyDefault(Value val) {
+    delete val;
+  }
+
+  static Value defaultValue() {
+    return new std::string();
+  }
+};
+
 // template class to automate definition of serializers
 template <typename T>
 struct KnownTypeSerializer : public TypedDataSerializer<REAL_TYPE(T)> {
@@ -83,6 +83,52 @@ public:
 
     entities.push_back(id);
   }
+  /**
+   * Remove an element from the quadtree,
+   * box must be the one used to insert it.
+   * Returns false if the element has not been found.
+   */
+  bool remove(const tlp::Rectangle<float> &box, const TYPE id) {
+    assert(box.isValid());
+    assert(_box.isValid());
+
+    // degenerated boxes are not inserted
+    if (box[0] == box[1]) {
+      return true;
+    }
+
+    // follow the same path as insert
+    Vec2f subBox((_box[0] + _box[1]) / 2.f);
+
+    if (!((subBox == _box[0]) || (subBox == _box[1]))) {
+      for (int i = 0; i < 4; ++i) {
+        if (getChildBox(i).isInside(box)) {
+          if (children[i] != nullptr) {
+            return children[i]->remove(box, id);
+          }
+
+          break;
+        }
+      }
+    }
+
+    for (size_t i = 0; i < entities.size(); ++i) {
+      if (entities[i] == id) {
+        entities[i] = entities.back();
+        entities.pop_back();
+        return true;
+      }
+    }
+
+    return false;
+  }
+  /**
+   * Return true if box is inside the global bounding box
+   * of the quadtree, so its element can be inserted
+   */
+  bool canInsert(const tlp::Rectangle<float> &box) const {
+    return _box.isInside(box);
+  }
   /**
    * return all elements that could be in
    * the given box (the function ensures that
@@ -52,6 +52,8 @@ public:
   // redefinition of some AbstractProperty methods
   void setNodeValue(const node n, StoredType<Size>::ConstReference v) override;
   void setAllNodeValue(StoredType<Size>::ConstReference v, const Graph *graph = nullptr) override;
+  void setNodeValues(const std::vector<node> &nodes, const std::vector<Size> &values) override;
+  void setNodeValues(const std::vector<node> &nodes, StoredType<Size>::ConstReference v) override;
 
   int compare(const node n1, const node n2) const override;
 
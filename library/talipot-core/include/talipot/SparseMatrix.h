@@ -0,0 +1,108 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef TALIPOT_SPARSE_MATRIX_H
+#define TALIPOT_SPARSE_MATRIX_H
+
+#include <vector>
+
+#include <talipot/config.h>
+
+namespace tlp {
+
+/**
+ * @ingroup Structures
+ * @brief A square sparse matrix of doubles stored in the compressed sparse row format.
+ *
+ * The matrix is assembled by adding its non zero entries in any order with addEntry(),
+ * the values added several times at the same position are summed,
+ * then it is compressed once by compress() before being used.
+ * It is intended to hold the Laplacian like systems of the layout algorithms,
+ * which are solved by solveConjugateGradient().
+ */
+class TLP_SCOPE SparseMatrix {
+public:
+  explicit SparseMatrix(uint size = 0);
+
+  /**
+   * @brief Returns the number of rows (and columns) of the matrix.
+   */
+  uint size() const {
+    return nbRows;
+  }
+
+  /**
+   * @brief Returns the number of stored entries once the matrix is compressed.
+   */
+  uint numberOfEntries() const {
+    return values.size();
+  }
+
+  /**
+   * @brief Adds value to the entry at (row, col). It can only be called before compress().
+   */
+  void addEntry(uint row, uint col, double value);
+
+  /**
+   * @brief Builds the compressed rows from the added entries.
+   */
+  void compress();
+
+  /**
+   * @brief Returns the value of the entry at (row, col) of the compressed matrix.
+   */
+  double get(uint row, uint col) const;
+
+  /**
+   * @brief Returns the diagonal entry of a row of the compressed matrix.
+   */
+  double diagonal(uint row) const {
+    return get(row, row);
+  }
+
+  /**
+   * @brief Computes y = A.x, the rows are computed in parallel.
+   */
+  void multiply(const std::vector<double> &x, std::vector<double> &y) const;
+
+private:
+  uint nbRows;
+  // the uncompressed (row, col, value) entries
+  struct Triplet {
+    uint row, col;
+    double value;
+  };
+  std::vector<Triplet> triplets;
+  // the entries of row i are stored in [rowStarts[i], rowStarts[i + 1])
+  std::vector<uint> rowStarts;
+  std::vector<uint> columns;
+  std::vector<double> values;
+};
+
+/**
+ * @brief Solves the linear system A.x = b with the Jacobi preconditioned conjugate gradient method.
+ *
+ * The matrix must be symmetric positive definite and compressed,
+ * x holds the initial guess and is replaced by the solution.
+ * The iterations stop when the norm of the residual is lower than tolerance times the norm of b,
+ * or after maxIterations iterations.
+ *
+ * @param nbIterations if not null, receives the number of iterations done.
+ * @return true if the required tolerance has been reached.
+ */
+TLP_SCOPE bool solveConjugateGradient(const SparseMatrix &A, const std::vector<double> &b,
+                                      std::vector<double> &x, double tolerance = 1e-6,
+                                      uint maxIterations = 1000, uint *nbIterations = nullptr);
+}
+
+#endif // TALIPOT_SPARSE_MATRIX_H
@@ -43,6 +43,13 @@ struct StoredType {
   }
   // destruction of stored value
   static void destroy(Value) {}
+  // cloning and destruction of the default value of a container
+  static Value cloneDefault(const TYPE &val) {
+    return clone(val);
+  }
+  static void destroyDefault(Value val) {
+    destroy(val);
+  }
   // the default value of that type
   static Value defaultValue() {
     return static_cast<Value>(0);
@@ -82,6 +89,15 @@ struct StoredType {
     static void destroy(Value val) {               \
       delete val;                                  \
     }                                              \
+                                                   \
+    static Value cloneDefault(const T &val) {      \
+      return new T(val);                           \
+    }                                              \
+                                                   \
+    static void destroyDefault(Value val) {        \
+      delete val;                                  \
+    }                                              \
+                                                   \
     static Value defaultValue() {                  \
       return new T();                              \
     }                                              \
@@ -0,0 +1,70 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef TALIPOT_STRING_POOL_H
+#define TALIPOT_STRING_POOL_H
+
+#include <string>
+
+#include <talipot/config.h>
+
+namespace tlp {
+
+/**
+ * @ingroup Structures
+ * @brief A thread safe pool of reference counted interned strings.
+ *
+ * Interning a string returns the address of the single copy of its content stored
+ * in the pool, so two interned strings are equal if and only if their addresses are equal.
+ * The values of the StringProperty objects can be interned (see
+ * StringProperty::setInternedValues()), which saves a lot of memory
+ * when a few distinct labels or categories are shared by many graph elements,
+ * and allows to compare or index them by address instead of by content.
+ *
+ * Each call to intern() must be balanced by a call to release(),
+ * the string is removed from the pool when it is no longer referenced.
+ */
+class TLP_SCOPE StringPool {
+public:
+  /**
+   * @brief Returns the interned copy of str and increments its reference count.
+   */
+  static const std::string *intern(const std::string &str);
+
+  /**
+   * @brief Decrements the reference count of an interned string
+   * and removes it from the pool if it is no longer referenced.
+   */
+  static void release(const std::string *str);
+
+  /**
+   * @brief Returns the number of references to an interned string.
+   */
+  static uint refCount(const std::string *str);
+
+  /**
+   * @brief Returns the number of distinct strings in the pool.
+   */
+  static uint size();
+
+  /**
+   * @brief Returns the number of bytes allocated to store the strings of the pool.
+   */
+  static size_t memoryUsage();
+
+private:
+  StringPool() = delete;
+};
+}
+
+#endif // TALIPOT_STRING_POOL_H
@@ -49,6 +49,44 @@ public:
   }
   int compare(const node n1, const node n2) const override;
   int compare(const edge e1, const edge e2) const override;
+
+  /**
+   * @brief Sets whether the values of the elements are interned in the StringPool.
+   *
+   * The elements with equal values then share a single string, which saves memory
+   * when a few distinct values, like categories, are shared by many elements.
+   * It is disabled by default as interning costs a lock on a shared pool for each
+   * value set and an extra allocation for each distinct value,
+   * which only slows down the properties with mostly distinct values like labels.
+   * The values already set are converted.
+   */
+  void setInternedValues(bool interned);
+
+  /**
+   * @brief Returns whether the values of the elements are interned in the StringPool.
+   */
+  bool hasInternedValues() const {
+    return nodeProperties.hasInternedValues();
+  }
+
+  /**
+   * @brief Returns an identifier of the value of a node.
+   *
+   * When the values are interned, two nodes have the same identifier if and only if
+   * they have the same value. It allows to compare, hash or cache the values
+   * without reading their contents. Otherwise only the nodes with the default value
+   * share the same identifier.
+   * The identifier is the address of the value and remains valid
+   * until the value of the node or the default value is modified.
+   */
+  const std::string *getNodeValueId(const node n) const;
+
+  /**
+   * @brief Returns an identifier of the value of an edge.
+   *
+   * @see getNodeValueId()
+   */
+  const std::string *getEdgeValueId(const edge e) const;
 };
 
 DECLARE_DLL_TEMPLATE_INSTANCE(
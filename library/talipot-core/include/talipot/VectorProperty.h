@@ -14,6 +14,9 @@
 #ifndef TALIPOT_VECTOR_PROPERTY_H
 #define TALIPOT_VECTOR_PROPERTY_H
 
+#include <type_traits>
+#include <vector>
+
 #include <talipot/Graph.h>
 #include <talipot/GraphParallelTools.h>
 #include <talipot/NumericProperty.h>
@@ -114,11 +117,13 @@ public:
   template <typename PROP_PTR>
   void copyToProperty(PROP_PTR prop) {
     assert(graph);
-    const std::vector<node> &nodes = graph->nodes();
-    uint nbNodes = nodes.size();
+    // the values are set in bulk so that only one event is sent
+    using ValueType = std::decay_t<decltype(prop->getNodeDefaultValue())>;
 
-    for (uint i = 0; i < nbNodes; ++i) {
-      prop->setNodeValue(nodes[i], (*this)[i]);
+    if constexpr (std::is_same_v<typename std::decay_t<decltype(*this)>::value_type, ValueType>) {
+      prop->setNodeValues(graph->nodes(), *this);
+    } else {
+      prop->setNodeValues(graph->nodes(), std::vector<ValueType>(this->begin(), this->end()));
     }
   }
 };
@@ -218,11 +223,13 @@ public:
   template <typename PROP_PTR>
   void copyToProperty(PROP_PTR prop) {
     assert(graph);
-    const std::vector<node> &nodes = graph->nodes();
-    uint nbNodes = nodes.size();
+    // the values are set in bulk so that only one event is sent
+    using ValueType = std::decay_t<decltype(prop->getNodeDefaultValue())>;
 
-    for (uint i = 0; i < nbNodes; ++i) {
-      prop->setNodeValue(nodes[i], (*this)[i]);
+    if constexpr (std::is_same_v<typename std::decay_t<decltype(*this)>::value_type, ValueType>) {
+      prop->setNodeValues(graph->nodes(), *this);
+    } else {
+      prop->setNodeValues(graph->nodes(), std::vector<ValueType>(this->begin(), this->end()));
     }
   }
 };
@@ -327,11 +334,13 @@ public:
   template <typename PROP_PTR>
   void copyToProperty(PROP_PTR prop) {
     assert(graph);
-    const std::vector<edge> &edges = graph->edges();
-    uint nbEdges = edges.size();
+    // the values are set in bulk so that only one event is sent
+    using ValueType = std::decay_t<decltype(prop->getEdgeDefaultValue())>;
 
-    for (uint i = 0; i < nbEdges; ++i) {
-      prop->setEdgeValue(edges[i], (*this)[i]);
+    if constexpr (std::is_same_v<typename std::decay_t<decltype(*this)>::value_type, ValueType>) {
+      prop->setEdgeValues(graph->edges(), *this);
+    } else {
+      prop->setEdgeValues(graph->edges(), std::vector<ValueType>(this->begin(), this->end()));
     }
   }
 };
@@ -427,11 +436,13 @@ public:
   template <typename PROP_PTR>
   void copyToProperty(PROP_PTR prop) {
     assert(graph);
-    const std::vector<edge> &edges = graph->edges();
-    uint nbEdges = edges.size();
+    // the values are set in bulk so that only one event is sent
+    using ValueType = std::decay_t<decltype(prop->getEdgeDefaultValue())>;
 
-    for (uint i = 0; i < nbEdges; ++i) {
-      prop->setEdgeValue(edges[i], (*this)[i]);
+    if constexpr (std::is_same_v<typename std::decay_t<decltype(*this)>::value_type, ValueType>) {
+      prop->setEdgeValues(graph->edges(), *this);
+    } else {
+      prop->setEdgeValues(graph->edges(), std::vector<ValueType>(this->begin(), this->end()));
     }
   }
 };
@@ -110,6 +110,60 @@ void tlp::AbstractProperty<NodeType, EdgeType, PropType>::setEdgeValue(
 }
 //=============================================================
 template <class NodeType, class EdgeType, class PropType>
+void tlp::AbstractProperty<NodeType, EdgeType, PropType>::setNodeValues(
+    const std::vector<tlp::node> &nodes, const std::vector<REAL_TYPE(NodeType)> &values) {
+  assert(nodes.size() == values.size());
+  PropType::notifyBeforeSetNodesValues(nodes);
+
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    assert(PropType::graph->isElement(nodes[i]));
+    nodeProperties.set(nodes[i], values[i]);
+  }
+
+  PropType::notifyAfterSetNodesValues(nodes);
+}
+//=============================================================
+template <class NodeType, class EdgeType, class PropType>
+void tlp::AbstractProperty<NodeType, EdgeType, PropType>::setNodeValues(
+    const std::vector<tlp::node> &nodes, TYPE_CONST_REFERENCE(NodeType) v) {
+  PropType::notifyBeforeSetNodesValues(nodes);
+
+  for (auto n : nodes) {
+    assert(PropType::graph->isElement(n));
+    nodeProperties.set(n, v);
+  }
+
+  PropType::notifyAfterSetNodesValues(nodes);
+}
+//=============================================================
+template <class NodeType, class EdgeType, class PropType>
+void tlp::AbstractProperty<NodeType, EdgeType, PropType>::setEdgeValues(
+    const std::vector<tlp::edge> &edges, const std::vector<REAL_TYPE(EdgeType)> &values) {
+  assert(edges.size() == values.size());
+  PropType::notifyBeforeSetEdgesValues(edges);
+
+  for (size_t i = 0; i < edges.size(); ++i) {
+    assert(PropType::graph->isElement(edges[i]));
+    edgeProperties.set(edges[i], values[i]);
+  }
+
+  PropType::notifyAfterSetEdgesValues(edges);
+}
+//=============================================================
+template <class NodeType, class EdgeType, class PropType>
+void tlp::AbstractProperty<NodeType, EdgeType, PropType>::setEdgeValues(
+    const std::vector<tlp::edge> &edges, TYPE_CONST_REFERENCE(EdgeType) v) {
+  PropType::notifyBeforeSetEdgesValues(edges);
+
+  for (auto e : edges) {
+    assert(PropType::graph->isElement(e));
+    edgeProperties.set(e, v);
+  }
+
+  PropType::notifyAfterSetEdgesValues(edges);
+}
+//=============================================================
+template <class NodeType, class EdgeType, class PropType>
 void tlp::AbstractProperty<NodeType, EdgeType, PropType>::setNodeDefaultValue(
     TYPE_CONST_REFERENCE(NodeType) v) {
   if (nodeDefaultValue == v) {
@@ -153,9 +207,7 @@ template <class NodeType, class EdgeType, class PropType>
 void tlp::AbstractProperty<NodeType, EdgeType, PropType>::setAllNodeValue(
     TYPE_CONST_REFERENCE(NodeType) v, const Graph *graph) {
   if (graph && this->getGraph()->isDescendantGraph(graph)) {
-    for (auto n : graph->nodes()) {
-      setNodeValue(n, v);
-    }
+    setNodeValues(graph->nodes(), v);
   } else {
     PropType::notifyBeforeSetAllNodeValue();
     nodeDefaultValue = v;
@@ -209,9 +261,7 @@ template <class NodeType, class EdgeType, class PropType>
 void tlp::AbstractProperty<NodeType, EdgeType, PropType>::setAllEdgeValue(
     TYPE_CONST_REFERENCE(EdgeType) v, const Graph *graph) {
   if (graph && this->getGraph()->isDescendantGraph(graph)) {
-    for (auto e : graph->edges()) {
-      setEdgeValue(e, v);
-    }
+    setEdgeValues(graph->edges(), v);
   } else {
     PropType::notifyBeforeSetAllEdgeValue();
     edgeDefaultValue = v;
@@ -347,6 +397,11 @@ uint tlp::AbstractProperty<NodeType, EdgeType, PropType>::numberOfNonDefaultValu
 }
 //============================================================
 template <class NodeType, class EdgeType, class PropType>
+size_t tlp::AbstractProperty<NodeType, EdgeType, PropType>::memoryUsage() const {
+  return nodeProperties.memoryUsage() + edgeProperties.memoryUsage();
+}
+//============================================================
+template <class NodeType, class EdgeType, class PropType>
 uint tlp::AbstractProperty<NodeType, EdgeType, PropType>::edgeValueSize() const {
   return EdgeType::valueSize();
 }
@@ -395,33 +450,46 @@ tlp::AbstractProperty<NodeType, EdgeType, PropType>::operator=(
       PropType::graph = prop.PropType::graph;
     }
 
+    // the values are gathered to be set in bulk
+    std::vector<tlp::node> nodes;
+    std::vector<REAL_TYPE(NodeType)> nodeValues;
+    std::vector<tlp::edge> edges;
+    std::vector<REAL_TYPE(EdgeType)> edgeValues;
+
     if (PropType::graph == prop.PropType::graph) {
       setAllNodeValue(prop.getNodeDefaultValue());
       setAllEdgeValue(prop.getEdgeDefaultValue());
 
       for (auto itn : prop.getNonDefaultValuatedNodes()) {
-        setNodeValue(itn, prop.getNodeValue(itn));
+        nodes.push_back(itn);
+        nodeValues.push_back(prop.getNodeValue(itn));
       }
 
       for (auto ite : prop.getNonDefaultValuatedEdges()) {
-        setEdgeValue(ite, prop.getEdgeValue(ite));
+        edges.push_back(ite);
+        edgeValues.push_back(prop.getEdgeValue(ite));
       }
 
     } else {
       //==============================================================*
       for (auto n : PropType::graph->nodes()) {
         if (prop.PropType::graph->isElement(n)) {
-          setNodeValue(n, prop.getNodeValue(n));
+          nodes.push_back(n);
+          nodeValues.push_back(prop.getNodeValue(n));
         }
       }
 
       for (auto e : PropType::graph->edges()) {
         if (prop.PropType::graph->isElement(e)) {
-          setEdgeValue(e, prop.getEdgeValue(e));
+          edges.push_back(e);
+          edgeValues.push_back(prop.getEdgeValue(e));
         }
       }
     }
 
+    setNodeValues(nodes, nodeValues);
+    setEdgeValues(edges, edgeValues);
+
     clone_handler(prop);
   }
 
@@ -587,6 +655,36 @@ bool tlp::AbstractProperty<NodeType, EdgeType, PropType>::copy(const tlp::edge d
 }
 //============================================================
 template <typename NodeType, typename EdgeType, typename PropType>
+void tlp::AbstractProperty<NodeType, EdgeType, PropType>::copy(const std::vector<tlp::node> &nodes,
+                                                               tlp::PropertyInterface *property) {
+  auto *tp = dynamic_cast<tlp::AbstractProperty<NodeType, EdgeType, PropType> *>(property);
+  assert(tp);
+  std::vector<REAL_TYPE(NodeType)> values;
+  values.reserve(nodes.size());
+
+  for (auto n : nodes) {
+    values.push_back(tp->getNodeValue(n));
+  }
+
+  setNodeValues(nodes, values);
+}
+//============================================================
+template <typename NodeType, typename EdgeType, typename PropType>
+void tlp::AbstractProperty<NodeType, EdgeType, PropType>::copy(const std::vector<tlp::edge> &edges,
+                                                               tlp::PropertyInterface *property) {
+  auto *tp = dynamic_cast<tlp::AbstractProperty<NodeType, EdgeType, PropType> *>(property);
+  assert(tp);
+  std::vector<REAL_TYPE(EdgeType)> values;
+  values.reserve(edges.size());
+
+  for (auto e : edges) {
+    values.push_back(tp->getEdgeValue(e));
+  }
+
+  setEdgeValues(edges, values);
+}
+//============================================================
+template <typename NodeType, typename EdgeType, typename PropType>
 void tlp::AbstractProperty<NodeType, EdgeType, PropType>::copy(tlp::PropertyInterface *property) {
   auto *prop =
       dynamic_cast<typename tlp::AbstractProperty<NodeType, EdgeType, PropType> *>(property);
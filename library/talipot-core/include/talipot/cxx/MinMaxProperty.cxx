@@ -277,6 +277,46 @@ void tlp::MinMaxProperty<NodeType, EdgeType, PropType>::updateAllEdgesValues(
   }
 }
 
+template <typename NodeType, typename EdgeType, typename PropType>
+void tlp::MinMaxProperty<NodeType, EdgeType, PropType>::setNodeValues(
+    const std::vector<tlp::node> &nodes, const std::vector<REAL_TYPE(NodeType)> &values) {
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    updateNodeValue(nodes[i], values[i]);
+  }
+
+  AbstractProperty<NodeType, EdgeType, PropType>::setNodeValues(nodes, values);
+}
+
+template <typename NodeType, typename EdgeType, typename PropType>
+void tlp::MinMaxProperty<NodeType, EdgeType, PropType>::setNodeValues(
+    const std::vector<tlp::node> &nodes, TYPE_CONST_REFERENCE(NodeType) v) {
+  for (auto n : nodes) {
+    updateNodeValue(n, v);
+  }
+
+  AbstractProperty<NodeType, EdgeType, PropType>::setNodeValues(nodes, v);
+}
+
+template <typename NodeType, typename EdgeType, typename PropType>
+void tlp::MinMaxProperty<NodeType, EdgeType, PropType>::setEdgeValues(
+    const std::vector<tlp::edge> &edges, const std::vector<REAL_TYPE(EdgeType)> &values) {
+  for (size_t i = 0; i < edges.size(); ++i) {
+    updateEdgeValue(edges[i], values[i]);
+  }
+
+  AbstractProperty<NodeType, EdgeType, PropType>::setEdgeValues(edges, values);
+}
+
+template <typename NodeType, typename EdgeType, typename PropType>
+void tlp::MinMaxProperty<NodeType, EdgeType, PropType>::setEdgeValues(
+    const std::vector<tlp::edge> &edges, TYPE_CONST_REFERENCE(EdgeType) v) {
+  for (auto e : edges) {
+    updateEdgeValue(e, v);
+  }
+
+  AbstractProperty<NodeType, EdgeType, PropType>::setEdgeValues(edges, v);
+}
+
 template <typename NodeType, typename EdgeType, typename PropType>
 void tlp::MinMaxProperty<NodeType, EdgeType, PropType>::treatEvent(const tlp::Event &ev) {
   const auto *graphEvent = dynamic_cast<const tlp::GraphEvent *>(&ev);
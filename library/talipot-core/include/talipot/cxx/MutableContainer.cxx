@@ -20,6 +20,55 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <set>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <talipot/StringPool.h>
+
+//===================================================================
+// the functions below estimate the number of bytes used by a value
+// stored by pointer, including the memory it allocates
+namespace tlp {
+template <typename TYPE>
+size_t storedValueMemoryUsage(const TYPE &) {
+  return sizeof(TYPE);
+}
+
+inline size_t storedValueMemoryUsage(const std::string &str) {
+  const char *begin = reinterpret_cast<const char *>(&str);
+
+  // the short strings are stored inside the string object
+  if (str.data() >= begin && str.data() < begin + sizeof(std::string)) {
+    return sizeof(std::string);
+  }
+
+  return sizeof(std::string) + str.capacity() + 1;
+}
+
+inline size_t storedValueMemoryUsage(const std::vector<bool> &vect) {
+  return sizeof(std::vector<bool>) + vect.capacity() / 8;
+}
+
+template <typename TYPE>
+size_t storedValueMemoryUsage(const std::set<TYPE> &set) {
+  // a tree node holds a value, three pointers and a color
+  return sizeof(std::set<TYPE>) + set.size() * (sizeof(TYPE) + 4 * sizeof(void *));
+}
+
+template <typename TYPE>
+size_t storedValueMemoryUsage(const std::vector<TYPE> &vect) {
+  size_t bytes = sizeof(std::vector<TYPE>) + (vect.capacity() - vect.size()) * sizeof(TYPE);
+
+  for (const auto &val : vect) {
+    bytes += storedValueMemoryUsage(val);
+  }
+
+  return bytes;
+}
+}
+
 //===================================================================
 // we implement 2 templates with IteratorValue as parent class
 // for the two kinds of storage used in a MutableContainer
@@ -28,34 +77,38 @@ template <typename TYPE, typename INDEX_TYPE>
 class IteratorVect : public tlp::IteratorValue<INDEX_TYPE> {
 public:
   IteratorVect(const TYPE &value, bool equal,
-               std::deque<typename tlp::StoredType<TYPE>::Value> *vData, uint minIndex)
-      : _value(value), _equal(equal), _pos(minIndex), vData(vData), it(vData->begin()) {
-    while (it != (*vData).end() && tlp::StoredType<TYPE>::equal((*it), _value) != _equal) {
-      ++it;
+               tlp::ChunkedVector<typename tlp::StoredType<TYPE>::Value> *vData, uint minIndex)
+      : _value(value), _equal(equal), _pos(minIndex), vData(vData), _idx(0) {
+    while (_idx < vData->size() &&
+           tlp::StoredType<TYPE>::equal(vData->get(_idx), _value) != _equal) {
+      ++_idx;
       ++_pos;
     }
   }
   bool hasNext() override {
-    return (_pos < UINT_MAX && it != (*vData).end());
+    return (_pos < UINT_MAX && _idx < vData->size());
   }
   INDEX_TYPE next() override {
     INDEX_TYPE tmp = _pos;
 
     do {
-      ++it;
+      ++_idx;
       ++_pos;
-    } while (it != (*vData).end() && tlp::StoredType<TYPE>::equal((*it), _value) != _equal);
+    } while (_idx < vData->size() &&
+             tlp::StoredType<TYPE>::equal(vData->get(_idx), _value) != _equal);
 
     return tmp;
   }
   INDEX_TYPE nextValue(tlp::DataMem &val) override {
-    static_cast<tlp::TypedValueContainer<TYPE> &>(val).value = tlp::StoredType<TYPE>::get(*it);
+    static_cast<tlp::TypedValueContainer<TYPE> &>(val).value =
+        tlp::StoredType<TYPE>::get(vData->get(_idx));
     INDEX_TYPE pos = _pos;
 
     do {
-      ++it;
+      ++_idx;
       ++_pos;
-    } while (it != (*vData).end() && tlp::StoredType<TYPE>::equal((*it), _value) != _equal);
+    } while (_idx < vData->size() &&
+             tlp::StoredType<TYPE>::equal(vData->get(_idx), _value) != _equal);
 
     return pos;
   }
@@ -64,8 +117,8 @@ private:
   const TYPE _value;
   bool _equal;
   INDEX_TYPE _pos;
-  std::deque<typename tlp::StoredType<TYPE>::Value> *vData;
-  typename std::deque<typename tlp::StoredType<TYPE>::Value>::const_iterator it;
+  tlp::ChunkedVector<typename tlp::StoredType<TYPE>::Value> *vData;
+  size_t _idx;
 };
 
 // one for hash storage
@@ -116,12 +169,13 @@ private:
 //===================================================================
 template <typename TYPE, typename INDEX_TYPE>
 tlp::MutableContainer<TYPE, INDEX_TYPE>::MutableContainer()
-    : vData(new std::deque<typename StoredType<TYPE>::Value>()), hData(nullptr), minIndex(UINT_MAX),
+    : vData(new ChunkedVector<typename StoredType<TYPE>::Value>()), hData(nullptr), minIndex(UINT_MAX),
       maxIndex(UINT_MAX), defaultValue(StoredType<TYPE>::defaultValue()), state(VECT),
       elementInserted(0),
-      ratio(double(sizeof(typename tlp::StoredType<TYPE>::Value)) /
-            (3.0 * double(sizeof(void *)) + double(sizeof(typename tlp::StoredType<TYPE>::Value)))),
-      compressing(false) {}
+      ratio(ChunkedVector<typename tlp::StoredType<TYPE>::Value>::valueSize /
+            (3.0 * double(sizeof(void *)) +
+             ChunkedVector<typename tlp::StoredType<TYPE>::Value>::valueSize)),
+      compressing(false), internedValues(false) {}
 //===================================================================
 template <typename TYPE, typename INDEX_TYPE>
 tlp::MutableContainer<TYPE, INDEX_TYPE>::~MutableContainer<TYPE, INDEX_TYPE>() {
@@ -130,14 +184,12 @@ tlp::MutableContainer<TYPE, INDEX_TYPE>::~MutableContainer<TYPE, INDEX_TYPE>() {
 
     if (StoredType<TYPE>::isPointer) {
       // delete stored values
-      auto it = vData->begin();
+      for (size_t k = 0; k < vData->size(); ++k) {
+        typename StoredType<TYPE>::Value val = vData->get(k);
 
-      while (it != vData->end()) {
-        if ((*it) != defaultValue) {
-          StoredType<TYPE>::destroy(*it);
+        if (val != defaultValue) {
+          destroyValue(val);
         }
-
-        ++it;
       }
     }
 
@@ -152,7 +204,7 @@ tlp::MutableContainer<TYPE, INDEX_TYPE>::~MutableContainer<TYPE, INDEX_TYPE>() {
       auto it = hData->begin();
 
       while (it != hData->end()) {
-        StoredType<TYPE>::destroy(it->second);
+        destroyValue(it->second);
         ++it;
       }
     }
@@ -167,14 +219,86 @@ tlp::MutableContainer<TYPE, INDEX_TYPE>::~MutableContainer<TYPE, INDEX_TYPE>() {
     break;
   }
 
-  StoredType<TYPE>::destroy(defaultValue);
+  StoredType<TYPE>::destroyDefault(defaultValue);
+}
+//===================================================================
+template <typename TYPE, typename INDEX_TYPE>
+typename tlp::StoredType<TYPE>::Value tlp::MutableContainer<TYPE, INDEX_TYPE>::cloneValue(
+    typename StoredType<TYPE>::ConstReference value) const {
+  if constexpr (std::is_same<TYPE, std::string>::value) {
+    if (internedValues) {
+      return const_cast<std::string *>(StringPool::intern(value));
+    }
+  }
+
+  return StoredType<TYPE>::clone(value);
+}
+//===================================================================
+template <typename TYPE, typename INDEX_TYPE>
+void tlp::MutableContainer<TYPE, INDEX_TYPE>::destroyValue(
+    typename StoredType<TYPE>::Value value) const {
+  if constexpr (std::is_same<TYPE, std::string>::value) {
+    if (internedValues) {
+      StringPool::release(value);
+      return;
+    }
+  }
+
+  StoredType<TYPE>::destroy(value);
+}
+//===================================================================
+template <typename TYPE, typename INDEX_TYPE>
+void tlp::MutableContainer<TYPE, INDEX_TYPE>::setInternedValues(bool interned) {
+  if constexpr (std::is_same<TYPE, std::string>::value) {
+    if (interned == internedValues) {
+      return;
+    }
+
+    // the stored values are replaced by copies in the new mode
+    auto convert = [this, interned](typename StoredType<TYPE>::Value val) {
+      typename StoredType<TYPE>::Value newVal =
+          interned ? const_cast<std::string *>(StringPool::intern(*val)) : new std::string(*val);
+      destroyValue(val);
+      return newVal;
+    };
+
+    switch (state) {
+    case VECT:
+      for (size_t k = 0; k < vData->size(); ++k) {
+        typename StoredType<TYPE>::Value val = vData->get(k);
+
+        if (val != defaultValue) {
+          vData->set(k, convert(val));
+        }
+      }
+
+      break;
+
+    case HASH:
+      for (auto &it : *hData) {
+        it.second = convert(it.second);
+      }
+
+      break;
+
+    default:
+      assert(false);
+      tlp::error() << __PRETTY_FUNCTION__ << "unexpected state value (serious bug)" << std::endl;
+      break;
+    }
+
+    internedValues = interned;
+  } else {
+    // only the strings can be interned
+    assert(!interned);
+  }
 }
 //===================================================================
 template <typename TYPE, typename INDEX_TYPE>
 void tlp::MutableContainer<TYPE, INDEX_TYPE>::setDefault(
     typename StoredType<TYPE>::ConstReference value) {
-  StoredType<TYPE>::destroy(defaultValue);
-  defaultValue = StoredType<TYPE>::clone(value);
+  StoredType<TYPE>::destroyDefault(defaultValue);
+  defaultValue = StoredType<TYPE>::cloneDefault(value);
 }
 //===================================================================
 template <typename TYPE, typename INDEX_TYPE>
@@ -185,14 +309,12 @@ void tlp::MutableContainer<TYPE, INDEX_TYPE>::setAll(
 
     if (StoredType<TYPE>::isPointer) {
       // delete stored values
-      auto it = vData->begin();
+      for (size_t k = 0; k < vData->size(); ++k) {
+        typename StoredType<TYPE>::Value val = vData->get(k);
 
-      while (it != vData->end()) {
-        if ((*it) != defaultValue) {
-          StoredType<TYPE>::destroy(*it);
+        if (val != defaultValue) {
+          destroyValue(val);
         }
-
-        ++it;
       }
     }
 
@@ -204,13 +326,13 @@ void tlp::MutableContainer<TYPE, INDEX_TYPE>::setAll(
     if (StoredType<TYPE>::isPointer) {
       // delete stored values
       for (const auto &[id, type] : *hData) {
-        StoredType<TYPE>::destroy(type);
+        destroyValue(type);
       }
     }
 
     delete hData;
     hData = nullptr;
-    vData = new std::deque<typename StoredType<TYPE>::Value>();
+    vData = new ChunkedVector<typename StoredType<TYPE>::Value>();
     break;
 
   default:
@@ -219,8 +341,8 @@ void tlp::MutableContainer<TYPE, INDEX_TYPE>::setAll(
     break;
   }
 
-  StoredType<TYPE>::destroy(defaultValue);
-  defaultValue = StoredType<TYPE>::clone(value);
+  StoredType<TYPE>::destroyDefault(defaultValue);
+  defaultValue = StoredType<TYPE>::cloneDefault(value);
   state = VECT;
   maxIndex = UINT_MAX;
   minIndex = UINT_MAX;
@@ -292,11 +414,11 @@ void tlp::MutableContainer<TYPE, INDEX_TYPE>::vectset(const INDEX_TYPE i,
       --minIndex;
     }
 
-    typename StoredType<TYPE>::Value val = (*vData)[i - minIndex];
-    (*vData)[i - minIndex] = value;
+    typename StoredType<TYPE>::Value val = vData->get(i - minIndex);
+    vData->set(i - minIndex, value);
 
     if (val != defaultValue) {
-      StoredType<TYPE>::destroy(val);
+      destroyValue(val);
     } else {
       ++elementInserted;
     }
@@ -320,11 +442,11 @@ void tlp::MutableContainer<TYPE, INDEX_TYPE>::set(const INDEX_TYPE i,
     case VECT:
 
       if (i <= maxIndex && i >= minIndex) {
-        typename StoredType<TYPE>::Value val = (*vData)[i - minIndex];
+        typename StoredType<TYPE>::Value val = vData->get(i - minIndex);
 
         if (val != defaultValue) {
-          (*vData)[i - minIndex] = defaultValue;
-          StoredType<TYPE>::destroy(val);
+          vData->set(i - minIndex, defaultValue);
+          destroyValue(val);
           --elementInserted;
         } else if (forceDefaultValueRemoval)
           --elementInserted;
@@ -336,7 +458,7 @@ void tlp::MutableContainer<TYPE, INDEX_TYPE>::set(const INDEX_TYPE i,
       auto it = hData->find(i);
 
       if (it != hData->end()) {
-        StoredType<TYPE>::destroy(it->second);
+        destroyValue(it->second);
         hData->erase(it);
         --elementInserted;
       }
@@ -350,7 +472,7 @@ void tlp::MutableContainer<TYPE, INDEX_TYPE>::set(const INDEX_TYPE i,
       break;
     }
   } else {
-    typename StoredType<TYPE>::Value newVal = StoredType<TYPE>::clone(value);
+    typename StoredType<TYPE>::Value newVal = cloneValue(value);
 
     switch (state) {
     case VECT:
@@ -363,7 +485,7 @@ void tlp::MutableContainer<TYPE, INDEX_TYPE>::set(const INDEX_TYPE i,
       auto it = hData->find(i);
 
       if (it != hData->end()) {
-        StoredType<TYPE>::destroy(it->second);
+        destroyValue(it->second);
         it->second = newVal;
       } else {
         ++elementInserted;
@@ -402,14 +524,14 @@ void tlp::MutableContainer<TYPE, INDEX_TYPE>::add(const INDEX_TYPE i, TYPE val)
         return;
       }
 
-      TYPE &oldVal = (*vData)[i - minIndex];
+      TYPE oldVal = vData->get(i - minIndex);
 
       if (oldVal == defaultValue) {
         set(i, defaultValue + val);
         return;
       }
 
-      oldVal += val;
+      vData->set(i - minIndex, oldVal + val);
 
       return;
     }
@@ -420,7 +542,7 @@ void tlp::MutableContainer<TYPE, INDEX_TYPE>::add(const INDEX_TYPE i, TYPE val)
       if (it != hData->end()) {
         // check default value
         if ((it->second + val) == defaultValue) {
-          StoredType<TYPE>::destroy(it->second);
+          destroyValue(it->second);
           hData->erase(it);
           --elementInserted;
         } else {
@@ -459,7 +581,7 @@ tlp::MutableContainer<TYPE, INDEX_TYPE>::get(const INDEX_TYPE i) const {
     if (i > maxIndex || i < minIndex) {
       return StoredType<TYPE>::get(defaultValue);
     } else {
-      return StoredType<TYPE>::get((*vData)[i - minIndex]);
+      return StoredType<TYPE>::get(vData->get(i - minIndex));
     }
 
   case HASH: {
@@ -487,14 +609,14 @@ void tlp::MutableContainer<TYPE, INDEX_TYPE>::invertBooleanValue(const INDEX_TYP
       if (i > maxIndex || i < minIndex) {
         vectset(i, !defaultValue);
       } else {
-        typename StoredType<TYPE>::Value val = (*vData)[i - minIndex];
+        typename StoredType<TYPE>::Value val = vData->get(i - minIndex);
 
         if (val != defaultValue) {
           --elementInserted;
         } else {
           ++elementInserted;
         }
-        (*vData)[i - minIndex] = !val;
+        vData->set(i - minIndex, !val);
       }
       return;
     }
@@ -539,7 +661,7 @@ bool tlp::MutableContainer<TYPE, INDEX_TYPE>::hasNonDefaultValue(const INDEX_TYP
 
   switch (state) {
   case VECT:
-    return (i <= maxIndex && i >= minIndex && (((*vData)[i - minIndex]) != defaultValue));
+    return (i <= maxIndex && i >= minIndex && ((vData->get(i - minIndex)) != defaultValue));
 
   case HASH:
     return ((hData->find(i)) != hData->end());
@@ -566,7 +688,7 @@ tlp::MutableContainer<TYPE, INDEX_TYPE>::get(const INDEX_TYPE i, bool &notDefaul
       notDefault = false;
       return StoredType<TYPE>::get(defaultValue);
     } else {
-      typename StoredType<TYPE>::Value val = (*vData)[i - minIndex];
+      typename StoredType<TYPE>::Value val = vData->get(i - minIndex);
       notDefault = val != defaultValue;
       return StoredType<TYPE>::get(val);
     }
@@ -605,8 +727,10 @@ void tlp::MutableContainer<TYPE, INDEX_TYPE>::vecttohash() {
   elementInserted = 0;
 
   for (INDEX_TYPE i = minIndex; i <= maxIndex; ++i) {
-    if ((*vData)[i - minIndex] != defaultValue) {
-      (*hData)[i] = (*vData)[i - minIndex];
+    typename StoredType<TYPE>::Value val = vData->get(i - minIndex);
+
+    if (val != defaultValue) {
+      (*hData)[i] = val;
       newMaxIndex = std::max(newMaxIndex, i);
       newMinIndex = std::min(newMinIndex, i);
       ++elementInserted;
@@ -622,7 +746,7 @@ void tlp::MutableContainer<TYPE, INDEX_TYPE>::vecttohash() {
 //===================================================================
 template <typename TYPE, typename INDEX_TYPE>
 void tlp::MutableContainer<TYPE, INDEX_TYPE>::hashtovect() {
-  vData = new std::deque<typename StoredType<TYPE>::Value>();
+  vData = new ChunkedVector<typename StoredType<TYPE>::Value>();
   minIndex = UINT_MAX;
   maxIndex = UINT_MAX;
   elementInserted = 0;
@@ -676,3 +800,57 @@ typename tlp::StoredType<TYPE>::ConstReference
 tlp::MutableContainer<TYPE, INDEX_TYPE>::operator[](const INDEX_TYPE i) const {
   return get(i);
 }
+//===================================================================
+template <typename TYPE, typename INDEX_TYPE>
+size_t tlp::MutableContainer<TYPE, INDEX_TYPE>::memoryUsage() const {
+  constexpr bool pointerValues = static_cast<bool>(StoredType<TYPE>::isPointer);
+  size_t bytes = 0;
+
+  switch (state) {
+  case VECT:
+    bytes = vData->memoryUsage();
+
+    // the interned strings are shared, their memory is accounted by the StringPool
+    if constexpr (pointerValues) {
+      if (!internedValues) {
+        for (size_t k = 0; k < vData->size(); ++k) {
+          typename StoredType<TYPE>::Value val = vData->get(k);
+
+          if (val != defaultValue) {
+            bytes += storedValueMemoryUsage(*val);
+          }
+        }
+      }
+    }
+
+    break;
+
+  case HASH:
+    // a slot and a control byte for each bucket
+    bytes = hData->capacity() *
+            (sizeof(typename phmap::flat_hash_map<INDEX_TYPE,
+                                                  typename StoredType<TYPE>::Value>::value_type) +
+             1);
+
+    if constexpr (pointerValues) {
+      if (!internedValues) {
+        for (const auto &[id, val] : *hData) {
+          bytes += storedValueMemoryUsage(*val);
+        }
+      }
+    }
+
+    break;
+
+  default:
+    assert(false);
+    tlp::error() << __PRETTY_FUNCTION__ << "unexpected state value (serious bug)" << std::endl;
+    break;
+  }
+
+  if constexpr (pointerValues) {
+    bytes += storedValueMemoryUsage(*defaultValue);
+  }
+
+  return bytes;
+}
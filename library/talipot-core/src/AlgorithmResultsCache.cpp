@@ -0,0 +1,478 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <list>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <talipot/AlgorithmResultsCache.h>
+#include <talipot/DataSet.h>
+#include <talipot/Graph.h>
+#include <talipot/ParallelTools.h>
+#include <talipot/PluginsManager.h>
+#include <talipot/PropertyInterface.h>
+
+using namespace std;
+using namespace tlp;
+
+TLP_DEFINE_GLOBAL_LOCK(AlgorithmResultsCacheLock);
+
+namespace {
+
+struct CachedResult {
+  // values of the result property for the elements of the graph
+  shared_ptr<PropertyInterface> values;
+  // values of the out parameters
+  shared_ptr<DataSet> outParameters;
+  // the graph and the property parameters the result depends on
+  vector<const Observable *> dependencies;
+  // position in the least recently used list
+  list<string>::iterator lruPos;
+};
+
+// The cache listens to the graphs and properties involved in the cached calls
+// to maintain their modification counters
+class ResultsCacheListener : public Observable {
+public:
+  void treatEvent(const Event &) override;
+
+  // returns the modification counter of obj and starts to observe it if needed
+  uint version(const Observable *obj);
+  // discards the results depending on obj
+  void invalidate(const Observable *obj);
+  void eraseResult(unordered_map<string, CachedResult>::iterator it);
+  void evictResults();
+  void clear();
+
+  bool enabled = false;
+  uint maxResults = 64;
+  // the parameters of each algorithm making it read the initial values of its result
+  unordered_map<string, unordered_set<string>> resultInputParameters;
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+
+  unordered_map<const Observable *, uint> versions;
+  unordered_map<const Observable *, unordered_set<string>> dependents;
+  unordered_map<string, CachedResult> results;
+  // the keys of the cached results, most recently used first
+  list<string> lru;
+};
+
+uint ResultsCacheListener::version(const Observable *obj) {
+  auto it = versions.find(obj);
+
+  if (it == versions.end()) {
+    obj->addListener(this);
+    it = versions.emplace(obj, 0).first;
+  }
+
+  return it->second;
+}
+
+void ResultsCacheListener::invalidate(const Observable *obj) {
+  auto it = dependents.find(obj);
+
+  if (it != dependents.end()) {
+    // copy the keys as eraseResult updates the dependents
+    vector<string> keys(it->second.begin(), it->second.end());
+
+    for (const auto &key : keys) {
+      if (auto itr = results.find(key); itr != results.end()) {
+        eraseResult(itr);
+      }
+    }
+
+    dependents.erase(obj);
+  }
+}
+
+void ResultsCacheListener::eraseResult(unordered_map<string, CachedResult>::iterator it) {
+  for (auto obj : it->second.dependencies) {
+    if (auto itd = dependents.find(obj); itd != dependents.end()) {
+      itd->second.erase(it->first);
+    }
+  }
+
+  lru.erase(it->second.lruPos);
+  results.erase(it);
+}
+
+void ResultsCacheListener::evictResults() {
+  while (results.size() > maxResults) {
+    eraseResult(results.find(lru.back()));
+  }
+}
+
+void ResultsCacheListener::clear() {
+  for (const auto &[obj, version] : versions) {
+    obj->removeListener(this);
+  }
+
+  versions.clear();
+  dependents.clear();
+  results.clear();
+  lru.clear();
+}
+
+void ResultsCacheListener::treatEvent(const Event &evt) {
+  bool modified = false;
+
+  if (evt.type() == Event::TLP_DELETE) {
+    modified = true;
+  } else if (const auto *gEvt = dynamic_cast<const GraphEvent *>(&evt)) {
+    switch (gEvt->getType()) {
+    case GraphEvent::TLP_ADD_NODE:
+    case GraphEvent::TLP_DEL_NODE:
+    case GraphEvent::TLP_ADD_EDGE:
+    case GraphEvent::TLP_DEL_EDGE:
+    case GraphEvent::TLP_REVERSE_EDGE:
+    case GraphEvent::TLP_AFTER_SET_ENDS:
+    case GraphEvent::TLP_ADD_NODES:
+    case GraphEvent::TLP_ADD_EDGES:
+      modified = true;
+      break;
+
+    default:
+      // we don't care about other events
+      break;
+    }
+  } else if (const auto *pEvt = dynamic_cast<const PropertyEvent *>(&evt)) {
+    switch (pEvt->getType()) {
+    case PropertyEvent::TLP_AFTER_SET_NODE_VALUE:
+    case PropertyEvent::TLP_AFTER_SET_ALL_NODE_VALUE:
+    case PropertyEvent::TLP_AFTER_SET_EDGE_VALUE:
+    case PropertyEvent::TLP_AFTER_SET_ALL_EDGE_VALUE:
+    case PropertyEvent::TLP_AFTER_SET_NODES_VALUES:
+    case PropertyEvent::TLP_AFTER_SET_EDGES_VALUES:
+      modified = true;
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  if (!modified) {
+    return;
+  }
+
+  const Observable *obj = evt.sender();
+
+  TLP_GLOBALLY_LOCK_SECTION(AlgorithmResultsCacheLock) {
+    invalidate(obj);
+
+    if (evt.type() == Event::TLP_DELETE) {
+      versions.erase(obj);
+    } else if (auto it = versions.find(obj); it != versions.end()) {
+      ++it->second;
+    }
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(AlgorithmResultsCacheLock);
+}
+
+// the cache may be used while registering the plugins,
+// so it is created on first use
+ResultsCacheListener &getCache() {
+  static ResultsCacheListener cache;
+  return cache;
+}
+}
+
+void AlgorithmResultsCache::setEnabled(bool enabled) {
+  ResultsCacheListener &cache = getCache();
+
+  TLP_GLOBALLY_LOCK_SECTION(AlgorithmResultsCacheLock) {
+    cache.enabled = enabled;
+
+    if (!enabled) {
+      cache.clear();
+    }
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(AlgorithmResultsCacheLock);
+}
+
+bool AlgorithmResultsCache::isEnabled() {
+  return getCache().enabled;
+}
+
+void AlgorithmResultsCache::setMaximumNumberOfResults(uint maxResults) {
+  ResultsCacheListener &cache = getCache();
+
+  TLP_GLOBALLY_LOCK_SECTION(AlgorithmResultsCacheLock) {
+    cache.maxResults = maxResults;
+    cache.evictResults();
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(AlgorithmResultsCacheLock);
+}
+
+uint AlgorithmResultsCache::maximumNumberOfResults() {
+  return getCache().maxResults;
+}
+
+uint AlgorithmResultsCache::numberOfResults() {
+  uint nbResults = 0;
+  TLP_GLOBALLY_LOCK_SECTION(AlgorithmResultsCacheLock) {
+    nbResults = getCache().results.size();
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(AlgorithmResultsCacheLock);
+  return nbResults;
+}
+
+void AlgorithmResultsCache::clear() {
+  TLP_GLOBALLY_LOCK_SECTION(AlgorithmResultsCacheLock) {
+    getCache().clear();
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(AlgorithmResultsCacheLock);
+}
+
+uint64_t AlgorithmResultsCache::numberOfHits() {
+  return getCache().hits;
+}
+
+uint64_t AlgorithmResultsCache::numberOfMisses() {
+  return getCache().misses;
+}
+
+void AlgorithmResultsCache::resetStatistics() {
+  ResultsCacheListener &cache = getCache();
+
+  TLP_GLOBALLY_LOCK_SECTION(AlgorithmResultsCacheLock) {
+    cache.hits = cache.misses = 0;
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(AlgorithmResultsCacheLock);
+}
+
+void AlgorithmResultsCache::addResultInputParameter(const string &algorithm,
+                                                    const string &parameter) {
+  TLP_GLOBALLY_LOCK_SECTION(AlgorithmResultsCacheLock) {
+    getCache().resultInputParameters[algorithm].insert(parameter);
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(AlgorithmResultsCacheLock);
+}
+
+// Serializes in values the input parameters of a call and in state the modification counters
+// of the graph and of the property parameters the call depends on, which are added
+// to dependencies. Returns false if the call cannot be cached.
+// It must be called in the locked section.
+static bool serializeCall(const Graph *graph, const string &algorithm, const DataSet *parameters,
+                          string &values, string &state,
+                          vector<const Observable *> &dependencies) {
+  ResultsCacheListener &cache = getCache();
+
+  if (!PluginsManager::pluginExists(algorithm)) {
+    return false;
+  }
+
+  auto itInputs = cache.resultInputParameters.find(algorithm);
+  stringstream valuesStream;
+  stringstream stateStream;
+  stateStream << static_cast<const void *>(graph) << ':' << cache.version(graph);
+  dependencies.push_back(graph);
+
+  // only the declared input parameters are part of the key
+  for (const auto &param : PluginsManager::getPluginParameters(algorithm).getParameters()) {
+    const string &name = param.getName();
+
+    // the result property is not an input of the algorithm
+    if (name == "result") {
+      continue;
+    }
+
+    bool isProperty = DataType::isTalipotProperty(param.getTypeName());
+
+    // the values of the out properties are not cached
+    if (isProperty && param.getDirection() != IN_PARAM) {
+      return false;
+    }
+
+    if (param.getDirection() == OUT_PARAM) {
+      continue;
+    }
+
+    unique_ptr<DataType> value(parameters ? parameters->getData(name) : nullptr);
+
+    if (!value) {
+      valuesStream << " '" << name << "'";
+    } else if (isProperty) {
+      PropertyInterface *prop = value->getProperty();
+
+      if (prop) {
+        // the algorithm reads the initial values of its result
+        if (itInputs != cache.resultInputParameters.end() && itInputs->second.count(name)) {
+          return false;
+        }
+
+        stateStream << " '" << name << "'=" << static_cast<const void *>(prop) << ':'
+                    << cache.version(prop);
+        dependencies.push_back(prop);
+      } else {
+        valuesStream << " '" << name << "'=None";
+      }
+    } else if (DataTypeSerializer *serializer =
+                   DataSet::typenameToSerializer(value->getTypeName())) {
+      valuesStream << " '" << name << "'=" << serializer->toString(value.get());
+    } else {
+      return false;
+    }
+  }
+
+  values = valuesStream.str();
+  state = stateStream.str();
+  return true;
+}
+
+bool AlgorithmResultsCache::computeKey(const Graph *graph, const string &algorithm,
+                                       const DataSet *parameters, string &key) {
+  if (!getCache().enabled) {
+    return false;
+  }
+
+  bool cacheable = false;
+  string values, state;
+  vector<const Observable *> dependencies;
+
+  TLP_GLOBALLY_LOCK_SECTION(AlgorithmResultsCacheLock) {
+    cacheable = serializeCall(graph, algorithm, parameters, values, state, dependencies);
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(AlgorithmResultsCacheLock);
+
+  // the modification counters end the key
+  key = algorithm + '\n' + values + '\n' + state;
+  return cacheable;
+}
+
+bool AlgorithmResultsCache::restoreResult(const string &key, const Graph *graph,
+                                          PropertyInterface *result, DataSet *parameters) {
+  ResultsCacheListener &cache = getCache();
+
+  shared_ptr<PropertyInterface> values;
+  shared_ptr<DataSet> outParameters;
+
+  TLP_GLOBALLY_LOCK_SECTION(AlgorithmResultsCacheLock) {
+    auto it = cache.results.find(key);
+
+    if (it != cache.results.end() &&
+        it->second.values->getTypename() == result->getTypename()) {
+      values = it->second.values;
+      outParameters = it->second.outParameters;
+      // move the result at the front of the least recently used list
+      cache.lru.splice(cache.lru.begin(), cache.lru, it->second.lruPos);
+      ++cache.hits;
+    } else {
+      ++cache.misses;
+    }
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(AlgorithmResultsCacheLock);
+
+  if (!values) {
+    return false;
+  }
+
+  // the copy may trigger the invalidation of other results
+  // so it must be done outside the locked section
+  result->copy(graph->nodes(), values.get());
+  result->copy(graph->edges(), values.get());
+
+  if (parameters) {
+    for (const auto &[name, value] : outParameters->getValues()) {
+      parameters->setData(name, value);
+    }
+  }
+
+  return true;
+}
+
+void AlgorithmResultsCache::storeResult(const string &key, const Graph *graph,
+                                        const string &algorithm, const DataSet *parameters,
+                                        PropertyInterface *result) {
+  ResultsCacheListener &cache = getCache();
+
+  if (!cache.enabled) {
+    return;
+  }
+
+  // check that neither the graph nor the property parameters
+  // have been modified while running the algorithm,
+  // the values of the in/out parameters may have been
+  bool valid = false;
+  string values, state;
+  vector<const Observable *> dependencies;
+
+  TLP_GLOBALLY_LOCK_SECTION(AlgorithmResultsCacheLock) {
+    valid = serializeCall(graph, algorithm, parameters, values, state, dependencies) &&
+            key.substr(key.rfind('\n') + 1) == state;
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(AlgorithmResultsCacheLock);
+
+  if (!valid) {
+    return;
+  }
+
+  shared_ptr<PropertyInterface> resultValues(
+      result->clonePrototype(const_cast<Graph *>(graph), ""));
+
+  for (auto n : graph->nodes()) {
+    resultValues->copy(n, n, result);
+  }
+
+  for (auto e : graph->edges()) {
+    resultValues->copy(e, e, result);
+  }
+
+  auto outParameters = make_shared<DataSet>();
+
+  if (parameters) {
+    for (const auto &param : PluginsManager::getPluginParameters(algorithm).getParameters()) {
+      if (param.getDirection() != IN_PARAM && param.getName() != "result" &&
+          parameters->exists(param.getName())) {
+        unique_ptr<DataType> value(parameters->getData(param.getName()));
+        outParameters->setData(param.getName(), value.get());
+      }
+    }
+  }
+
+  TLP_GLOBALLY_LOCK_SECTION(AlgorithmResultsCacheLock) {
+    if (auto it = cache.results.find(key); it != cache.results.end()) {
+      cache.eraseResult(it);
+    }
+
+    // the key may have been invalidated in the meantime
+    valid = true;
+
+    for (auto obj : dependencies) {
+      if (cache.versions.find(obj) == cache.versions.end()) {
+        valid = false;
+        break;
+      }
+    }
+
+    if (valid) {
+      cache.lru.push_front(key);
+      CachedResult &cachedResult = cache.results[key];
+      cachedResult.values = resultValues;
+      cachedResult.outParameters = outParameters;
+      cachedResult.dependencies = dependencies;
+      cachedResult.lruPos = cache.lru.begin();
+
+      for (auto obj : dependencies) {
+        cache.dependents[obj].insert(key);
+      }
+
+      cache.evictResults();
+    }
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(AlgorithmResultsCacheLock);
+}
@@ -14,8 +14,8 @@
 #include <stack>
 
 #include <talipot/BiconnectedTest.h>
+#include <talipot/Graph.h>
 #include <talipot/ConnectedTest.h>
-#include <talipot/ConnectedTestListener.h>
 #include <talipot/MutableContainer.h>
 #include <talipot/StableIterator.h>
 
@@ -23,7 +23,68 @@ using namespace std;
 using namespace tlp;
 
 //=================================================================
-static ConnectedTestListener instance;
+class BiconnectedTestListener : public Observable {
+public:
+  // override of Observable::treatEvent to remove the cached result for a graph if it is modified.
+  void treatEvent(const Event &) override;
+
+  /**
+   * @brief Stored results for graphs. When a graph is updated, its entry is removed from the map.
+   **/
+  std::unordered_map<const Graph *, bool> resultsBuffer;
+};
+
+void BiconnectedTestListener::treatEvent(const Event &evt) {
+  const auto *gEvt = dynamic_cast<const GraphEvent *>(&evt);
+
+  if (gEvt) {
+    Graph *graph = gEvt->getGraph();
+
+    switch (gEvt->getType()) {
+    case GraphEvent::TLP_ADD_NODE:
+      resultsBuffer[graph] = false;
+      break;
+
+    case GraphEvent::TLP_DEL_NODE:
+      graph->removeListener(this);
+      resultsBuffer.erase(graph);
+      break;
+
+    case GraphEvent::TLP_ADD_EDGE:
+
+      if (resultsBuffer.find(graph) != resultsBuffer.end() && resultsBuffer[graph]) {
+        return;
+      }
+
+      graph->removeListener(this);
+      resultsBuffer.erase(graph);
+      break;
+
+    case GraphEvent::TLP_DEL_EDGE:
+
+      if (resultsBuffer.find(graph) != resultsBuffer.end() && !resultsBuffer[graph]) {
+        return;
+      }
+
+      graph->removeListener(this);
+      resultsBuffer.erase(graph);
+      break;
+
+    default:
+      // we don't care about other events
+      break;
+    }
+  } else {
+
+    auto *graph = static_cast<Graph *>(evt.sender());
+
+    if (evt.type() == Event::TLP_DELETE) {
+      resultsBuffer.erase(graph);
+    }
+  }
+}
+//=================================================================
+static BiconnectedTestListener instance;
 //=================================================================
 // structure below is used to implement dfs loop
 struct dfsBiconnectStruct {
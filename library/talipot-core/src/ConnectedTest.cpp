@@ -11,70 +11,27 @@
  *
  */
 
+#include <climits>
+
 #include <talipot/ConnectedTest.h>
 #include <talipot/ConnectedTestListener.h>
-#include <talipot/VectorProperty.h>
 
 using namespace std;
 using namespace tlp;
 //=================================================================
 static ConnectedTestListener instance;
 //=================================================================
-static uint connectedTest(const Graph *const graph, node n, NodeVectorProperty<bool> &visited) {
-  list<node> nodesToVisit;
-  visited[n] = true;
-  nodesToVisit.push_front(n);
-  uint count = 1;
-
-  while (!nodesToVisit.empty()) {
-    node r = nodesToVisit.front();
-    nodesToVisit.pop_front();
-    // loop on all neighbours
-    for (auto neighbour : graph->getInOutNodes(r)) {
-      uint neighPos = graph->nodePos(neighbour);
-      // check if neighbour has been visited
-      if (!visited[neighPos]) {
-        // mark neighbour as already visited
-        visited[neighPos] = true;
-        // push it for further deeper exploration
-        nodesToVisit.push_back(neighbour);
-        ++count;
-      }
-    }
-  }
-
-  return count;
-}
-//=================================================================
 bool ConnectedTest::isConnected(const tlp::Graph *const graph) {
-  if (instance.resultsBuffer.find(graph) != instance.resultsBuffer.end()) {
-    return instance.resultsBuffer[graph];
-  }
-
-  if (graph->isEmpty()) {
-    return true;
-  }
-
-  // graph can not be connected with that configuration
-  if (graph->numberOfEdges() < graph->numberOfNodes() - 1) {
-    return false;
-  }
-
-  NodeVectorProperty<bool> visited(graph);
-  visited.setAll(false);
-  uint count = connectedTest(graph, graph->getOneNode(), visited);
-  bool result = (count == graph->numberOfNodes());
-  graph->addListener(instance);
-  return instance.resultsBuffer[graph] = result;
+  return numberOfConnectedComponents(graph) <= 1u;
 }
 //=================================================================
 vector<edge> ConnectedTest::makeConnected(Graph *graph) {
   vector<edge> addedEdges;
-  graph->removeListener(instance);
-  instance.resultsBuffer.erase(graph);
   vector<node> toLink;
   connect(graph, toLink);
 
+  // the cached components are updated when receiving
+  // the edges addition events
   for (uint i = 1; i < toLink.size(); ++i) {
     addedEdges.push_back(graph->addEdge(toLink[i - 1], toLink[i]));
   }
@@ -84,86 +41,79 @@ vector<edge> ConnectedTest::makeConnected(Graph *graph) {
 }
 //=================================================================
 uint ConnectedTest::numberOfConnectedComponents(const tlp::Graph *const graph) {
-  if (graph->isEmpty()) {
-    return 0u;
+  uint result = 0;
+  TLP_GLOBALLY_LOCK_SECTION(ConnectedTestBuffer) {
+    result = instance.getComponents(graph).numberOfComponents();
   }
-
-  graph->removeListener(instance);
-  vector<node> toLink;
-  connect(graph, toLink);
-  uint result;
-
-  if (!toLink.empty()) {
-    result = toLink.size();
-  } else {
-    result = 1u;
+  TLP_GLOBALLY_UNLOCK_SECTION(ConnectedTestBuffer);
+  return result;
+}
+//=================================================================
+uint ConnectedTest::componentId(const tlp::Graph *const graph, const node n) {
+  uint result = 0;
+  TLP_GLOBALLY_LOCK_SECTION(ConnectedTestBuffer) {
+    result = instance.getComponents(graph).find(graph->nodePos(n));
   }
-
-  instance.resultsBuffer[graph] = (result == 1u);
-  graph->addListener(instance);
+  TLP_GLOBALLY_UNLOCK_SECTION(ConnectedTestBuffer);
+  return result;
+}
+//=================================================================
+bool ConnectedTest::areConnected(const tlp::Graph *const graph, const node n1, const node n2) {
+  bool result = false;
+  TLP_GLOBALLY_LOCK_SECTION(ConnectedTestBuffer) {
+    ConnectedComponentsUnionFind &components = instance.getComponents(graph);
+    result = components.find(graph->nodePos(n1)) == components.find(graph->nodePos(n2));
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(ConnectedTestBuffer);
   return result;
 }
 //======================================================================
 vector<vector<node>> ConnectedTest::computeConnectedComponents(const tlp::Graph *graph) {
   vector<vector<node>> components;
-  NodeVectorProperty<bool> visited(graph);
-  visited.setAll(false);
-  // do a bfs traversal for each node
-  TLP_MAP_NODES_AND_INDICES(graph, [&](node n, uint i) {
-    // check if curNode has been already visited
-    if (!visited[i]) {
-      // add a new component
-      components.push_back(std::vector<node>());
-      std::vector<node> &component = components.back();
-      // and initialize it with current node
-      component.push_back(n);
-      // do a bfs traversal this node
-      list<node> nodesToVisit;
-      visited[i] = true;
-      nodesToVisit.push_front(n);
-
-      while (!nodesToVisit.empty()) {
-        n = nodesToVisit.front();
-        nodesToVisit.pop_front();
-
-        // loop on all neighbours
-        for (auto neighbour : graph->getInOutNodes(n)) {
-          uint neighPos = graph->nodePos(neighbour);
-          // check if neighbour has been visited
-          if (!visited[neighPos]) {
-            // mark neighbour as already visited
-            visited[neighPos] = true;
-            // insert it in current component
-            component.push_back(neighbour);
-            // push it for further deeper exploration
-            nodesToVisit.push_back(neighbour);
-          }
-        }
+  // index of the component of each representative node
+  vector<uint> componentIdx(graph->numberOfNodes(), UINT_MAX);
+  const vector<node> &nodes = graph->nodes();
+
+  TLP_GLOBALLY_LOCK_SECTION(ConnectedTestBuffer) {
+    ConnectedComponentsUnionFind &ccs = instance.getComponents(graph);
+    components.reserve(ccs.numberOfComponents());
+
+    // components are ordered according to the position
+    // of their first node in the graph
+    for (uint i = 0; i < nodes.size(); ++i) {
+      uint root = ccs.find(i);
+
+      if (componentIdx[root] == UINT_MAX) {
+        componentIdx[root] = components.size();
+        components.emplace_back();
       }
+
+      components[componentIdx[root]].push_back(nodes[i]);
     }
-  });
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(ConnectedTestBuffer);
   return components;
 }
 //=================================================================
 void ConnectedTest::connect(const tlp::Graph *const graph, vector<node> &toLink) {
+  const vector<node> &nodes = graph->nodes();
 
-  if (const auto it = instance.resultsBuffer.find(graph); it != instance.resultsBuffer.end()) {
-    if (it->second) {
-      return;
-    }
-  }
+  TLP_GLOBALLY_LOCK_SECTION(ConnectedTestBuffer) {
+    ConnectedComponentsUnionFind &components = instance.getComponents(graph);
 
-  if (graph->isEmpty()) {
-    return;
-  }
+    if (components.numberOfComponents() > 1) {
+      // the first node of each component has to be linked
+      vector<bool> visited(nodes.size(), false);
 
-  NodeVectorProperty<bool> visited(graph);
-  visited.setAll(false);
+      for (uint i = 0; i < nodes.size(); ++i) {
+        uint root = components.find(i);
 
-  TLP_MAP_NODES_AND_INDICES(graph, [&](node n, uint i) {
-    if (!visited[i]) {
-      toLink.push_back(n);
-      connectedTest(graph, n, visited);
+        if (!visited[root]) {
+          visited[root] = true;
+          toLink.push_back(nodes[i]);
+        }
+      }
     }
-  });
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(ConnectedTestBuffer);
 }
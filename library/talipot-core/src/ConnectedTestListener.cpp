@@ -11,57 +11,166 @@
  *
  */
 
+#include <numeric>
+
 #include <talipot/ConnectedTestListener.h>
 
 using namespace std;
 using namespace tlp;
 
+namespace tlp {
+TLP_DEFINE_GLOBAL_LOCK(ConnectedTestBuffer);
+}
+
+void ConnectedComponentsUnionFind::init(const Graph *graph) {
+  uint nbNodes = graph->numberOfNodes();
+  parents.resize(nbNodes);
+  iota(parents.begin(), parents.end(), 0);
+  sizes.assign(nbNodes, 1);
+  nbComponents = nbNodes;
+
+  for (auto e : graph->edges()) {
+    addEdge(graph, e);
+  }
+
+  // the deleted element may not have been removed yet
+  upToDate = !(deletedNode.isValid() && graph->isElement(deletedNode)) &&
+             !(deletedEdge.isValid() && graph->isElement(deletedEdge));
+
+  if (upToDate) {
+    deletedNode = node();
+    deletedEdge = edge();
+  }
+}
+
+void ConnectedComponentsUnionFind::invalidate(node n, edge e) {
+  upToDate = false;
+  deletedNode = n;
+  deletedEdge = e;
+}
+
+void ConnectedComponentsUnionFind::addNodes(const Graph *graph) {
+  for (uint pos = parents.size(); pos < graph->numberOfNodes(); ++pos) {
+    parents.push_back(pos);
+    sizes.push_back(1);
+    ++nbComponents;
+  }
+}
+
+void ConnectedComponentsUnionFind::addEdge(const Graph *graph, edge e) {
+  // the edge may have already been deleted when the event is received,
+  // the structure will then be invalidated when receiving the deletion event
+  if (!graph->isElement(e)) {
+    return;
+  }
+
+  const auto &[src, tgt] = graph->ends(e);
+  unite(graph->nodePos(src), graph->nodePos(tgt));
+}
+
+uint ConnectedComponentsUnionFind::find(uint pos) {
+  // path halving
+  while (parents[pos] != pos) {
+    parents[pos] = parents[parents[pos]];
+    pos = parents[pos];
+  }
+  return pos;
+}
+
+void ConnectedComponentsUnionFind::unite(uint pos1, uint pos2) {
+  pos1 = find(pos1);
+  pos2 = find(pos2);
+
+  if (pos1 == pos2) {
+    return;
+  }
+
+  // union by size
+  if (sizes[pos1] < sizes[pos2]) {
+    swap(pos1, pos2);
+  }
+
+  parents[pos2] = pos1;
+  sizes[pos1] += sizes[pos2];
+  --nbComponents;
+}
+
+ConnectedComponentsUnionFind &ConnectedTestListener::getComponents(const Graph *graph) {
+  auto it = componentsBuffer.find(graph);
+
+  if (it == componentsBuffer.end()) {
+    it = componentsBuffer.emplace(graph, ConnectedComponentsUnionFind()).first;
+    it->second.init(graph);
+    graph->addListener(this);
+  } else if (!it->second.isUpToDate()) {
+    it->second.init(graph);
+  }
+
+  return it->second;
+}
+
 void ConnectedTestListener::treatEvent(const Event &evt) {
   const auto *gEvt = dynamic_cast<const GraphEvent *>(&evt);
 
   if (gEvt) {
     Graph *graph = gEvt->getGraph();
 
-    switch (gEvt->getType()) {
-    case GraphEvent::TLP_ADD_NODE:
-      resultsBuffer[graph] = false;
-      break;
+    TLP_GLOBALLY_LOCK_SECTION(ConnectedTestBuffer) {
+      auto it = componentsBuffer.find(graph);
 
-    case GraphEvent::TLP_DEL_NODE:
-      graph->removeListener(this);
-      resultsBuffer.erase(graph);
-      break;
+      if (it != componentsBuffer.end()) {
+        ConnectedComponentsUnionFind &components = it->second;
 
-    case GraphEvent::TLP_ADD_EDGE:
+        switch (gEvt->getType()) {
+        // a new node is in its own component
+        case GraphEvent::TLP_ADD_NODE:
+        case GraphEvent::TLP_ADD_NODES:
+          components.addNodes(graph);
+          break;
 
-      if (resultsBuffer.find(graph) != resultsBuffer.end() && resultsBuffer[graph]) {
-        return;
-      }
+        // a new edge merges the components of its ends
+        case GraphEvent::TLP_ADD_EDGE:
+          components.addNodes(graph);
+          components.addEdge(graph, gEvt->getEdge());
+          break;
 
-      graph->removeListener(this);
-      resultsBuffer.erase(graph);
-      break;
+        case GraphEvent::TLP_ADD_EDGES:
+          components.addNodes(graph);
+          for (auto e : gEvt->getEdges()) {
+            components.addEdge(graph, e);
+          }
+          break;
 
-    case GraphEvent::TLP_DEL_EDGE:
+        // deletions may split a component and change the nodes positions
+        // so components will be recomputed when needed
+        case GraphEvent::TLP_DEL_NODE:
+          components.invalidate(gEvt->getNode());
+          break;
 
-      if (resultsBuffer.find(graph) != resultsBuffer.end() && !resultsBuffer[graph]) {
-        return;
-      }
+        case GraphEvent::TLP_DEL_EDGE:
+          components.invalidate(node(), gEvt->getEdge());
+          break;
 
-      graph->removeListener(this);
-      resultsBuffer.erase(graph);
-      break;
+        case GraphEvent::TLP_AFTER_SET_ENDS:
+          components.invalidate();
+          break;
 
-    default:
-      // we don't care about other events
-      break;
+        default:
+          // we don't care about other events
+          break;
+        }
+      }
     }
+    TLP_GLOBALLY_UNLOCK_SECTION(ConnectedTestBuffer);
   } else {
 
     auto *graph = static_cast<Graph *>(evt.sender());
 
     if (evt.type() == Event::TLP_DELETE) {
-      resultsBuffer.erase(graph);
+      TLP_GLOBALLY_LOCK_SECTION(ConnectedTestBuffer) {
+        componentsBuffer.erase(graph);
+      }
+      TLP_GLOBALLY_UNLOCK_SECTION(ConnectedTestBuffer);
     }
   }
 }
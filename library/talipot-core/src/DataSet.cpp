@@ -44,6 +44,55 @@ bool DataType::isTalipotProperty(const std::string &typeName) {
           ISPROP(tlp::PropertyInterface) || ISPROP(tlp::GraphProperty));
 }
 
+template <typename PROPERTY>
+static bool getPropertyPointer(const DataType *data, PropertyInterface *&prop) {
+  if (data->getTypeName() != typeid(PROPERTY *).name()) {
+    return false;
+  }
+
+  prop = *static_cast<PROPERTY **>(data->value);
+  return true;
+}
+
+template <typename PROPERTY>
+static bool setPropertyPointer(DataType *data, PropertyInterface *prop) {
+  if (data->getTypeName() != typeid(PROPERTY *).name()) {
+    return false;
+  }
+
+  *static_cast<PROPERTY **>(data->value) = static_cast<PROPERTY *>(prop);
+  return true;
+}
+
+// the Talipot properties whose pointers may be stored in a DataType
+template <typename... PROPERTIES>
+struct PropertyPointerTypes {
+  static PropertyInterface *get(const DataType *data) {
+    PropertyInterface *prop = nullptr;
+    (getPropertyPointer<PROPERTIES>(data, prop) || ...);
+    return prop;
+  }
+
+  static bool set(DataType *data, PropertyInterface *prop) {
+    return (setPropertyPointer<PROPERTIES>(data, prop) || ...);
+  }
+};
+
+using TalipotPropertyPointerTypes =
+    PropertyPointerTypes<BooleanProperty, BooleanVectorProperty, DoubleProperty,
+                         DoubleVectorProperty, LayoutProperty, CoordVectorProperty, StringProperty,
+                         StringVectorProperty, IntegerProperty, IntegerVectorProperty, SizeProperty,
+                         SizeVectorProperty, ColorProperty, ColorVectorProperty, NumericProperty,
+                         PropertyInterface, GraphProperty>;
+
+PropertyInterface *DataType::getProperty() const {
+  return TalipotPropertyPointerTypes::get(this);
+}
+
+bool DataType::setProperty(PropertyInterface *prop) {
+  return TalipotPropertyPointerTypes::set(this, prop);
+}
+
 DataSet::DataSet(const DataSet &set) {
   *this = set;
 }
@@ -312,7 +361,7 @@ string DataSet::toString() const {
       ss << " ";
     } else {
       if (value->isTalipotProperty()) {
-        PropertyInterface *prop = *(static_cast<PropertyInterface **>(value->value));
+        PropertyInterface *prop = value->getProperty();
         ss << "'" << key << "'=";
 
         if (prop) {
@@ -16,6 +16,7 @@
 #include <stack>
 #include <unordered_set>
 
+#include <talipot/AlgorithmResultsCache.h>
 #include <talipot/GraphImpl.h>
 #include <talipot/BooleanProperty.h>
 #include <talipot/ColorProperty.h>
@@ -31,6 +32,7 @@
 #include <talipot/DrawingTools.h>
 #include <talipot/ViewSettings.h>
 #include <talipot/FontAwesome.h>
+#include <talipot/PluginProfiler.h>
 #include <talipot/PropertyAlgorithm.h>
 #include <talipot/StableIterator.h>
 
@@ -341,8 +343,16 @@ Graph *tlp::importGraph(const std::string &format, DataSet &parameters, PluginPr
   // ensure that the parsing of float or double does not depend on locale
   setlocale(LC_NUMERIC, "C");
 
+  bool result;
+
+  {
+    PluginProfiler::Scope profilerScope(format, "Import", graph);
+    result = newImportModule->importGraph();
+    profilerScope.setSuccess(result);
+  }
+
   // If the import failed and we created the graph then delete the graph
-  if (!newImportModule->importGraph()) {
+  if (!result) {
     if (newGraphP) {
       delete graph;
     }
@@ -397,7 +407,11 @@ bool tlp::exportGraph(Graph *graph, std::ostream &outputStream, const std::strin
     graph->setAttribute("file", filename);
   }
 
-  result = newExportModule->exportGraph(outputStream);
+  {
+    PluginProfiler::Scope profilerScope(format, "Export", graph);
+    result = newExportModule->exportGraph(outputStream);
+    profilerScope.setSuccess(result);
+  }
 
   if (deletePluginProgress) {
     delete tmpProgress;
@@ -601,12 +615,18 @@ bool Graph::applyAlgorithm(const std::string &algorithm, std::string &errorMessa
   auto *context = new AlgorithmContext(this, parameters, tmpProgress);
   auto *newAlgo = PluginsManager::getPluginObject<Algorithm>(algorithm, context);
 
-  if ((result = newAlgo->check(errorMessage))) {
-    result = newAlgo->run();
+  {
+    PluginProfiler::Scope profilerScope(algorithm, "Algorithm", this);
 
-    if (!result) {
-      errorMessage = tmpProgress->getError();
+    if ((result = newAlgo->check(errorMessage))) {
+      result = newAlgo->run();
+
+      if (!result) {
+        errorMessage = tmpProgress->getError();
+      }
     }
+
+    profilerScope.setSuccess(result);
   }
 
   delete newAlgo;
@@ -662,6 +682,17 @@ bool tlp::Graph::applyPropertyAlgorithm(const std::string &algorithm, PropertyIn
     return false;
   }
 
+  PluginProfiler::Scope profilerScope(algorithm, "PropertyAlgorithm", this, prop);
+
+  // reuse the result of a previous identical call if available
+  std::string cacheKey;
+  bool cacheable = AlgorithmResultsCache::computeKey(this, algorithm, parameters, cacheKey);
+
+  if (cacheable && AlgorithmResultsCache::restoreResult(cacheKey, this, prop, parameters)) {
+    profilerScope.setSuccess(true);
+    return true;
+  }
+
   tlp::PluginProgress *tmpProgress;
 
   if (progress == nullptr) {
@@ -709,6 +740,11 @@ bool tlp::Graph::applyPropertyAlgorithm(const std::string &algorithm, PropertyIn
 
   circularCalls.erase(algorithm);
   tlp::Observable::unholdObservers();
+  profilerScope.setSuccess(result);
+
+  if (result && cacheable) {
+    AlgorithmResultsCache::storeResult(cacheKey, this, algorithm, parameters, prop);
+  }
 
   if (progress == nullptr) {
     delete tmpProgress;
@@ -89,6 +89,24 @@ void GraphProperty::setNodeValue(const node n,
   }
 }
 //============================================================
+// the referenced graphs have to be maintained for each node,
+// so the values are set one by one
+void GraphProperty::setNodeValues(const std::vector<node> &nodes,
+                                  const std::vector<GraphType::RealType> &values) {
+  assert(nodes.size() == values.size());
+
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    setNodeValue(nodes[i], values[i]);
+  }
+}
+//============================================================
+void GraphProperty::setNodeValues(const std::vector<node> &nodes,
+                                  tlp::StoredType<GraphType::RealType>::ConstReference g) {
+  for (auto n : nodes) {
+    setNodeValue(n, g);
+  }
+}
+//============================================================
 PropertyInterface *GraphProperty::clonePrototype(Graph *g, const std::string &n) const {
   if (!g) {
     return nullptr;
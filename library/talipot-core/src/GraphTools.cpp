@@ -11,6 +11,8 @@
  *
  */
 
+#include <deque>
+
 #include <talipot/GraphMeasure.h>
 #include <talipot/TreeTest.h>
 #include <talipot/DoubleProperty.h>
@@ -145,6 +145,18 @@ void GraphUpdatesRecorder::treatEvent(const Event &ev) {
         beforeSetEdgeValue(prop, propEvt->getEdge());
         break;
 
+      case PropertyEvent::TLP_BEFORE_SET_NODES_VALUES:
+        for (auto n : propEvt->getNodes()) {
+          beforeSetNodeValue(prop, n);
+        }
+        break;
+
+      case PropertyEvent::TLP_BEFORE_SET_EDGES_VALUES:
+        for (auto e : propEvt->getEdges()) {
+          beforeSetEdgeValue(prop, e);
+        }
+        break;
+
       default:
         break;
       }
@@ -0,0 +1,367 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <sys/resource.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <talipot/Graph.h>
+#include <talipot/ParallelTools.h>
+#include <talipot/PluginProfiler.h>
+#include <talipot/PropertyInterface.h>
+#include <talipot/YajlFacade.h>
+
+using namespace std;
+using namespace tlp;
+
+TLP_DEFINE_GLOBAL_LOCK(PluginProfilerLock);
+
+namespace {
+
+struct ProfilerState {
+  ProfilerState();
+  ~ProfilerState();
+
+  bool enabled = false;
+  chrono::steady_clock::time_point origin = chrono::steady_clock::now();
+  vector<PluginProfile> profiles;
+  // the indices of the threads the profiled plugins were run in
+  unordered_map<thread::id, uint> threadIndices;
+  // the thread loading the library, the only one where graph events are counted
+  thread::id mainThread = this_thread::get_id();
+  // the trace file set through the TALIPOT_PLUGINS_PROFILE_TRACE environment variable
+  string traceFile;
+};
+
+ProfilerState profiler;
+
+ProfilerState::ProfilerState() {
+  if (const char *file = getenv("TALIPOT_PLUGINS_PROFILE_TRACE"); file && file[0]) {
+    traceFile = file;
+    enabled = true;
+  }
+}
+
+ProfilerState::~ProfilerState() {
+  if (!traceFile.empty()) {
+    PluginProfiler::writeTrace(traceFile);
+  }
+}
+
+// the nesting level of the profiled invocations in the current thread
+thread_local uint currentDepth = 0;
+
+double cpuTimeNow() {
+  return double(clock()) / CLOCKS_PER_SEC;
+}
+
+int64_t peakResidentSetSize() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return counters.PeakWorkingSetSize;
+  }
+
+  return 0;
+#elif defined(__EMSCRIPTEN__)
+  return 0;
+#else
+  struct rusage usage;
+
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+
+#ifdef __APPLE__
+  // ru_maxrss is given in bytes on macOS
+  return usage.ru_maxrss;
+#else
+  // and in kilobytes on other platforms
+  return int64_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+// listening to the graphs and properties is only safe outside
+// of the parallel sections and of the worker threads
+bool canObserve() {
+#ifdef _OPENMP
+  if (omp_in_parallel()) {
+    return false;
+  }
+#endif
+  return this_thread::get_id() == profiler.mainThread;
+}
+}
+
+// counts the graph events and the values written during an invocation
+struct PluginProfiler::Scope::Measure : public Observable {
+  PluginProfile profile;
+  chrono::steady_clock::time_point realStart;
+  double cpuStart = 0;
+  int64_t peakMemoryStart = 0;
+  unordered_set<Observable *> observed;
+
+  void observe(Observable *obj) {
+    if (obj && observed.insert(obj).second) {
+      obj->addListener(this);
+    }
+  }
+
+  void observeGraph(Graph *graph) {
+    if (observed.find(graph) != observed.end()) {
+      return;
+    }
+
+    observe(graph);
+
+    for (auto *prop : graph->getObjectProperties()) {
+      observe(prop);
+    }
+  }
+
+  void stopObserving() {
+    for (auto *obj : observed) {
+      obj->removeListener(this);
+    }
+
+    observed.clear();
+  }
+
+  void treatEvent(const Event &evt) override;
+};
+
+void PluginProfiler::Scope::Measure::treatEvent(const Event &evt) {
+  if (evt.type() == Event::TLP_DELETE) {
+    observed.erase(evt.sender());
+    return;
+  }
+
+  if (const auto *gEvt = dynamic_cast<const GraphEvent *>(&evt)) {
+    ++profile.graphEvents;
+
+    switch (gEvt->getType()) {
+    case GraphEvent::TLP_AFTER_ADD_DESCENDANTGRAPH:
+      observeGraph(const_cast<Graph *>(gEvt->getSubGraph()));
+      break;
+
+    case GraphEvent::TLP_ADD_LOCAL_PROPERTY:
+    case GraphEvent::TLP_ADD_INHERITED_PROPERTY:
+      observe(gEvt->getGraph()->getProperty(gEvt->getPropertyName()));
+      break;
+
+    default:
+      break;
+    }
+  } else if (const auto *pEvt = dynamic_cast<const PropertyEvent *>(&evt)) {
+    switch (pEvt->getType()) {
+    case PropertyEvent::TLP_AFTER_SET_NODE_VALUE:
+    case PropertyEvent::TLP_AFTER_SET_EDGE_VALUE:
+      ++profile.valuesWritten;
+      break;
+
+    case PropertyEvent::TLP_AFTER_SET_ALL_NODE_VALUE:
+      profile.valuesWritten += pEvt->getProperty()->getGraph()->numberOfNodes();
+      break;
+
+    case PropertyEvent::TLP_AFTER_SET_ALL_EDGE_VALUE:
+      profile.valuesWritten += pEvt->getProperty()->getGraph()->numberOfEdges();
+      break;
+
+    case PropertyEvent::TLP_AFTER_SET_NODES_VALUES:
+      profile.valuesWritten += pEvt->getNodes().size();
+      break;
+
+    case PropertyEvent::TLP_AFTER_SET_EDGES_VALUES:
+      profile.valuesWritten += pEvt->getEdges().size();
+      break;
+
+    default:
+      break;
+    }
+  }
+}
+
+PluginProfiler::Scope::Scope(const string &pluginName, const string &category, Graph *graph,
+                             PropertyInterface *result)
+    : measure(nullptr) {
+  if (!profiler.enabled) {
+    return;
+  }
+
+  measure = new Measure();
+  PluginProfile &profile = measure->profile;
+  profile.pluginName = pluginName;
+  profile.category = category;
+  profile.graphId = graph ? graph->getId() : 0;
+  profile.depth = currentDepth++;
+
+  if (canObserve()) {
+    if (graph) {
+      measure->observeGraph(graph);
+
+      for (auto *sg : graph->getDescendantGraphs()) {
+        measure->observeGraph(sg);
+      }
+    }
+
+    measure->observe(result);
+  }
+
+  // start the measures once the listeners are set up
+  measure->peakMemoryStart = peakResidentSetSize();
+  measure->cpuStart = cpuTimeNow();
+  measure->realStart = chrono::steady_clock::now();
+}
+
+PluginProfiler::Scope::~Scope() {
+  if (measure == nullptr) {
+    return;
+  }
+
+  auto realEnd = chrono::steady_clock::now();
+  PluginProfile &profile = measure->profile;
+  profile.cpuTime = cpuTimeNow() - measure->cpuStart;
+  profile.peakMemoryDelta = peakResidentSetSize() - measure->peakMemoryStart;
+  profile.wallTime = chrono::duration<double>(realEnd - measure->realStart).count();
+  measure->stopObserving();
+  --currentDepth;
+
+  TLP_GLOBALLY_LOCK_SECTION(PluginProfilerLock) {
+    // the profiler may have been disabled or restarted during the invocation
+    if (profiler.enabled && measure->realStart >= profiler.origin) {
+      profile.startTime = chrono::duration<double>(measure->realStart - profiler.origin).count();
+      profile.threadIndex =
+          profiler.threadIndices.emplace(this_thread::get_id(), profiler.threadIndices.size())
+              .first->second;
+      profiler.profiles.push_back(std::move(profile));
+    }
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(PluginProfilerLock);
+
+  delete measure;
+}
+
+void PluginProfiler::Scope::setSuccess(bool success) {
+  if (measure) {
+    measure->profile.success = success;
+  }
+}
+
+void PluginProfiler::setEnabled(bool enabled) {
+  TLP_GLOBALLY_LOCK_SECTION(PluginProfilerLock) {
+    if (enabled && !profiler.enabled) {
+      profiler.profiles.clear();
+      profiler.threadIndices.clear();
+      profiler.origin = chrono::steady_clock::now();
+    }
+
+    profiler.enabled = enabled;
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(PluginProfilerLock);
+}
+
+bool PluginProfiler::isEnabled() {
+  return profiler.enabled;
+}
+
+vector<PluginProfile> PluginProfiler::profiles() {
+  vector<PluginProfile> result;
+  TLP_GLOBALLY_LOCK_SECTION(PluginProfilerLock) {
+    result = profiler.profiles;
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(PluginProfilerLock);
+  return result;
+}
+
+void PluginProfiler::clear() {
+  TLP_GLOBALLY_LOCK_SECTION(PluginProfilerLock) {
+    profiler.profiles.clear();
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(PluginProfilerLock);
+}
+
+void PluginProfiler::writeTrace(ostream &os) {
+  YajlWriteFacade writer;
+  writer.writeMapOpen();
+  writer.writeString("traceEvents");
+  writer.writeArrayOpen();
+
+  // each invocation is a complete event whose timestamps are in microseconds
+  for (const auto &profile : profiles()) {
+    writer.writeMapOpen();
+    writer.writeString("name");
+    writer.writeString(profile.pluginName);
+    writer.writeString("cat");
+    writer.writeString(profile.category);
+    writer.writeString("ph");
+    writer.writeString("X");
+    writer.writeString("ts");
+    writer.writeDouble(profile.startTime * 1e6);
+    writer.writeString("dur");
+    writer.writeDouble(profile.wallTime * 1e6);
+    writer.writeString("pid");
+    writer.writeInteger(0);
+    writer.writeString("tid");
+    writer.writeInteger(profile.threadIndex);
+    writer.writeString("args");
+    writer.writeMapOpen();
+    writer.writeString("graph");
+    writer.writeInteger(profile.graphId);
+    writer.writeString("success");
+    writer.writeBool(profile.success);
+    writer.writeString("cpu_time_us");
+    writer.writeDouble(profile.cpuTime * 1e6);
+    writer.writeString("peak_memory_delta_bytes");
+    writer.writeInteger(profile.peakMemoryDelta);
+    writer.writeString("graph_events");
+    writer.writeInteger(profile.graphEvents);
+    writer.writeString("values_written");
+    writer.writeInteger(profile.valuesWritten);
+    writer.writeMapClose();
+    writer.writeMapClose();
+  }
+
+  writer.writeArrayClose();
+  writer.writeString("displayTimeUnit");
+  writer.writeString("ms");
+  writer.writeMapClose();
+  os << writer.generatedString();
+}
+
+bool PluginProfiler::writeTrace(const string &filename) {
+  ofstream os(filename);
+
+  if (!os) {
+    return false;
+  }
+
+  writeTrace(os);
+  return bool(os);
+}
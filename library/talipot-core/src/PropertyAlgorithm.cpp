@@ -11,15 +11,24 @@
  *
  */
 
+#include <chrono>
+
 #include <talipot/PropertyAlgorithm.h>
 
 #include <talipot/BooleanProperty.h>
 #include <talipot/ColorProperty.h>
+#include <talipot/ConnectedTest.h>
 #include <talipot/DoubleProperty.h>
 #include <talipot/IntegerProperty.h>
 #include <talipot/LayoutProperty.h>
+#include <talipot/ParallelTools.h>
+#include <talipot/PluginsManager.h>
+#include <talipot/SimplePluginProgress.h>
 #include <talipot/SizeProperty.h>
 #include <talipot/StringProperty.h>
+#include <talipot/VectorProperty.h>
+
+using namespace std;
 
 tlp::BooleanAlgorithm::BooleanAlgorithm(const tlp::PluginContext *context)
     : tlp::TemplateAlgorithm<BooleanProperty>(context) {
@@ -51,6 +60,252 @@ tlp::LayoutAlgorithm::LayoutAlgorithm(const tlp::PluginContext *context)
       "result", "This parameter indicates the property to compute.", "viewLayout");
 }
 
+namespace {
+// a connected component copied in a standalone graph
+struct ComponentLayout {
+  tlp::Graph *graph = nullptr;
+  tlp::DataSet dataSet;
+  // the unregistered copies of the property parameters
+  vector<tlp::PropertyInterface *> properties;
+  tlp::SimplePluginProgress progress;
+  tlp::LayoutAlgorithm *algorithm = nullptr;
+  string errorMessage;
+  bool success = false;
+
+  ~ComponentLayout() {
+    delete algorithm;
+
+    for (auto *prop : properties) {
+      delete prop;
+    }
+
+    delete graph;
+  }
+};
+}
+
+// the name of the optional parameter of the layout plugins
+// bounding the time spent in milliseconds, 0 meaning no limit
+static const char *TIME_BUDGET = "time budget";
+
+bool tlp::LayoutAlgorithm::layoutConnectedComponents(bool concurrent) {
+  // the time budget bounds the layout of all the components
+  uint timeBudget = 0;
+  auto deadline = chrono::steady_clock::time_point::max();
+
+  if (dataSet != nullptr && dataSet->get(TIME_BUDGET, timeBudget) && timeBudget > 0) {
+    deadline = chrono::steady_clock::now() + chrono::milliseconds(timeBudget);
+  }
+
+  auto components = ConnectedTest::computeConnectedComponents(graph);
+  uint nbComponents = components.size();
+
+  // the property parameters are given in the dataset or, if missing,
+  // through the name of the property used by default
+  struct PropertyParameter {
+    string name;
+    PropertyInterface *property;
+    bool inDataSet;
+  };
+  vector<PropertyParameter> propertyParams;
+
+  for (const auto &param : getParameters().getParameters()) {
+    if (param.getDirection() == OUT_PARAM || !DataType::isTalipotProperty(param.getTypeName())) {
+      continue;
+    }
+
+    if (dataSet != nullptr && dataSet->exists(param.getName())) {
+      DataType *value = dataSet->getData(param.getName());
+      PropertyInterface *prop = value->getProperty();
+      delete value;
+
+      if (prop != nullptr) {
+        propertyParams.push_back({param.getName(), prop, true});
+      }
+    } else if (!param.getDefaultValue().empty() && graph->existProperty(param.getDefaultValue())) {
+      propertyParams.push_back(
+          {param.getDefaultValue(), graph->getProperty(param.getDefaultValue()), false});
+    }
+  }
+
+  // the position of each node in its component
+  NodeVectorProperty<uint> nodeComponent(graph);
+  NodeVectorProperty<uint> nodeIndex(graph);
+
+  for (uint i = 0; i < nbComponents; ++i) {
+    for (uint j = 0; j < components[i].size(); ++j) {
+      nodeComponent[components[i][j]] = i;
+      nodeIndex[components[i][j]] = j;
+    }
+  }
+
+  vector<vector<edge>> componentsEdges(nbComponents);
+
+  for (auto e : graph->edges()) {
+    componentsEdges[nodeComponent[graph->source(e)]].push_back(e);
+  }
+
+  vector<node> nodes;
+  vector<Coord> coords;
+  vector<edge> edges;
+  vector<vector<Coord>> bends;
+  nodes.reserve(graph->numberOfNodes());
+  coords.reserve(graph->numberOfNodes());
+  edges.reserve(graph->numberOfEdges());
+  bends.reserve(graph->numberOfEdges());
+
+  // the components are laid out by batches
+  // to limit the memory used by their copies
+  uint batchSize = concurrent ? 16 * TLP_NB_THREADS : 1;
+
+  for (uint first = 0; first < nbComponents; first += batchSize) {
+    uint nbLayouts = std::min(batchSize, nbComponents - first);
+    vector<ComponentLayout> layouts(nbLayouts);
+
+    // the copies and the plugins instances are created sequentially
+    for (uint i = 0; i < nbLayouts; ++i) {
+      ComponentLayout &layout = layouts[i];
+      const vector<node> &component = components[first + i];
+      Graph *cGraph = layout.graph = newGraph();
+      const vector<node> &cNodes = cGraph->addNodes(component.size());
+      vector<pair<node, node>> cEnds;
+      cEnds.reserve(componentsEdges[first + i].size());
+
+      for (auto e : componentsEdges[first + i]) {
+        const auto &[src, tgt] = graph->ends(e);
+        cEnds.emplace_back(cNodes[nodeIndex[src]], cNodes[nodeIndex[tgt]]);
+      }
+
+      const vector<edge> &cEdges = cGraph->addEdges(cEnds);
+
+      if (dataSet != nullptr) {
+        layout.dataSet = *dataSet;
+        layout.dataSet.remove("result");
+      }
+
+      for (const auto &param : propertyParams) {
+        // the properties given in the dataset are copied in unregistered properties,
+        // the ones used by default are registered under the same name
+        PropertyInterface *cProp =
+            param.property->clonePrototype(cGraph, param.inDataSet ? "" : param.name);
+
+        for (uint j = 0; j < component.size(); ++j) {
+          cProp->copy(cNodes[j], component[j], param.property, true);
+        }
+
+        for (uint j = 0; j < cEdges.size(); ++j) {
+          cProp->copy(cEdges[j], componentsEdges[first + i][j], param.property, true);
+        }
+
+        if (param.inDataSet) {
+          layout.properties.push_back(cProp);
+          // the typed pointer of the parameter is replaced by the copy
+          DataType *value = layout.dataSet.getData(param.name);
+          value->setProperty(cProp);
+          layout.dataSet.setData(param.name, value);
+          delete value;
+        }
+      }
+
+      AlgorithmContext context(cGraph, &layout.dataSet, &layout.progress);
+      layout.algorithm = PluginsManager::getPluginObject<LayoutAlgorithm>(name(), &context);
+    }
+
+    auto runLayout = [&layouts, deadline](uint i) {
+      ComponentLayout &layout = layouts[i];
+
+      // each instance gets the time remaining when it starts
+      if (deadline != chrono::steady_clock::time_point::max()) {
+        auto remaining =
+            chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now());
+        layout.dataSet.set(TIME_BUDGET, uint(std::max<long long>(remaining.count(), 1)));
+      }
+
+      if (layout.algorithm != nullptr && layout.algorithm->check(layout.errorMessage)) {
+        layout.success = layout.algorithm->run();
+
+        if (!layout.success) {
+          layout.errorMessage = layout.progress.getError();
+        }
+      }
+    };
+
+    // the events sent when deleting an observable are still dispatched,
+    // so the graphs and properties are only created or deleted sequentially
+    if (concurrent) {
+      Observable::disableEventNotification();
+      TLP_PARALLEL_MAP_INDICES(nbLayouts, runLayout);
+      Observable::enableEventNotification();
+    } else {
+      for (uint i = 0; i < nbLayouts; ++i) {
+        runLayout(i);
+      }
+    }
+
+    for (uint i = 0; i < nbLayouts; ++i) {
+      ComponentLayout &layout = layouts[i];
+
+      if (!layout.success) {
+        if (pluginProgress) {
+          pluginProgress->setError(layout.errorMessage);
+        }
+
+        return false;
+      }
+
+      const vector<node> &component = components[first + i];
+      const vector<node> &cNodes = layout.graph->nodes();
+      LayoutProperty *cResult = layout.algorithm->result;
+
+      for (uint j = 0; j < component.size(); ++j) {
+        nodes.push_back(component[j]);
+        coords.push_back(cResult->getNodeValue(cNodes[j]));
+      }
+
+      const vector<edge> &cEdges = layout.graph->edges();
+
+      for (uint j = 0; j < cEdges.size(); ++j) {
+        edges.push_back(componentsEdges[first + i][j]);
+        bends.push_back(cResult->getEdgeValue(cEdges[j]));
+      }
+    }
+
+    if (pluginProgress) {
+      pluginProgress->progress(first + nbLayouts, nbComponents);
+
+      if (pluginProgress->state() == TLP_CANCEL) {
+        return false;
+      }
+
+      // when stopped, the components already laid out are kept
+      if (pluginProgress->state() == TLP_STOP) {
+        break;
+      }
+    }
+  }
+
+  result->setNodeValues(nodes, coords);
+  result->setEdgeValues(edges, bends);
+
+  // call connected component packing
+  string err;
+  LayoutProperty tmpLayout(graph);
+  DataSet tmpDataSet;
+  tmpDataSet.set("coordinates", result);
+
+  if (!graph->applyPropertyAlgorithm("Connected Component Packing", &tmpLayout, err, &tmpDataSet,
+                                     pluginProgress)) {
+    if (pluginProgress) {
+      pluginProgress->setError(err);
+    }
+
+    return false;
+  }
+
+  *result = tmpLayout;
+  return true;
+}
+
 tlp::SizeAlgorithm::SizeAlgorithm(const tlp::PluginContext *context)
     : tlp::TemplateAlgorithm<SizeProperty>(context) {
   addOutParameter<tlp::SizeProperty>("result", "This parameter indicates the property to compute.",
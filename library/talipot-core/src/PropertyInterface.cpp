@@ -91,6 +91,34 @@ void PropertyInterface::notifyAfterSetAllEdgeValue() {
   }
 }
 
+void PropertyInterface::notifyBeforeSetNodesValues(const std::vector<node> &nodes) {
+  if (hasOnlookers() && !nodes.empty()) {
+    sendEvent(PropertyEvent(*this, PropertyEvent::TLP_BEFORE_SET_NODES_VALUES,
+                            Event::TLP_INFORMATION, nodes));
+  }
+}
+
+void PropertyInterface::notifyAfterSetNodesValues(const std::vector<node> &nodes) {
+  if (hasOnlookers() && !nodes.empty()) {
+    sendEvent(PropertyEvent(*this, PropertyEvent::TLP_AFTER_SET_NODES_VALUES,
+                            Event::TLP_MODIFICATION, nodes));
+  }
+}
+
+void PropertyInterface::notifyBeforeSetEdgesValues(const std::vector<edge> &edges) {
+  if (hasOnlookers() && !edges.empty()) {
+    sendEvent(PropertyEvent(*this, PropertyEvent::TLP_BEFORE_SET_EDGES_VALUES,
+                            Event::TLP_INFORMATION, edges));
+  }
+}
+
+void PropertyInterface::notifyAfterSetEdgesValues(const std::vector<edge> &edges) {
+  if (hasOnlookers() && !edges.empty()) {
+    sendEvent(PropertyEvent(*this, PropertyEvent::TLP_AFTER_SET_EDGES_VALUES,
+                            Event::TLP_MODIFICATION, edges));
+  }
+}
+
 void PropertyInterface::notifyDestroy() {
   if (hasOnlookers()) {
     // the undo/redo mechanism has to simulate graph destruction
@@ -183,6 +183,23 @@ void SizeProperty::setAllNodeValue(tlp::StoredType<Size>::ConstReference v, cons
   resetMinMax();
   AbstractSizeProperty::setAllNodeValue(v, graph);
 }
+//=================================================================================
+void SizeProperty::setNodeValues(const std::vector<node> &nodes, const std::vector<Size> &values) {
+  if (!nodes.empty()) {
+    resetMinMax();
+  }
+
+  AbstractSizeProperty::setNodeValues(nodes, values);
+}
+//=================================================================================
+void SizeProperty::setNodeValues(const std::vector<node> &nodes,
+                                 tlp::StoredType<Size>::ConstReference v) {
+  if (!nodes.empty()) {
+    resetMinMax();
+  }
+
+  AbstractSizeProperty::setNodeValues(nodes, v);
+}
 //=============================================================================
 PropertyInterface *SizeProperty::clonePrototype(Graph *g, const std::string &n) const {
   if (!g) {
@@ -0,0 +1,205 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include <talipot/ParallelTools.h>
+#include <talipot/SparseMatrix.h>
+
+using namespace std;
+using namespace tlp;
+
+namespace {
+
+// the vectors are processed by blocks of fixed size,
+// so the results of the reductions do not depend on the number of threads
+const uint BLOCK_SIZE = 4096;
+
+template <typename BlockFunction>
+void forEachBlock(uint size, const BlockFunction &blockFunction) {
+  uint nbBlocks = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+  if (nbBlocks < 2) {
+    blockFunction(0, 0, size);
+  } else {
+    TLP_PARALLEL_MAP_INDICES(nbBlocks, [&](uint block) {
+      blockFunction(block, block * BLOCK_SIZE, min(size, (block + 1) * BLOCK_SIZE));
+    });
+  }
+}
+
+double dot(const vector<double> &u, const vector<double> &v) {
+  uint size = u.size();
+  vector<double> sums((size + BLOCK_SIZE - 1) / BLOCK_SIZE + 1, 0);
+  forEachBlock(size, [&](uint block, uint begin, uint end) {
+    double sum = 0;
+
+    for (uint i = begin; i < end; ++i) {
+      sum += u[i] * v[i];
+    }
+
+    sums[block] = sum;
+  });
+
+  double sum = 0;
+
+  for (double s : sums) {
+    sum += s;
+  }
+
+  return sum;
+}
+}
+
+SparseMatrix::SparseMatrix(uint size) : nbRows(size) {}
+
+void SparseMatrix::addEntry(uint row, uint col, double value) {
+  assert(row < nbRows && col < nbRows && rowStarts.empty());
+  triplets.push_back({row, col, value});
+}
+
+void SparseMatrix::compress() {
+  sort(triplets.begin(), triplets.end(), [](const Triplet &t1, const Triplet &t2) {
+    return t1.row < t2.row || (t1.row == t2.row && t1.col < t2.col);
+  });
+
+  rowStarts.assign(nbRows + 1, 0);
+  columns.clear();
+  values.clear();
+
+  for (const auto &t : triplets) {
+    if (!columns.empty() && rowStarts[t.row + 1] > 0 && columns.back() == t.col) {
+      // sum the values added at the same position
+      values.back() += t.value;
+    } else {
+      columns.push_back(t.col);
+      values.push_back(t.value);
+      ++rowStarts[t.row + 1];
+    }
+  }
+
+  for (uint i = 0; i < nbRows; ++i) {
+    rowStarts[i + 1] += rowStarts[i];
+  }
+
+  triplets.clear();
+  triplets.shrink_to_fit();
+}
+
+double SparseMatrix::get(uint row, uint col) const {
+  assert(row < nbRows && !rowStarts.empty());
+  auto begin = columns.begin() + rowStarts[row];
+  auto end = columns.begin() + rowStarts[row + 1];
+  auto it = lower_bound(begin, end, col);
+
+  if (it == end || *it != col) {
+    return 0;
+  }
+
+  return values[it - columns.begin()];
+}
+
+void SparseMatrix::multiply(const vector<double> &x, vector<double> &y) const {
+  assert(x.size() == nbRows && !rowStarts.empty());
+  y.resize(nbRows);
+  forEachBlock(nbRows, [&](uint, uint begin, uint end) {
+    for (uint row = begin; row < end; ++row) {
+      double sum = 0;
+
+      for (uint i = rowStarts[row]; i < rowStarts[row + 1]; ++i) {
+        sum += values[i] * x[columns[i]];
+      }
+
+      y[row] = sum;
+    }
+  });
+}
+
+bool tlp::solveConjugateGradient(const SparseMatrix &A, const vector<double> &b, vector<double> &x,
+                                 double tolerance, uint maxIterations, uint *nbIterations) {
+  uint size = A.size();
+  assert(b.size() == size);
+  x.resize(size, 0);
+
+  if (nbIterations) {
+    *nbIterations = 0;
+  }
+
+  double bNorm = sqrt(dot(b, b));
+
+  if (bNorm == 0) {
+    x.assign(size, 0);
+    return true;
+  }
+
+  // the Jacobi preconditioner is the inverse of the diagonal
+  vector<double> invDiagonal(size);
+  forEachBlock(size, [&](uint, uint begin, uint end) {
+    for (uint i = begin; i < end; ++i) {
+      double d = A.diagonal(i);
+      invDiagonal[i] = d != 0 ? 1 / d : 1;
+    }
+  });
+
+  vector<double> r(size), z(size), p(size), Ap(size);
+  A.multiply(x, Ap);
+  forEachBlock(size, [&](uint, uint begin, uint end) {
+    for (uint i = begin; i < end; ++i) {
+      r[i] = b[i] - Ap[i];
+      p[i] = z[i] = invDiagonal[i] * r[i];
+    }
+  });
+
+  double threshold = tolerance * bNorm;
+  double rz = dot(r, z);
+
+  for (uint iter = 0; iter < maxIterations; ++iter) {
+    if (sqrt(dot(r, r)) <= threshold) {
+      return true;
+    }
+
+    A.multiply(p, Ap);
+    double pAp = dot(p, Ap);
+
+    if (pAp <= 0) {
+      // the matrix is not positive definite
+      return false;
+    }
+
+    double alpha = rz / pAp;
+    forEachBlock(size, [&](uint, uint begin, uint end) {
+      for (uint i = begin; i < end; ++i) {
+        x[i] += alpha * p[i];
+        r[i] -= alpha * Ap[i];
+        z[i] = invDiagonal[i] * r[i];
+      }
+    });
+
+    double rzNew = dot(r, z);
+    double beta = rzNew / rz;
+    rz = rzNew;
+    forEachBlock(size, [&](uint, uint begin, uint end) {
+      for (uint i = begin; i < end; ++i) {
+        p[i] = z[i] + beta * p[i];
+      }
+    });
+
+    if (nbIterations) {
+      *nbIterations = iter + 1;
+    }
+  }
+
+  return sqrt(dot(r, r)) <= threshold;
+}
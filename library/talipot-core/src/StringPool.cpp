@@ -0,0 +1,138 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <cassert>
+#include <string_view>
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+#endif
+#include <parallel_hashmap/phmap.h>
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+#include <talipot/ParallelTools.h>
+#include <talipot/StringPool.h>
+
+using namespace std;
+using namespace tlp;
+
+TLP_DEFINE_GLOBAL_LOCK(StringPoolLock);
+
+namespace {
+
+struct Entry {
+  string value;
+  uint refs;
+};
+
+// the entries are indexed by their content
+typedef phmap::flat_hash_map<string_view, Entry *> Entries;
+
+// the pool is never destroyed as the properties and their values
+// may be deleted at exit after the static objects
+Entries &entries() {
+  static auto *entries = new Entries();
+  return *entries;
+}
+}
+
+const string *StringPool::intern(const string &str) {
+  Entry *entry = nullptr;
+
+  TLP_GLOBALLY_LOCK_SECTION(StringPoolLock) {
+    auto &pool = entries();
+    auto it = pool.find(string_view(str));
+
+    if (it != pool.end()) {
+      entry = it->second;
+      ++entry->refs;
+    } else {
+      entry = new Entry{str, 1};
+      pool.emplace(string_view(entry->value), entry);
+    }
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(StringPoolLock);
+
+  return &entry->value;
+}
+
+void StringPool::release(const string *str) {
+  Entry *unused = nullptr;
+
+  TLP_GLOBALLY_LOCK_SECTION(StringPoolLock) {
+    auto &pool = entries();
+    auto it = pool.find(string_view(*str));
+    assert(it != pool.end() && &it->second->value == str);
+
+    if (--it->second->refs == 0) {
+      unused = it->second;
+      pool.erase(it);
+    }
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(StringPoolLock);
+
+  delete unused;
+}
+
+uint StringPool::refCount(const string *str) {
+  uint refs = 0;
+
+  TLP_GLOBALLY_LOCK_SECTION(StringPoolLock) {
+    auto &pool = entries();
+    auto it = pool.find(string_view(*str));
+
+    if (it != pool.end() && &it->second->value == str) {
+      refs = it->second->refs;
+    }
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(StringPoolLock);
+
+  return refs;
+}
+
+uint StringPool::size() {
+  uint nbStrings = 0;
+
+  TLP_GLOBALLY_LOCK_SECTION(StringPoolLock) {
+    nbStrings = entries().size();
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(StringPoolLock);
+
+  return nbStrings;
+}
+
+size_t StringPool::memoryUsage() {
+  size_t bytes = 0;
+
+  TLP_GLOBALLY_LOCK_SECTION(StringPoolLock) {
+    auto &pool = entries();
+    // a slot and a control byte for each bucket
+    bytes = pool.capacity() * (sizeof(Entries::value_type) + 1);
+
+    for (const auto &[view, entry] : pool) {
+      bytes += sizeof(Entry);
+      const char *begin = reinterpret_cast<const char *>(&entry->value);
+
+      // the short strings are stored inside the string object
+      if (view.data() < begin || view.data() >= begin + sizeof(string)) {
+        bytes += entry->value.capacity() + 1;
+      }
+    }
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(StringPoolLock);
+
+  return bytes;
+}
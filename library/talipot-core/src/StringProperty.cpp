@@ -68,15 +68,34 @@ PropertyInterface *StringProperty::clonePrototype(Graph *g, const std::string &n
   StringProperty *p = n.empty() ? new StringProperty(g) : g->getLocalStringProperty(n);
   p->setAllNodeValue(getNodeDefaultValue());
   p->setAllEdgeValue(getEdgeDefaultValue());
+  p->setInternedValues(hasInternedValues());
   return p;
 }
 //=================================================================================
+void StringProperty::setInternedValues(bool interned) {
+  nodeProperties.setInternedValues(interned);
+  edgeProperties.setInternedValues(interned);
+}
+//=================================================================================
 int StringProperty::compare(const node n1, const node n2) const {
-  return getNodeValue(n1).compare(getNodeValue(n2));
+  const std::string *v1 = getNodeValueId(n1);
+  const std::string *v2 = getNodeValueId(n2);
+  return (v1 == v2) ? 0 : v1->compare(*v2);
 }
 //=================================================================================
 int StringProperty::compare(const edge e1, const edge e2) const {
-  return getEdgeValue(e1).compare(getEdgeValue(e2));
+  const std::string *v1 = getEdgeValueId(e1);
+  const std::string *v2 = getEdgeValueId(e2);
+  return (v1 == v2) ? 0 : v1->compare(*v2);
+}
+//=================================================================================
+const std::string *StringProperty::getNodeValueId(const node n) const {
+  // the default value is always a private copy
+  return &nodeProperties.get(n);
+}
+//=================================================================================
+const std::string *StringProperty::getEdgeValueId(const edge e) const {
+  return &edgeProperties.get(e);
 }
 //=================================================================================
 PropertyInterface *StringVectorProperty::clonePrototype(Graph *g, const std::string &n) const {
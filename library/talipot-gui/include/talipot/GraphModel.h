@@ -14,6 +14,8 @@
 #ifndef TALIPOT_GRAPH_MODEL_H
 #define TALIPOT_GRAPH_MODEL_H
 
+#include <vector>
+
 #include <QVector>
 #include <QSet>
 #include <QSortFilterProxyModel>
@@ -81,8 +83,30 @@ class TLP_QT_SCOPE GraphSortFilterProxyModel : public QSortFilterProxyModel, pub
   QVector<PropertyInterface *> _properties;
   BooleanProperty *_filterProperty;
 
+  // index of the graph elements ordered by the values of the property
+  // used to sort the model, it is lazily built on the first comparison
+  // and patched when the property values are modified
+  mutable PropertyInterface *_sortProperty;
+  mutable Graph *_sortGraph;
+  // whether the sorted elements are nodes or edges
+  mutable bool _sortNodes;
+  mutable bool _sortIndexValid;
+  // number of elements moved in the index since it was built
+  mutable uint _sortIndexUpdates;
+  mutable std::vector<uint> _sortedElements;
+  // positions of the elements in _sortedElements indexed by their ids
+  mutable std::vector<uint> _sortRanks;
+
+  void buildSortIndex(PropertyInterface *prop) const;
+  void updateSortIndex(uint id);
+  void clearSortIndex();
+  bool elementLessThan(uint a, uint b) const;
+
 public:
   GraphSortFilterProxyModel(QObject *parent = nullptr);
+  ~GraphSortFilterProxyModel() override;
+
+  void setSourceModel(QAbstractItemModel *source) override;
 
   void setFilterProperty(tlp::BooleanProperty *);
   void setSelectedOnly(bool);
@@ -13,6 +13,8 @@
 
 #include "talipot/GraphHierarchiesModel.h"
 
+#include <set>
+
 #include <QFont>
 #include <QCryptographicHash>
 
@@ -800,19 +802,29 @@ void GraphHierarchiesModel::treatEvent(const Event &e) {
     // ensure to load textures once they are set and not during graph rendering
     // to avoid recursive repaint when a texture must be downloaded from a HTTP
     // URL (due to QEventLoop use in FileDownloader class implementation)
-    string texture;
+    set<string> textures;
     auto *viewTexture = static_cast<StringProperty *>(pe->getProperty());
     if (pe->getType() == PropertyEvent::TLP_AFTER_SET_NODE_VALUE) {
-      texture = viewTexture->getNodeValue(pe->getNode());
+      textures.insert(viewTexture->getNodeValue(pe->getNode()));
     } else if (pe->getType() == PropertyEvent::TLP_AFTER_SET_EDGE_VALUE) {
-      texture = viewTexture->getEdgeValue(pe->getEdge());
+      textures.insert(viewTexture->getEdgeValue(pe->getEdge()));
+    } else if (pe->getType() == PropertyEvent::TLP_AFTER_SET_NODES_VALUES) {
+      for (auto n : pe->getNodes()) {
+        textures.insert(viewTexture->getNodeValue(n));
+      }
+    } else if (pe->getType() == PropertyEvent::TLP_AFTER_SET_EDGES_VALUES) {
+      for (auto e : pe->getEdges()) {
+        textures.insert(viewTexture->getEdgeValue(e));
+      }
     } else if (pe->getType() == PropertyEvent::TLP_AFTER_SET_ALL_NODE_VALUE) {
-      texture = viewTexture->getNodeDefaultValue();
+      textures.insert(viewTexture->getNodeDefaultValue());
     } else if (pe->getType() == PropertyEvent::TLP_AFTER_SET_ALL_EDGE_VALUE) {
-      texture = viewTexture->getEdgeDefaultValue();
+      textures.insert(viewTexture->getEdgeDefaultValue());
     }
-    if (!texture.empty()) {
-      GlTextureManager::loadTexture(texture);
+    for (const auto &texture : textures) {
+      if (!texture.empty()) {
+        GlTextureManager::loadTexture(texture);
+      }
     }
     return;
   }
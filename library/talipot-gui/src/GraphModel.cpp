@@ -13,7 +13,13 @@
 
 #include "talipot/GraphModel.h"
 
+#include <climits>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+
 #include <talipot/MetaTypes.h>
+#include <talipot/ParallelTools.h>
 #include <talipot/FontIconManager.h>
 #include <talipot/MaterialDesignIcons.h>
 
@@ -863,12 +869,269 @@ bool EdgesGraphModel::lessThan(uint a, uint b, PropertyInterface *prop) const {
 // Filter proxy
 GraphSortFilterProxyModel::GraphSortFilterProxyModel(QObject *parent)
     : QSortFilterProxyModel(parent), _properties(QVector<PropertyInterface *>()),
-      _filterProperty(nullptr) {}
+      _filterProperty(nullptr), _sortProperty(nullptr), _sortGraph(nullptr), _sortNodes(true),
+      _sortIndexValid(false), _sortIndexUpdates(0) {}
+
+GraphSortFilterProxyModel::~GraphSortFilterProxyModel() {
+  clearSortIndex();
+
+  if (_filterProperty != nullptr) {
+    _filterProperty->removeListener(this);
+  }
+}
+
+void GraphSortFilterProxyModel::setSourceModel(QAbstractItemModel *source) {
+  // the sort index is bound to the previous source
+  clearSortIndex();
+
+  if (sourceModel() != nullptr) {
+    disconnect(sourceModel(), &QObject::destroyed, this, nullptr);
+  }
+
+  QSortFilterProxyModel::setSourceModel(source);
+
+  if (source != nullptr) {
+    connect(source, &QObject::destroyed, this, [this] { clearSortIndex(); });
+  }
+}
+
+// maximum number of elements moved in the sort index before it is rebuilt
+static constexpr uint MAX_SORT_INDEX_UPDATES = 16;
+
+// returns an unsigned integer key whose ordering is the one of the double value
+static uint64_t doubleSortKey(double v) {
+  uint64_t key;
+  memcpy(&key, &v, sizeof(key));
+  // flip all the bits of the negative values,
+  // only the sign bit of the positive ones
+  return (key & (uint64_t(1) << 63)) ? ~key : (key | (uint64_t(1) << 63));
+}
+
+// stable LSD radix sort of the elements according to their keys,
+// using 16 bits digits
+static void radixSort(std::vector<uint64_t> &keys, std::vector<uint> &elts) {
+  uint nbElts = keys.size();
+  std::vector<uint64_t> sortedKeys(nbElts);
+  std::vector<uint> sortedElts(nbElts);
+  std::vector<uint> offsets(1 << 16);
+
+  for (uint shift = 0; shift < 64; shift += 16) {
+    std::fill(offsets.begin(), offsets.end(), 0);
+
+    for (auto key : keys) {
+      ++offsets[(key >> shift) & 0xFFFF];
+    }
+
+    // nothing to do if all the keys have the same digit
+    if (offsets[(keys[0] >> shift) & 0xFFFF] == nbElts) {
+      continue;
+    }
+
+    uint sum = 0;
+
+    for (auto &offset : offsets) {
+      uint count = offset;
+      offset = sum;
+      sum += count;
+    }
+
+    for (uint i = 0; i < nbElts; ++i) {
+      uint pos = offsets[(keys[i] >> shift) & 0xFFFF]++;
+      sortedKeys[pos] = keys[i];
+      sortedElts[pos] = elts[i];
+    }
+
+    keys.swap(sortedKeys);
+    elts.swap(sortedElts);
+  }
+}
+
+bool GraphSortFilterProxyModel::elementLessThan(uint a, uint b) const {
+  bool nodes = _sortNodes;
+  int cmp;
+
+  if (auto *metric = dynamic_cast<NumericProperty *>(_sortProperty)) {
+    uint64_t ka = doubleSortKey(nodes ? metric->getNodeDoubleValue(node(a))
+                                      : metric->getEdgeDoubleValue(edge(a)));
+    uint64_t kb = doubleSortKey(nodes ? metric->getNodeDoubleValue(node(b))
+                                      : metric->getEdgeDoubleValue(edge(b)));
+    cmp = (ka < kb) ? -1 : (ka > kb);
+  } else {
+    cmp = nodes ? _sortProperty->compare(node(a), node(b)) : _sortProperty->compare(edge(a), edge(b));
+  }
+
+  // equal values are ordered according to the elements ids
+  return cmp < 0 || (cmp == 0 && a < b);
+}
+
+void GraphSortFilterProxyModel::buildSortIndex(PropertyInterface *prop) const {
+  auto *graphModel = static_cast<GraphModel *>(sourceModel());
+  auto *self = const_cast<GraphSortFilterProxyModel *>(this);
+
+  if (prop != _sortProperty) {
+    if (_sortProperty != nullptr) {
+      _sortProperty->removeListener(self);
+    }
+
+    _sortProperty = prop;
+    _sortProperty->addListener(self);
+  }
+
+  // the graph is observed to be notified of the elements addition
+  if (graphModel->graph() != _sortGraph) {
+    if (_sortGraph != nullptr) {
+      _sortGraph->removeListener(self);
+    }
+
+    _sortGraph = graphModel->graph();
+
+    if (_sortGraph != nullptr) {
+      _sortGraph->addListener(self);
+    }
+  }
+
+  bool nodes = _sortNodes = graphModel->isNode();
+  uint nbElts = graphModel->rowCount();
+  _sortedElements.resize(nbElts);
+  uint maxId = 0;
+
+  for (uint i = 0; i < nbElts; ++i) {
+    uint id = _sortedElements[i] = graphModel->elementAt(i);
+    maxId = std::max(maxId, id);
+  }
+
+  std::sort(_sortedElements.begin(), _sortedElements.end());
+
+  if (auto *metric = dynamic_cast<NumericProperty *>(prop); metric && nbElts) {
+    // numeric values are extracted in parallel then radix sorted
+    std::vector<uint64_t> keys(nbElts);
+    TLP_PARALLEL_MAP_INDICES(nbElts, [&](uint i) {
+      uint id = _sortedElements[i];
+      keys[i] = doubleSortKey(nodes ? metric->getNodeDoubleValue(node(id))
+                                    : metric->getEdgeDoubleValue(edge(id)));
+    });
+    radixSort(keys, _sortedElements);
+  } else if (auto *strProp = dynamic_cast<StringProperty *>(prop); strProp && nbElts) {
+    // only the distinct value identifiers are sorted, which are the distinct strings
+    // when the values are interned, then the elements are radix sorted
+    // according to the rank of their value
+    std::vector<uint64_t> keys(nbElts);
+    std::unordered_map<const std::string *, uint64_t> ranks;
+
+    for (uint i = 0; i < nbElts; ++i) {
+      uint id = _sortedElements[i];
+      keys[i] = ranks.emplace(nodes ? strProp->getNodeValueId(node(id))
+                                    : strProp->getEdgeValueId(edge(id)),
+                              ranks.size())
+                    .first->second;
+    }
+
+    std::vector<const std::string *> values(ranks.size());
+
+    for (const auto &[value, rank] : ranks) {
+      values[rank] = value;
+    }
 
+    std::vector<uint64_t> sortedRanks(values.size());
+    std::vector<uint> order(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&values](uint a, uint b) { return *values[a] < *values[b]; });
+
+    // the identifiers of equal values have the same rank
+    for (uint i = 0, rank = 0; i < order.size(); ++i) {
+      if (i > 0 && *values[order[i]] != *values[order[i - 1]]) {
+        ++rank;
+      }
+
+      sortedRanks[order[i]] = rank;
+    }
+
+    for (auto &key : keys) {
+      key = sortedRanks[key];
+    }
+
+    radixSort(keys, _sortedElements);
+  } else {
+    std::stable_sort(_sortedElements.begin(), _sortedElements.end(), [&](uint a, uint b) {
+      return (nodes ? prop->compare(node(a), node(b)) : prop->compare(edge(a), edge(b))) < 0;
+    });
+  }
+
+  _sortRanks.assign(nbElts ? maxId + 1 : 0, UINT_MAX);
+
+  for (uint i = 0; i < nbElts; ++i) {
+    _sortRanks[_sortedElements[i]] = i;
+  }
+
+  _sortIndexValid = true;
+  _sortIndexUpdates = 0;
+}
+
+void GraphSortFilterProxyModel::updateSortIndex(uint id) {
+  if (!_sortIndexValid) {
+    return;
+  }
+
+  if (id >= _sortRanks.size() || _sortRanks[id] == UINT_MAX) {
+    _sortIndexValid = false;
+    return;
+  }
+
+  // each move costs a linear time so when many values are set one by one,
+  // the index is rather rebuilt once on the next comparison
+  if (++_sortIndexUpdates > MAX_SORT_INDEX_UPDATES) {
+    _sortIndexValid = false;
+    return;
+  }
+
+  // move the element to its new position
+  uint oldPos = _sortRanks[id];
+  _sortedElements.erase(_sortedElements.begin() + oldPos);
+  auto it = std::lower_bound(_sortedElements.begin(), _sortedElements.end(), id,
+                             [this](uint a, uint b) { return elementLessThan(a, b); });
+  uint newPos = it - _sortedElements.begin();
+  _sortedElements.insert(it, id);
+
+  for (uint i = std::min(oldPos, newPos); i <= std::max(oldPos, newPos); ++i) {
+    _sortRanks[_sortedElements[i]] = i;
+  }
+}
+
+void GraphSortFilterProxyModel::clearSortIndex() {
+  if (_sortProperty != nullptr) {
+    _sortProperty->removeListener(this);
+    _sortProperty = nullptr;
+  }
+
+  if (_sortGraph != nullptr) {
+    _sortGraph->removeListener(this);
+    _sortGraph = nullptr;
+  }
+
+  _sortIndexValid = false;
+  _sortedElements.clear();
+  _sortRanks.clear();
+}
+
+// the mapping of QSortFilterProxyModel being private, Qt still sorts the rows
+// through this comparison, but it only compares the ranks of the sort index
 bool GraphSortFilterProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const {
   auto *graphModel = static_cast<GraphModel *>(sourceModel());
-  return graphModel->lessThan(graphModel->elementAt(left.row()), graphModel->elementAt(right.row()),
-                              static_cast<PropertyInterface *>(left.internalPointer()));
+  auto *prop = static_cast<PropertyInterface *>(left.internalPointer());
+  uint a = graphModel->elementAt(left.row());
+  uint b = graphModel->elementAt(right.row());
+
+  if (prop != _sortProperty || !_sortIndexValid || graphModel->graph() != _sortGraph) {
+    buildSortIndex(prop);
+  }
+
+  if (a < _sortRanks.size() && b < _sortRanks.size() && _sortRanks[a] != UINT_MAX &&
+      _sortRanks[b] != UINT_MAX) {
+    return _sortRanks[a] < _sortRanks[b];
+  }
+
+  return graphModel->lessThan(a, b, prop);
 }
 void GraphSortFilterProxyModel::setProperties(QVector<PropertyInterface *> properties) {
   _properties = properties;
@@ -936,6 +1199,69 @@ void GraphSortFilterProxyModel::treatEvent(const Event &e) {
   if (e.sender() == _filterProperty) {
     invalidateFilter();
   }
+
+  if (e.sender() == _sortProperty || e.sender() == _sortGraph) {
+    if (sourceModel() == nullptr) {
+      clearSortIndex();
+    } else if (e.type() == Event::TLP_DELETE) {
+      if (e.sender() == _sortProperty) {
+        _sortProperty = nullptr;
+      } else {
+        _sortGraph = nullptr;
+      }
+
+      clearSortIndex();
+    } else if (const auto *propEv = dynamic_cast<const PropertyEvent *>(&e)) {
+      bool nodes = _sortNodes;
+
+      switch (propEv->getType()) {
+      case PropertyEvent::TLP_AFTER_SET_NODE_VALUE:
+        if (nodes) {
+          updateSortIndex(propEv->getNode().id);
+        }
+        break;
+
+      case PropertyEvent::TLP_AFTER_SET_EDGE_VALUE:
+        if (!nodes) {
+          updateSortIndex(propEv->getEdge().id);
+        }
+        break;
+
+      case PropertyEvent::TLP_AFTER_SET_NODES_VALUES:
+        if (nodes) {
+          _sortIndexValid = false;
+        }
+        break;
+
+      case PropertyEvent::TLP_AFTER_SET_EDGES_VALUES:
+        if (!nodes) {
+          _sortIndexValid = false;
+        }
+        break;
+
+      case PropertyEvent::TLP_AFTER_SET_ALL_NODE_VALUE:
+      case PropertyEvent::TLP_AFTER_SET_ALL_EDGE_VALUE:
+        _sortIndexValid = false;
+        break;
+
+      default:
+        break;
+      }
+    } else if (const auto *graphEv = dynamic_cast<const GraphEvent *>(&e)) {
+      switch (graphEv->getType()) {
+      case GraphEvent::TLP_ADD_NODE:
+      case GraphEvent::TLP_ADD_NODES:
+      case GraphEvent::TLP_ADD_EDGE:
+      case GraphEvent::TLP_ADD_EDGES:
+        // the new elements will be indexed on the next sort
+        _sortIndexValid = false;
+        break;
+
+      default:
+        break;
+      }
+    }
+  }
 }
 
 BooleanProperty *GraphSortFilterProxyModel::filterProperty() const {
@@ -1106,6 +1432,7 @@ void NodesGraphModel::treatEvent(const Event &ev) {
     }
   } else if (propEv) {
     if (propEv->getType() == PropertyEvent::TLP_AFTER_SET_NODE_VALUE ||
+        propEv->getType() == PropertyEvent::TLP_AFTER_SET_NODES_VALUES ||
         propEv->getType() == PropertyEvent::TLP_AFTER_SET_ALL_NODE_VALUE) {
       _propertiesModified.insert(propEv->getProperty());
     }
@@ -1191,6 +1518,7 @@ void EdgesGraphModel::treatEvent(const Event &ev) {
     }
   } else if (propEv) {
     if (propEv->getType() == PropertyEvent::TLP_AFTER_SET_EDGE_VALUE ||
+        propEv->getType() == PropertyEvent::TLP_AFTER_SET_EDGES_VALUES ||
         propEv->getType() == PropertyEvent::TLP_AFTER_SET_ALL_EDGE_VALUE) {
       _propertiesModified.insert(propEv->getProperty());
     }
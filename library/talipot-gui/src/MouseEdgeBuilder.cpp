@@ -182,8 +182,10 @@ void MouseEdgeBuilder::treatEvent(const Event &evt) {
   } else {
     const auto *propertyEvent = dynamic_cast<const PropertyEvent *>(&evt);
 
-    if (propertyEvent && propertyEvent->getType() == PropertyEvent::TLP_AFTER_SET_NODE_VALUE &&
-        propertyEvent->getNode() == _source && propertyEvent->getProperty() == _layoutProperty) {
+    if (propertyEvent && propertyEvent->getProperty() == _layoutProperty &&
+        ((propertyEvent->getType() == PropertyEvent::TLP_AFTER_SET_NODE_VALUE &&
+          propertyEvent->getNode() == _source) ||
+         propertyEvent->getType() == PropertyEvent::TLP_AFTER_SET_NODES_VALUES)) {
       _startPos = _layoutProperty->getNodeValue(_source);
     }
   }
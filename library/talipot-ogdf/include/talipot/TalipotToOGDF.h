@@ -20,10 +20,10 @@
 
 #include <ogdf/basic/GraphAttributes.h>
 
-#include <unordered_map>
 #include <vector>
 
 namespace tlp {
+class LayoutProperty;
 class NumericProperty;
 class SizeProperty;
 
@@ -44,26 +44,53 @@ public:
   }
 
   ogdf::node getOGDFGraphNode(node nTlp) {
-    return ogdfNodes[nTlp];
+    return ogdfNodes[talipotGraph->nodePos(nTlp)];
   }
 
   ogdf::edge getOGDFGraphEdge(edge eTlp) {
-    return ogdfEdges[eTlp];
+    return ogdfEdges[talipotGraph->edgePos(eTlp)];
   }
 
+  /**
+   * @brief Resets the attributes of the OGDF graph from the properties of the Talipot graph,
+   * as done at construction, so the OGDF graph can be reused by another layout algorithm.
+   */
+  void updateOGDFGraphAttr();
+
+  /**
+   * @brief Returns true if the OGDF graph has still been built from the current nodes
+   * and edges of the Talipot graph and has not been made simple.
+   * The changes of the ends of the edges are not checked.
+   */
+  bool isOGDFGraphUpToDate() const;
+
   void makeOGDFGraphSimple();
 
   Coord getNodeCoordFromOGDFGraphAttr(node n);
   std::vector<Coord> getEdgeCoordFromOGDFGraphAttr(edge e);
 
+  /**
+   * @brief Copies the coordinates of the nodes and the bends of the edges
+   * computed by an OGDF layout algorithm into a layout property.
+   * The values are set in bulk, so only one event is sent for the nodes and one for the edges.
+   */
+  void copyOGDFLayoutToTlpLayout(LayoutProperty *layout);
+
   void copyTlpNumericPropertyToOGDFEdgeLength(NumericProperty *);
   void copyTlpNumericPropertyToOGDFNodeWeight(NumericProperty *);
   void copyTlpNodeSizeToOGDF(SizeProperty *);
 
 private:
   Graph *talipotGraph;
-  std::unordered_map<node, ogdf::node> ogdfNodes;
-  std::unordered_map<edge, ogdf::edge> ogdfEdges;
+  bool importEdgeBends;
+  bool simple;
+  // the nodes and edges of the Talipot graph the OGDF graph has been built from
+  std::vector<node> tlpNodes;
+  std::vector<edge> tlpEdges;
+  // the OGDF nodes and edges indexed by the positions of the Talipot ones,
+  // the removed OGDF edges are null
+  std::vector<ogdf::node> ogdfNodes;
+  std::vector<ogdf::edge> ogdfEdges;
   ogdf::Graph ogdfGraph;
   ogdf::GraphAttributes ogdfGraphAttributes;
 };
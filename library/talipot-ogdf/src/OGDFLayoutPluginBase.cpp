@@ -17,17 +17,109 @@
 #include <ogdf/packing/ComponentSplitterLayout.h>
 
 #include <talipot/DrawingTools.h>
+#include <talipot/ParallelTools.h>
 
 using namespace std;
 using namespace tlp;
 
+TLP_DEFINE_GLOBAL_LOCK(OGDFGraphCacheLock);
+
+namespace {
+
+// Keeps the OGDF graph built for the last laid out Talipot graph,
+// so consecutive OGDF layouts of a graph whose topology is unchanged
+// do not need to convert it again.
+// The cached converter is given to one plugin at a time,
+// and released as soon as the topology of its graph changes.
+class OGDFGraphCache : public Observable {
+public:
+  // returns the converter of g, the caller takes its ownership
+  TalipotToOGDF *take(Graph *g) {
+    TalipotToOGDF *cached = nullptr;
+
+    TLP_GLOBALLY_LOCK_SECTION(OGDFGraphCacheLock) {
+      if (converter && converter->getTalipotGraph() == g) {
+        cached = converter;
+        converter = nullptr;
+        g->removeListener(this);
+      }
+    }
+    TLP_GLOBALLY_UNLOCK_SECTION(OGDFGraphCacheLock);
+
+    if (cached && cached->isOGDFGraphUpToDate()) {
+      cached->updateOGDFGraphAttr();
+      return cached;
+    }
+
+    delete cached;
+    return new TalipotToOGDF(g, false);
+  }
+
+  // keeps a converter for the next layout of its graph
+  void keep(TalipotToOGDF *tlpToOGDF) {
+    if (!tlpToOGDF->isOGDFGraphUpToDate()) {
+      delete tlpToOGDF;
+      return;
+    }
+
+    TalipotToOGDF *released = tlpToOGDF;
+
+    TLP_GLOBALLY_LOCK_SECTION(OGDFGraphCacheLock) {
+      std::swap(converter, released);
+
+      if (released) {
+        released->getTalipotGraph()->removeListener(this);
+      }
+
+      converter->getTalipotGraph()->addListener(this);
+    }
+    TLP_GLOBALLY_UNLOCK_SECTION(OGDFGraphCacheLock);
+
+    delete released;
+  }
+
+  void treatEvent(const Event &evt) override {
+    const auto *gEvt = dynamic_cast<const GraphEvent *>(&evt);
+
+    if (evt.type() == Event::TLP_DELETE ||
+        (gEvt && gEvt->getType() <= GraphEvent::TLP_ADD_EDGES)) {
+      TalipotToOGDF *released = nullptr;
+
+      TLP_GLOBALLY_LOCK_SECTION(OGDFGraphCacheLock) {
+        if (converter && converter->getTalipotGraph() == evt.sender()) {
+          released = converter;
+          converter = nullptr;
+
+          if (evt.type() != Event::TLP_DELETE) {
+            released->getTalipotGraph()->removeListener(this);
+          }
+        }
+      }
+      TLP_GLOBALLY_UNLOCK_SECTION(OGDFGraphCacheLock);
+
+      delete released;
+    }
+  }
+
+private:
+  TalipotToOGDF *converter = nullptr;
+};
+
+// the cache is never destroyed as the graphs may be deleted at exit after the static objects
+OGDFGraphCache &ogdfGraphCache() {
+  static auto *cache = new OGDFGraphCache();
+  return *cache;
+}
+}
+
 OGDFLayoutPluginBase::OGDFLayoutPluginBase(const PluginContext *context,
                                            ogdf::LayoutModule *ogdfLayoutAlgo)
     : LayoutAlgorithm(context), tlpToOGDF(nullptr), ogdfLayoutAlgo(ogdfLayoutAlgo),
       componentSplitterLayout(ogdfLayoutAlgo ? new ogdf::ComponentSplitterLayout : nullptr) {
-  // convert Tulip Graph to OGDF Graph including attributes
+  // convert Tulip Graph to OGDF Graph including attributes,
+  // or reuse the one converted for a previous layout of the graph
   if (graph) {
-    tlpToOGDF = new TalipotToOGDF(graph, false);
+    tlpToOGDF = ogdfGraphCache().take(graph);
   }
   if (ogdfLayoutAlgo) {
     // ComponentSplitterLayout takes ownership of the LayoutModule instance
@@ -36,7 +128,10 @@ OGDFLayoutPluginBase::OGDFLayoutPluginBase(const PluginContext *context,
 }
 
 OGDFLayoutPluginBase::~OGDFLayoutPluginBase() {
-  delete tlpToOGDF;
+  if (tlpToOGDF) {
+    ogdfGraphCache().keep(tlpToOGDF);
+  }
+
   delete componentSplitterLayout;
 }
 
@@ -98,18 +193,9 @@ bool OGDFLayoutPluginBase::run() {
     return false;
   }
 
-  // retrieve nodes coordinates computed by the OGDF Layout Algorithm
+  // retrieve nodes coordinates and edges bends computed by the OGDF Layout Algorithm
   // and store them in the Tulip Layout Property
-  for (auto n : graph->nodes()) {
-    Coord nodeCoord = tlpToOGDF->getNodeCoordFromOGDFGraphAttr(n);
-    result->setNodeValue(n, nodeCoord);
-  }
-
-  // same operation as above but with edges
-  for (auto e : graph->edges()) {
-    vector<Coord> edgeCoord = tlpToOGDF->getEdgeCoordFromOGDFGraphAttr(e);
-    result->setEdgeValue(e, edgeCoord);
-  }
+  tlpToOGDF->copyOGDFLayoutToTlpLayout(result);
 
   afterCall();
 
@@ -15,13 +15,33 @@
 #include <talipot/LayoutProperty.h>
 #include <talipot/SizeProperty.h>
 #include <talipot/NumericProperty.h>
+#include <talipot/ParallelTools.h>
 #include <talipot/SimpleTest.h>
 
 using namespace std;
 using namespace tlp;
 
-TalipotToOGDF::TalipotToOGDF(Graph *g, bool importEdgeBends) : talipotGraph(g) {
+TalipotToOGDF::TalipotToOGDF(Graph *g, bool importEdgeBends)
+    : talipotGraph(g), importEdgeBends(importEdgeBends), simple(false), tlpNodes(g->nodes()),
+      tlpEdges(g->edges()) {
 
+  ogdfNodes.reserve(tlpNodes.size());
+
+  for (uint i = 0; i < tlpNodes.size(); ++i) {
+    ogdfNodes.push_back(ogdfGraph.newNode());
+  }
+
+  ogdfEdges.reserve(tlpEdges.size());
+
+  for (auto eTlp : tlpEdges) {
+    const auto &[srcTlp, tgtTlp] = talipotGraph->ends(eTlp);
+    ogdfEdges.push_back(ogdfGraph.newEdge(getOGDFGraphNode(srcTlp), getOGDFGraphNode(tgtTlp)));
+  }
+
+  updateOGDFGraphAttr();
+}
+
+void TalipotToOGDF::updateOGDFGraphAttr() {
   // needed to initialize some ogdfAttributes fields
   long attributes =
       // x, y, width, height fields
@@ -35,46 +55,48 @@ TalipotToOGDF::TalipotToOGDF(Graph *g, bool importEdgeBends) : talipotGraph(g) {
       // z coordinate
       ogdf::GraphAttributes::threeD;
 
+  // the attributes are reset to their default values,
+  // the edge weights being set to 1.0
   ogdfGraphAttributes = ogdf::GraphAttributes(ogdfGraph, attributes);
 
   SizeProperty *sizeProp = talipotGraph->getSizeProperty("viewSize");
   LayoutProperty *layoutProp = talipotGraph->getLayoutProperty("viewLayout");
 
-  for (auto nTlp : talipotGraph->nodes()) {
-    ogdf::node nOGDF = ogdfGraph.newNode();
-    ogdfNodes[nTlp] = nOGDF;
-    const Coord &c = layoutProp->getNodeValue(nTlp);
+  TLP_PARALLEL_MAP_INDICES(tlpNodes.size(), [&](uint i) {
+    ogdf::node nOGDF = ogdfNodes[i];
+    const Coord &c = layoutProp->getNodeValue(tlpNodes[i]);
     ogdfGraphAttributes.x(nOGDF) = c.getX();
     ogdfGraphAttributes.y(nOGDF) = c.getY();
     ogdfGraphAttributes.z(nOGDF) = c.getZ();
-    const Size &s = sizeProp->getNodeValue(nTlp);
+    const Size &s = sizeProp->getNodeValue(tlpNodes[i]);
     ogdfGraphAttributes.width(nOGDF) = s.getW();
     ogdfGraphAttributes.height(nOGDF) = s.getH();
-  }
+  });
 
-  for (auto eTlp : talipotGraph->edges()) {
-    const auto &[srcTlp, tgtTlp] = talipotGraph->ends(eTlp);
-    ogdf::edge eOGDF = ogdfGraph.newEdge(ogdfNodes[srcTlp], ogdfNodes[tgtTlp]);
-    ogdfEdges[eTlp] = eOGDF;
+  if (importEdgeBends) {
+    for (uint i = 0; i < tlpEdges.size(); ++i) {
+      ogdf::edge eOGDF = ogdfEdges[i];
 
-    if (importEdgeBends) {
+      if (eOGDF == nullptr) {
+        continue;
+      }
 
-      const vector<Coord> &v = layoutProp->getEdgeValue(eTlp);
-      ogdf::DPolyline bends;
+      const vector<Coord> &v = layoutProp->getEdgeValue(tlpEdges[i]);
+      ogdf::DPolyline &bends = ogdfGraphAttributes.bends(eOGDF);
 
       for (const auto &coord : v) {
         bends.pushBack(ogdf::DPoint(coord.getX(), coord.getY()));
       }
-
-      ogdfGraphAttributes.bends(eOGDF) = bends;
     }
-
-    ogdfGraphAttributes.doubleWeight(eOGDF) = 1.0;
   }
 }
 
+bool TalipotToOGDF::isOGDFGraphUpToDate() const {
+  return !simple && talipotGraph->nodes() == tlpNodes && talipotGraph->edges() == tlpEdges;
+}
+
 Coord TalipotToOGDF::getNodeCoordFromOGDFGraphAttr(node nTlp) {
-  ogdf::node n = ogdfNodes[nTlp];
+  ogdf::node n = getOGDFGraphNode(nTlp);
 
   double x = ogdfGraphAttributes.x(n);
   double y = ogdfGraphAttributes.y(n);
@@ -85,10 +107,9 @@ Coord TalipotToOGDF::getNodeCoordFromOGDFGraphAttr(node nTlp) {
 
 vector<Coord> TalipotToOGDF::getEdgeCoordFromOGDFGraphAttr(edge eTlp) {
   vector<Coord> v;
-  if (ogdfEdges.find(eTlp) != ogdfEdges.end()) {
-
-    ogdf::edge e = ogdfEdges[eTlp];
+  ogdf::edge e = getOGDFGraphEdge(eTlp);
 
+  if (e != nullptr) {
     for (const auto &bend : ogdfGraphAttributes.bends(e)) {
       v.push_back(Coord(bend.m_x, bend.m_y));
     }
@@ -96,13 +117,38 @@ vector<Coord> TalipotToOGDF::getEdgeCoordFromOGDFGraphAttr(edge eTlp) {
   return v;
 }
 
+void TalipotToOGDF::copyOGDFLayoutToTlpLayout(LayoutProperty *layout) {
+  vector<Coord> coords(tlpNodes.size());
+  TLP_PARALLEL_MAP_INDICES(tlpNodes.size(), [&](uint i) {
+    ogdf::node n = ogdfNodes[i];
+    coords[i] = Coord(ogdfGraphAttributes.x(n), ogdfGraphAttributes.y(n), ogdfGraphAttributes.z(n));
+  });
+  layout->setNodeValues(tlpNodes, coords);
+
+  vector<vector<Coord>> bends(tlpEdges.size());
+  TLP_PARALLEL_MAP_INDICES(tlpEdges.size(), [&](uint i) {
+    ogdf::edge e = ogdfEdges[i];
+
+    if (e != nullptr) {
+      for (const auto &bend : ogdfGraphAttributes.bends(e)) {
+        bends[i].push_back(Coord(bend.m_x, bend.m_y));
+      }
+    }
+  });
+  layout->setEdgeValues(tlpEdges, bends);
+}
+
 void TalipotToOGDF::copyTlpNumericPropertyToOGDFEdgeLength(NumericProperty *metric) {
   if (!metric) {
     return;
   }
 
-  for (auto eTlp : talipotGraph->edges()) {
-    ogdfGraphAttributes.doubleWeight(ogdfEdges[eTlp]) = metric->getEdgeDoubleValue(eTlp);
+  // the weights are updated sequentially
+  // as the edges of a simplified graph may be shared
+  for (uint i = 0; i < tlpEdges.size(); ++i) {
+    if (ogdfEdges[i] != nullptr) {
+      ogdfGraphAttributes.doubleWeight(ogdfEdges[i]) = metric->getEdgeDoubleValue(tlpEdges[i]);
+    }
   }
 }
 
@@ -111,21 +157,26 @@ void TalipotToOGDF::copyTlpNodeSizeToOGDF(SizeProperty *size) {
     return;
   }
 
-  for (auto nTlp : talipotGraph->nodes()) {
-    const Size &s = size->getNodeValue(nTlp);
-    ogdf::node nOGDF = ogdfNodes[nTlp];
+  TLP_PARALLEL_MAP_INDICES(tlpNodes.size(), [&](uint i) {
+    const Size &s = size->getNodeValue(tlpNodes[i]);
+    ogdf::node nOGDF = ogdfNodes[i];
     ogdfGraphAttributes.width(nOGDF) = s.getW();
     ogdfGraphAttributes.height(nOGDF) = s.getH();
-  }
+  });
 
-  for (auto eTlp : talipotGraph->edges()) {
-    const auto &[srcTlp, tgtTlp] = talipotGraph->ends(eTlp);
-    ogdf::node srcOGDF = ogdfNodes[srcTlp];
+  // the weights are updated sequentially
+  // as the edges of a simplified graph may be shared
+  for (uint i = 0; i < tlpEdges.size(); ++i) {
+    ogdf::edge eOGDF = ogdfEdges[i];
+
+    if (eOGDF == nullptr) {
+      continue;
+    }
+
+    const auto &[srcTlp, tgtTlp] = talipotGraph->ends(tlpEdges[i]);
     const Size &sSrc = size->getNodeValue(srcTlp);
-    ogdf::node tgtOGDF = ogdfNodes[tgtTlp];
     const Size &sTgt = size->getNodeValue(tgtTlp);
 
-    ogdf::edge eOGDF = ogdfEdges[eTlp];
     ogdfGraphAttributes.doubleWeight(eOGDF) =
         ogdfGraphAttributes.doubleWeight(eOGDF) + sSrc.getW() / 2. + sTgt.getW() / 2. - 1.;
   }
@@ -136,26 +187,29 @@ void TalipotToOGDF::copyTlpNumericPropertyToOGDFNodeWeight(NumericProperty *metr
     return;
   }
 
-  for (auto nTlp : talipotGraph->nodes()) {
-    ogdfGraphAttributes.weight(ogdfNodes[nTlp]) = int(metric->getNodeDoubleValue(nTlp));
-  }
+  TLP_PARALLEL_MAP_INDICES(tlpNodes.size(), [&](uint i) {
+    ogdfGraphAttributes.weight(ogdfNodes[i]) = int(metric->getNodeDoubleValue(tlpNodes[i]));
+  });
 }
 
 void TalipotToOGDF::makeOGDFGraphSimple() {
   auto [loops, parallelEdges] = SimpleTest::getLoopsAndParallelEdges(talipotGraph);
+  simple = true;
 
   for (auto e : loops) {
-    ogdfGraph.delEdge(ogdfEdges[e]);
-    ogdfEdges.erase(e);
+    uint pos = talipotGraph->edgePos(e);
+    ogdfGraph.delEdge(ogdfEdges[pos]);
+    ogdfEdges[pos] = nullptr;
   }
 
   for (auto e : parallelEdges) {
     auto [src, tgt] = talipotGraph->ends(e);
     auto ee = talipotGraph->existEdge(src, tgt, false);
+    uint pos = talipotGraph->edgePos(e);
     // an edge can be a loop and a paralell one
-    if (ogdfEdges.find(e) != ogdfEdges.end()) {
-      ogdfGraph.delEdge(ogdfEdges[e]);
-      ogdfEdges[e] = ogdfEdges[ee];
+    if (ogdfEdges[pos] != nullptr) {
+      ogdfGraph.delEdge(ogdfEdges[pos]);
+      ogdfEdges[pos] = getOGDFGraphEdge(ee);
     }
   }
 }
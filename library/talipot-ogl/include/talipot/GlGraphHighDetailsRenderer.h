@@ -57,6 +57,10 @@ protected:
 
   GlLODCalculator *lodCalculator;
 
+  // cache of the metric ordering of the visible elements
+  struct MetricOrderingCache;
+  MetricOrderingCache *metricOrderingCache;
+
   GlScene *baseScene;
   GlScene *fakeScene;
   Vec4i selectionViewport;
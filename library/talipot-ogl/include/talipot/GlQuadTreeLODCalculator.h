@@ -104,6 +104,24 @@ protected:
 
   void setHaveToCompute();
 
+  // incremental updates of the graph elements quadtrees,
+  // they fall back to a full rebuild when an element cannot be updated
+  BoundingBox getBoundingBox(node n) const;
+  BoundingBox getBoundingBox(edge e) const;
+  void insertElement(node n);
+  void insertElement(edge e);
+  void removeElement(node n);
+  void removeElement(edge e);
+  // counts the elements about to be updated, returns false if the quadtrees
+  // have to be rebuilt instead
+  bool countElementsUpdates(uint nbElements);
+  // removes the element (and its incident edges) whose bounding box is going to change
+  void beginElementUpdate(node n);
+  void beginElementUpdate(edge e);
+  // inserts the elements removed by beginElementUpdate
+  void endElementsUpdate();
+  void elementsUpdated();
+
   std::vector<QuadTreeNode<uint> *> nodesQuadTree;
   std::vector<QuadTreeNode<uint> *> edgesQuadTree;
   std::vector<QuadTreeNode<GlEntity *> *> entitiesQuadTree;
@@ -128,6 +146,13 @@ protected:
 
   int quadTreesVectorPosition;
   int entitiesVectorPosition;
+  // position of the quadtrees containing the graph elements, -1 if none
+  int graphQuadTreesPosition;
+  // elements being updated
+  std::vector<node> updatedNodes;
+  std::vector<edge> updatedEdges;
+  // number of elements updated since the last rebuild of the quadtrees
+  uint nbElementsUpdates;
 };
 }
 
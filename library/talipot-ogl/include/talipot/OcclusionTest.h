@@ -14,6 +14,8 @@
 #ifndef TALIPOT_OCCLUSION_TEST_H
 #define TALIPOT_OCCLUSION_TEST_H
 
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 #include <talipot/Rectangle.h>
@@ -27,15 +29,23 @@ typedef Rectangle<int> RectangleInt2D;
  *
  * That class enables to store a set of non overlapping 2D AABB.
  *
- * @todo Use the Talipot quadtree to store AABB and thus speedup testRectangle function
+ * The AABB are indexed in a uniform grid whose cells are CELL_SIZE pixels wide,
+ * so testing a new AABB only requires to check the ones sharing a cell with it.
+ * The AABB covering too many cells are stored apart and always checked.
  */
 struct TLP_GL_SCOPE OcclusionTest {
+  static constexpr int CELL_SIZE = 64;
+  static constexpr int MAX_NB_CELLS = 64;
+
   std::vector<RectangleInt2D> data;
+
   /**
    * Remove all 2D AABB previously added.
    */
   void clear() {
     data.clear();
+    cells.clear();
+    largeRectangles.clear();
   }
   /**
    * Add a new 2D AABB to the set of non overlapping AABB
@@ -47,7 +57,16 @@ struct TLP_GL_SCOPE OcclusionTest {
    */
   bool addRectangle(const RectangleInt2D &rec) {
     if (!testRectangle(rec)) {
+      uint idx = data.size();
       data.push_back(rec);
+
+      if (!forEachCell(rec, [&](uint64_t cell) {
+            cells[cell].push_back(idx);
+            return false;
+          })) {
+        largeRectangles.push_back(idx);
+      }
+
       return true;
     }
 
@@ -59,14 +78,71 @@ struct TLP_GL_SCOPE OcclusionTest {
    * @return true if the AABB intersect else false.
    */
   bool testRectangle(const RectangleInt2D &rec) {
-    for (const auto &r : data) {
-      if (rec.intersect(r)) {
+    for (auto idx : largeRectangles) {
+      if (rec.intersect(data[idx])) {
         return true;
       }
     }
 
-    return false;
+    bool intersect = false;
+
+    if (!forEachCell(rec, [&](uint64_t cell) {
+          auto it = cells.find(cell);
+
+          if (it != cells.end()) {
+            for (auto idx : it->second) {
+              if (rec.intersect(data[idx])) {
+                intersect = true;
+                return true;
+              }
+            }
+          }
+
+          return false;
+        })) {
+      // too many cells to visit, check all the AABB
+      for (const auto &r : data) {
+        if (rec.intersect(r)) {
+          return true;
+        }
+      }
+    }
+
+    return intersect;
   }
+
+private:
+  // index of the cell containing the coordinate c
+  static int cellIndex(int c) {
+    return c >= 0 ? c / CELL_SIZE : -((-c - 1) / CELL_SIZE) - 1;
+  }
+
+  // calls f on the cells covered by rec until it returns true,
+  // returns false if rec covers more than MAX_NB_CELLS cells
+  template <typename F>
+  static bool forEachCell(const RectangleInt2D &rec, const F &f) {
+    int xMin = cellIndex(rec[0][0]), xMax = cellIndex(rec[1][0]);
+    int yMin = cellIndex(rec[0][1]), yMax = cellIndex(rec[1][1]);
+
+    if (int64_t(xMax - xMin + 1) * (yMax - yMin + 1) > MAX_NB_CELLS) {
+      return false;
+    }
+
+    for (int x = xMin; x <= xMax; ++x) {
+      for (int y = yMin; y <= yMax; ++y) {
+        if (f((uint64_t(uint32_t(x)) << 32) | uint32_t(y))) {
+          return true;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  // indices in data of the AABB covering each cell
+  std::unordered_map<uint64_t, std::vector<uint>> cells;
+  // indices in data of the AABB covering too many cells
+  std::vector<uint> largeRectangles;
 };
 }
 
@@ -140,7 +140,8 @@ void GlGraph::treatEvent(const Event &evt) {
   } else {
     const auto *propertyEvent = dynamic_cast<const PropertyEvent *>(&evt);
 
-    if (propertyEvent && propertyEvent->getType() == PropertyEvent::TLP_AFTER_SET_NODE_VALUE) {
+    if (propertyEvent && (propertyEvent->getType() == PropertyEvent::TLP_AFTER_SET_NODE_VALUE ||
+                          propertyEvent->getType() == PropertyEvent::TLP_AFTER_SET_NODES_VALUES)) {
       nodesModified = true;
     }
   }
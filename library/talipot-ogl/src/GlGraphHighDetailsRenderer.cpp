@@ -110,24 +110,107 @@ struct entityWithDistanceCompare {
 
 const GlGraphInputData *entityWithDistanceCompare::inputData = nullptr;
 
-/** \brief Comparator to order entities with metric to display labels with metric ordering
- * Comparator to order entities with metric to display labels with metric ordering
+/** \brief Cache of the metric ordering of the visible elements
+ * The elements to draw are ordered by decreasing metric values. As they are
+ * enumerated in the same order from one frame to another while the view does not change,
+ * the computed order is kept until the visible elements or the metric values change.
  */
-class GreatThanNode {
-public:
-  NumericProperty *metric;
-  bool operator()(pair<node, float> n1, pair<node, float> n2) const {
-    return (metric->getNodeDoubleValue(n1.first) > metric->getNodeDoubleValue(n2.first));
+struct GlGraphHighDetailsRenderer::MetricOrderingCache : public Observable {
+  // the different lists of elements that are ordered
+  enum OrderedElements {
+    NODES = 0,
+    EDGES,
+    SELECTED_NODES_LABELS,
+    NODES_LABELS,
+    SELECTED_EDGES_LABELS,
+    EDGES_LABELS,
+    NB_ORDERED_ELEMENTS
+  };
+
+  struct Ordering {
+    // ids of the elements in their enumeration order
+    vector<uint> ids;
+    // the metric ordering as positions in ids
+    vector<uint> order;
+  };
+
+  NumericProperty *metric = nullptr;
+  Ordering orderings[NB_ORDERED_ELEMENTS];
+
+  ~MetricOrderingCache() override {
+    setMetric(nullptr);
   }
-};
-/** \brief Comparator to order entities with metric to display labels with metric ordering
- * Comparator to order entities with metric to display labels with metric ordering
- */
-class GreatThanEdge {
-public:
-  NumericProperty *metric;
-  bool operator()(pair<edge, float> e1, pair<edge, float> e2) const {
-    return (metric->getEdgeDoubleValue(e1.first) > metric->getEdgeDoubleValue(e2.first));
+
+  void invalidate() {
+    for (auto &ordering : orderings) {
+      ordering.ids.clear();
+    }
+  }
+
+  void setMetric(NumericProperty *newMetric) {
+    if (newMetric != metric) {
+      if (metric) {
+        metric->removeListener(this);
+      }
+
+      metric = newMetric;
+
+      if (metric) {
+        metric->addListener(this);
+      }
+
+      invalidate();
+    }
+  }
+
+  void treatEvent(const Event &ev) override {
+    if (ev.type() == Event::TLP_DELETE) {
+      metric = nullptr;
+    }
+
+    invalidate();
+  }
+
+  // orders elts by decreasing metric values
+  template <typename ELT_TYPE>
+  void sort(vector<pair<ELT_TYPE, float>> &elts, OrderedElements orderedElements) {
+    Ordering &ordering = orderings[orderedElements];
+    uint nbElts = elts.size();
+    bool sameElements = !ordering.ids.empty() && ordering.ids.size() == nbElts;
+
+    for (uint i = 0; sameElements && i < nbElts; ++i) {
+      sameElements = ordering.ids[i] == elts[i].first.id;
+    }
+
+    if (!sameElements) {
+      ordering.ids.resize(nbElts);
+      ordering.order.resize(nbElts);
+      vector<double> values(nbElts);
+
+      for (uint i = 0; i < nbElts; ++i) {
+        ELT_TYPE elt = elts[i].first;
+        ordering.ids[i] = elt.id;
+        ordering.order[i] = i;
+
+        if constexpr (std::is_same_v<ELT_TYPE, node>) {
+          values[i] = metric->getNodeDoubleValue(elt);
+        } else {
+          values[i] = metric->getEdgeDoubleValue(elt);
+        }
+      }
+
+      std::sort(ordering.order.begin(), ordering.order.end(),
+                [&](uint i, uint j) { return values[i] > values[j]; });
+    }
+
+    // the lods of the elements may have changed
+    vector<pair<ELT_TYPE, float>> orderedElts(nbElts);
+
+    for (uint i = 0; i < nbElts; ++i) {
+      orderedElts[i] = elts[ordering.order[i]];
+    }
+
+    elts.swap(orderedElts);
   }
 };
 
@@ -138,14 +221,15 @@ public:
 //===================================================================
 
 GlGraphHighDetailsRenderer::GlGraphHighDetailsRenderer(const GlGraphInputData *inputData)
-    : GlGraphRenderer(inputData), lodCalculator(nullptr), baseScene(nullptr),
-      fakeScene(new GlScene) {
+    : GlGraphRenderer(inputData), lodCalculator(nullptr),
+      metricOrderingCache(new MetricOrderingCache), baseScene(nullptr), fakeScene(new GlScene) {
   fakeScene->createLayer("fakeLayer");
 }
 //===================================================================
 GlGraphHighDetailsRenderer::GlGraphHighDetailsRenderer(const GlGraphInputData *inputData,
                                                        GlScene *scene)
-    : GlGraphRenderer(inputData), lodCalculator(nullptr), baseScene(scene), fakeScene(new GlScene) {
+    : GlGraphRenderer(inputData), lodCalculator(nullptr),
+      metricOrderingCache(new MetricOrderingCache), baseScene(scene), fakeScene(new GlScene) {
   fakeScene->createLayer("fakeLayer");
 }
 //===================================================================
@@ -156,6 +240,8 @@ GlGraphHighDetailsRenderer::~GlGraphHighDetailsRenderer() {
 
   delete lodCalculator;
 
+  delete metricOrderingCache;
+
   delete fakeScene;
 }
 //===================================================================
@@ -231,6 +317,7 @@ void GlGraphHighDetailsRenderer::draw(float, Camera *camera) {
 
   BooleanProperty *filteringProperty = inputData->parameters->getDisplayFilteringProperty();
   NumericProperty *metric = inputData->parameters->getElementOrderingProperty();
+  metricOrderingCache->setMetric(metric);
   bool displayNodes = inputData->parameters->isDisplayNodes();
   bool displayMetaNodes = inputData->parameters->isDisplayMetaNodes();
   bool displayMetaNodesLabel = inputData->parameters->isViewMetaLabel();
@@ -280,9 +367,7 @@ void GlGraphHighDetailsRenderer::draw(float, Camera *camera) {
 
     if (metric) {
       // Draw nodes with metric ordering
-      GreatThanNode ltn;
-      ltn.metric = metric;
-      sort(nodesMetricOrdered.begin(), nodesMetricOrdered.end(), ltn);
+      metricOrderingCache->sort(nodesMetricOrdered, MetricOrderingCache::NODES);
 
       if (!inputData->renderingParameters()->isElementOrderedDescending()) {
         std::reverse(nodesMetricOrdered.begin(), nodesMetricOrdered.end());
@@ -336,9 +421,7 @@ void GlGraphHighDetailsRenderer::draw(float, Camera *camera) {
 
       if (metric) {
         // Draw edges with metric ordering
-        GreatThanEdge lte;
-        lte.metric = metric;
-        sort(edgesMetricOrdered.begin(), edgesMetricOrdered.end(), lte);
+        metricOrderingCache->sort(edgesMetricOrdered, MetricOrderingCache::EDGES);
 
         if (!inputData->renderingParameters()->isElementOrderedDescending()) {
           reverse(edgesMetricOrdered.begin(), edgesMetricOrdered.end());
@@ -604,9 +687,9 @@ void GlGraphHighDetailsRenderer::drawLabelsForComplexEntities(bool drawSelected,
 
     if (metric) {
       // Draw selected nodes label with metric ordering
-      GreatThanNode ltn;
-      ltn.metric = metric;
-      sort(nodesMetricOrdered.begin(), nodesMetricOrdered.end(), ltn);
+      metricOrderingCache->sort(nodesMetricOrdered,
+                                drawSelected ? MetricOrderingCache::SELECTED_NODES_LABELS
+                                             : MetricOrderingCache::NODES_LABELS);
 
       for (auto it : nodesMetricOrdered) {
         GlNode glNode(node(it.first.id), graph);
@@ -648,9 +731,9 @@ void GlGraphHighDetailsRenderer::drawLabelsForComplexEntities(bool drawSelected,
     if (metric) {
       // Draw selected edges label with metric ordering
 
-      GreatThanEdge lte;
-      lte.metric = metric;
-      sort(edgesMetricOrdered.begin(), edgesMetricOrdered.end(), lte);
+      metricOrderingCache->sort(edgesMetricOrdered,
+                                drawSelected ? MetricOrderingCache::SELECTED_EDGES_LABELS
+                                             : MetricOrderingCache::EDGES_LABELS);
 
       for (auto &it : edgesMetricOrdered) {
         GlEdge glEdge(edge(it.first.id), graph);
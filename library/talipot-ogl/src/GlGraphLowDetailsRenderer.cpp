@@ -240,6 +240,8 @@ void GlGraphLowDetailsRenderer::treatEvent(const Event &ev) {
     case PropertyEvent::TLP_BEFORE_SET_NODE_VALUE:
     case PropertyEvent::TLP_BEFORE_SET_ALL_EDGE_VALUE:
     case PropertyEvent::TLP_BEFORE_SET_EDGE_VALUE:
+    case PropertyEvent::TLP_BEFORE_SET_NODES_VALUES:
+    case PropertyEvent::TLP_BEFORE_SET_EDGES_VALUES:
       buildVBO = true;
       break;
 
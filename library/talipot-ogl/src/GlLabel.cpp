@@ -11,6 +11,9 @@
  *
  */
 
+#include <map>
+#include <tuple>
+
 #ifdef __GNUC__
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
@@ -94,6 +97,21 @@ static std::string getVisualText(const std::string &text) {
 
 static const int SpaceBetweenLine = 5;
 
+// the metrics of the labels texts are cached as many graph elements
+// usually share the same labels, they are identified by the font file,
+// the font size and the text; the cache is shared by the labels
+// of all the OpenGL contexts so its accesses are guarded
+struct TextMetrics {
+  std::vector<std::string> lines;
+  std::vector<float> widths;
+  BoundingBox boundingBox;
+};
+
+typedef std::tuple<std::string, int, std::string> TextMetricsKey;
+static std::map<TextMetricsKey, TextMetrics> textMetricsCache;
+static const size_t MaxCachedTextMetrics = 4096;
+TLP_DEFINE_GLOBAL_LOCK(TextMetricsCacheLock);
+
 GlLabel::GlLabel() : leftAlign(false), oldCamera(nullptr) {
   init();
 }
@@ -159,6 +177,25 @@ void GlLabel::setText(const string &text) {
     ftglOutlineFont->FaceSize(fontSize);
   }
 
+  TextMetricsKey key(font.fontFile(), fontSize, text);
+  bool cached = false;
+
+  TLP_GLOBALLY_LOCK_SECTION(TextMetricsCacheLock) {
+    auto itm = textMetricsCache.find(key);
+
+    if (itm != textMetricsCache.end()) {
+      textVector = itm->second.lines;
+      textWidthVector = itm->second.widths;
+      textBoundingBox = itm->second.boundingBox;
+      cached = true;
+    }
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(TextMetricsCacheLock);
+
+  if (cached) {
+    return;
+  }
+
   // split each line
   textVector.clear();
   textWidthVector.clear();
@@ -198,6 +235,16 @@ void GlLabel::setText(const string &text) {
       textBoundingBox[0][1] -= fontSize + SpaceBetweenLine;
     }
   }
+
+  TLP_GLOBALLY_LOCK_SECTION(TextMetricsCacheLock) {
+    if (textMetricsCache.size() >= MaxCachedTextMetrics) {
+      textMetricsCache.clear();
+    }
+
+    textMetricsCache.emplace(std::move(key),
+                             TextMetrics{textVector, textWidthVector, textBoundingBox});
+  }
+  TLP_GLOBALLY_UNLOCK_SECTION(TextMetricsCacheLock);
 }
 //============================================================
 BoundingBox GlLabel::getBoundingBox() {
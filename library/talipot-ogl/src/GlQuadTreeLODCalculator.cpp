@@ -11,6 +11,8 @@
  *
  */
 
+#include <algorithm>
+
 #include <talipot/GlQuadTreeLODCalculator.h>
 
 #include <talipot/QuadTree.h>
@@ -34,11 +36,24 @@ BoundingBox computeNewBoundingBox(const BoundingBox &box, const Coord &centerSce
   return BoundingBox(center - size, center + size);
 }
 
+// expand the bounding box of an edge with direction (0,0,x)
+// the elements are removed from and inserted again in the quadtrees
+// until the number of updates exceeds this fraction of the graph elements,
+// then rebuilding the quadtrees is cheaper
+static constexpr uint MAX_UPDATES_FRACTION = 16;
+
+static void expandEdgeBoundingBox(BoundingBox &bb) {
+  if (bb[0][0] == bb[1][0] && bb[0][1] == bb[1][1]) {
+    bb.expand(bb[1] + Coord(0.01f, 0.01f, 0));
+  }
+}
+
 GlQuadTreeLODCalculator::GlQuadTreeLODCalculator()
     : haveToCompute(true), haveToInitObservers(true),
       seBBIndex(2 * ThreadManager::getNumberOfThreads()),
       eBBOffset(ThreadManager::getNumberOfThreads()), currentGraph(nullptr),
-      layoutProperty(nullptr), sizeProperty(nullptr), selectionProperty(nullptr) {
+      layoutProperty(nullptr), sizeProperty(nullptr), selectionProperty(nullptr),
+      graphQuadTreesPosition(-1), nbElementsUpdates(0) {
   threadSafe = true;
   // we have to deal with
   // ThreadManager::getNumberOfThreads() bounding boxes for nodes
@@ -204,6 +219,11 @@ void GlQuadTreeLODCalculator::compute(const Vec4i &globalViewport, const Vec4i &
 
     entitiesQuadTree.clear();
 
+    graphQuadTreesPosition = -1;
+    updatedNodes.clear();
+    updatedEdges.clear();
+    nbElementsUpdates = 0;
+
     quadTreesVectorPosition = 0;
     const auto &layersVector = glScene->getLayersList();
 
@@ -327,6 +347,11 @@ void GlQuadTreeLODCalculator::computeFor3DCamera(LayerLODUnit *layerLODUnit, con
     size_t nbSimples = layerLODUnit->entitiesLODVector.size();
     size_t nbNodes = layerLODUnit->nodesLODVector.size();
     size_t nbEdges = layerLODUnit->edgesLODVector.size();
+
+    if (nbNodes || nbEdges) {
+      graphQuadTreesPosition = quadTreesVectorPosition;
+    }
+
     auto thrdF1 = [&]() {
       for (size_t i = 0; i < nbSimples; ++i) {
         const auto &entity = layerLODUnit->entitiesLODVector[i];
@@ -341,14 +366,8 @@ void GlQuadTreeLODCalculator::computeFor3DCamera(LayerLODUnit *layerLODUnit, con
     };
     auto thrdF3 = [&]() {
       for (size_t i = 0; i < nbEdges; ++i) {
-        // This code is here to expand edge bounding box when we have an edge with direction
-        // (0,0,x)
         auto &entity = layerLODUnit->edgesLODVector[i];
-        if (entity.boundingBox[0][0] == entity.boundingBox[1][0] &&
-            entity.boundingBox[0][1] == entity.boundingBox[1][1]) {
-          entity.boundingBox.expand(entity.boundingBox[1] + Coord(0.01f, 0.01f, 0));
-        }
-
+        expandEdgeBoundingBox(entity.boundingBox);
         edgesQuadTree[quadTreesVectorPosition]->insert(entity.boundingBox, entity.id);
       }
     };
@@ -522,9 +541,155 @@ void GlQuadTreeLODCalculator::addObservers() {
 }
 
 void GlQuadTreeLODCalculator::update(PropertyInterface *property) {
-  if (property == inputData->getElementLayout() || property == inputData->getElementSize() ||
-      property == inputData->getElementSelected()) {
+  // the bounding boxes of the elements do not depend on their selection
+  if (property == inputData->getElementLayout() || property == inputData->getElementSize()) {
+    setHaveToCompute();
+  }
+}
+
+BoundingBox GlQuadTreeLODCalculator::getBoundingBox(node n) const {
+  return GlNode(n, currentGraph).getBoundingBox(inputData);
+}
+
+BoundingBox GlQuadTreeLODCalculator::getBoundingBox(edge e) const {
+  BoundingBox bb = GlEdge(e, currentGraph).getBoundingBox(inputData);
+  expandEdgeBoundingBox(bb);
+  return bb;
+}
+
+void GlQuadTreeLODCalculator::insertElement(node n) {
+  if (haveToCompute) {
+    return;
+  }
+
+  BoundingBox bb = getBoundingBox(n);
+  QuadTreeNode<uint> *quadTree =
+      graphQuadTreesPosition == -1 ? nullptr : nodesQuadTree[graphQuadTreesPosition];
+
+  // an element outside of the quadtree box could not be found
+  if (quadTree && quadTree->canInsert(bb)) {
+    quadTree->insert(bb, n.id);
+  } else {
+    setHaveToCompute();
+  }
+}
+
+void GlQuadTreeLODCalculator::insertElement(edge e) {
+  if (haveToCompute) {
+    return;
+  }
+
+  BoundingBox bb = getBoundingBox(e);
+  QuadTreeNode<uint> *quadTree =
+      graphQuadTreesPosition == -1 ? nullptr : edgesQuadTree[graphQuadTreesPosition];
+
+  if (quadTree && quadTree->canInsert(bb)) {
+    quadTree->insert(bb, e.id);
+  } else {
+    setHaveToCompute();
+  }
+}
+
+void GlQuadTreeLODCalculator::removeElement(node n) {
+  if (haveToCompute) {
+    return;
+  }
+
+  QuadTreeNode<uint> *quadTree =
+      graphQuadTreesPosition == -1 ? nullptr : nodesQuadTree[graphQuadTreesPosition];
+
+  // the element is not found if its bounding box has changed
+  // without being notified (e.g. when its rotation has been modified)
+  if (!quadTree || !quadTree->remove(getBoundingBox(n), n.id)) {
+    setHaveToCompute();
+  }
+}
+
+void GlQuadTreeLODCalculator::removeElement(edge e) {
+  if (haveToCompute) {
+    return;
+  }
+
+  QuadTreeNode<uint> *quadTree =
+      graphQuadTreesPosition == -1 ? nullptr : edgesQuadTree[graphQuadTreesPosition];
+
+  if (!quadTree || !quadTree->remove(getBoundingBox(e), e.id)) {
+    setHaveToCompute();
+  }
+}
+
+bool GlQuadTreeLODCalculator::countElementsUpdates(uint nbElements) {
+  if (haveToCompute) {
+    // the bounding box of the graph may change anyway
+    elementsUpdated();
+    return false;
+  }
+
+  nbElementsUpdates += nbElements;
+
+  if (nbElementsUpdates * MAX_UPDATES_FRACTION >
+      currentGraph->numberOfNodes() + currentGraph->numberOfEdges()) {
     setHaveToCompute();
+    return false;
+  }
+
+  return true;
+}
+
+void GlQuadTreeLODCalculator::beginElementUpdate(node n) {
+  // the bounding boxes of the incident edges depend on the node ones
+  vector<edge> edges = currentGraph->incidence(n);
+  // a loop is twice in the incidence of its node
+  sort(edges.begin(), edges.end());
+  edges.erase(unique(edges.begin(), edges.end()), edges.end());
+
+  if (!countElementsUpdates(edges.size() + 1)) {
+    return;
+  }
+
+  removeElement(n);
+  updatedNodes.push_back(n);
+
+  for (auto e : edges) {
+    removeElement(e);
+    updatedEdges.push_back(e);
+  }
+}
+
+void GlQuadTreeLODCalculator::beginElementUpdate(edge e) {
+  if (!countElementsUpdates(1)) {
+    return;
+  }
+
+  removeElement(e);
+  updatedEdges.push_back(e);
+}
+
+void GlQuadTreeLODCalculator::endElementsUpdate() {
+  if (updatedNodes.empty() && updatedEdges.empty()) {
+    return;
+  }
+
+  for (auto n : updatedNodes) {
+    insertElement(n);
+  }
+
+  for (auto e : updatedEdges) {
+    insertElement(e);
+  }
+
+  updatedNodes.clear();
+  updatedEdges.clear();
+  elementsUpdated();
+}
+
+void GlQuadTreeLODCalculator::elementsUpdated() {
+  // the bounding box of the graph may have changed
+  auto *attachedQuadTreeLODCalculator =
+      dynamic_cast<GlQuadTreeLODCalculator *>(attachedLODCalculator);
+
+  if (attachedQuadTreeLODCalculator) {
+    attachedQuadTreeLODCalculator->setHaveToCompute();
   }
 }
 
@@ -538,9 +703,27 @@ void GlQuadTreeLODCalculator::treatEvent(const Event &ev) {
 
     switch (graphEvent->getType()) {
     case GraphEvent::TLP_ADD_NODE:
+      insertElement(graphEvent->getNode());
+      elementsUpdated();
+      break;
+
     case GraphEvent::TLP_ADD_EDGE:
+      insertElement(graphEvent->getEdge());
+      elementsUpdated();
+      break;
+
     case GraphEvent::TLP_DEL_NODE:
+      removeElement(graphEvent->getNode());
+      elementsUpdated();
+      break;
+
     case GraphEvent::TLP_DEL_EDGE:
+      removeElement(graphEvent->getEdge());
+      elementsUpdated();
+      break;
+
+    case GraphEvent::TLP_ADD_NODES:
+    case GraphEvent::TLP_ADD_EDGES:
       setHaveToCompute();
       break;
 
@@ -566,13 +749,34 @@ void GlQuadTreeLODCalculator::treatEvent(const Event &ev) {
     PropertyInterface *property = propertyEvent->getProperty();
 
     switch (propertyEvent->getType()) {
+    // the bulk updates may concern many elements sharing incident edges,
+    // so the quadtrees are rather rebuilt
     case PropertyEvent::TLP_BEFORE_SET_ALL_NODE_VALUE:
-    case PropertyEvent::TLP_BEFORE_SET_NODE_VALUE:
     case PropertyEvent::TLP_BEFORE_SET_ALL_EDGE_VALUE:
-    case PropertyEvent::TLP_BEFORE_SET_EDGE_VALUE:
+    case PropertyEvent::TLP_BEFORE_SET_NODES_VALUES:
+    case PropertyEvent::TLP_BEFORE_SET_EDGES_VALUES:
       update(property);
       break;
 
+    // the elements whose bounding box changes are removed from the quadtrees
+    // before the update then inserted again
+    case PropertyEvent::TLP_BEFORE_SET_NODE_VALUE:
+      if (property == layoutProperty || property == sizeProperty) {
+        beginElementUpdate(propertyEvent->getNode());
+      }
+      break;
+
+    case PropertyEvent::TLP_BEFORE_SET_EDGE_VALUE:
+      if (property == layoutProperty || property == sizeProperty) {
+        beginElementUpdate(propertyEvent->getEdge());
+      }
+      break;
+
+    case PropertyEvent::TLP_AFTER_SET_NODE_VALUE:
+    case PropertyEvent::TLP_AFTER_SET_EDGE_VALUE:
+      endElementsUpdate();
+      break;
+
     default:
       break;
     }
@@ -1117,6 +1117,7 @@ void GlVertexArrayManager::treatEvent(const Event &evt) {
     switch (propertyEvent->getType()) {
     case PropertyEvent::TLP_BEFORE_SET_ALL_NODE_VALUE:
     case PropertyEvent::TLP_BEFORE_SET_NODE_VALUE:
+    case PropertyEvent::TLP_BEFORE_SET_NODES_VALUES:
       if (shapeProperty == property || sizeProperty == property) {
         edgesModified = true;
       }
@@ -1126,6 +1127,7 @@ void GlVertexArrayManager::treatEvent(const Event &evt) {
 
     case PropertyEvent::TLP_BEFORE_SET_ALL_EDGE_VALUE:
     case PropertyEvent::TLP_BEFORE_SET_EDGE_VALUE:
+    case PropertyEvent::TLP_BEFORE_SET_EDGES_VALUES:
 
       if (layoutProperty == property || shapeProperty == property ||
           srcAnchorShapeProperty == property || tgtAnchorShapeProperty == property ||
@@ -11,6 +11,11 @@
  *
  */
 
+#include <climits>
+
+#include <talipot/ParallelTools.h>
+#include <talipot/VectorProperty.h>
+
 #include "EqualValueClustering.h"
 
 //================================================================================
@@ -27,30 +32,38 @@ static constexpr std::string_view paramHelp[] = {
     "The type of graph elements to partition.",
 
     // Connected
-    "If true, the resulting subgraphs are guaranteed to be connected."};
+    "If true, the resulting subgraphs are guaranteed to be connected.",
+
+    // Induced edges
+    "If true and the nodes are partitioned, the edges linking two nodes of a subgraph are added "
+    "to it. Disabling it speeds up the partitioning of large graphs."};
 
 #define ELT_TYPE "Type"
 #define ELT_TYPES "nodes;edges;"
 #define NODE_ELT 0
 #define EDGE_ELT 1
 //================================================================================
-EqualValueClustering::EqualValueClustering(tlp::PluginContext *context) : Algorithm(context) {
+EqualValueClustering::EqualValueClustering(tlp::PluginContext *context)
+    : Algorithm(context), inducedEdges(true) {
   addInParameter<PropertyInterface *>("Property", paramHelp[0].data(), "viewMetric");
   addInParameter<StringCollection>(ELT_TYPE, paramHelp[1].data(), ELT_TYPES, true,
                                    "<b>nodes</b> <br> <b>edges</b>");
   addInParameter<bool>("Connected", paramHelp[2].data(), "false");
+  addInParameter<bool>("Induced edges", paramHelp[3].data(), "true");
 }
 //===============================================================================
 bool EqualValueClustering::run() {
   PropertyInterface *property = nullptr;
   StringCollection eltTypes(ELT_TYPES);
   bool connected = false;
+  inducedEdges = true;
   eltTypes.setCurrent(0);
 
   if (dataSet != nullptr) {
     dataSet->get("Property", property);
     dataSet->get(ELT_TYPE, eltTypes);
     dataSet->get("Connected", connected);
+    dataSet->get("Induced edges", inducedEdges);
   }
 
   if (property == nullptr) {
@@ -60,215 +73,192 @@ bool EqualValueClustering::run() {
   const bool onNodes = eltTypes.getCurrent() == NODE_ELT;
 
   // try to work with NumericProperty
-  if (dynamic_cast<NumericProperty *>(property)) {
-    return computeClusters(static_cast<NumericProperty *>(property), onNodes, connected);
+  if (auto *metric = dynamic_cast<NumericProperty *>(property)) {
+    return computeClusters(
+        property, onNodes, connected, [metric](node n) { return metric->getNodeDoubleValue(n); },
+        [metric](edge e) { return metric->getEdgeDoubleValue(e); });
   }
 
-  return computeClusters(property, onNodes, connected);
+  // the interned string values are compared and hashed by their identifiers
+  if (auto *strProp = dynamic_cast<StringProperty *>(property);
+      strProp && strProp->hasInternedValues()) {
+    return computeClusters(
+        property, onNodes, connected, [strProp](node n) { return strProp->getNodeValueId(n); },
+        [strProp](edge e) { return strProp->getEdgeValueId(e); });
+  }
+
+  return computeClusters(
+      property, onNodes, connected, [property](node n) { return property->getNodeStringValue(n); },
+      [property](edge e) { return property->getEdgeStringValue(e); });
 }
 
-bool EqualValueClustering::computeClusters(NumericProperty *prop, bool onNodes, bool connected) {
-  uint step = 0;
-  uint maxSteps;
+// returns the name of the cluster of the elements having the same value as n
+static string clusterName(PropertyInterface *prop, node n) {
+  stringstream sstr;
+  sstr << prop->getName().c_str() << ": ";
 
-  std::unordered_map<double, Graph *> clusters;
-  std::unordered_map<std::string, uint> valuesCount;
-  MutableContainer<bool> visited;
-  visited.setAll(false);
+  if (auto *metric = dynamic_cast<NumericProperty *>(prop)) {
+    sstr.width(8);
+    sstr << metric->getNodeDoubleValue(n);
+  } else {
+    sstr << prop->getNodeStringValue(n).c_str();
+  }
 
-  if (onNodes) {
-    maxSteps = graph->numberOfNodes();
+  return sstr.str();
+}
 
-    if (pluginProgress) {
-      pluginProgress->setComment("Partitioning nodes...");
+static string clusterName(PropertyInterface *prop, edge e) {
+  stringstream sstr;
+  sstr << prop->getName().c_str() << ": ";
+
+  if (auto *metric = dynamic_cast<NumericProperty *>(prop)) {
+    sstr.width(8);
+    sstr << metric->getEdgeDoubleValue(e);
+  } else {
+    sstr << prop->getEdgeStringValue(e).c_str();
+  }
+
+  return sstr.str();
+}
+
+// groups the elements having the same value, the groups are ordered
+// according to the first occurrence of their value in elts.
+// The elements are partitioned in parallel into one chunk per thread,
+// the chunks partitions are then merged in order.
+template <typename ELT, typename ValueFunction>
+static vector<vector<ELT>> partitionElements(const vector<ELT> &elts,
+                                             const ValueFunction &valueOf) {
+  typedef decltype(valueOf(ELT())) Value;
+  uint nbElts = elts.size();
+  uint nbChunks = std::max(1u, std::min<uint>(TLP_NB_THREADS, nbElts / 1024));
+  vector<vector<Value>> chunksValues(nbChunks);
+  vector<vector<vector<ELT>>> chunksGroups(nbChunks);
+
+  TLP_PARALLEL_MAP_INDICES(nbChunks, [&](uint chunk) {
+    std::unordered_map<Value, uint> groupIds;
+    auto &values = chunksValues[chunk];
+    auto &groups = chunksGroups[chunk];
+    uint end = (uint64_t(chunk) + 1) * nbElts / nbChunks;
+
+    for (uint i = uint64_t(chunk) * nbElts / nbChunks; i < end; ++i) {
+      auto value = valueOf(elts[i]);
+      auto [it, inserted] = groupIds.emplace(value, groups.size());
+
+      if (inserted) {
+        values.push_back(value);
+        groups.emplace_back();
+      }
+
+      groups[it->second].push_back(elts[i]);
     }
+  });
 
-    // do a bfs traversal for each node
-    for (auto curNode : graph->nodes()) {
-      // check if curNode has been already visited
-      if (!visited.get(curNode.id)) {
-        // get the value of the node
-        double curValue = prop->getNodeDoubleValue(curNode);
-        Graph *sg;
-
-        if (connected || (clusters.find(curValue) == clusters.end())) {
-          // add a new cluster
-          sg = graph->addSubGraph();
-          // set its name
-          string strVal = prop->getNodeStringValue(curNode);
-          stringstream sstr;
-          sstr << prop->getName().c_str() << ": ";
-          sstr.width(8);
-          sstr << curValue;
-
-          if (connected) {
-            auto itv = valuesCount.find(strVal);
-
-            if (itv != valuesCount.end()) {
-              itv->second += 1;
-              sstr << " [" << itv->second << ']';
-            } else {
-              valuesCount[strVal] = 0;
-            }
-          } else {
-            clusters[curValue] = sg;
-          }
+  vector<vector<ELT>> groups;
+  std::unordered_map<Value, uint> groupIds;
 
-          sg->setName(sstr.str());
-        } else {
-          sg = clusters[curValue];
-        }
+  for (uint chunk = 0; chunk < nbChunks; ++chunk) {
+    auto &chunkGroups = chunksGroups[chunk];
 
-        // add curNode in the cluster
-        sg->addNode(curNode);
+    for (uint i = 0; i < chunkGroups.size(); ++i) {
+      auto [it, inserted] = groupIds.emplace(chunksValues[chunk][i], groups.size());
 
-        if (pluginProgress && (++step % 50 == 1)) {
-          pluginProgress->progress(step, maxSteps);
+      if (inserted) {
+        groups.push_back(std::move(chunkGroups[i]));
+      } else {
+        auto &group = groups[it->second];
+        group.insert(group.end(), chunkGroups[i].begin(), chunkGroups[i].end());
+      }
+    }
 
-          if (pluginProgress->state() != TLP_CONTINUE) {
-            return pluginProgress->state() != TLP_CANCEL;
-          }
-        }
+    chunkGroups.clear();
+  }
 
-        // do a bfs traversal for this node
-        list<node> nodesToVisit;
-        visited.set(curNode.id, true);
-        nodesToVisit.push_front(curNode);
+  return groups;
+}
 
-        while (!nodesToVisit.empty()) {
-          node curNode = nodesToVisit.front();
-          nodesToVisit.pop_front();
-          for (auto curEdge : graph->getInOutEdges(curNode)) {
-            node neighbour = graph->opposite(curEdge, curNode);
+template <typename NodeValue, typename EdgeValue>
+bool EqualValueClustering::computeClusters(PropertyInterface *prop, bool onNodes, bool connected,
+                                           NodeValue nodeValue, EdgeValue edgeValue) {
+  if (connected) {
+    return computeConnectedClusters(prop, onNodes, nodeValue, edgeValue);
+  }
 
-            if (neighbour == curNode) {
-              // add loop
-              sg->addEdge(curEdge);
-              continue;
-            }
+  if (pluginProgress) {
+    pluginProgress->setComment(onNodes ? "Partitioning nodes..." : "Partitioning edges...");
+  }
 
-            //
-            // check if neighbour has the same value
-            if (curValue == prop->getNodeDoubleValue(neighbour)) {
-              // check if neighbour has not been visited
-              if (!visited.get(neighbour.id)) {
-                // add neighbour and edge in cluster
-                sg->addNode(neighbour);
-                sg->addEdge(curEdge);
-                // push it for further deeper exploration
-                visited.set(neighbour.id, true);
-                nodesToVisit.push_back(neighbour);
+  if (onNodes) {
+    vector<vector<node>> clusters = partitionElements(graph->nodes(), nodeValue);
+    vector<vector<edge>> clustersEdges;
 
-                if (pluginProgress && (++step % 50 == 1)) {
-                  pluginProgress->progress(step, maxSteps);
+    if (inducedEdges) {
+      // an edge belongs to the cluster of its ends if they are in the same one
+      NodeVectorProperty<uint> nodeCluster(graph);
 
-                  if (pluginProgress->state() != TLP_CONTINUE) {
-                    return pluginProgress->state() != TLP_CANCEL;
-                  }
-                }
-              } else {
-                // check if curEdge already exist in cluster
-                if (!sg->isElement(curEdge)) {
-                  sg->addEdge(curEdge);
-                }
-              }
-            }
-          }
+      for (uint i = 0; i < clusters.size(); ++i) {
+        for (auto n : clusters[i]) {
+          nodeCluster[n] = i;
         }
       }
-    }
-  } else {
-    maxSteps = graph->numberOfEdges();
 
-    if (pluginProgress) {
-      pluginProgress->setComment("Partitioning edges...");
-    }
+      clustersEdges.resize(clusters.size());
 
-    // do a bfs traversal for each edge
-    for (auto curEdge : graph->edges()) {
-      // check if curEdge has been already visited
-      if (!visited.get(curEdge.id)) {
-        // get the value of the edge
-        double curValue = prop->getEdgeDoubleValue(curEdge);
-        Graph *sg;
-
-        if (connected || (clusters.find(curValue) == clusters.end())) {
-          // add a new cluster
-          sg = graph->addSubGraph();
-          // set its name
-          string strVal = prop->getEdgeStringValue(curEdge);
-          stringstream sstr;
-          sstr << prop->getName().c_str() << ": ";
-          sstr.width(8);
-          sstr << curValue;
-
-          if (connected) {
-            auto itv = valuesCount.find(strVal);
-
-            if (itv != valuesCount.end()) {
-              itv->second += 1;
-              sstr << " [" << itv->second << ']';
-            } else {
-              valuesCount[strVal] = 0;
-            }
-          } else {
-            clusters[curValue] = sg;
-          }
+      for (auto e : graph->edges()) {
+        const auto &[src, tgt] = graph->ends(e);
+        uint cluster = nodeCluster[src];
 
-          sg->setName(sstr.str());
-        } else {
-          sg = clusters[curValue];
+        if (cluster == nodeCluster[tgt]) {
+          clustersEdges[cluster].push_back(e);
         }
+      }
+    }
 
-        // add curEdge in cluster
-        const auto &[src, tgt] = graph->ends(curEdge);
-        sg->addNode(src);
-        sg->addNode(tgt);
-        sg->addEdge(curEdge);
+    for (uint i = 0; i < clusters.size(); ++i) {
+      Graph *sg = graph->addSubGraph(clusterName(prop, clusters[i].front()));
+      sg->addNodes(clusters[i]);
 
-        if (pluginProgress && (++step % 50 == 1)) {
-          pluginProgress->progress(step, maxSteps);
+      if (inducedEdges) {
+        sg->addEdges(clustersEdges[i]);
+      }
 
-          if (pluginProgress->state() != TLP_CONTINUE) {
-            return pluginProgress->state() != TLP_CANCEL;
+      if (pluginProgress && (i % 50 == 49)) {
+        pluginProgress->progress(i, clusters.size());
+
+        if (pluginProgress->state() != TLP_CONTINUE) {
+          return pluginProgress->state() != TLP_CANCEL;
+        }
+      }
+    }
+  } else {
+    vector<vector<edge>> clusters = partitionElements(graph->edges(), edgeValue);
+    // the last cluster each node has been added to
+    NodeVectorProperty<uint> nodeCluster(graph);
+    nodeCluster.setAll(UINT_MAX);
+    vector<node> clusterNodes;
+
+    for (uint i = 0; i < clusters.size(); ++i) {
+      clusterNodes.clear();
+
+      for (auto e : clusters[i]) {
+        const auto &[src, tgt] = graph->ends(e);
+
+        for (auto n : {src, tgt}) {
+          if (nodeCluster[n] != i) {
+            nodeCluster[n] = i;
+            clusterNodes.push_back(n);
           }
         }
+      }
 
-        // do a bfs traversal for this edge
-        list<node> nodesToVisit;
-        nodesToVisit.push_front(src);
-        nodesToVisit.push_front(tgt);
-        visited.set(curEdge.id, true);
-
-        while (!nodesToVisit.empty()) {
-          node curNode = nodesToVisit.front();
-          nodesToVisit.pop_front();
-          for (auto curEdge : graph->getInOutEdges(curNode)) {
-            // check if the edge has not been visited AND
-            // if it has the same value
-            if (!visited.get(curEdge.id) && curValue == prop->getEdgeDoubleValue(curEdge)) {
-              node neighbour = graph->opposite(curEdge, curNode);
-
-              if (neighbour != curNode) {
-                // add neighbour in cluster
-                sg->addNode(neighbour);
-                // and push it for further deeper exploration
-                nodesToVisit.push_back(neighbour);
-              }
+      Graph *sg = graph->addSubGraph(clusterName(prop, clusters[i].front()));
+      sg->addNodes(clusterNodes);
+      sg->addEdges(clusters[i]);
 
-              // add edge in cluster
-              sg->addEdge(curEdge);
-              visited.set(curEdge.id, true);
+      if (pluginProgress && (i % 50 == 49)) {
+        pluginProgress->progress(i, clusters.size());
 
-              if (pluginProgress && (++step % 50 == 1)) {
-                pluginProgress->progress(step, maxSteps);
-
-                if (pluginProgress->state() != TLP_CONTINUE) {
-                  return pluginProgress->state() != TLP_CANCEL;
-                }
-              }
-            }
-          }
+        if (pluginProgress->state() != TLP_CONTINUE) {
+          return pluginProgress->state() != TLP_CANCEL;
         }
       }
     }
@@ -277,16 +267,18 @@ bool EqualValueClustering::computeClusters(NumericProperty *prop, bool onNodes,
   return true;
 }
 
-bool EqualValueClustering::computeClusters(PropertyInterface *prop, bool onNodes, bool connected) {
+template <typename NodeValue, typename EdgeValue>
+bool EqualValueClustering::computeConnectedClusters(PropertyInterface *prop, bool onNodes,
+                                                    NodeValue nodeValue, EdgeValue edgeValue) {
   uint step = 0;
   uint maxSteps;
 
-  std::unordered_map<std::string, Graph *> clusters;
-  std::unordered_map<std::string, uint> valuesCount;
   MutableContainer<bool> visited;
   visited.setAll(false);
 
   if (onNodes) {
+    std::unordered_map<decltype(nodeValue(node())), uint> valuesCount;
+
     maxSteps = graph->numberOfNodes();
 
     if (pluginProgress) {
@@ -299,35 +291,25 @@ bool EqualValueClustering::computeClusters(PropertyInterface *prop, bool onNodes
       // check if curNode has been already visited
       if (!visited.get(curNode.id)) {
         // get the value of the node
-        string curValue = prop->getNodeStringValue(curNode);
-        Graph *sg;
-
-        if (connected || (clusters.find(curValue) == clusters.end())) {
-          // add a new cluster
-          sg = graph->addSubGraph();
-          // set its name
-          stringstream sstr;
-          sstr << prop->getName().c_str() << ": " << curValue.c_str();
-
-          if (connected) {
-            auto itv = valuesCount.find(curValue);
-
-            if (itv != valuesCount.end()) {
-              itv->second += 1;
-              sstr << " [" << itv->second << ']';
-            } else {
-              valuesCount[curValue] = 0;
-            }
-          } else {
-            clusters[curValue] = sg;
-          }
-
-          sg->setName(sstr.str());
+        auto curValue = nodeValue(curNode);
+        // add a new cluster
+        Graph *sg = graph->addSubGraph();
+        // set its name
+        stringstream sstr;
+        sstr << clusterName(prop, curNode);
+
+        auto itv = valuesCount.find(curValue);
+
+        if (itv != valuesCount.end()) {
+          itv->second += 1;
+          sstr << " [" << itv->second << ']';
         } else {
-          sg = clusters[curValue];
+          valuesCount[curValue] = 0;
         }
 
-        // add curNode in cluster
+        sg->setName(sstr.str());
+
+        // add curNode in the cluster
         sg->addNode(curNode);
 
         if (pluginProgress && (++step % 50 == 1)) {
@@ -350,18 +332,24 @@ bool EqualValueClustering::computeClusters(PropertyInterface *prop, bool onNodes
             node neighbour = graph->opposite(curEdge, curNode);
 
             if (neighbour == curNode) {
-              // add loop in cluster
-              sg->addEdge(curEdge);
+              // add loop
+              if (inducedEdges) {
+                sg->addEdge(curEdge);
+              }
               continue;
             }
 
             // check if neighbour has the same value
-            if (curValue == prop->getNodeStringValue(neighbour)) {
+            if (curValue == nodeValue(neighbour)) {
               // check if neighbour has not been visited
               if (!visited.get(neighbour.id)) {
                 // add neighbour and edge in cluster
                 sg->addNode(neighbour);
-                sg->addEdge(curEdge);
+
+                if (inducedEdges) {
+                  sg->addEdge(curEdge);
+                }
+
                 // push it for further deeper exploration
                 visited.set(neighbour.id, true);
                 nodesToVisit.push_back(neighbour);
@@ -375,7 +363,7 @@ bool EqualValueClustering::computeClusters(PropertyInterface *prop, bool onNodes
                 }
               } else {
                 // check if curEdge already exist in cluster
-                if (!sg->isElement(curEdge)) {
+                if (inducedEdges && !sg->isElement(curEdge)) {
                   sg->addEdge(curEdge);
                 }
               }
@@ -385,6 +373,7 @@ bool EqualValueClustering::computeClusters(PropertyInterface *prop, bool onNodes
       }
     }
   } else {
+    std::unordered_map<decltype(edgeValue(edge())), uint> valuesCount;
     maxSteps = graph->numberOfEdges();
 
     if (pluginProgress) {
@@ -393,39 +382,27 @@ bool EqualValueClustering::computeClusters(PropertyInterface *prop, bool onNodes
 
     // do a bfs traversal for each edge
     for (auto curEdge : graph->edges()) {
-
       // check if curEdge has been already visited
       if (!visited.get(curEdge.id)) {
         // get the value of the edge
-        string curValue = prop->getEdgeStringValue(curEdge);
-        Graph *sg;
-
-        if (connected || (clusters.find(curValue) == clusters.end())) {
-          // add a new cluster
-          sg = graph->addSubGraph();
-          // set its name
-          string strVal = prop->getEdgeStringValue(curEdge);
-          stringstream sstr;
-          sstr << prop->getName().c_str() << ": " << curValue.c_str();
-
-          if (connected) {
-            auto itv = valuesCount.find(curValue);
-
-            if (itv != valuesCount.end()) {
-              itv->second += 1;
-              sstr << " [" << itv->second << ']';
-            } else {
-              valuesCount[strVal] = 0;
-            }
-          } else {
-            clusters[curValue] = sg;
-          }
-
-          sg->setName(sstr.str());
+        auto curValue = edgeValue(curEdge);
+        // add a new cluster
+        Graph *sg = graph->addSubGraph();
+        // set its name
+        stringstream sstr;
+        sstr << clusterName(prop, curEdge);
+
+        auto itv = valuesCount.find(curValue);
+
+        if (itv != valuesCount.end()) {
+          itv->second += 1;
+          sstr << " [" << itv->second << ']';
         } else {
-          sg = clusters[curValue];
+          valuesCount[curValue] = 0;
         }
 
+        sg->setName(sstr.str());
+
         // add curEdge in cluster
         const auto &[src, tgt] = graph->ends(curEdge);
         sg->addNode(src);
@@ -452,7 +429,7 @@ bool EqualValueClustering::computeClusters(PropertyInterface *prop, bool onNodes
           for (auto curEdge : graph->getInOutEdges(curNode)) {
             // check if the edge has not been visited AND
             // if it has the same value
-            if (!visited.get(curEdge.id) && curValue == prop->getEdgeStringValue(curEdge)) {
+            if (!visited.get(curEdge.id) && curValue == edgeValue(curEdge)) {
               node neighbour = graph->opposite(curEdge, curNode);
 
               if (neighbour != curNode) {
@@ -482,5 +459,3 @@ bool EqualValueClustering::computeClusters(PropertyInterface *prop, bool onNodes
 
   return true;
 }
-
-//================================================================================
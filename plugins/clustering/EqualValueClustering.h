@@ -22,11 +22,19 @@ public:
   PLUGININFORMATION("Equal Value", "Patrick Mary", "16/04/2014",
                     "Performs a graph clusterization grouping in the same cluster the nodes or "
                     "edges having the same value for a given property.",
-                    "1.1", "Clustering")
+                    "1.2", "Clustering")
   EqualValueClustering(tlp::PluginContext *context);
   bool run() override;
-  bool computeClusters(tlp::NumericProperty *prop, bool onNodes, bool connected);
-  bool computeClusters(tlp::PropertyInterface *prop, bool onNodes, bool connected);
+
+private:
+  template <typename NodeValue, typename EdgeValue>
+  bool computeClusters(tlp::PropertyInterface *prop, bool onNodes, bool connected,
+                       NodeValue nodeValue, EdgeValue edgeValue);
+  template <typename NodeValue, typename EdgeValue>
+  bool computeConnectedClusters(tlp::PropertyInterface *prop, bool onNodes, NodeValue nodeValue,
+                                EdgeValue edgeValue);
+
+  bool inducedEdges;
 };
 
 #endif // EQUAL_VALUE_CLUSTERING_H
@@ -30,6 +30,7 @@
 #define CURVEEDGES_H
 
 #include <talipot/Algorithm.h>
+#include <talipot/GraphParallelTools.h>
 #include <talipot/StringCollection.h>
 #include <talipot/LayoutProperty.h>
 #include <talipot/IntegerProperty.h>
@@ -86,7 +87,7 @@ class CurveEdges : public tlp::Algorithm {
 
 public:
   PLUGININFORMATION("Curve edges", "Antoine Lambert", "16/01/2015",
-                    "Computes quadratic or cubic bezier paths for edges", "1.0", "")
+                    "Computes quadratic or cubic bezier paths for edges", "1.1", "")
 
   CurveEdges(tlp::PluginContext *context)
       : tlp::Algorithm(context), curveType(0), curveRoundness(0.5), layout(nullptr),
@@ -331,13 +332,19 @@ public:
       layout = graph->getLayoutProperty("viewLayout");
     }
 
-    for (auto e : graph->edges()) {
+    // the control points of the edges are computed in parallel
+    // then set all at once
+    std::vector<std::vector<tlp::Coord>> controlPoints(graph->numberOfEdges());
+
+    TLP_PARALLEL_MAP_EDGES_AND_INDICES(graph, [&](const tlp::edge &e, uint i) {
       if (curveType >= CURVE_TYPE_CUBIC_CONTINUOUS) {
-        layout->setEdgeValue(e, computeCubicBezierControlPoints(e));
+        controlPoints[i] = computeCubicBezierControlPoints(e);
       } else {
-        layout->setEdgeValue(e, computeQuadraticBezierControlPoints(e));
+        controlPoints[i] = computeQuadraticBezierControlPoints(e);
       }
-    }
+    });
+
+    layout->setEdgeValues(graph->edges(), controlPoints);
 
     if (bezierEdges) {
       tlp::IntegerProperty *viewShape = graph->getIntegerProperty("viewShape");
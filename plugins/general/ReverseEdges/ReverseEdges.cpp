@@ -33,24 +33,34 @@ bool ReverseEdges::run() {
     dataSet->get<BooleanProperty *>("selection", selection);
   }
 
-  Iterator<edge> *ite = selection ? selection->getEdgesEqualTo(true) : graph->getEdges();
+  // the edges to reverse are collected first as reversing an edge updates the graph
+  std::vector<edge> edges = selection ? iteratorVector(selection->getEdgesEqualTo(true))
+                                      : graph->edges();
 
   pluginProgress->showPreview(false);
 
-  int step = 0, max_step = graph->numberOfEdges();
-  for (auto e : ite) {
+  // the graph observers are notified once all the edges are reversed
+  Observable::holdObservers();
+
+  bool result = true;
+  uint step = 0, max_step = edges.size();
+
+  for (auto e : edges) {
     if ((++step % 100) == 0) {
       ProgressState state = pluginProgress->progress(step, max_step);
 
       if (state != TLP_CONTINUE) {
-        return state != TLP_CANCEL;
+        result = state != TLP_CANCEL;
+        break;
       }
     }
 
     graph->reverse(e);
   }
 
-  return true;
+  Observable::unholdObservers();
+
+  return result;
 }
 
 PLUGIN(ReverseEdges)
@@ -23,6 +23,8 @@
 #include <talipot/DoubleProperty.h>
 #include <talipot/BooleanProperty.h>
 
+#include "GraphStreamBuilder.h"
+
 #include <QXmlStreamReader>
 #include <QFile>
 
@@ -110,6 +112,16 @@ public:
       return false;
     }
 
+    // nodes, edges and attributes values are buffered while streaming
+    // the file and only added to the graph once it has been fully parsed
+    GraphStreamBuilder graphBuilder(graph);
+    builder = &graphBuilder;
+    nodeLabels = builder->addNodeColumn<StringProperty, string>(viewLabel);
+    edgeLabels = builder->addEdgeColumn<StringProperty, string>(viewLabel);
+    nodeColors = builder->addNodeColumn<ColorProperty, Color>(viewColor);
+    nodeCoords = builder->addNodeColumn<LayoutProperty, Coord>(viewLayout);
+    nodeSizes = builder->addNodeColumn<SizeProperty, Size>(viewSize);
+
     // Instantiate a QXmlStreamReader to parse the file (GEXF is xml)
     QXmlStreamReader xmlReader(&xmlFile);
 
@@ -117,24 +129,22 @@ public:
     while (!xmlReader.atEnd()) {
       if (xmlReader.readNextStartElement()) {
         // only static graph are supported
-        if (xmlReader.name() == QString("graph")) {
-          string mode = QStringToTlpString(xmlReader.attributes().value("mode").toString());
-
-          if (mode == "dynamic") {
+        if (xmlReader.name() == QLatin1String("graph")) {
+          if (xmlReader.attributes().value("mode") == QLatin1String("dynamic")) {
             pluginProgress->setError("dynamic graph is not yet supported");
             return false;
           }
         }
         // create Talipot Properties from Gephi attributes
-        else if (xmlReader.name() == QString("attributes")) {
+        else if (xmlReader.name() == QLatin1String("attributes")) {
           createPropertiesFromAttributes(xmlReader);
         }
         // parse graph node data
-        else if (xmlReader.name() == QString("nodes")) {
-          createNodes(xmlReader, graph);
+        else if (xmlReader.name() == QLatin1String("nodes")) {
+          createNodes(xmlReader, -1);
         }
         // parse graph edge data
-        else if (xmlReader.name() == QString("edges")) {
+        else if (xmlReader.name() == QLatin1String("edges")) {
           createEdges(xmlReader);
         }
       }
@@ -142,12 +152,33 @@ public:
 
     xmlFile.close();
 
-    // Special case : some GEXF files declare edges before nodes
-    // so we have to add edges once nodes have been parsed
-    for (const auto &[srcId, tgtId] : edgesTmp) {
-      graph->addEdge(nodesMap[srcId], nodesMap[tgtId]);
+    if (pluginProgress->state() != TLP_CONTINUE) {
+      return pluginProgress->state() != TLP_CANCEL;
+    }
+
+    // Some GEXF files declare edges before nodes, the builder
+    // has already registered their extremities so they
+    // can now be created all at once
+    builder->commit();
+
+    // create the subgraphs of the hierarchy
+    for (const auto &[metaNode, sgNodes] : subGraphs) {
+      Graph *sg = graph->addSubGraph();
+      node mn = builder->getNode(metaNode);
+      // record mn as its fake meta node
+      sg->setAttribute<node>("meta-node", mn);
+      // and vice-versa
+      nodeToSubgraph[mn] = sg;
+      vector<node> nodes;
+      nodes.reserve(sgNodes.size());
+      for (auto n : sgNodes) {
+        nodes.push_back(builder->getNode(n));
+      }
+      sg->addNodes(nodes);
     }
 
+    builder = nullptr;
+
     // nodes shape will be circle
     viewShape->setAllNodeValue(NodeShape::Circle);
 
@@ -169,119 +200,140 @@ public:
     return true;
   }
 
+  static string attributeValue(const QXmlStreamAttributes &attributes, const char *name) {
+    return QStringToTlpString(attributes.value(name).toString());
+  }
+
+  // Report parsing progress, the parsing is aborted
+  // if the import has been stopped or cancelled
+  void updateProgress(QXmlStreamReader &xmlReader) {
+    QIODevice *device = xmlReader.device();
+
+    if (!builder->updateProgress(pluginProgress, device->pos(), device->size())) {
+      // ensure all the parsing loops end
+      xmlReader.raiseError("import stopped");
+    }
+  }
+
   // Create a set of Talipot Properties from the attributes declared in the GEXF file
   // according to data types
   void createPropertiesFromAttributes(QXmlStreamReader &xmlReader) {
-    bool nodeProperties = xmlReader.attributes().value("class") == QString("node");
-    unordered_map<string, PropertyInterface *> &propertiesMap =
-        nodeProperties ? nodePropertiesMap : edgePropertiesMap;
+    bool nodeProperties = xmlReader.attributes().value("class") == QLatin1String("node");
+    unordered_map<string, GraphStreamBuilder::Column *> &columnsMap =
+        nodeProperties ? nodeColumnsMap : edgeColumnsMap;
 
-    while (!(xmlReader.isEndElement() && xmlReader.name() == QString("attributes"))) {
+    while (!xmlReader.atEnd() &&
+           !(xmlReader.isEndElement() && xmlReader.name() == QLatin1String("attributes"))) {
       xmlReader.readNext();
 
-      // create a Talipot property and store mapping between attribute id and property
-      if (xmlReader.isStartElement() && xmlReader.name() == QString("attribute")) {
-        string attributeId = QStringToTlpString(xmlReader.attributes().value("id").toString());
-        string attributeName = QStringToTlpString(xmlReader.attributes().value("title").toString());
-        string attributeType = QStringToTlpString(xmlReader.attributes().value("type").toString());
+      // create a Talipot property and store mapping between attribute id
+      // and the column buffering its values
+      if (xmlReader.isStartElement() && xmlReader.name() == QLatin1String("attribute")) {
+        const QXmlStreamAttributes attributes = xmlReader.attributes();
+        string attributeId = attributeValue(attributes, "id");
+        string attributeName = attributeValue(attributes, "title");
+        string attributeType = attributeValue(attributes, "type");
+        PropertyInterface *prop = nullptr;
 
         if (attributeType == "string") {
-          propertiesMap[attributeId] = graph->getStringProperty(attributeName);
+          prop = graph->getStringProperty(attributeName);
         } else if (attributeType == "float" || attributeType == "double") {
-          propertiesMap[attributeId] = graph->getDoubleProperty(attributeName);
+          prop = graph->getDoubleProperty(attributeName);
         } else if (attributeType == "integer") {
-          propertiesMap[attributeId] = graph->getIntegerProperty(attributeName);
+          prop = graph->getIntegerProperty(attributeName);
         } else if (attributeType == "boolean") {
-          propertiesMap[attributeId] = graph->getBooleanProperty(attributeName);
+          prop = graph->getBooleanProperty(attributeName);
+        }
+
+        if (prop) {
+          columnsMap[attributeId] = builder->addColumn(prop, nodeProperties);
         }
       }
     }
   }
 
   // create nodes
-  void createNodes(QXmlStreamReader &xmlReader, Graph *g) {
-    while (!(xmlReader.isEndElement() && xmlReader.name() == QString("nodes"))) {
+  void createNodes(QXmlStreamReader &xmlReader, int sgIdx) {
+    while (!xmlReader.atEnd() &&
+           !(xmlReader.isEndElement() && xmlReader.name() == QLatin1String("nodes"))) {
       xmlReader.readNext();
 
       // must be a node
-      if (xmlReader.isStartElement() && xmlReader.name() == QString("node")) {
-        parseNode(xmlReader, g);
+      if (xmlReader.isStartElement() && xmlReader.name() == QLatin1String("node")) {
+        parseNode(xmlReader, sgIdx);
+        updateProgress(xmlReader);
       }
     }
   }
 
   // create edges
   void createEdges(QXmlStreamReader &xmlReader) {
-    while (!(xmlReader.isEndElement() && xmlReader.name() == QString("edges"))) {
+    while (!xmlReader.atEnd() &&
+           !(xmlReader.isEndElement() && xmlReader.name() == QLatin1String("edges"))) {
       xmlReader.readNext();
 
       // must be an edge
-      if (xmlReader.isStartElement() && xmlReader.name() == QString("edge")) {
+      if (xmlReader.isStartElement() && xmlReader.name() == QLatin1String("edge")) {
         parseEdge(xmlReader);
+        updateProgress(xmlReader);
       }
     }
   }
 
-  Graph *addInParent(node n, const string &pid) {
-    // get the parent node
-    // to find the corresponding sub graph
-    // in which the current node must be added
-    node pn;
-
-    if (nodesMap.find(pid) == nodesMap.end()) {
-      // create a fake meta node
-      pn = graph->addNode();
-      nodesMap[pid] = pn;
-    } else {
-      pn = nodesMap[pid];
-    }
-
-    Graph *sg = nullptr;
-    if (const auto it = nodeToSubgraph.find(pn); it != nodeToSubgraph.end()) {
-      sg = it->second;
+  // returns the index of the subgraph whose fake meta node
+  // is the node at index n, registering it if needed
+  int subGraphIndex(uint n) {
+    if (const auto it = nodeToSubgraphIdx.find(n); it != nodeToSubgraphIdx.end()) {
+      return it->second;
     }
 
-    if (sg == nullptr) {
-      // add a subgraph for the fake meta node
-      sg = graph->addSubGraph();
-      // record pn as its fake meta node
-      sg->setAttribute<node>("meta-node", pn);
-      // and vice-versa
-      nodeToSubgraph[pn] = sg;
-    }
+    int sgIdx = subGraphs.size();
+    subGraphs.emplace_back(n, vector<uint>());
+    nodeToSubgraphIdx[n] = sgIdx;
+    return sgIdx;
+  }
 
+  int addInParent(uint n, const string &pid) {
+    // get the parent node (a fake meta node is created if needed)
+    // to find the corresponding sub graph
+    // in which the current node must be added
+    int sgIdx = subGraphIndex(builder->nodeIndex(pid));
     // add n in the subgraph found
-    sg->addNode(n);
-
-    return sg;
+    subGraphs[sgIdx].second.push_back(n);
+    return sgIdx;
   }
 
   // Parse node data
-  void parseNode(QXmlStreamReader &xmlReader, Graph *g) {
-    node n;
-    string nodeId = QStringToTlpString(xmlReader.attributes().value("id").toString());
-
-    if (nodesMap.find(nodeId) == nodesMap.end()) {
-      // if needed, add a node in the graph we are building
-      n = g->addNode();
-      // save mapping between gexf node id and created Talipot node
-      nodesMap[nodeId] = n;
-    } else {
-      n = nodesMap[nodeId];
+  void parseNode(QXmlStreamReader &xmlReader, int sgIdx) {
+    const QXmlStreamAttributes attributes = xmlReader.attributes();
+    string nodeId = attributeValue(attributes, "id");
+    // if needed, register a node in the graph we are building
+    uint n = builder->nodeIndex(nodeId);
+
+    if (nodesDeclared.size() < builder->numberOfNodes()) {
+      nodesDeclared.resize(builder->numberOfNodes(), false);
+    }
+
+    // the node may have been registered before when used
+    // as an edge extremity or as a parent
+    bool firstDeclaration = !nodesDeclared[n];
+    nodesDeclared[n] = true;
+
+    if (firstDeclaration && sgIdx != -1) {
+      subGraphs[sgIdx].second.push_back(n);
     }
 
     // parse node label
-    if (xmlReader.attributes().hasAttribute("label")) {
-      string nodeLabel = QStringToTlpString(xmlReader.attributes().value("label").toString());
-      viewLabel->setNodeValue(n, nodeLabel);
+    if (attributes.hasAttribute("label")) {
+      nodeLabels->append(n, attributeValue(attributes, "label"));
     }
 
     // parse node pid
-    if (xmlReader.attributes().hasAttribute("pid")) {
-      string pid = QStringToTlpString(xmlReader.attributes().value("pid").toString());
+    if (attributes.hasAttribute("pid")) {
+      string pid = attributeValue(attributes, "pid");
 
-      if (g == graph) {
-        g = addInParent(n, pid);
+      if (sgIdx == -1 && firstDeclaration) {
+        sgIdx = addInParent(n, pid);
       } else {
         cerr << "multiple parents are not supported: " << pid.c_str()
              << " will be not added as parent of " << nodeId.c_str() << endl;
@@ -290,81 +342,65 @@ public:
 
     xmlReader.readNext();
 
-    while (!(xmlReader.isEndElement() && xmlReader.name() == QString("node"))) {
+    while (!xmlReader.atEnd() &&
+           !(xmlReader.isEndElement() && xmlReader.name() == QLatin1String("node"))) {
+      if (!xmlReader.isStartElement()) {
+        xmlReader.readNext();
+        continue;
+      }
+
+      const auto name = xmlReader.qualifiedName();
+
       // parse node color
-      if (xmlReader.isStartElement() && xmlReader.qualifiedName() == QString("viz:color")) {
-        uint r = xmlReader.attributes().value("r").toString().toUInt();
-        uint g = xmlReader.attributes().value("g").toString().toUInt();
-        uint b = xmlReader.attributes().value("b").toString().toUInt();
+      if (name == QLatin1String("viz:color")) {
+        const QXmlStreamAttributes colorAttributes = xmlReader.attributes();
+        uint r = colorAttributes.value("r").toUInt();
+        uint g = colorAttributes.value("g").toUInt();
+        uint b = colorAttributes.value("b").toUInt();
         float a = 1.0f;
 
-        if (xmlReader.attributes().hasAttribute("a")) {
-          a = xmlReader.attributes().value("a").toString().toFloat();
+        if (colorAttributes.hasAttribute("a")) {
+          a = colorAttributes.value("a").toFloat();
         }
 
-        viewColor->setNodeValue(n, Color(uchar(r), uchar(g), uchar(b), uchar(a * 255)));
+        nodeColors->append(n, Color(uchar(r), uchar(g), uchar(b), uchar(a * 255)));
       }
       // parse node coordinates
-      else if (xmlReader.isStartElement() && xmlReader.qualifiedName() == QString("viz:position")) {
+      else if (name == QLatin1String("viz:position")) {
         nodesHaveCoordinates = true;
-        float x = xmlReader.attributes().value("x").toString().toFloat();
-        float y = xmlReader.attributes().value("y").toString().toFloat();
-        float z = xmlReader.attributes().value("z").toString().toFloat();
-        viewLayout->setNodeValue(n, Coord(x, y, z));
+        const QXmlStreamAttributes posAttributes = xmlReader.attributes();
+        float x = posAttributes.value("x").toFloat();
+        float y = posAttributes.value("y").toFloat();
+        float z = posAttributes.value("z").toFloat();
+        nodeCoords->append(n, Coord(x, y, z));
       }
       // parse node size
-      else if (xmlReader.isStartElement() && xmlReader.qualifiedName() == QString("viz:size")) {
-        float size = xmlReader.attributes().value("value").toString().toFloat();
-        viewSize->setNodeValue(n, Size(size, size, size));
+      else if (name == QLatin1String("viz:size")) {
+        float size = xmlReader.attributes().value("value").toFloat();
+        nodeSizes->append(n, Size(size, size, size));
       }
       // parse node attributes
-      else if (xmlReader.isStartElement() && xmlReader.qualifiedName() == QString("attvalue")) {
-        string attributeId;
-
-        if (xmlReader.attributes().hasAttribute("id")) {
-          attributeId = QStringToTlpString(xmlReader.attributes().value("id").toString());
-        } else if (xmlReader.attributes().hasAttribute("for")) {
-          attributeId = QStringToTlpString(xmlReader.attributes().value("for").toString());
-        }
-
-        string attributeStrValue =
-            QStringToTlpString(xmlReader.attributes().value("value").toString());
-
-        if (nodePropertiesMap.find(attributeId) != nodePropertiesMap.end()) {
-          nodePropertiesMap[attributeId]->setNodeStringValue(n, attributeStrValue);
-        }
+      else if (name == QLatin1String("attvalue")) {
+        parseAttributeValue(xmlReader, nodeColumnsMap, n);
       }
       // check for subgraph
-      else if (xmlReader.isStartElement() && xmlReader.qualifiedName() == QString("nodes")) {
-        Graph *sg = nullptr;
-        if (const auto it = nodeToSubgraph.find(n); it != nodeToSubgraph.end()) {
-          sg = it->second;
-        }
-
-        if (sg == nullptr) {
-          // add subgraph
-          sg = graph->addSubGraph();
-          // record the current node as its fake meta node
-          sg->setAttribute<node>("meta-node", n);
-          // and vice-versa
-          nodeToSubgraph[n] = sg;
-        }
-
+      else if (name == QLatin1String("nodes")) {
         // create its nodes
-        createNodes(xmlReader, sg);
-      } else if (xmlReader.isStartElement() && xmlReader.qualifiedName() == QString("edges")) {
+        createNodes(xmlReader, subGraphIndex(n));
+      } else if (name == QLatin1String("edges")) {
         // create its edges
         createEdges(xmlReader);
-      } else if (xmlReader.isStartElement() && xmlReader.qualifiedName() == QString("parents")) {
-        while (!(xmlReader.isEndElement() && xmlReader.name() == QString("parents"))) {
+      } else if (name == QLatin1String("parents")) {
+        while (!xmlReader.atEnd() &&
+               !(xmlReader.isEndElement() && xmlReader.name() == QLatin1String("parents"))) {
           xmlReader.readNext();
 
           // must be a parent
-          if (xmlReader.isStartElement() && xmlReader.name() == QString("parent")) {
-            string pid = QStringToTlpString(xmlReader.attributes().value("for").toString());
+          if (xmlReader.isStartElement() && xmlReader.name() == QLatin1String("parent")) {
+            string pid = attributeValue(xmlReader.attributes(), "for");
 
-            if (g == graph) {
-              g = addInParent(n, pid);
+            if (sgIdx == -1 && firstDeclaration) {
+              sgIdx = addInParent(n, pid);
             } else {
               cerr << "multiple parents are not supported: " << pid.c_str()
                    << " will be not added as parent of " << nodeId.c_str() << endl;
@@ -377,49 +413,48 @@ public:
     }
   }
 
-  // Parse edge data
-  void parseEdge(QXmlStreamReader &xmlReader) {
-    // parse the source node id and target node id
-    string srcId = QStringToTlpString(xmlReader.attributes().value("source").toString());
-    string tgtId = QStringToTlpString(xmlReader.attributes().value("target").toString());
-
-    // Check if nodes have been parsed
-    if (!nodesMap.empty()) {
-      // add an edge in the graph we are building
-      edge e = graph->addEdge(nodesMap[srcId], nodesMap[tgtId]);
-
-      if (xmlReader.attributes().hasAttribute("label")) {
-        string edgeLabel = QStringToTlpString(xmlReader.attributes().value("label").toString());
-        viewLabel->setEdgeValue(e, edgeLabel);
-      }
-
-      xmlReader.readNext();
-
-      while (!(xmlReader.isEndElement() && xmlReader.name() == QString("edge"))) {
-        // parse edge attribute
-        if (xmlReader.isStartElement() && xmlReader.qualifiedName() == QString("attvalue")) {
-          string attributeId;
+  // Parse an attribute value of the element at index idx
+  void parseAttributeValue(QXmlStreamReader &xmlReader,
+                           unordered_map<string, GraphStreamBuilder::Column *> &columnsMap,
+                           uint idx) {
+    const QXmlStreamAttributes attributes = xmlReader.attributes();
+    string attributeId;
+
+    if (attributes.hasAttribute("id")) {
+      attributeId = attributeValue(attributes, "id");
+    } else if (attributes.hasAttribute("for")) {
+      attributeId = attributeValue(attributes, "for");
+    }
 
-          if (xmlReader.attributes().hasAttribute("id")) {
-            attributeId = QStringToTlpString(xmlReader.attributes().value("id").toString());
-          } else if (xmlReader.attributes().hasAttribute("for")) {
-            attributeId = QStringToTlpString(xmlReader.attributes().value("for").toString());
-          }
+    if (const auto it = columnsMap.find(attributeId); it != columnsMap.end()) {
+      it->second->appendString(idx, attributeValue(attributes, "value"));
+    }
+  }
 
-          string attributeStrValue =
-              QStringToTlpString(xmlReader.attributes().value("value").toString());
+  // Parse edge data
+  void parseEdge(QXmlStreamReader &xmlReader) {
+    const QXmlStreamAttributes attributes = xmlReader.attributes();
+    // register the source node and the target node if they
+    // have not been parsed yet, edges may be declared before nodes
+    uint src = builder->nodeIndex(attributeValue(attributes, "source"));
+    uint tgt = builder->nodeIndex(attributeValue(attributes, "target"));
+    // register an edge in the graph we are building
+    uint e = builder->addEdge(src, tgt);
+
+    if (attributes.hasAttribute("label")) {
+      edgeLabels->append(e, attributeValue(attributes, "label"));
+    }
 
-          if (edgePropertiesMap.find(attributeId) != edgePropertiesMap.end()) {
-            edgePropertiesMap[attributeId]->setEdgeStringValue(e, attributeStrValue);
-          }
-        }
+    xmlReader.readNext();
 
-        xmlReader.readNext();
+    while (!xmlReader.atEnd() &&
+           !(xmlReader.isEndElement() && xmlReader.name() == QLatin1String("edge"))) {
+      // parse edge attribute
+      if (xmlReader.isStartElement() && xmlReader.qualifiedName() == QLatin1String("attvalue")) {
+        parseAttributeValue(xmlReader, edgeColumnsMap, e);
       }
 
-      // Store edge extremities information to add them to the graph once nodes will be parsed
-    } else {
-      edgesTmp.push_back(make_pair(srcId, tgtId));
+      xmlReader.readNext();
     }
   }
 
@@ -570,15 +605,28 @@ public:
   }
 
 private:
-  // maps associating attribute id to Talipot property
-  unordered_map<string, PropertyInterface *> nodePropertiesMap;
-  unordered_map<string, PropertyInterface *> edgePropertiesMap;
-
-  // map associating GEXF node id to Talipot node
-  unordered_map<string, node> nodesMap;
-
-  // vector to store edge information in case edges are declared before nodes in GEXF file
-  vector<pair<string, string>> edgesTmp;
+  // the builder buffering the parsed graph elements
+  GraphStreamBuilder *builder = nullptr;
+
+  // maps associating attribute id to the column buffering its values
+  unordered_map<string, GraphStreamBuilder::Column *> nodeColumnsMap;
+  unordered_map<string, GraphStreamBuilder::Column *> edgeColumnsMap;
+
+  // columns buffering the visual attributes values
+  GraphStreamBuilder::NodeColumn<StringProperty, string> *nodeLabels = nullptr;
+  GraphStreamBuilder::EdgeColumn<StringProperty, string> *edgeLabels = nullptr;
+  GraphStreamBuilder::NodeColumn<ColorProperty, Color> *nodeColors = nullptr;
+  GraphStreamBuilder::NodeColumn<LayoutProperty, Coord> *nodeCoords = nullptr;
+  GraphStreamBuilder::NodeColumn<SizeProperty, Size> *nodeSizes = nullptr;
+
+  // flags the registered nodes which have been declared in the file
+  vector<bool> nodesDeclared;
+
+  // the subgraphs to create, each one is described by
+  // the index of its fake meta node and the indices of its nodes
+  vector<pair<uint, vector<uint>>> subGraphs;
+  // index of the subgraph corresponding to a fake meta node index
+  unordered_map<uint, int> nodeToSubgraphIdx;
 
   // Visual attributes properties pointers to the graph we are building
   LayoutProperty *viewLayout;
@@ -0,0 +1,400 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/ImportModule.h>
+#include <talipot/TlpQtTools.h>
+#include <talipot/LayoutProperty.h>
+#include <talipot/SizeProperty.h>
+#include <talipot/ColorProperty.h>
+#include <talipot/StringProperty.h>
+#include <talipot/IntegerProperty.h>
+#include <talipot/DoubleProperty.h>
+#include <talipot/BooleanProperty.h>
+
+#include "GraphStreamBuilder.h"
+
+#include <QXmlStreamReader>
+#include <QFile>
+
+using namespace tlp;
+using namespace std;
+
+/** \file
+ *  \brief - Import GraphML format graph file.
+ * This plugin imports a graph from a file in GraphML format
+ * (http://graphml.graphdrawing.org/).
+ * Nested graphs are flattened and hyperedges or ports are not supported.
+ * The edges referencing nodes not declared in the file are ignored,
+ * unless the creation of those nodes is requested.
+ */
+
+static constexpr std::string_view paramHelp[] = {
+    // filename
+    "This parameter defines the pathname of the GraphML file to import.",
+
+    // create undeclared nodes
+    "If true, the nodes referenced by an edge but not declared in the file are created. "
+    "Otherwise the edges referencing them are ignored."};
+
+class GraphMLImport : public ImportModule {
+
+  // description of a declared GraphML attribute
+  struct Attribute {
+    string name;
+    // columns buffering the values of the attribute
+    // for nodes and edges
+    GraphStreamBuilder::Column *nodeColumn = nullptr;
+    GraphStreamBuilder::Column *edgeColumn = nullptr;
+  };
+
+  // the graph element whose data are currently parsed
+  struct Element {
+    ElementType type;
+    uint idx;
+    // visual attributes of a node that may be
+    // defined by several GraphML attributes
+    Coord coord;
+    Size size;
+    Color color;
+    bool hasCoord = false, hasSize = false, hasColor = false;
+  };
+
+public:
+  PLUGININFORMATION("GraphML", "Antoine Lambert", "14/05/2017",
+                    "<p>Supported extension: graphml</p><p>Imports a graph from a file in the "
+                    "GraphML format (http://graphml.graphdrawing.org/).<br/>"
+                    "GraphML is a comprehensive and easy-to-use file format for graphs. "
+                    "It consists of a language core to describe the structural properties "
+                    "of a graph and a flexible extension mechanism to add application-specific "
+                    "data.</p>",
+                    "1.1", "File")
+  GraphMLImport(const PluginContext *context) : ImportModule(context) {
+    addInParameter<string>("file::filename", paramHelp[0].data(), "");
+    addInParameter<bool>("create undeclared nodes", paramHelp[1].data(), "false", false);
+  }
+
+  std::list<std::string> fileExtensions() const override {
+    return {"graphml"};
+  }
+
+  bool importGraph() override {
+    string filename;
+    bool createUndeclaredNodes = false;
+
+    // the previous version of the plugin named that parameter "filename"
+    if (!dataSet->get<string>("file::filename", filename) || filename.empty()) {
+      dataSet->get<string>("filename", filename);
+    }
+
+    dataSet->get<bool>("create undeclared nodes", createUndeclaredNodes);
+
+    QFile xmlFile(tlpStringToQString(filename));
+
+    if (!xmlFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+      pluginProgress->setError(QStringToTlpString(xmlFile.errorString()));
+      return false;
+    }
+
+    viewLabel = graph->getStringProperty("viewLabel");
+
+    // nodes, edges and attributes values are buffered while streaming
+    // the file and only added to the graph once it has been fully parsed
+    GraphStreamBuilder graphBuilder(graph);
+    builder = &graphBuilder;
+    nodeLabels = builder->addNodeColumn<StringProperty, string>(viewLabel);
+    nodeCoords =
+        builder->addNodeColumn<LayoutProperty, Coord>(graph->getLayoutProperty("viewLayout"));
+    nodeSizes = builder->addNodeColumn<SizeProperty, Size>(graph->getSizeProperty("viewSize"));
+    nodeColors = builder->addNodeColumn<ColorProperty, Color>(graph->getColorProperty("viewColor"));
+
+    QXmlStreamReader xmlReader(&xmlFile);
+
+    while (!xmlReader.atEnd()) {
+      xmlReader.readNext();
+
+      if (xmlReader.isStartElement()) {
+        const auto name = xmlReader.name();
+
+        // attribute definition
+        if (name == QLatin1String("key")) {
+          parseKey(xmlReader);
+        }
+        // node definition
+        else if (name == QLatin1String("node")) {
+          const QXmlStreamAttributes attributes = xmlReader.attributes();
+          string nodeId = attributeValue(attributes, "id");
+          Element element;
+          element.type = NODE;
+          element.idx = builder->nodeIndex(nodeId);
+
+          if (element.idx >= nodesDeclared.size()) {
+            nodesDeclared.resize(element.idx + 1, false);
+          }
+
+          nodesDeclared[element.idx] = true;
+          // the id is the default node label
+          nodeLabels->append(element.idx, nodeId);
+          elements.push_back(element);
+          updateProgress(xmlReader);
+        }
+        // edge definition
+        else if (name == QLatin1String("edge")) {
+          const QXmlStreamAttributes attributes = xmlReader.attributes();
+          // edges may reference nodes declared later in the file
+          uint src = builder->nodeIndex(attributeValue(attributes, "source"));
+          uint tgt = builder->nodeIndex(attributeValue(attributes, "target"));
+          Element element;
+          element.type = EDGE;
+          element.idx = builder->addEdge(src, tgt);
+          elements.push_back(element);
+          updateProgress(xmlReader);
+        }
+        // attribute value
+        else if (name == QLatin1String("data")) {
+          parseData(xmlReader);
+        }
+      } else if (xmlReader.isEndElement()) {
+        const auto name = xmlReader.name();
+
+        if (name == QLatin1String("node")) {
+          commitNodeVisualAttributes(elements.back());
+          elements.pop_back();
+        } else if (name == QLatin1String("edge")) {
+          elements.pop_back();
+        }
+      }
+    }
+
+    xmlFile.close();
+
+    if (pluginProgress->state() != TLP_CONTINUE) {
+      return pluginProgress->state() != TLP_CANCEL;
+    }
+
+    if (xmlReader.hasError()) {
+      pluginProgress->setError("line " + to_string(xmlReader.lineNumber()) + ": " +
+                               QStringToTlpString(xmlReader.errorString()));
+      return false;
+    }
+
+    builder->commit();
+
+    if (!createUndeclaredNodes) {
+      // the edges referencing the undeclared nodes are deleted with them
+      vector<node> undeclaredNodes;
+
+      for (uint i = 0; i < builder->numberOfNodes(); ++i) {
+        if (i >= nodesDeclared.size() || !nodesDeclared[i]) {
+          undeclaredNodes.push_back(builder->getNode(i));
+        }
+      }
+
+      graph->delNodes(undeclaredNodes);
+    }
+
+    builder = nullptr;
+
+    return true;
+  }
+
+private:
+  static string attributeValue(const QXmlStreamAttributes &attributes, const char *name) {
+    return QStringToTlpString(attributes.value(name).toString());
+  }
+
+  // Report parsing progress, the parsing is aborted
+  // if the import has been stopped or cancelled
+  void updateProgress(QXmlStreamReader &xmlReader) {
+    QIODevice *device = xmlReader.device();
+
+    if (!builder->updateProgress(pluginProgress, device->pos(), device->size())) {
+      xmlReader.raiseError("import stopped");
+    }
+  }
+
+  // try to create a Talipot property based on GraphML attribute type
+  PropertyInterface *getGraphProperty(const string &attrName, const string &attrType) {
+    if (attrType == "string") {
+      return graph->getStringProperty(attrName);
+    } else if (attrType == "boolean") {
+      return graph->getBooleanProperty(attrName);
+    } else if (attrType == "int" || attrType == "long") {
+      return graph->getIntegerProperty(attrName);
+    } else if (attrType == "double" || attrType == "float") {
+      return graph->getDoubleProperty(attrName);
+    }
+    return nullptr;
+  }
+
+  // parse an attribute definition and its optional default value
+  void parseKey(QXmlStreamReader &xmlReader) {
+    const QXmlStreamAttributes attributes = xmlReader.attributes();
+    string attrId = attributeValue(attributes, "id");
+    string attrFor = attributeValue(attributes, "for");
+    string attrType = "string";
+    Attribute attr;
+    attr.name = attrId;
+
+    if (attributes.hasAttribute("attr.name")) {
+      attr.name = attributeValue(attributes, "attr.name");
+    }
+
+    if (attributes.hasAttribute("attr.type")) {
+      attrType = attributeValue(attributes, "attr.type");
+    }
+
+    bool forNodes = attrFor == "node" || attrFor == "all";
+    bool forEdges = attrFor == "edge" || attrFor == "all";
+    PropertyInterface *prop = nullptr;
+
+    if (forNodes || forEdges) {
+      // get viewLabel corresponding attribute
+      if (attrType == "string") {
+        if (attr.name == "name") {
+          labelAttribute = attr.name;
+        } else if (attr.name == "label" && labelAttribute != "name") {
+          labelAttribute = attr.name;
+        }
+      }
+
+      // create a Talipot property compatible with the attribute type
+      prop = getGraphProperty(attr.name, attrType);
+
+      if (prop) {
+        if (forNodes) {
+          attr.nodeColumn = builder->addColumn(prop, true);
+        }
+
+        if (forEdges) {
+          attr.edgeColumn = builder->addColumn(prop, false);
+        }
+      }
+    }
+
+    // parse the default value of the attribute
+    while (!xmlReader.atEnd() &&
+           !(xmlReader.isEndElement() && xmlReader.name() == QLatin1String("key"))) {
+      xmlReader.readNext();
+
+      if (xmlReader.isStartElement() && xmlReader.name() == QLatin1String("default")) {
+        string defaultValue = QStringToTlpString(xmlReader.readElementText());
+
+        if (prop && forNodes) {
+          prop->setNodeDefaultStringValue(defaultValue);
+        }
+
+        if (prop && forEdges) {
+          prop->setEdgeDefaultStringValue(defaultValue);
+        }
+      }
+    }
+
+    attributesMap[attrId] = attr;
+  }
+
+  // parse an attribute value of the current graph element
+  void parseData(QXmlStreamReader &xmlReader) {
+    string key = attributeValue(xmlReader.attributes(), "key");
+    string content = QStringToTlpString(xmlReader.readElementText());
+
+    const auto it = attributesMap.find(key);
+
+    if (it == attributesMap.end()) {
+      return;
+    }
+
+    const Attribute &attr = it->second;
+
+    // graph attribute case
+    if (elements.empty()) {
+      graph->setAttribute(attr.name, content);
+    } else if (elements.back().type == NODE) {
+      Element &element = elements.back();
+
+      // try to parse some standard node visual attributes
+      // (label, layout, size, color)
+      if (attr.name == labelAttribute) {
+        nodeLabels->append(element.idx, content);
+      } else if (attr.name == "x" || attr.name == "y") {
+        double v = 0;
+        GraphStreamBuilder::parse(content, v);
+        element.coord[attr.name == "x" ? 0 : 1] = float(v);
+        element.hasCoord = true;
+      } else if (attr.name == "width" || attr.name == "height" || attr.name == "size") {
+        double v = 0;
+        GraphStreamBuilder::parse(content, v);
+
+        if (!element.hasSize) {
+          element.size = nodeSizes->defaultValue();
+          element.hasSize = true;
+        }
+
+        if (attr.name != "height") {
+          element.size[0] = float(v);
+        }
+
+        if (attr.name != "width") {
+          element.size[1] = float(v);
+        }
+      } else if (attr.name == "r" || attr.name == "g" || attr.name == "b") {
+        int v = 0;
+        GraphStreamBuilder::parse(content, v);
+
+        if (!element.hasColor) {
+          element.color = nodeColors->defaultValue();
+          element.hasColor = true;
+        }
+
+        element.color[attr.name == "r" ? 0 : (attr.name == "g" ? 1 : 2)] = uchar(v);
+      }
+
+      if (attr.nodeColumn) {
+        attr.nodeColumn->appendString(element.idx, content);
+      }
+    } else if (attr.edgeColumn) {
+      attr.edgeColumn->appendString(elements.back().idx, content);
+    }
+  }
+
+  void commitNodeVisualAttributes(const Element &element) {
+    if (element.hasCoord) {
+      nodeCoords->append(element.idx, element.coord);
+    }
+
+    if (element.hasSize) {
+      nodeSizes->append(element.idx, element.size);
+    }
+
+    if (element.hasColor) {
+      nodeColors->append(element.idx, element.color);
+    }
+  }
+
+  GraphStreamBuilder *builder = nullptr;
+  StringProperty *viewLabel = nullptr;
+  GraphStreamBuilder::NodeColumn<StringProperty, string> *nodeLabels = nullptr;
+  GraphStreamBuilder::NodeColumn<LayoutProperty, Coord> *nodeCoords = nullptr;
+  GraphStreamBuilder::NodeColumn<SizeProperty, Size> *nodeSizes = nullptr;
+  GraphStreamBuilder::NodeColumn<ColorProperty, Color> *nodeColors = nullptr;
+
+  // map associating GraphML attribute id to its description
+  unordered_map<string, Attribute> attributesMap;
+  // name of the attribute used as node label
+  string labelAttribute;
+  // stack of the graph elements being parsed
+  vector<Element> elements;
+  // flags the registered nodes which have been declared in the file
+  vector<bool> nodesDeclared;
+};
+
+PLUGIN(GraphMLImport)
@@ -0,0 +1,319 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef GRAPH_STREAM_BUILDER_H
+#define GRAPH_STREAM_BUILDER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <talipot/Graph.h>
+#include <talipot/BooleanProperty.h>
+#include <talipot/DoubleProperty.h>
+#include <talipot/IntegerProperty.h>
+#include <talipot/PluginProgress.h>
+#include <talipot/StringProperty.h>
+
+namespace tlp {
+
+/**
+ * @brief Buffers the elements of a graph parsed from a stream and creates
+ * them in one go.
+ *
+ * Streaming import plugins (e.g. GEXF, GraphML) register nodes, edges and
+ * attribute values while reading their input. Elements are only identified by
+ * an index during parsing, the attribute values are stored in typed columns
+ * (no string representation is kept for numeric or boolean values),
+ * and everything is committed at the end through a single Graph::addNodes and
+ * Graph::addEdges call followed by the columns transfer into the properties.
+ */
+class GraphStreamBuilder {
+public:
+  /**
+   * Base class of the typed columns storing the attribute values
+   * of the nodes or the edges.
+   */
+  class Column {
+  public:
+    virtual ~Column() = default;
+    /**
+     * Parses value and stores it for the element at index idx.
+     * Returns false if value is not a valid representation of the column type.
+     */
+    virtual bool appendString(uint idx, const std::string &value) = 0;
+    /**
+     * Transfers the stored values to the property
+     * then releases them.
+     */
+    virtual void commit(const std::vector<node> &nodes, const std::vector<edge> &edges) = 0;
+  };
+
+  template <ElementType ELT, typename PROPERTY, typename VALUE>
+  class ValueColumn : public Column {
+    PROPERTY *prop;
+    std::vector<uint> indices;
+    std::vector<VALUE> values;
+
+  public:
+    ValueColumn(PROPERTY *prop) : prop(prop) {}
+
+    void append(uint idx, const VALUE &value) {
+      indices.push_back(idx);
+      values.push_back(value);
+    }
+
+    // returns the default value of the property for the column elements
+    VALUE defaultValue() const {
+      if constexpr (ELT == NODE) {
+        return prop->getNodeDefaultValue();
+      } else {
+        return prop->getEdgeDefaultValue();
+      }
+    }
+
+    bool appendString(uint idx, const std::string &value) override {
+      VALUE v;
+      if (!parse(value, v)) {
+        return false;
+      }
+      append(idx, v);
+      return true;
+    }
+
+    void commit(const std::vector<node> &nodes, const std::vector<edge> &edges) override {
+      // the values are set in bulk so that only one event is sent
+      if constexpr (ELT == NODE) {
+        std::vector<node> elts;
+        elts.reserve(indices.size());
+        for (auto idx : indices) {
+          elts.push_back(nodes[idx]);
+        }
+        prop->setNodeValues(elts, values);
+      } else {
+        std::vector<edge> elts;
+        elts.reserve(indices.size());
+        for (auto idx : indices) {
+          elts.push_back(edges[idx]);
+        }
+        prop->setEdgeValues(elts, values);
+      }
+      std::vector<uint>().swap(indices);
+      std::vector<VALUE>().swap(values);
+    }
+  };
+
+  template <typename PROPERTY, typename VALUE>
+  using NodeColumn = ValueColumn<NODE, PROPERTY, VALUE>;
+  template <typename PROPERTY, typename VALUE>
+  using EdgeColumn = ValueColumn<EDGE, PROPERTY, VALUE>;
+
+  GraphStreamBuilder(Graph *graph) : graph(graph) {}
+
+  /**
+   * Returns the index of the node registered with the given id.
+   * A new node is registered if that id has not been seen yet.
+   */
+  uint nodeIndex(const std::string &id) {
+    auto it = nodeIds.find(id);
+    if (it != nodeIds.end()) {
+      return it->second;
+    }
+    uint idx = addNode();
+    nodeIds.emplace(id, idx);
+    return idx;
+  }
+
+  /**
+   * Returns whether a node has already been registered with the given id.
+   */
+  bool hasNode(const std::string &id) const {
+    return nodeIds.find(id) != nodeIds.end();
+  }
+
+  /**
+   * Registers a new node without id and returns its index.
+   */
+  uint addNode() {
+    return nbNodes++;
+  }
+
+  /**
+   * Registers a new edge between the nodes at indices src and tgt
+   * and returns its index.
+   */
+  uint addEdge(uint src, uint tgt) {
+    edgesEnds.emplace_back(src, tgt);
+    return edgesEnds.size() - 1;
+  }
+
+  uint numberOfNodes() const {
+    return nbNodes;
+  }
+
+  uint numberOfEdges() const {
+    return edgesEnds.size();
+  }
+
+  /**
+   * Creates a column whose values will be transferred to the nodes of prop.
+   * The returned column is owned by the builder.
+   */
+  template <typename PROPERTY, typename VALUE>
+  NodeColumn<PROPERTY, VALUE> *addNodeColumn(PROPERTY *prop) {
+    auto *column = new NodeColumn<PROPERTY, VALUE>(prop);
+    columns.emplace_back(column);
+    return column;
+  }
+
+  /**
+   * Creates a column whose values will be transferred to the edges of prop.
+   * The returned column is owned by the builder.
+   */
+  template <typename PROPERTY, typename VALUE>
+  EdgeColumn<PROPERTY, VALUE> *addEdgeColumn(PROPERTY *prop) {
+    auto *column = new EdgeColumn<PROPERTY, VALUE>(prop);
+    columns.emplace_back(column);
+    return column;
+  }
+
+  /**
+   * Creates a node or edge column for one of the property types
+   * that can be filled from a string (string, double, integer or boolean).
+   * Returns nullptr for an unsupported property type.
+   */
+  Column *addColumn(PropertyInterface *prop, bool forNodes) {
+    const std::string &type = prop->getTypename();
+    if (type == StringProperty::propertyTypename) {
+      return addColumn<StringProperty, std::string>(prop, forNodes);
+    } else if (type == DoubleProperty::propertyTypename) {
+      return addColumn<DoubleProperty, double>(prop, forNodes);
+    } else if (type == IntegerProperty::propertyTypename) {
+      return addColumn<IntegerProperty, int>(prop, forNodes);
+    } else if (type == BooleanProperty::propertyTypename) {
+      return addColumn<BooleanProperty, bool>(prop, forNodes);
+    }
+    return nullptr;
+  }
+
+  /**
+   * Reports the parsing progress, according to the current position
+   * in the input stream, once every 10000 calls.
+   * Returns false if the import has been stopped or cancelled.
+   */
+  bool updateProgress(PluginProgress *progress, int64_t pos, int64_t size) {
+    if (++nbProgressCalls % 10000) {
+      return true;
+    }
+    return progress->progress(int(pos * 100 / std::max(size, int64_t(1))), 100) == TLP_CONTINUE;
+  }
+
+  /**
+   * Creates the registered nodes and edges in the graph
+   * then fills the properties with the columns values.
+   * The buffered data are released once committed.
+   */
+  void commit() {
+    nodes = graph->addNodes(nbNodes);
+
+    std::vector<std::pair<node, node>> ends;
+    ends.reserve(edgesEnds.size());
+    for (const auto &[src, tgt] : edgesEnds) {
+      ends.emplace_back(nodes[src], nodes[tgt]);
+    }
+    std::vector<std::pair<uint, uint>>().swap(edgesEnds);
+    edges = graph->addEdges(ends);
+
+    for (auto &column : columns) {
+      column->commit(nodes, edges);
+    }
+    columns.clear();
+  }
+
+  /**
+   * Returns the graph node created for the node at index idx.
+   * Only valid after commit.
+   */
+  node getNode(uint idx) const {
+    return nodes[idx];
+  }
+
+  /**
+   * Returns the graph edge created for the edge at index idx.
+   * Only valid after commit.
+   */
+  edge getEdge(uint idx) const {
+    return edges[idx];
+  }
+
+  // parsing of typed values from their string representations
+  static bool parse(const std::string &str, std::string &v) {
+    v = str;
+    return true;
+  }
+
+  static bool parse(const std::string &str, double &v) {
+    char *end = nullptr;
+    v = strtod(str.c_str(), &end);
+    return end != str.c_str();
+  }
+
+  static bool parse(const std::string &str, int &v) {
+    char *end = nullptr;
+    v = int(strtol(str.c_str(), &end, 10));
+    return end != str.c_str();
+  }
+
+  static bool parse(const std::string &str, bool &v) {
+    if (str == "true" || str == "1") {
+      v = true;
+    } else if (str == "false" || str == "0") {
+      v = false;
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  // values of the other types are only appended already typed
+  template <typename VALUE>
+  static bool parse(const std::string &, VALUE &) {
+    return false;
+  }
+
+private:
+  template <typename PROPERTY, typename VALUE>
+  Column *addColumn(PropertyInterface *prop, bool forNodes) {
+    auto *typedProp = static_cast<PROPERTY *>(prop);
+    if (forNodes) {
+      return addNodeColumn<PROPERTY, VALUE>(typedProp);
+    }
+    return addEdgeColumn<PROPERTY, VALUE>(typedProp);
+  }
+
+  Graph *graph;
+  uint nbNodes = 0;
+  uint nbProgressCalls = 0;
+  std::unordered_map<std::string, uint> nodeIds;
+  std::vector<std::pair<uint, uint>> edgesEnds;
+  std::vector<std::unique_ptr<Column>> columns;
+  std::vector<node> nodes;
+  std::vector<edge> edges;
+};
+}
+
+#endif // GRAPH_STREAM_BUILDER_H
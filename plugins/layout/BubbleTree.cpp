@@ -328,32 +328,7 @@ BubbleTree::~BubbleTree() = default;
 bool BubbleTree::run() {
 
   if (!ConnectedTest::isConnected(graph)) {
-    // for each component draw
-    string err;
-    auto components = ConnectedTest::computeConnectedComponents(graph);
-
-    for (const auto &component : components) {
-      Graph *tmp = graph;
-      // apply "Bubble Tree" on the subgraph induced
-      // by the current connected component
-      graph = graph->inducedSubGraph(component);
-      run();
-      tmp->delSubGraph(graph);
-      // restore current graph
-      graph = tmp;
-      if (pluginProgress && pluginProgress->state() != TLP_CONTINUE) {
-        return pluginProgress->state() != TLP_CANCEL;
-      }
-    }
-
-    // call connected component packing
-    LayoutProperty tmpLayout(graph);
-    DataSet tmpdataSet;
-    tmpdataSet.set("coordinates", result);
-    graph->applyPropertyAlgorithm("Connected Component Packing", &tmpLayout, err, &tmpdataSet,
-                                  pluginProgress);
-    *result = tmpLayout;
-    return true;
+    return layoutConnectedComponents();
   }
 
   if (!getNodeSizePropertyParameter(dataSet, nodeSize)) {
@@ -14,6 +14,8 @@
 #include "Circular.h"
 #include "DatasetTools.h"
 
+#include <deque>
+
 PLUGIN(Circular)
 
 using namespace std;
@@ -11,6 +11,10 @@
  *
  */
 
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+
 #include <libvpsc/generate-constraints.h>
 #include <libvpsc/remove_rectangle_overlap.h>
 
@@ -65,6 +69,247 @@ FastOverlapRemoval::FastOverlapRemoval(const tlp::PluginContext *context)
   addInParameter<double>("y border", paramHelp[6].data(), "0.0");
 }
 
+// two rectangles closer than that are not considered as overlapping,
+// it absorbs the rounding errors of the solver
+static const double OVERLAP_EPSILON = 1e-6;
+// the number of rounds of per cluster solving before falling back to a global one
+static const uint MAX_ROUNDS = 16;
+// or when the clusters to solve contain more than this ratio of the rectangles
+static const double MAX_CLUSTERED_RATIO = 0.5;
+// the number of grid cells processed as a whole by a thread
+static const uint CELLS_BLOCK_SIZE = 256;
+// the maximum number of rectangles in a grid cell, as all their pairs are tested
+static const uint MAX_CELL_SIZE = 128;
+
+enum OverlapRemovalType { X_Y_REMOVAL = 0, X_REMOVAL, Y_REMOVAL };
+
+static bool overlap(const vpsc::Rectangle &r1, const vpsc::Rectangle &r2) {
+  return r1.getMinX() < r2.getMaxX() - OVERLAP_EPSILON &&
+         r2.getMinX() < r1.getMaxX() - OVERLAP_EPSILON &&
+         r1.getMinY() < r2.getMaxY() - OVERLAP_EPSILON &&
+         r2.getMinY() < r1.getMaxY() - OVERLAP_EPSILON;
+}
+
+// finds the pairs of overlapping rectangles using a uniform grid:
+// each rectangle is registered in the cells it intersects, then the cells are
+// scanned in parallel and a pair is only reported by the cell containing
+// the lower corner of the intersection of its rectangles;
+// returns false when a cell holds too many rectangles (e.g. when they are coincident)
+static bool findOverlaps(const vector<vpsc::Rectangle> &rects,
+                         vector<pair<uint, uint>> &overlaps) {
+  overlaps.clear();
+  uint nbRects = rects.size();
+
+  if (nbRects < 2) {
+    return true;
+  }
+
+  double minX = DBL_MAX, minY = DBL_MAX, maxX = -DBL_MAX, maxY = -DBL_MAX;
+  double meanWidth = 0, meanHeight = 0;
+
+  for (const auto &r : rects) {
+    minX = min(minX, r.getMinX());
+    minY = min(minY, r.getMinY());
+    maxX = max(maxX, r.getMaxX());
+    maxY = max(maxY, r.getMaxY());
+    meanWidth += r.width();
+    meanHeight += r.height();
+  }
+
+  // the cells are about twice as large as the mean rectangle
+  double cellWidth = max(2 * meanWidth / nbRects, (maxX - minX) / nbRects);
+  double cellHeight = max(2 * meanHeight / nbRects, (maxY - minY) / nbRects);
+  cellWidth = max(cellWidth, OVERLAP_EPSILON);
+  cellHeight = max(cellHeight, OVERLAP_EPSILON);
+  uint nbColumns = uint((maxX - minX) / cellWidth) + 1;
+  uint nbRows = uint((maxY - minY) / cellHeight) + 1;
+
+  // the grid has no more cells than twice the number of rectangles
+  while (double(nbColumns) * nbRows > 2.0 * nbRects) {
+    double ratio = sqrt(double(nbColumns) * nbRows / (2.0 * nbRects));
+    cellWidth *= ratio;
+    cellHeight *= ratio;
+    nbColumns = uint((maxX - minX) / cellWidth) + 1;
+    nbRows = uint((maxY - minY) / cellHeight) + 1;
+  }
+
+  auto column = [&](double x) { return min(uint((x - minX) / cellWidth), nbColumns - 1); };
+  auto row = [&](double y) { return min(uint((y - minY) / cellHeight), nbRows - 1); };
+
+  // the content of the cells is stored contiguously, each cell lists its
+  // rectangles in increasing order
+  uint nbCells = nbColumns * nbRows;
+  vector<uint> cellStarts(nbCells + 1, 0);
+
+  for (const auto &r : rects) {
+    for (uint j = row(r.getMinY()); j <= row(r.getMaxY()); ++j) {
+      for (uint i = column(r.getMinX()); i <= column(r.getMaxX()); ++i) {
+        ++cellStarts[j * nbColumns + i + 1];
+      }
+    }
+  }
+
+  for (uint c = 0; c < nbCells; ++c) {
+    if (cellStarts[c + 1] > MAX_CELL_SIZE) {
+      return false;
+    }
+
+    cellStarts[c + 1] += cellStarts[c];
+  }
+
+  vector<uint> cellRects(cellStarts[nbCells]);
+  vector<uint> cellEnds(cellStarts.begin(), cellStarts.end() - 1);
+
+  for (uint k = 0; k < nbRects; ++k) {
+    const vpsc::Rectangle &r = rects[k];
+
+    for (uint j = row(r.getMinY()); j <= row(r.getMaxY()); ++j) {
+      for (uint i = column(r.getMinX()); i <= column(r.getMaxX()); ++i) {
+        cellRects[cellEnds[j * nbColumns + i]++] = k;
+      }
+    }
+  }
+
+  uint nbBlocks = (nbCells + CELLS_BLOCK_SIZE - 1) / CELLS_BLOCK_SIZE;
+  vector<vector<pair<uint, uint>>> blockOverlaps(nbBlocks);
+
+  TLP_PARALLEL_MAP_INDICES(nbBlocks, [&](uint b) {
+    uint lastCell = min(nbCells, (b + 1) * CELLS_BLOCK_SIZE);
+
+    for (uint c = b * CELLS_BLOCK_SIZE; c < lastCell; ++c) {
+      for (uint k1 = cellStarts[c]; k1 < cellStarts[c + 1]; ++k1) {
+        const vpsc::Rectangle &r1 = rects[cellRects[k1]];
+
+        for (uint k2 = k1 + 1; k2 < cellStarts[c + 1]; ++k2) {
+          const vpsc::Rectangle &r2 = rects[cellRects[k2]];
+
+          if (overlap(r1, r2) &&
+              row(max(r1.getMinY(), r2.getMinY())) * nbColumns +
+                      column(max(r1.getMinX(), r2.getMinX())) ==
+                  c) {
+            blockOverlaps[b].emplace_back(cellRects[k1], cellRects[k2]);
+          }
+        }
+      }
+    }
+  });
+
+  for (const auto &pairs : blockOverlaps) {
+    overlaps.insert(overlaps.end(), pairs.begin(), pairs.end());
+  }
+
+  return true;
+}
+
+static void removeOverlaps(uint type, vector<vpsc::Rectangle> &rects, double xBorder,
+                           double yBorder) {
+  if (type == X_Y_REMOVAL) {
+    removeRectangleOverlap(rects.size(), rects.data(), xBorder, yBorder);
+  } else if (type == X_REMOVAL) {
+    removeRectangleOverlapX(rects.size(), rects.data(), xBorder, yBorder);
+  } else {
+    removeRectangleOverlapY(rects.size(), rects.data(), yBorder);
+  }
+}
+
+static uint findRoot(vector<uint> &parents, uint i) {
+  while (parents[i] != i) {
+    i = parents[i] = parents[parents[i]];
+  }
+
+  return i;
+}
+
+// removes the overlaps of each cluster of overlapping rectangles independently,
+// the clusters being solved in parallel; as moving the rectangles of a cluster
+// may create new overlaps, the clusters are merged and solved again until
+// no overlap remains
+static void removeOverlapsByClusters(uint type, vector<vpsc::Rectangle> &rects, double xBorder,
+                                     double yBorder) {
+  uint nbRects = rects.size();
+  vector<uint> parents(nbRects);
+  vector<pair<uint, uint>> overlaps;
+
+  for (uint i = 0; i < nbRects; ++i) {
+    parents[i] = i;
+  }
+
+  for (uint round = 0;; ++round) {
+    // testing all the pairs of a crowded cell would be quadratic
+    if (!findOverlaps(rects, overlaps)) {
+      removeOverlaps(type, rects, xBorder, yBorder);
+      return;
+    }
+
+    if (overlaps.empty()) {
+      return;
+    }
+
+    vector<bool> toSolve(nbRects, false);
+
+    for (const auto &[i, j] : overlaps) {
+      uint root1 = findRoot(parents, i);
+      uint root2 = findRoot(parents, j);
+      parents[max(root1, root2)] = min(root1, root2);
+    }
+
+    for (const auto &overlapping : overlaps) {
+      toSolve[findRoot(parents, overlapping.first)] = true;
+    }
+
+    uint nbRectsToSolve = 0;
+
+    for (uint i = 0; i < nbRects; ++i) {
+      nbRectsToSolve += toSolve[findRoot(parents, i)];
+    }
+
+    // when the clusters gather most of the rectangles, they are all solved at once
+    // as splitting them is no longer worth it
+    if (round == MAX_ROUNDS || nbRectsToSolve > MAX_CLUSTERED_RATIO * nbRects) {
+      removeOverlaps(type, rects, xBorder, yBorder);
+      return;
+    }
+
+    // the clusters containing an overlap, with their rectangles in increasing order
+    vector<vector<uint>> clusters;
+    vector<uint> clusterIndices(nbRects, UINT_MAX);
+
+    for (uint i = 0; i < nbRects; ++i) {
+      uint root = findRoot(parents, i);
+
+      if (toSolve[root]) {
+        if (clusterIndices[root] == UINT_MAX) {
+          clusterIndices[root] = clusters.size();
+          clusters.emplace_back();
+        }
+
+        clusters[clusterIndices[root]].push_back(i);
+      }
+    }
+
+    // the largest clusters are solved first to balance the load of the threads
+    stable_sort(clusters.begin(), clusters.end(), [](const vector<uint> &c1, const vector<uint> &c2) {
+      return c1.size() > c2.size();
+    });
+
+    TLP_PARALLEL_MAP_INDICES(clusters.size(), [&](uint c) {
+      const vector<uint> &cluster = clusters[c];
+      vector<vpsc::Rectangle> clusterRects;
+      clusterRects.reserve(cluster.size());
+
+      for (uint i : cluster) {
+        clusterRects.push_back(rects[i]);
+      }
+
+      removeOverlaps(type, clusterRects, xBorder, yBorder);
+
+      for (uint k = 0; k < cluster.size(); ++k) {
+        rects[cluster[k]] = clusterRects[k];
+      }
+    });
+  }
+}
+
 /**
  * The following function transfers the node set into vpsc rectangles
  * and runs fast overlap removal.  This vpsc code was a port of Dwyer
@@ -125,16 +370,22 @@ bool FastOverlapRemoval::run() {
     result->setEdgeValue(e, viewLayout->getEdgeValue(e));
   }
 
+  uint type = stringCollection.getCurrent();
   size_t nbNodes = graph->numberOfNodes();
   const std::vector<node> &nodes = graph->nodes();
 
+  // each pass starts from the positions computed by the previous one
+  vector<Coord> positions(nbNodes);
+  TLP_PARALLEL_MAP_NODES_AND_INDICES(
+      graph, [&](const node &n, uint i) { positions[i] = viewLayout->getNodeValue(n); });
+
   vector<vpsc::Rectangle> nodeRectangles(nbNodes);
 
-  for (float passIndex = 1; passIndex <= nbPasses; ++passIndex) {
+  for (int passIndex = 1; passIndex <= nbPasses; ++passIndex) {
     // initialization
     TLP_PARALLEL_MAP_NODES_AND_INDICES(graph, [&](const node &curNode, uint i) {
-      Size sz = viewSize->getNodeValue(curNode) * passIndex / float(nbPasses);
-      const Coord &pos = viewLayout->getNodeValue(curNode);
+      Size sz = viewSize->getNodeValue(curNode) * float(passIndex) / float(nbPasses);
+      const Coord &pos = positions[i];
       double curRot = viewRot->getNodeValue(curNode);
       Size rotSize = Size(sz.getW() * fabs(cos(curRot * M_PI / 180.0)) +
                               sz.getH() * fabs(sin(curRot * M_PI / 180.0)),
@@ -150,19 +401,23 @@ bool FastOverlapRemoval::run() {
     });
 
     // actually apply fast overlap removal
-    if (stringCollection.getCurrentString() == "X-Y") {
-      removeRectangleOverlap(nbNodes, nodeRectangles.data(), xBorder, yBorder);
-    } else if (stringCollection.getCurrentString() == "X") {
-      removeRectangleOverlapX(nbNodes, nodeRectangles.data(), xBorder, yBorder);
-    } else {
-      removeRectangleOverlapY(nbNodes, nodeRectangles.data(), yBorder);
-    }
+    removeOverlapsByClusters(type, nodeRectangles, xBorder, yBorder);
 
-    for (uint i = 0; i < nbNodes; ++i) {
-      Coord newPos = Coord(nodeRectangles[i].getCentreX(), nodeRectangles[i].getCentreY());
-      LayoutAlgorithm::result->setNodeValue(nodes[i], newPos);
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+      positions[i] = Coord(nodeRectangles[i].getCentreX(), nodeRectangles[i].getCentreY());
+    });
+
+    if (pluginProgress && pluginProgress->progress(passIndex, nbPasses) != TLP_CONTINUE) {
+      if (pluginProgress->state() == TLP_CANCEL) {
+        return false;
+      }
+
+      // the positions of the passes done are kept when stopped
+      break;
     }
   }
 
+  result->setNodeValues(nodes, positions);
+
   return true;
 } // end run
@@ -45,7 +45,7 @@ public:
       "Implements a layout algorithm removing the nodes overlaps. It was first published as:<br/>"
       "<b>Fast Node Overlap Removal</b>, Tim Dwyer, Kim Marriot, Peter J. Stuckey, Graph Drawing, "
       "Vol. 3843 (2006), pp. 153-164.",
-      "1.3", "Misc")
+      "1.4", "Misc")
 
   FastOverlapRemoval(const tlp::PluginContext *context);
   ~FastOverlapRemoval() override = default;
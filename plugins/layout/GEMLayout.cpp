@@ -11,7 +11,12 @@
  *
  */
 
+#include <cfloat>
+#include <climits>
+
 #include "GEMLayout.h"
+#include "IncrementalLayout.h"
+#include "MultilevelLayout.h"
 // An implementation of the GEM3D layout algorithm, based on
 // code by Arne Frick placed in the public domain.  See GEMLayout.h for further details.
 
@@ -84,13 +89,16 @@ GEMLayout::GEMLayout(const tlp::PluginContext *context)
   addInParameter<LayoutProperty>("initial layout", paramHelp[2].data(), "", false);
   addInParameter<BooleanProperty>("unmovable nodes", paramHelp[3].data(), "", false);
   addInParameter<uint>("max iterations", paramHelp[4].data(), "0");
+  addMultilevelParameter(this);
+  addIncrementalParameters(this);
   addDependency("Connected Component Packing", "1.0");
 }
 //=========================================================
 GEMLayout::~GEMLayout() = default;
 //=========================================================
 uint GEMLayout::select() {
-  return randomInteger(graph->numberOfNodes() - 1);
+  std::uniform_int_distribution<int> dist(0, graph->numberOfNodes() - 1);
+  return dist(_random);
 }
 //=========================================================
 void GEMLayout::vertexdata_init(const float starttemp) {
@@ -98,7 +106,8 @@ void GEMLayout::vertexdata_init(const float starttemp) {
   _center.fill(0);
 
   for (auto &p : _particules) {
-    p.heat = starttemp;
+    // the fixed nodes do not take part in the temperature
+    p.heat = (fixedNodes && fixedNodes->getNodeValue(p.n)) ? 0 : starttemp;
     _temperature += p.heat * p.heat;
     p.imp.fill(0);
     p.dir = 0;
@@ -126,12 +135,16 @@ Coord GEMLayout::computeForces(uint v, float shake, float gravity, bool testPlac
   node vNode = _particules[v].n;
 
   // Init force in a random position
+  std::uniform_real_distribution<double> dist(0, std::nextafter(2. * shake, DBL_MAX));
+
   for (uint cnt = 0; cnt < _dim; ++cnt) {
-    force[cnt] = shake - float(randomDouble(2. * shake));
+    force[cnt] = shake - float(dist(_random));
   }
 
-  // Add central force
-  force += (_center / float(_nbNodes) - vPos) * vMass * gravity;
+  // Add central force, useless when the unmovable nodes anchor the layout
+  if (fixedNodes == nullptr) {
+    force += (_center / float(_nbNodes) - vPos) * vMass * gravity;
+  }
   //
   double maxEdgeLength;
 
@@ -269,7 +282,10 @@ void GEMLayout::insert() {
 
       d = 0;
 
-      while ((d++ < i_maxiter) && (gemP.heat > i_finaltemp)) {
+      // once the time budget is spent, the nodes are only placed
+      // at the barycenter of their inserted neighbors
+      while ((d++ < i_maxiter) && (gemP.heat > i_finaltemp) &&
+             std::chrono::steady_clock::now() < deadline) {
         this->displace(v, computeForces(v, i_shake, i_gravity, true));
       }
     } else {
@@ -308,6 +324,11 @@ void GEMLayout::displace(uint v, Coord imp) {
 //==========================================================================
 void GEMLayout::a_round() {
   for (uint i = 0; i < _nbNodes; ++i) {
+    // as a round costs O(n^2), the time budget is also checked during it
+    if ((i % 64) == 0 && std::chrono::steady_clock::now() >= deadline) {
+      return;
+    }
+
     uint v = this->select();
     node vNode = _particules[v].n;
 
@@ -343,7 +364,8 @@ void GEMLayout::arrange() {
   stop_temperature = float(a_finaltemp * a_finaltemp * maxEdgeLength * _nbNodes);
   Iteration = 0;
 
-  while (_temperature > stop_temperature && Iteration < max_iter) {
+  while (_temperature > stop_temperature && Iteration < max_iter &&
+         std::chrono::steady_clock::now() < deadline) {
     //    tlp::warning() << "t°:"<< _temperature << "/" << stop_temperature << " it:" << Iteration
     //    << endl;
     if (pluginProgress->progress(Iteration, max_iter / 2) != TLP_CONTINUE) {
@@ -359,39 +381,31 @@ void GEMLayout::arrange() {
 }
 //============================================================================
 bool GEMLayout::run() {
-  if (!ConnectedTest::isConnected(graph)) {
-    // for each component draw
-    string err;
-    auto components = ConnectedTest::computeConnectedComponents(graph);
-
-    for (const auto &component : components) {
-      Graph *tmp = graph;
-      // apply "GEM (Frick)" on the subgraph induced
-      // by the current connected component
-      graph = graph->inducedSubGraph(component);
-      auto result = run();
-      tmp->delSubGraph(graph);
-      // restore current graph
-      graph = tmp;
-      // return if needed
-      if (!result) {
-        return result;
-      }
-    }
+  if (useIncrementalLayout(graph, dataSet)) {
+    return incrementalLayout(this, "unmovable nodes");
+  }
+
+  bool multilevel = useMultilevelLayout(graph, dataSet);
+  LayoutProperty *layout = nullptr;
+  fixedNodes = nullptr;
 
-    // call connected component packing
-    LayoutProperty tmpLayout(graph);
-    DataSet ds;
-    ds.set("coordinates", result);
-    graph->applyPropertyAlgorithm("Connected Component Packing", &tmpLayout, err, &ds,
-                                  pluginProgress);
-    *result = tmpLayout;
-    return true;
+  if (dataSet != nullptr && dataSet->get("initial layout", layout) && layout != nullptr) {
+    dataSet->get("unmovable nodes", fixedNodes);
+  }
+
+  // the packing of the components would move the unmovable nodes
+  if (fixedNodes == nullptr && !ConnectedTest::isConnected(graph)) {
+    // the multilevel scheme creates graphs and plugin instances
+    // so the components are then laid out sequentially
+    return layoutConnectedComponents(!multilevel);
+  }
+
+  if (multilevel) {
+    return multilevelLayout(this);
   }
 
   /* Handle parameters */
   metric = nullptr;
-  LayoutProperty *layout = graph->getLayoutProperty("viewLayout");
 
   bool is3D = false;
   bool initLayout = false;
@@ -403,12 +417,13 @@ bool GEMLayout::run() {
     _useLength = dataSet->get("edge length", metric) && metric != nullptr;
     dataSet->get("max iterations", max_iter);
     initLayout = !dataSet->get("initial layout", layout);
-
-    if (initLayout) {
-      dataSet->get("unmovable nodes", fixedNodes);
-    }
+  } else if (graph->existProperty("viewLayout")) {
+    // no property is created as the components may be laid out concurrently
+    layout = graph->getLayoutProperty("viewLayout");
   }
 
+  deadline = getLayoutDeadline(dataSet);
+
   if (is3D) {
     _dim = 3;
   } else {
@@ -421,7 +436,11 @@ bool GEMLayout::run() {
   result->setAllEdgeValue(vector<Coord>(0));
 
   // initialize a random sequence according the given seed
-  tlp::initRandomSequence();
+  if (getSeedOfRandomSequence() == UINT_MAX) {
+    _random.seed(std::random_device()());
+  } else {
+    _random.seed(getSeedOfRandomSequence());
+  }
 
   if (max_iter == 0) {
     max_iter = std::max(a_maxiter * _nbNodes * _nbNodes, MIN_ITER);
@@ -444,7 +463,7 @@ bool GEMLayout::run() {
     ++i;
   }
 
-  if (initLayout && layout != nullptr) {
+  if (initLayout) {
     if (i_finaltemp < i_starttemp) {
       this->insert();
     }
@@ -14,6 +14,8 @@
 #ifndef GEM_LAYOUT_H
 #define GEM_LAYOUT_H
 
+#include <chrono>
+#include <random>
 #include <vector>
 
 #include <talipot/PluginHeaders.h>
@@ -73,7 +75,7 @@ public:
                     " <b>A fast, adaptive layout algorithm for undirected graphs</b>, A. Frick, A. "
                     "Ludwig, and H. Mehldau, Graph Drawing'94, Volume 894 of Lecture Notes in "
                     "Computer Science (1995).",
-                    "1.2", "Force Directed")
+                    "1.4", "Force Directed")
   GEMLayout(const tlp::PluginContext *context);
   ~GEMLayout() override;
   bool run() override;
@@ -113,6 +115,9 @@ private:
 
   std::vector<GEMparticule> _particules;
   std::vector<int> _map; // for random selection
+  // each instance has its own generator as the
+  // connected components are laid out concurrently
+  std::mt19937 _random;
 
   /*
    * GEM3D variables
@@ -159,6 +164,8 @@ private:
   tlp::NumericProperty *metric;     // metric for edge length
   tlp::BooleanProperty *fixedNodes; // selection of not movable nodes
   uint max_iter;                    // the max number of iterations
+  // the end of the time budget
+  std::chrono::steady_clock::time_point deadline;
 };
 
 #endif // GEM_LAYOUT_H
@@ -11,6 +11,8 @@
  *
  */
 
+#include <climits>
+
 #include "Grip.h"
 #include "Distances.h"
 
@@ -90,6 +92,7 @@ void Grip::computeCurrentGraphLayout() {
     init();
     firstNodesPlacement();
     placement();
+    coords.copyToProperty(result);
   }
 }
 //======================================================
@@ -114,30 +117,12 @@ bool Grip::run() {
     pluginProgress->showStops(false);
   }
 
-  auto components = ConnectedTest::computeConnectedComponents(graph);
-
-  if (components.size() > 1) {
-    for (const auto &component : components) {
-      currentGraph = graph->inducedSubGraph(component);
-      computeCurrentGraphLayout();
-      graph->delSubGraph(currentGraph);
-    }
-
-    string err;
-    DataSet tmp;
-    tmp.set("coordinates", result);
-    LayoutProperty layout(graph);
-    graph->applyPropertyAlgorithm("Connected Component Packing", &layout, err, &tmp);
-
-    for (auto n : graph->nodes()) {
-      result->setNodeValue(n, layout.getNodeValue(n));
-    }
-
-  } else {
-    currentGraph = graph;
-    computeCurrentGraphLayout();
+  if (!ConnectedTest::isConnected(graph)) {
+    return layoutConnectedComponents();
   }
 
+  currentGraph = graph;
+  computeCurrentGraphLayout();
   return true;
 }
 //======================================================
@@ -150,58 +135,54 @@ void Grip::firstNodesPlacement() {
   node n1 = misf->ordering[0];
   node n2 = misf->ordering[1];
   node n3 = misf->ordering[2];
+  uint p1 = ordering[0];
+  uint p2 = ordering[1];
+  uint p3 = ordering[2];
 
   float d12 = getDist(currentGraph, n1, n2);
   float d13 = getDist(currentGraph, n1, n3);
   float d23 = getDist(currentGraph, n2, n3);
 
-  result->setNodeValue(n1, Coord(0, 0, 0));
-  result->setNodeValue(n2, Coord(d12, 0, 0));
+  coords[p1] = Coord(0, 0, 0);
+  coords[p2] = Coord(d12, 0, 0);
 
   float x3 = (d13 * d13 - d23 * d23 + d12 * d12) / (d12 * 2.);
   float y3 = sqrt(d13 * d13 - x3 * x3);
-  result->setNodeValue(n3, Coord(x3, y3, 0));
+  coords[p3] = Coord(x3, y3, 0);
 
   if (_dim == 2) {
-    oldDisp[n1] = Coord(1., 0, 0);
-    oldDisp[n2] = Coord(d12 + 1., 0, 0);
-    oldDisp[n3] = Coord(x3 + 1., y3, 0);
+    oldDisp[p1] = Coord(1., 0, 0);
+    oldDisp[p2] = Coord(d12 + 1., 0, 0);
+    oldDisp[p3] = Coord(x3 + 1., y3, 0);
   } else {
-    Graph *g = currentGraph->addSubGraph();
-    g->addNode(n1);
-    g->addNode(n2);
-    g->addNode(n3);
-    result->rotateX(3.14159 / 2. - (3.14159 * randomInteger(1)), g->getNodes(), g->getEdges());
-    currentGraph->delSubGraph(g);
-
-    const Coord &c1 = result->getNodeValue(n1);
-    const Coord &c2 = result->getNodeValue(n2);
-    const Coord &c3 = result->getNodeValue(n3);
-    oldDisp[n1] = c1;
-    oldDisp[n2] = c2;
-    oldDisp[n3] = c3;
+    // rotate the three nodes around the X axis, the angle being given in degrees
+    double aRot = 2.0 * M_PI * (3.14159 / 2. - (3.14159 * randomInteger(1))) / 360.0;
+    auto cosA = float(cos(aRot));
+    auto sinA = float(sin(aRot));
+
+    for (uint p : {p1, p2, p3}) {
+      Coord &c = coords[p];
+      float y = c[1];
+      c[1] = y * cosA - c[2] * sinA;
+      c[2] = y * sinA + c[2] * cosA;
+      oldDisp[p] = c;
+    }
   }
 
-  neighbors[n1].push_back(n2);
-  neighbors[n1].push_back(n3);
-  neighbors_dist[n1].push_back(uint(d12));
-  neighbors_dist[n1].push_back(uint(d13));
-  neighbors[n2].push_back(n1);
-  neighbors[n2].push_back(n3);
-  neighbors_dist[n2].push_back(uint(d12));
-  neighbors_dist[n2].push_back(uint(d23));
-  neighbors[n3].push_back(n1);
-  neighbors[n3].push_back(n2);
-  neighbors_dist[n3].push_back(uint(d13));
-  neighbors_dist[n3].push_back(uint(d23));
+  neighbors[p1] = {p2, p3};
+  neighbors_dist[p1] = {uint(d12), uint(d13)};
+  neighbors[p2] = {p1, p3};
+  neighbors_dist[p2] = {uint(d12), uint(d23)};
+  neighbors[p3] = {p1, p2};
+  neighbors_dist[p3] = {uint(d13), uint(d23)};
 }
 //======================================================
 void Grip::placement() {
   uint misf_size = misf->index.size();
 
   if (misf_size == 1) {
-    initialPlacement(misf->index[0], misf->ordering.size() - 1);
-    fr_reffinement(0, misf->ordering.size() - 1);
+    initialPlacement(misf->index[0], ordering.size() - 1);
+    fr_reffinement(0, ordering.size() - 1);
     return;
   }
 
@@ -212,39 +193,46 @@ void Grip::placement() {
     ++level;
   }
 
-  initialPlacement(misf->index[misf->index.size() - 1], misf->ordering.size() - 1);
-  fr_reffinement(0, misf->ordering.size() - 1);
+  initialPlacement(misf->index[misf->index.size() - 1], ordering.size() - 1);
+  fr_reffinement(0, ordering.size() - 1);
 }
 //======================================================
 void Grip::seeLayout(uint end) {
   cerr << "profondeur " << level << endl;
 
   for (uint i = 0; i <= end; ++i) {
-    node n = misf->ordering[i];
+    uint p = ordering[i];
 
-    for (uint j = 0; j < neighbors[n].size(); ++j) {
-      cerr << "distance euclidienne "
-           << (result->getNodeValue(n) - result->getNodeValue(neighbors[n][j])).norm() / edgeLength
-           << " et distance dans le graphe " << neighbors_dist[n][j] << endl;
+    for (uint j = 0; j < neighbors[p].size(); ++j) {
+      cerr << "distance euclidienne " << (coords[p] - coords[neighbors[p][j]]).norm() / edgeLength
+           << " et distance dans le graphe " << neighbors_dist[p][j] << endl;
     }
   }
 }
 //======================================================
 void Grip::initialPlacement(uint start, uint end) {
-  for (uint i = start; i <= end; ++i) {
-    node currNode = misf->ordering[i];
-    misf->getNearest(currNode, neighbors[currNode], neighbors_dist[currNode], level,
-                     levelToNbNeighbors[level + 1]);
-  }
+  uint nbNeighbors = levelToNbNeighbors[level + 1];
+
+  // the nearest nodes only depend on the filtering so they are searched in parallel
+  TLP_PARALLEL_MAP_INDICES(end + 1 - start, [&](uint i) {
+    uint p = ordering[start + i];
+    vector<node> nearest;
+    misf->getNearest(misf->ordering[start + i], nearest, neighbors_dist[p], level, nbNeighbors);
+    neighbors[p].resize(nearest.size());
+
+    for (uint j = 0; j < nearest.size(); ++j) {
+      neighbors[p][j] = currentGraph->nodePos(nearest[j]);
+    }
+  });
 
   for (uint i = start; i <= end; ++i) {
-    node currNode = misf->ordering[i];
+    uint p = ordering[i];
     Coord c_tmp;
     float nbConsidered = 0.;
 
-    for (uint j = 0; j < neighbors[currNode].size(); ++j) {
-      c_tmp += result->getNodeValue(neighbors[currNode][j]);
-      oldDisp[currNode] += oldDisp[neighbors[currNode][j]];
+    for (uint n : neighbors[p]) {
+      c_tmp += coords[n];
+      oldDisp[p] += oldDisp[n];
       nbConsidered += 1.;
     }
 
@@ -258,106 +246,88 @@ void Grip::initialPlacement(uint start, uint end) {
     }
 
     c_tmp /= nbConsidered;
-    oldDisp[currNode] /= nbConsidered;
-    oldDisp[currNode] += alea;
+    oldDisp[p] /= nbConsidered;
+    oldDisp[p] += alea;
     c_tmp += alea;
-    result->setNodeValue(currNode, c_tmp);
-    heat[currNode] = edgeLength / 6.0;
-    kk_local_reffinement(currNode);
+    coords[p] = c_tmp;
+    heat[p] = edgeLength / 6.0;
+    kk_local_reffinement(p);
   }
 }
 
 //======================================================
-void Grip::kk_local_reffinement(node currNode) {
-  //  cerr << __PRETTY_FUNCTION__ << endl;
+void Grip::kk_local_reffinement(uint p) {
   uint cpt = 6;
 
   while (cpt > 1) {
-    disp[currNode] = Coord(0, 0, 0);
-    const Coord &c = result->getNodeValue(currNode);
-
-    for (uint j = 0; j < neighbors[currNode].size() /*&& j < 3*/; ++j) {
-      node n = neighbors[currNode][j];
-      const Coord &c_n = result->getNodeValue(n);
-      Coord c_tmp = c_n - c;
-      float euclidian_dist_sqr = c_tmp[0] * c_tmp[0] + c_tmp[1] * c_tmp[1];
+    kk_displacement(p);
+    displace(p);
+    --cpt;
+  }
+}
+//======================================================
+void Grip::kk_displacement(uint p) {
+  disp[p] = Coord(0, 0, 0);
+  const Coord &c = coords[p];
 
-      if (_dim == 3) {
-        euclidian_dist_sqr += c_tmp[2] * c_tmp[2];
-      }
+  for (uint j = 0; j < neighbors[p].size(); ++j) {
+    Coord c_tmp = coords[neighbors[p][j]] - c;
+    float euclidian_dist_sqr = c_tmp[0] * c_tmp[0] + c_tmp[1] * c_tmp[1];
 
-      float th_dist = neighbors_dist[currNode][j];
-      c_tmp *= (euclidian_dist_sqr / (th_dist * th_dist * edgeLength * edgeLength)) - 1.;
-      disp[currNode] += c_tmp;
+    if (_dim == 3) {
+      euclidian_dist_sqr += c_tmp[2] * c_tmp[2];
     }
 
-    displace(currNode);
-    --cpt;
+    float th_dist = neighbors_dist[p][j];
+    c_tmp *= (euclidian_dist_sqr / (th_dist * th_dist * edgeLength * edgeLength)) - 1.;
+    disp[p] += c_tmp;
   }
 }
 //======================================================
-void Grip::displace(node n) {
-  updateLocalTemp(n);
-  float disp_norm = disp[n].norm();
+void Grip::displace(uint p) {
+  updateLocalTemp(p);
+  float disp_norm = disp[p].norm();
 
   if (disp_norm > 1E-4) {
-    disp[n] /= disp_norm;
-    oldDisp[n] = disp[n];
-    disp[n] *= float(heat[n]);
-    result->setNodeValue(n, result->getNodeValue(n) + disp[n]);
+    disp[p] /= disp_norm;
+    oldDisp[p] = disp[p];
+    disp[p] *= float(heat[p]);
+    coords[p] += disp[p];
   }
 }
 //======================================================
 void Grip::kk_reffinement(uint start, uint end) {
-  // cerr << __PRETTY_FUNCTION__ << endl;
   uint cpt = rounds(end, 0, 20, currentGraph->numberOfNodes(), 30) + 2;
 
   while (cpt >= 1) {
-    for (uint i = start; i <= end; ++i) {
-      node currNode = misf->ordering[i];
-      disp[currNode] = Coord(0, 0, 0);
-      const Coord &c = result->getNodeValue(currNode);
-
-      for (uint j = 0; j < neighbors[currNode].size(); ++j) {
-        node n = neighbors[currNode][j];
-        const Coord &c_n = result->getNodeValue(n);
-        Coord c_tmp = c_n - c;
-        float euclidian_dist_sqr = c_tmp[0] * c_tmp[0] + c_tmp[1] * c_tmp[1];
-
-        if (_dim == 3) {
-          euclidian_dist_sqr += c_tmp[2] * c_tmp[2];
-        }
-
-        float th_dist = neighbors_dist[currNode][j];
-        c_tmp *= (euclidian_dist_sqr / (th_dist * th_dist * edgeLength * edgeLength)) - 1.;
-        disp[currNode] += c_tmp;
-      }
-    }
+    // all the displacements are computed from the current positions
+    // before updating them, so the nodes can be processed in parallel
+    TLP_PARALLEL_MAP_INDICES(end + 1 - start, [&](uint i) { kk_displacement(ordering[start + i]); });
 
     // update node position
-    for (uint i = 0; i <= end; ++i) {
-      displace(misf->ordering[i]);
-    }
+    TLP_PARALLEL_MAP_INDICES(end + 1, [&](uint i) { displace(ordering[i]); });
 
     --cpt;
   }
 }
 //======================================================
 void Grip::fr_reffinement(uint start, uint end) {
-  // cerr << __PRETTY_FUNCTION__ << endl;
-
   uint cpt = rounds(end, 0, 20, currentGraph->numberOfNodes(), 30) + 2;
 
   while (cpt >= 1) {
-    for (uint i = start; i <= end; ++i) {
-      node currNode = misf->ordering[i];
-      const Coord &curCoord = result->getNodeValue(currNode);
-      disp[currNode] = Coord(0, 0, 0);
+    // the global random sequence cannot be used in the parallel loop,
+    // so the nodes at the same position are moved apart using
+    // a random generator seeded for each pair of nodes
+    uint seed = randomUnsignedInteger(UINT_MAX);
+
+    TLP_PARALLEL_MAP_INDICES(end + 1 - start, [&](uint i) {
+      uint p = ordering[start + i];
+      const Coord &curCoord = coords[p];
+      disp[p] = Coord(0, 0, 0);
 
       // attractive force calculation
-      for (auto n : currentGraph->getInOutNodes(currNode)) {
-        const Coord &c_n = result->getNodeValue(n);
-        Coord c_tmp = c_n - curCoord;
+      for (uint n : adjacency[p]) {
+        Coord c_tmp = coords[n] - curCoord;
         float euclidian_dist_sqr = c_tmp[0] * c_tmp[0] + c_tmp[1] * c_tmp[1];
 
         if (_dim == 3) {
@@ -365,14 +335,12 @@ void Grip::fr_reffinement(uint start, uint end) {
         }
 
         c_tmp *= euclidian_dist_sqr / (edgeLength * edgeLength);
-        disp[currNode] += c_tmp;
+        disp[p] += c_tmp;
       }
 
       // repulsive force calculation
-      for (uint j = 0; j < neighbors[currNode].size(); ++j) {
-        node n = neighbors[currNode][j];
-        const Coord &c_n = result->getNodeValue(n);
-        Coord c_tmp = curCoord - c_n;
+      for (uint n : neighbors[p]) {
+        Coord c_tmp = curCoord - coords[n];
         double euclidian_dist_sqr =
             double(c_tmp[0]) * double(c_tmp[0]) + double(c_tmp[1]) * double(c_tmp[1]);
 
@@ -381,10 +349,11 @@ void Grip::fr_reffinement(uint start, uint end) {
         }
 
         if (!(euclidian_dist_sqr > 1E-4)) {
-          double alpha = randomDouble(2.0);
-          c_tmp = Coord(alpha - (2. * alpha * randomInteger(1)),
-                        alpha - (2. * alpha * randomInteger(1)),
-                        alpha - (2. * alpha * randomInteger(1)));
+          std::minstd_rand gen(seed ^ (p * 2654435761u) ^ (n * 40503u));
+          double alpha = uniform_real_distribution<double>(0, 2.0)(gen);
+          uniform_int_distribution<int> sign(0, 1);
+          c_tmp = Coord(alpha - (2. * alpha * sign(gen)), alpha - (2. * alpha * sign(gen)),
+                        alpha - (2. * alpha * sign(gen)));
 
           if (_dim == 2) {
             c_tmp[2] = 0.;
@@ -394,47 +363,40 @@ void Grip::fr_reffinement(uint start, uint end) {
         }
 
         c_tmp *= (0.05f * edgeLength * edgeLength) / float(euclidian_dist_sqr);
-        disp[currNode] += c_tmp;
+        disp[p] += c_tmp;
       }
-    }
+    });
 
     // update node position
-    for (uint i = 0; i <= end; ++i) {
-      displace(misf->ordering[i]);
-    }
+    TLP_PARALLEL_MAP_INDICES(end + 1, [&](uint i) { displace(ordering[i]); });
 
     --cpt;
   }
 }
 
 //======================================================
-void Grip::updateLocalTemp(node v) {
-  // cerr << __PRETTY_FUNCTION__ << endl;
-  float oldDisp_norm = oldDisp[v].norm();
-  float curDisp_norm = disp[v].norm();
+void Grip::updateLocalTemp(uint p) {
+  float oldDisp_norm = oldDisp[p].norm();
+  float curDisp_norm = disp[p].norm();
 
   if (curDisp_norm * oldDisp_norm > 1E-4) {
 
-    double scalar = disp[v].dotProduct(oldDisp[v]);
+    double scalar = disp[p].dotProduct(oldDisp[p]);
     double cos = scalar / (curDisp_norm * oldDisp_norm);
 
-    Coord tmp1 = oldDisp[v] / oldDisp_norm;
-    Coord tmp2 = disp[v] / curDisp_norm;
+    Coord tmp1 = oldDisp[p] / oldDisp_norm;
+    Coord tmp2 = disp[p] / curDisp_norm;
 
     double sin = (tmp2 ^ tmp1).norm();
 
     double r = 6.;
     double o = 6.0;
 
-    heat[v] += cos * r * heat[v];
-    /*
-    heat[v] = std::max(heat[v], 0.001);
-    heat[v] = std::min(heat[v], 2. * edgeLength/6.0);
-    */
-    heat[v] += sin * o * heat[v];
+    heat[p] += cos * r * heat[p];
+    heat[p] += sin * o * heat[p];
 
-    heat[v] = std::max(heat[v], edgeLength / 300.);
-    heat[v] = std::min(heat[v], edgeLength / 4.0);
+    heat[p] = std::max(heat[p], edgeLength / 300.);
+    heat[p] = std::min(heat[p], edgeLength / 4.0);
   }
 }
 //======================================================
@@ -450,13 +412,32 @@ uint Grip::rounds(uint x, uint max, uint maxVal, uint min, uint minVal) {
 }
 //======================================================
 void Grip::init() {
-  // cerr << __PRETTY_FUNCTION__ << endl;
   set_nbr_size();
   edgeLength = 32.;
   level = 0;
 
-  double diam = sqrt(currentGraph->numberOfNodes());
-  for (auto n : currentGraph->nodes()) {
+  const std::vector<node> &nodes = currentGraph->nodes();
+  uint nbNodes = nodes.size();
+  coords.alloc(currentGraph);
+  disp.alloc(currentGraph);
+  oldDisp.alloc(currentGraph);
+  heat.alloc(currentGraph);
+  adjacency.alloc(currentGraph);
+  neighbors.alloc(currentGraph);
+  neighbors_dist.alloc(currentGraph);
+  ordering.resize(misf->ordering.size());
+
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+    ordering[i] = currentGraph->nodePos(misf->ordering[i]);
+
+    for (auto n : currentGraph->getInOutNodes(nodes[i])) {
+      adjacency[i].push_back(currentGraph->nodePos(n));
+    }
+  });
+
+  double diam = sqrt(nbNodes);
+
+  for (uint i = 0; i < nbNodes; ++i) {
     Coord alea = Coord(diam - (2. * diam * randomInteger(1)), diam - (2. * diam * randomInteger(1)),
                        diam - (2. * diam * randomInteger(1)));
 
@@ -464,17 +445,17 @@ void Grip::init() {
       alea[2] = 0.;
     }
 
-    result->setNodeValue(n, alea);
-    disp[n] = Coord(0, 0, 0);
-    oldDisp[n] = Coord(0, 0, 0);
-    heat[n] = edgeLength / 6.;
+    coords[i] = alea;
+    disp[i] = Coord(0, 0, 0);
+    oldDisp[i] = Coord(0, 0, 0);
+    heat[i] = edgeLength / 6.;
   }
 }
 //======================================================
 void Grip::init_heat(uint end) {
 
   for (uint i = 0; i <= end; ++i) {
-    heat[misf->ordering[i]] = edgeLength / 6.;
+    heat[ordering[i]] = edgeLength / 6.;
   }
 }
 //======================================================
@@ -15,6 +15,7 @@
 #define GRIP_H
 
 #include <talipot/PluginHeaders.h>
+#include <talipot/VectorProperty.h>
 #include <unordered_map>
 #include "MISFiltering.h"
 
@@ -45,7 +46,7 @@ public:
                     "<b>GRIP: Graph dRawing with Intelligent Placement</b>, P. Gajer and S.G. "
                     "Kobourov, Journal Graph Algorithm and Applications, vol. 6, no. 3, pages "
                     "203--224, (2002).",
-                    "1.1", "Force Directed")
+                    "1.2", "Force Directed")
 
   Grip(const tlp::PluginContext *);
   ~Grip() override;
@@ -58,11 +59,12 @@ private:
   void firstNodesPlacement();
   void placement();
   void initialPlacement(uint, uint);
-  void kk_local_reffinement(tlp::node);
+  void kk_local_reffinement(uint);
+  void kk_displacement(uint);
   void kk_reffinement(uint, uint);
   void fr_reffinement(uint, uint);
-  void displace(tlp::node);
-  void updateLocalTemp(tlp::node);
+  void displace(uint);
+  void updateLocalTemp(uint);
   void init();
   void init_heat(uint);
 
@@ -75,13 +77,20 @@ private:
   MISFiltering *misf;
   float edgeLength;
   int level;
-  std::unordered_map<tlp::node, std::vector<uint>> neighbors_dist;
-  std::unordered_map<tlp::node, std::vector<tlp::node>> neighbors;
+  // the per node data below are indexed by the node positions in currentGraph
+  // the positions of the nodes in the ordering computed by the filtering
+  std::vector<uint> ordering;
+  // the positions of the neighbours of the nodes in the graph
+  tlp::NodeVectorProperty<std::vector<uint>> adjacency;
+  // the positions of the nearest nodes of the nodes at the current level
+  // and their distances in the graph
+  tlp::NodeVectorProperty<std::vector<uint>> neighbors;
+  tlp::NodeVectorProperty<std::vector<uint>> neighbors_dist;
   std::unordered_map<uint, uint> levelToNbNeighbors;
-  std::unordered_map<tlp::node, tlp::Coord> disp;
-  std::unordered_map<tlp::node, tlp::Coord> oldDisp;
-  std::unordered_map<tlp::node, double> heat;
-  std::unordered_map<tlp::node, double> oldCos;
+  tlp::NodeVectorProperty<tlp::Coord> coords;
+  tlp::NodeVectorProperty<tlp::Coord> disp;
+  tlp::NodeVectorProperty<tlp::Coord> oldDisp;
+  tlp::NodeVectorProperty<double> heat;
 
   tlp::Graph *currentGraph;
   int _dim;
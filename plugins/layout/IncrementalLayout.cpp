@@ -0,0 +1,513 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <deque>
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+#include <talipot/AlgorithmResultsCache.h>
+#include <talipot/ParallelTools.h>
+#include <talipot/PluginsManager.h>
+
+#include "IncrementalLayout.h"
+
+using namespace std;
+using namespace tlp;
+
+#define CHANGED_NODES "changed nodes"
+#define NEIGHBORHOOD_DEPTH "neighborhood depth"
+#define TIME_BUDGET "time budget"
+
+static constexpr std::string_view paramHelp[] = {
+    // changed nodes
+    "The nodes added or modified since the previous layout of the graph. When given, the layout "
+    "is updated incrementally: the existing layout (the initial layout if any, else the "
+    "viewLayout property) is kept and only the nodes close to the changed ones are moved.",
+
+    // neighborhood depth
+    "In the incremental mode, the nodes up to this number of edges away from a changed node are "
+    "moved, the other ones stay in place.",
+
+    // time budget
+    "The maximum time in milliseconds spent refining the layout, 0 means no limit.",
+
+    // time budget of the incremental mode only
+    "The maximum time in milliseconds spent refining the layout in the incremental mode, "
+    "0 means no limit. It does not apply to the computation of a whole layout."};
+
+// the maximum number of iterations of the local spring embedder
+static const uint MAX_RELAXATION_ITERATIONS = 100;
+// its temperature, relative to the edge length, decreases by this factor at each iteration
+static const float COOLING_FACTOR = 0.95f;
+static const float MIN_TEMPERATURE = 0.01f;
+
+void addIncrementalParameters(LayoutAlgorithm *pLayout, bool incrementalTimeBudgetOnly) {
+  pLayout->addInParameter<BooleanProperty>(CHANGED_NODES, paramHelp[0].data(), "", false);
+  // the incremental layout starts from the current values of the result
+  AlgorithmResultsCache::addResultInputParameter(pLayout->name(), CHANGED_NODES);
+  pLayout->addInParameter<uint>(NEIGHBORHOOD_DEPTH, paramHelp[1].data(), "2");
+  pLayout->addInParameter<uint>(TIME_BUDGET, paramHelp[incrementalTimeBudgetOnly ? 3 : 2].data(),
+                                "0");
+}
+
+bool useIncrementalLayout(const Graph *, const DataSet *dataSet) {
+  BooleanProperty *changedNodes = nullptr;
+  return dataSet != nullptr && dataSet->get(CHANGED_NODES, changedNodes) &&
+         changedNodes != nullptr;
+}
+
+chrono::steady_clock::time_point getLayoutDeadline(const DataSet *dataSet) {
+  uint timeBudget = 0;
+
+  if (dataSet != nullptr && dataSet->get(TIME_BUDGET, timeBudget) && timeBudget > 0) {
+    return chrono::steady_clock::now() + chrono::milliseconds(timeBudget);
+  }
+
+  return chrono::steady_clock::time_point::max();
+}
+
+void setRemainingTimeBudget(DataSet &dataSet, chrono::steady_clock::time_point deadline) {
+  if (deadline != chrono::steady_clock::time_point::max()) {
+    auto remaining =
+        chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now());
+    // 0 would mean no limit
+    dataSet.set(TIME_BUDGET, uint(std::max<long long>(remaining.count(), 1)));
+  }
+}
+
+static vector<vector<uint>> getNeighbors(const Graph *graph) {
+  const vector<node> &nodes = graph->nodes();
+  vector<vector<uint>> neighbors(nodes.size());
+
+  for (uint i = 0; i < nodes.size(); ++i) {
+    for (auto n : graph->getInOutNodes(nodes[i])) {
+      if (n != nodes[i]) {
+        neighbors[i].push_back(graph->nodePos(n));
+      }
+    }
+  }
+
+  return neighbors;
+}
+
+// places each changed node near its already placed neighbors, in breadth first order
+// from the unchanged nodes; the components only made of changed nodes
+// are started on the right of the existing layout
+static void placeChangedNodes(const vector<vector<uint>> &neighbors, const vector<bool> &changed,
+                              float edgeLength, mt19937 &random, vector<Coord> &coords) {
+  uint nbNodes = coords.size();
+  vector<bool> placed(nbNodes);
+  vector<bool> queued(nbNodes, false);
+  deque<uint> queue;
+  Coord minCoord(FLT_MAX, FLT_MAX, FLT_MAX), maxCoord(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+  bool hasPlacedNodes = false;
+
+  auto enqueueNeighbors = [&](uint i) {
+    for (uint j : neighbors[i]) {
+      if (!placed[j] && !queued[j]) {
+        queued[j] = true;
+        queue.push_back(j);
+      }
+    }
+  };
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    placed[i] = !changed[i];
+
+    if (placed[i]) {
+      minCoord = tlp::minVector(minCoord, coords[i]);
+      maxCoord = tlp::maxVector(maxCoord, coords[i]);
+      hasPlacedNodes = true;
+    }
+  }
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    if (placed[i]) {
+      enqueueNeighbors(i);
+    }
+  }
+
+  uint nbNewComponents = 0;
+  uniform_real_distribution<float> angles(0, 2 * M_PI);
+
+  auto place = [&](uint i) {
+    Coord center;
+    uint nbPlacedNeighbors = 0;
+
+    for (uint j : neighbors[i]) {
+      if (placed[j]) {
+        center += coords[j];
+        ++nbPlacedNeighbors;
+      }
+    }
+
+    if (nbPlacedNeighbors > 0) {
+      float angle = angles(random);
+      coords[i] = center / float(nbPlacedNeighbors) +
+                  Coord(0.5f * edgeLength * cos(angle), 0.5f * edgeLength * sin(angle), 0);
+    } else {
+      float y = 2 * edgeLength * nbNewComponents++;
+      coords[i] =
+          hasPlacedNodes ? Coord(maxCoord[0] + 2 * edgeLength, minCoord[1] + y, 0) : Coord(0, y, 0);
+    }
+
+    placed[i] = true;
+    enqueueNeighbors(i);
+  };
+
+  auto placeQueuedNodes = [&]() {
+    while (!queue.empty()) {
+      place(queue.front());
+      queue.pop_front();
+    }
+  };
+
+  placeQueuedNodes();
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    if (!placed[i]) {
+      place(i);
+      placeQueuedNodes();
+    }
+  }
+}
+
+// the key of the cell (x, y) of a grid
+static uint64_t cellKey(int64_t x, int64_t y) {
+  return (uint64_t(uint32_t(x)) << 32) | uint32_t(y);
+}
+
+// a Fruchterman-Reingold spring embedder restricted to the local graph,
+// the repulsive forces are ignored beyond twice the edge length
+// so they are only computed between the nodes of neighbor cells of a grid of that size
+static void relaxLocalLayout(const vector<vector<uint>> &neighbors, const vector<bool> &pinned,
+                             float edgeLength, chrono::steady_clock::time_point deadline,
+                             vector<Coord> &coords) {
+  uint nbNodes = coords.size();
+  float cellSize = 2 * edgeLength;
+  float maxDist2 = cellSize * cellSize;
+  float temperature = edgeLength;
+  vector<Coord> displacements(nbNodes);
+  // the nodes sorted by cell and the range of each cell in this order
+  vector<pair<uint64_t, uint>> cellNodes(nbNodes);
+  unordered_map<uint64_t, pair<uint, uint>> cells;
+
+  auto cellOf = [cellSize](const Coord &c) {
+    return make_pair(int64_t(floor(c[0] / cellSize)), int64_t(floor(c[1] / cellSize)));
+  };
+
+  for (uint iter = 0; iter < MAX_RELAXATION_ITERATIONS &&
+                      temperature > MIN_TEMPERATURE * edgeLength &&
+                      chrono::steady_clock::now() < deadline;
+       ++iter) {
+    for (uint i = 0; i < nbNodes; ++i) {
+      const auto &[x, y] = cellOf(coords[i]);
+      cellNodes[i] = {cellKey(x, y), i};
+    }
+
+    sort(cellNodes.begin(), cellNodes.end());
+    cells.clear();
+
+    for (uint first = 0, last = 0; first < nbNodes; first = last) {
+      while (last < nbNodes && cellNodes[last].first == cellNodes[first].first) {
+        ++last;
+      }
+
+      cells.emplace(cellNodes[first].first, make_pair(first, last));
+    }
+
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+      Coord force;
+
+      if (!pinned[i]) {
+        const auto &[x, y] = cellOf(coords[i]);
+
+        for (int64_t cx = x - 1; cx <= x + 1; ++cx) {
+          for (int64_t cy = y - 1; cy <= y + 1; ++cy) {
+            auto it = cells.find(cellKey(cx, cy));
+
+            if (it == cells.end()) {
+              continue;
+            }
+
+            for (uint k = it->second.first; k < it->second.second; ++k) {
+              uint j = cellNodes[k].second;
+              Coord delta = coords[i] - coords[j];
+              float dist2 = delta.dotProduct(delta);
+
+              if (j != i && dist2 > 0 && dist2 < maxDist2) {
+                force += delta * (edgeLength * edgeLength / dist2);
+              }
+            }
+          }
+        }
+
+        for (uint j : neighbors[i]) {
+          Coord delta = coords[j] - coords[i];
+          force += delta * (delta.norm() / edgeLength);
+        }
+
+        float norm = force.norm();
+
+        if (norm > temperature) {
+          force *= temperature / norm;
+        }
+      }
+
+      displacements[i] = force;
+    });
+
+    for (uint i = 0; i < nbNodes; ++i) {
+      coords[i] += displacements[i];
+    }
+
+    temperature *= COOLING_FACTOR;
+  }
+}
+
+// runs a new instance of the plugin on the local graph with its boundary pinned,
+// the nodes and edges of the local graph are copies of nodes and edges
+static bool layoutLocalGraph(LayoutAlgorithm *pLayout, const string &unmovableNodesParameter,
+                             Graph *localGraph, const vector<node> &nodes,
+                             const vector<edge> &edges, const vector<bool> &pinned,
+                             chrono::steady_clock::time_point deadline, vector<Coord> &coords) {
+  const vector<node> &localNodes = localGraph->nodes();
+  const vector<edge> &localEdges = localGraph->edges();
+  DataSet dataSet = *pLayout->dataSet;
+  dataSet.remove(CHANGED_NODES);
+  // the values of the property parameters are copied on the local graph,
+  // the properties given in the dataset in unregistered properties,
+  // the ones used by default under the same name
+  vector<unique_ptr<PropertyInterface>> properties;
+
+  for (const auto &param : pLayout->getParameters().getParameters()) {
+    if (param.getDirection() == OUT_PARAM || !DataType::isTalipotProperty(param.getTypeName()) ||
+        param.getName() == unmovableNodesParameter || param.getName() == "initial layout") {
+      continue;
+    }
+
+    PropertyInterface *prop = nullptr;
+    PropertyInterface *localProp = nullptr;
+    DataType *value = nullptr;
+
+    if (dataSet.exists(param.getName())) {
+      value = dataSet.getData(param.getName());
+      prop = value->getProperty();
+
+      if (prop != nullptr) {
+        localProp = prop->clonePrototype(localGraph, "");
+        properties.emplace_back(localProp);
+        value->setProperty(localProp);
+        dataSet.setData(param.getName(), value);
+      }
+
+      delete value;
+    } else if (!param.getDefaultValue().empty() &&
+               pLayout->graph->existProperty(param.getDefaultValue())) {
+      prop = pLayout->graph->getProperty(param.getDefaultValue());
+      localProp = prop->clonePrototype(localGraph, param.getDefaultValue());
+    }
+
+    if (localProp != nullptr) {
+      for (uint i = 0; i < localNodes.size(); ++i) {
+        localProp->copy(localNodes[i], nodes[i], prop, true);
+      }
+
+      for (uint i = 0; i < localEdges.size(); ++i) {
+        localProp->copy(localEdges[i], edges[i], prop, true);
+      }
+    }
+  }
+
+  LayoutProperty initialLayout(localGraph);
+  LayoutProperty localResult(localGraph);
+  BooleanProperty unmovableNodes(localGraph);
+  initialLayout.setNodeValues(localNodes, coords);
+
+  for (uint i = 0; i < localNodes.size(); ++i) {
+    unmovableNodes.setNodeValue(localNodes[i], pinned[i]);
+  }
+
+  dataSet.set("initial layout", &initialLayout);
+  dataSet.set(unmovableNodesParameter, &unmovableNodes);
+  dataSet.set("result", &localResult);
+
+  setRemainingTimeBudget(dataSet, deadline);
+
+  AlgorithmContext context(localGraph, &dataSet, pLayout->pluginProgress);
+  unique_ptr<LayoutAlgorithm> layout(
+      PluginsManager::getPluginObject<LayoutAlgorithm>(pLayout->name(), &context));
+  string errorMessage;
+
+  if (layout == nullptr || !layout->check(errorMessage)) {
+    pLayout->pluginProgress->setError(errorMessage);
+    return false;
+  }
+
+  if (!layout->run()) {
+    return false;
+  }
+
+  for (uint i = 0; i < localNodes.size(); ++i) {
+    coords[i] = localResult.getNodeValue(localNodes[i]);
+  }
+
+  return true;
+}
+
+bool incrementalLayout(LayoutAlgorithm *pLayout, const string &unmovableNodesParameter) {
+  Graph *graph = pLayout->graph;
+  const DataSet *dataSet = pLayout->dataSet;
+  auto deadline = getLayoutDeadline(dataSet);
+  BooleanProperty *changedNodes = nullptr;
+  LayoutProperty *layout = nullptr;
+  uint depth = 2;
+  dataSet->get(CHANGED_NODES, changedNodes);
+  dataSet->get(NEIGHBORHOOD_DEPTH, depth);
+
+  if (!dataSet->get("initial layout", layout) || layout == nullptr) {
+    layout = graph->getLayoutProperty("viewLayout");
+  }
+
+  const vector<node> &nodes = graph->nodes();
+  uint nbNodes = nodes.size();
+  vector<Coord> coords(nbNodes);
+  vector<bool> changed(nbNodes);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    coords[i] = layout->getNodeValue(nodes[i]);
+    changed[i] = changedNodes->getNodeValue(nodes[i]);
+  }
+
+  // the edge length is the mean one of the existing layout
+  double edgesLength = 0;
+  uint nbEdges = 0;
+
+  for (auto e : graph->edges()) {
+    const auto &[src, tgt] = graph->ends(e);
+    uint i = graph->nodePos(src), j = graph->nodePos(tgt);
+
+    if (!changed[i] && !changed[j] && i != j) {
+      edgesLength += coords[i].dist(coords[j]);
+      ++nbEdges;
+    }
+  }
+
+  float edgeLength = (nbEdges > 0 && edgesLength > 0) ? edgesLength / nbEdges : 1;
+
+  mt19937 random;
+
+  if (getSeedOfRandomSequence() == UINT_MAX) {
+    random.seed(random_device()());
+  } else {
+    random.seed(getSeedOfRandomSequence());
+  }
+
+  vector<vector<uint>> neighbors = getNeighbors(graph);
+  placeChangedNodes(neighbors, changed, edgeLength, random, coords);
+
+  // the nodes up to depth edges away from a changed node can move,
+  // the ones just beyond are pinned to attach them to the rest of the layout
+  vector<uint> distances(nbNodes, UINT_MAX);
+  vector<node> localNodes;
+  deque<uint> queue;
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    if (changed[i]) {
+      distances[i] = 0;
+      queue.push_back(i);
+    }
+  }
+
+  while (!queue.empty()) {
+    uint i = queue.front();
+    queue.pop_front();
+    localNodes.push_back(nodes[i]);
+
+    if (distances[i] <= depth) {
+      for (uint j : neighbors[i]) {
+        if (distances[j] == UINT_MAX) {
+          distances[j] = distances[i] + 1;
+          queue.push_back(j);
+        }
+      }
+    }
+  }
+
+  bool success = true;
+
+  if (!localNodes.empty()) {
+    // the local graph is a standalone copy of the subgraph induced by the local nodes
+    // so that the hierarchy of the graph is not modified
+    uint nbLocalNodes = localNodes.size();
+    vector<uint> localIndex(nbNodes, UINT_MAX);
+
+    for (uint i = 0; i < nbLocalNodes; ++i) {
+      localIndex[graph->nodePos(localNodes[i])] = i;
+    }
+
+    Graph *localGraph = newGraph();
+    localGraph->addNodes(nbLocalNodes);
+    const vector<node> &localGraphNodes = localGraph->nodes();
+    vector<pair<node, node>> localEnds;
+    vector<edge> localEdges;
+
+    for (auto e : graph->edges()) {
+      const auto &[src, tgt] = graph->ends(e);
+      uint i = localIndex[graph->nodePos(src)], j = localIndex[graph->nodePos(tgt)];
+
+      if (i != UINT_MAX && j != UINT_MAX) {
+        localEnds.emplace_back(localGraphNodes[i], localGraphNodes[j]);
+        localEdges.push_back(e);
+      }
+    }
+
+    localGraph->addEdges(localEnds);
+    vector<Coord> localCoords(nbLocalNodes);
+    vector<bool> pinned(nbLocalNodes);
+
+    for (uint i = 0; i < nbLocalNodes; ++i) {
+      uint pos = graph->nodePos(localNodes[i]);
+      localCoords[i] = coords[pos];
+      pinned[i] = distances[pos] > depth;
+    }
+
+    if (unmovableNodesParameter.empty()) {
+      relaxLocalLayout(getNeighbors(localGraph), pinned, edgeLength, deadline, localCoords);
+    } else {
+      success = layoutLocalGraph(pLayout, unmovableNodesParameter, localGraph, localNodes,
+                                 localEdges, pinned, deadline, localCoords);
+    }
+
+    for (uint i = 0; i < nbLocalNodes; ++i) {
+      if (!pinned[i]) {
+        coords[graph->nodePos(localNodes[i])] = localCoords[i];
+      }
+    }
+
+    delete localGraph;
+  }
+
+  if (success) {
+    pLayout->result->setNodeValues(nodes, coords);
+    // no bends
+    pLayout->result->setAllEdgeValue(vector<Coord>(0));
+  }
+
+  return success;
+}
@@ -0,0 +1,72 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef INCREMENTAL_LAYOUT_H
+#define INCREMENTAL_LAYOUT_H
+
+#include <chrono>
+
+#include <talipot/PluginHeaders.h>
+
+/**
+ * The incremental mode shared by the force directed layout plugins.
+ *
+ * When some nodes of an already laid out graph have been added or modified,
+ * the existing layout (the "initial layout" parameter or the viewLayout property)
+ * is kept: the changed nodes are first placed near their neighbors, then only
+ * the nodes close to them are refined while the other ones stay in place.
+ * The refinement is done by the plugin itself on the induced subgraph of these nodes,
+ * its boundary being pinned with the parameter given to incrementalLayout().
+ * A plugin without such a parameter is refined by a local spring embedder.
+ *
+ * A plugin uses it by declaring the incremental parameters in its constructor
+ * with addIncrementalParameters(), then by starting its run method with:
+ * @code
+ * if (useIncrementalLayout(graph, dataSet)) {
+ *   return incrementalLayout(this, "unmovable nodes");
+ * }
+ * @endcode
+ * The "time budget" parameter is also meant to bound the iterations of a whole layout,
+ * a plugin that cannot honour it outside of the incremental mode declares it
+ * with incrementalTimeBudgetOnly set to true.
+ */
+
+void addIncrementalParameters(tlp::LayoutAlgorithm *pLayout,
+                              bool incrementalTimeBudgetOnly = false);
+
+/**
+ * Returns true if the changed nodes have been given with the "changed nodes" parameter.
+ */
+bool useIncrementalLayout(const tlp::Graph *graph, const tlp::DataSet *dataSet);
+
+/**
+ * Returns the time at which the iterations of a layout must stop
+ * according to its "time budget" parameter.
+ */
+std::chrono::steady_clock::time_point getLayoutDeadline(const tlp::DataSet *dataSet);
+
+/**
+ * Sets the "time budget" parameter of dataSet to the time remaining before the deadline,
+ * so the runs of the plugin on parts of the graph share the budget of the top-level run.
+ */
+void setRemainingTimeBudget(tlp::DataSet &dataSet, std::chrono::steady_clock::time_point deadline);
+
+/**
+ * Updates the layout of the graph of pLayout in its result around the changed nodes.
+ * The nodes which must not move are given to the plugin with the unmovableNodesParameter
+ * boolean property, if empty the plugin is not used for the refinement.
+ */
+bool incrementalLayout(tlp::LayoutAlgorithm *pLayout,
+                       const std::string &unmovableNodesParameter = "");
+
+#endif // INCREMENTAL_LAYOUT_H
@@ -12,7 +12,9 @@
  */
 
 #include "LinLogAlgorithm.h"
+#include "IncrementalLayout.h"
 #include "LinLogLayout.h"
+#include "MultilevelLayout.h"
 
 using namespace std;
 using namespace tlp;
@@ -57,11 +59,23 @@ LinLogAlgorithm::LinLogAlgorithm(const tlp::PluginContext *context) : LayoutAlgo
   addInParameter<float>("gravitation factor", paramHelp[6].data(), "0.05");
   addInParameter<BooleanProperty>("skip nodes", paramHelp[7].data(), "", false);
   addInParameter<LayoutProperty>("initial layout", paramHelp[8].data(), "", false);
+  addMultilevelParameter(this);
+  addIncrementalParameters(this);
 }
 
 LinLogAlgorithm::~LinLogAlgorithm() = default;
 
 bool LinLogAlgorithm::run() {
+  if (useIncrementalLayout(graph, dataSet)) {
+    return incrementalLayout(this, "skip nodes");
+  }
+
+  if (useMultilevelLayout(graph, dataSet)) {
+    return multilevelLayout(this);
+  }
+
+  auto deadline = getLayoutDeadline(dataSet);
+
   bool is3D = false;
   bool useOctTree = false;
 
@@ -100,6 +114,7 @@ bool LinLogAlgorithm::run() {
 
   // launches the lin log algorithm
   linlog.initAlgo(result, edgeWeight, aExp, rExp, gFac, max_iter, is3D, useOctTree, skipNodes);
+  linlog.setDeadline(deadline);
 
   return linlog.startAlgo();
 }
@@ -37,7 +37,7 @@ public:
                     "first published as:<br/>"
                     "<b>Energy Models for Graph Clustering</b>, Andreas Noack., "
                     "Journal of Graph Algorithms and Applications 11(2):453-480, 2007.",
-                    "1.0", "Force Directed");
+                    "1.2", "Force Directed");
 
   LinLogAlgorithm(const tlp::PluginContext *context);
 
@@ -33,6 +33,7 @@ LinLogLayout::LinLogLayout(tlp::Graph *_graph, tlp::PluginProgress *_pluginProgr
   /** Factor for repulsion energy. */
   repuFactor = 0.0;
   max_iter = 100;
+  deadline = std::chrono::steady_clock::time_point::max();
 }
 
 bool LinLogLayout::initAlgo(tlp::LayoutProperty *_layout, tlp::NumericProperty *_weight,
@@ -621,6 +622,10 @@ bool LinLogLayout::minimizeEnergyNoTree(int nrIterations) {
         pluginProgress->progress(step, nrIterations) != TLP_CONTINUE) {
       return pluginProgress->state() != TLP_CANCEL;
     }
+
+    if (std::chrono::steady_clock::now() >= deadline) {
+      break;
+    }
   }
 
   return true;
@@ -751,6 +756,10 @@ bool LinLogLayout::minimizeEnergy(int nrIterations) {
         pluginProgress->progress(step, nrIterations) != TLP_CONTINUE) {
       return pluginProgress->state() != TLP_CANCEL;
     }
+
+    if (std::chrono::steady_clock::now() >= deadline) {
+      break;
+    }
   }
 
   return true;
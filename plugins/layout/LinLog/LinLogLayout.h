@@ -14,6 +14,8 @@
 #ifndef LIN_LOG_LAYOUT_H
 #define LIN_LOG_LAYOUT_H
 
+#include <chrono>
+
 #include <talipot/PluginHeaders.h>
 #include "OctTree.h"
 
@@ -27,6 +29,11 @@ public:
 
   bool startAlgo();
 
+  // the iterations stop at this time
+  void setDeadline(std::chrono::steady_clock::time_point _deadline) {
+    deadline = _deadline;
+  }
+
 private:
   tlp::NumericProperty *edgeWeight;
   tlp::LayoutProperty *layoutResult;
@@ -40,6 +47,7 @@ private:
   uint _nbNodes; // number of nodes in the graph
   uint max_iter; // the max number of iterations
   bool useOctTree;
+  std::chrono::steady_clock::time_point deadline;
 
   /** Factor for repulsion energy. */
   double repuFactor;
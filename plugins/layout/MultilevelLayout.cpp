@@ -0,0 +1,364 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <memory>
+
+#include <talipot/PluginsManager.h>
+
+#include "IncrementalLayout.h"
+#include "MultilevelLayout.h"
+
+using namespace std;
+using namespace tlp;
+
+#define MULTILEVEL "multilevel"
+#define COARSENINGS "none;matching;independent set"
+
+enum CoarseningType { NO_COARSENING = 0, MATCHING_COARSENING, INDEPENDENT_SET_COARSENING };
+
+static constexpr std::string_view paramHelp[] = {
+    // multilevel
+    "The coarsening used to lay out the graph level by level. With <b>none</b> the whole graph is "
+    "laid out at once, <b>matching</b> collapses the ends of the edges of a maximal matching and "
+    "<b>independent set</b> collapses the nodes of a maximal independent set with their "
+    "neighbors. It is not used when an initial layout is given."};
+
+// the coarsening stops when a level has less nodes than
+static const uint MIN_LEVEL_SIZE = 64;
+// or when it removes less than a fifth of the nodes
+static const double MAX_COARSENING_RATIO = 0.8;
+
+namespace {
+struct Level {
+  Graph *graph = nullptr;
+  // the number of nodes of the finest level collapsed in each node
+  vector<uint> weights;
+  // the position of the parent of each node in the coarser level
+  vector<uint> parents;
+};
+}
+
+void addMultilevelParameter(LayoutAlgorithm *pLayout) {
+  pLayout->addInParameter<StringCollection>(MULTILEVEL, paramHelp[0].data(), COARSENINGS, true,
+                                            "<b>none</b> <br> <b>matching</b> <br> "
+                                            "<b>independent set</b>");
+}
+
+static uint getCoarsening(const DataSet *dataSet) {
+  StringCollection coarsenings;
+
+  if (dataSet != nullptr && dataSet->get(MULTILEVEL, coarsenings)) {
+    return coarsenings.getCurrent();
+  }
+
+  return NO_COARSENING;
+}
+
+bool useMultilevelLayout(const Graph *graph, const DataSet *dataSet) {
+  LayoutProperty *initialLayout = nullptr;
+  return getCoarsening(dataSet) != NO_COARSENING && graph->numberOfNodes() > MIN_LEVEL_SIZE &&
+         !(dataSet->get("initial layout", initialLayout) && initialLayout != nullptr);
+}
+
+// computes the parent of each node of graph, returns the number of parents
+static uint coarsen(const Graph *graph, uint coarsening, const vector<uint> &weights,
+                    vector<uint> &parents) {
+  const vector<node> &nodes = graph->nodes();
+  uint nbNodes = nodes.size();
+  vector<vector<uint>> neighbors(nbNodes);
+  vector<uint> order(nbNodes);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    for (auto n : graph->getInOutNodes(nodes[i])) {
+      neighbors[i].push_back(graph->nodePos(n));
+    }
+
+    order[i] = i;
+  }
+
+  parents.assign(nbNodes, UINT_MAX);
+  uint nbParents = 0;
+
+  if (coarsening == MATCHING_COARSENING) {
+    // the nodes of low degree are matched first,
+    // each one with its lightest unmatched neighbor
+    stable_sort(order.begin(), order.end(), [&neighbors](uint i, uint j) {
+      return neighbors[i].size() < neighbors[j].size();
+    });
+
+    for (uint i : order) {
+      if (parents[i] != UINT_MAX) {
+        continue;
+      }
+
+      uint mate = UINT_MAX;
+
+      for (uint j : neighbors[i]) {
+        if (j != i && parents[j] == UINT_MAX && (mate == UINT_MAX || weights[j] < weights[mate])) {
+          mate = j;
+        }
+      }
+
+      parents[i] = nbParents;
+
+      if (mate != UINT_MAX) {
+        parents[mate] = nbParents;
+      }
+
+      ++nbParents;
+    }
+  } else {
+    // the nodes of high degree are selected first in the independent set
+    stable_sort(order.begin(), order.end(), [&neighbors](uint i, uint j) {
+      return neighbors[i].size() > neighbors[j].size();
+    });
+    vector<bool> covered(nbNodes, false);
+    vector<bool> selected(nbNodes, false);
+    vector<uint> parentWeights;
+
+    for (uint i : order) {
+      if (!covered[i]) {
+        covered[i] = selected[i] = true;
+        parents[i] = nbParents++;
+        parentWeights.push_back(weights[i]);
+
+        for (uint j : neighbors[i]) {
+          covered[j] = true;
+        }
+      }
+    }
+
+    // as the set is maximal, each other node has a selected neighbor,
+    // it is collapsed with the lightest one
+    for (uint i : order) {
+      if (selected[i]) {
+        continue;
+      }
+
+      uint parent = UINT_MAX;
+
+      for (uint j : neighbors[i]) {
+        if (selected[j] &&
+            (parent == UINT_MAX || parentWeights[parents[j]] < parentWeights[parent])) {
+          parent = parents[j];
+        }
+      }
+
+      parents[i] = parent;
+      parentWeights[parent] += weights[i];
+    }
+  }
+
+  return nbParents;
+}
+
+// builds the graph whose nodes are the parents of the nodes of the finer level
+static Graph *buildCoarseGraph(const Graph *graph, const vector<uint> &parents, uint nbParents) {
+  Graph *coarseGraph = newGraph();
+  const vector<node> &coarseNodes = coarseGraph->addNodes(nbParents);
+  vector<pair<uint, uint>> ends;
+  ends.reserve(graph->numberOfEdges());
+
+  for (auto e : graph->edges()) {
+    const auto &[src, tgt] = graph->ends(e);
+    uint p1 = parents[graph->nodePos(src)];
+    uint p2 = parents[graph->nodePos(tgt)];
+
+    if (p1 != p2) {
+      ends.emplace_back(min(p1, p2), max(p1, p2));
+    }
+  }
+
+  // the multiple edges between two parents are merged
+  sort(ends.begin(), ends.end());
+  ends.erase(unique(ends.begin(), ends.end()), ends.end());
+  vector<pair<node, node>> coarseEnds;
+  coarseEnds.reserve(ends.size());
+
+  for (const auto &[p1, p2] : ends) {
+    coarseEnds.emplace_back(coarseNodes[p1], coarseNodes[p2]);
+  }
+
+  coarseGraph->addEdges(coarseEnds);
+  return coarseGraph;
+}
+
+// initializes the layout of a level from the layout of the coarser one:
+// the coarse layout is scaled to give room to the finer level, then the nodes
+// collapsed in the same parent are placed on a small circle around it
+static void prolongate(const Level &level, const Graph *coarseGraph,
+                       const LayoutProperty *coarseLayout, LayoutProperty *layout) {
+  const vector<node> &coarseNodes = coarseGraph->nodes();
+  uint nbCoarseNodes = coarseNodes.size();
+  vector<Coord> coarseCoords(nbCoarseNodes);
+  Coord center;
+
+  for (uint i = 0; i < nbCoarseNodes; ++i) {
+    coarseCoords[i] = coarseLayout->getNodeValue(coarseNodes[i]);
+    center += coarseCoords[i];
+  }
+
+  center /= nbCoarseNodes;
+  const vector<node> &nodes = level.graph->nodes();
+  float scale = sqrt(float(nodes.size()) / nbCoarseNodes);
+  double edgesLength = 0;
+
+  for (auto e : coarseGraph->edges()) {
+    const auto &[src, tgt] = coarseGraph->ends(e);
+    edgesLength += coarseLayout->getNodeValue(src).dist(coarseLayout->getNodeValue(tgt));
+  }
+
+  float radius = 0.25f * scale;
+
+  if (coarseGraph->numberOfEdges() > 0 && edgesLength > 0) {
+    radius *= edgesLength / coarseGraph->numberOfEdges();
+  }
+
+  // the rank of each node among the ones collapsed in its parent
+  vector<uint> sizes(nbCoarseNodes, 0);
+  vector<uint> ranks(nodes.size());
+
+  for (uint i = 0; i < nodes.size(); ++i) {
+    ranks[i] = sizes[level.parents[i]]++;
+  }
+
+  vector<Coord> coords(nodes.size());
+
+  for (uint i = 0; i < nodes.size(); ++i) {
+    uint parent = level.parents[i];
+    coords[i] = center + (coarseCoords[parent] - center) * scale;
+
+    if (sizes[parent] > 1) {
+      // the golden angle varies the orientation of the circles
+      double angle = 2 * M_PI * ranks[i] / sizes[parent] + 2.39996 * parent;
+      coords[i] += Coord(radius * cos(angle), radius * sin(angle), 0);
+    }
+  }
+
+  layout->setNodeValues(nodes, coords);
+}
+
+// runs a new instance of the plugin on a level
+static bool layoutLevel(const string &algorithm, Graph *graph, DataSet dataSet,
+                        LayoutProperty *initialLayout, LayoutProperty *result,
+                        PluginProgress *pluginProgress) {
+  dataSet.set("result", result);
+
+  if (initialLayout != nullptr) {
+    dataSet.set("initial layout", initialLayout);
+  }
+
+  AlgorithmContext context(graph, &dataSet, pluginProgress);
+  unique_ptr<LayoutAlgorithm> layout(
+      PluginsManager::getPluginObject<LayoutAlgorithm>(algorithm, &context));
+  string errorMessage;
+
+  if (layout == nullptr || !layout->check(errorMessage)) {
+    pluginProgress->setError(errorMessage);
+    return false;
+  }
+
+  return layout->run();
+}
+
+bool multilevelLayout(LayoutAlgorithm *pLayout) {
+  // the time budget bounds the layout of all the levels
+  auto deadline = getLayoutDeadline(pLayout->dataSet);
+  Graph *graph = pLayout->graph;
+  uint coarsening = getCoarsening(pLayout->dataSet);
+  vector<Level> levels(1);
+  // the finest level is the graph itself
+  levels[0].graph = graph;
+  levels[0].weights.assign(graph->numberOfNodes(), 1);
+
+  while (levels.back().graph->numberOfNodes() > MIN_LEVEL_SIZE) {
+    Level &level = levels.back();
+    uint nbNodes = level.graph->numberOfNodes();
+    uint nbParents = coarsen(level.graph, coarsening, level.weights, level.parents);
+
+    if (nbParents > MAX_COARSENING_RATIO * nbNodes) {
+      break;
+    }
+
+    Level coarseLevel;
+    coarseLevel.graph = buildCoarseGraph(level.graph, level.parents, nbParents);
+    coarseLevel.weights.assign(nbParents, 0);
+
+    for (uint i = 0; i < nbNodes; ++i) {
+      coarseLevel.weights[level.parents[i]] += level.weights[i];
+    }
+
+    levels.push_back(std::move(coarseLevel));
+  }
+
+  // the levels are laid out by instances of the plugin without multilevel scheme
+  DataSet dataSet;
+
+  if (pLayout->dataSet != nullptr) {
+    dataSet = *pLayout->dataSet;
+  }
+
+  dataSet.remove(MULTILEVEL);
+  dataSet.remove("initial layout");
+  dataSet.remove("result");
+  // the property parameters only apply to the finest level
+  DataSet coarseDataSet = dataSet;
+
+  for (const auto &param : pLayout->getParameters().getParameters()) {
+    if (DataType::isTalipotProperty(param.getTypeName())) {
+      coarseDataSet.remove(param.getName());
+    }
+  }
+
+  bool success = true;
+  unique_ptr<LayoutProperty> coarseLayout;
+
+  for (uint i = levels.size() - 1; success && i > 0; --i) {
+    Graph *levelGraph = levels[i].graph;
+    auto *levelLayout = new LayoutProperty(levelGraph);
+    unique_ptr<LayoutProperty> initialLayout;
+
+    if (coarseLayout) {
+      initialLayout = make_unique<LayoutProperty>(levelGraph);
+      prolongate(levels[i], levels[i + 1].graph, coarseLayout.get(), initialLayout.get());
+    }
+
+    setRemainingTimeBudget(coarseDataSet, deadline);
+    success = layoutLevel(pLayout->name(), levelGraph, coarseDataSet, initialLayout.get(),
+                          levelLayout, pLayout->pluginProgress);
+    coarseLayout.reset(levelLayout);
+  }
+
+  if (success) {
+    LayoutProperty initialLayout(graph);
+
+    if (coarseLayout) {
+      prolongate(levels[0], levels[1].graph, coarseLayout.get(), &initialLayout);
+    }
+
+    setRemainingTimeBudget(dataSet, deadline);
+    success = layoutLevel(pLayout->name(), graph, dataSet, coarseLayout ? &initialLayout : nullptr,
+                          pLayout->result, pLayout->pluginProgress);
+  }
+
+  coarseLayout.reset();
+
+  for (uint i = 1; i < levels.size(); ++i) {
+    delete levels[i].graph;
+  }
+
+  return success;
+}
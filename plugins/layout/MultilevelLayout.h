@@ -0,0 +1,51 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef MULTILEVEL_LAYOUT_H
+#define MULTILEVEL_LAYOUT_H
+
+#include <talipot/PluginHeaders.h>
+
+/**
+ * The multilevel scheme shared by the force directed layout plugins.
+ *
+ * The graph is coarsened level by level, by collapsing the nodes of a maximal matching
+ * or the neighborhoods of a maximal independent set, until it becomes small enough.
+ * The coarsest graph is laid out from scratch by the plugin, then each level is
+ * initialized from the layout of the coarser one and refined by the plugin
+ * using its "initial layout" parameter.
+ *
+ * A plugin uses it by declaring the "multilevel" parameter in its constructor
+ * with addMultilevelParameter(), then by starting its run method with:
+ * @code
+ * if (useMultilevelLayout(graph, dataSet)) {
+ *   return multilevelLayout(this);
+ * }
+ * @endcode
+ */
+
+void addMultilevelParameter(tlp::LayoutAlgorithm *pLayout);
+
+/**
+ * Returns true if a coarsening has been chosen with the "multilevel" parameter,
+ * no initial layout has been given and the graph is large enough to be coarsened.
+ */
+bool useMultilevelLayout(const tlp::Graph *graph, const tlp::DataSet *dataSet);
+
+/**
+ * Lays out the graph of pLayout in its result using the multilevel scheme.
+ * The levels are laid out by new instances of the same plugin.
+ */
+bool multilevelLayout(tlp::LayoutAlgorithm *pLayout);
+
+#endif // MULTILEVEL_LAYOUT_H
@@ -18,6 +18,8 @@
 
 #include <ogdf/energybased/FMMMLayout.h>
 
+#include "IncrementalLayout.h"
+
 using namespace std;
 
 #define ELT_PAGEFORMAT "Page Format"
@@ -236,8 +238,9 @@ public:
   PLUGININFORMATION("FM^3 (OGDF)", "Stephan Hachul", "09/11/2007",
                     "Implements the FM³ layout algorithm by Hachul and Jünger. It is a multilevel, "
                     "force-directed layout algorithm that can be applied to very large graphs.",
-                    "1.4", "Force Directed")
+                    "1.5", "Force Directed")
   OGDFFm3(const tlp::PluginContext *context);
+  bool run() override;
   void beforeCall() override;
   void callOGDFLayoutAlgorithm(ogdf::GraphAttributes &gAttributes) override;
 };
@@ -287,6 +290,18 @@ OGDFFm3::OGDFFm3(const tlp::PluginContext *context)
   addInParameter<tlp::StringCollection>(ELT_SMALLESTCELLFINDING, paramHelp[17].data(),
                                         ELT_SMALLESTCELLFINDINGLIST, true,
                                         smallestCellFindingValuesDescription);
+  // the OGDF implementation has no time limit
+  addIncrementalParameters(this, true);
+}
+
+bool OGDFFm3::run() {
+  // FM^3 cannot keep nodes in place so the incremental layout
+  // is refined by a local spring embedder
+  if (useIncrementalLayout(graph, dataSet)) {
+    return incrementalLayout(this);
+  }
+
+  return OGDFLayoutPluginBase::run();
 }
 
 void OGDFFm3::beforeCall() {
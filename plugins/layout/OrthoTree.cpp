@@ -11,6 +11,7 @@
  *
  */
 
+#include <talipot/GraphParallelTools.h>
 #include <talipot/SizeProperty.h>
 #include <talipot/LayoutProperty.h>
 #include <talipot/VectorProperty.h>
@@ -31,7 +32,7 @@ class OrthoTree : public tlp::LayoutAlgorithm {
   void computeLayout(const tlp::node n, tlp::NodeVectorProperty<double> &verticalSize);
 
 public:
-  PLUGININFORMATION("OrthoTree", "Romain Bourqui", "20/02/2012", "Orthogonal Tree", "1.0", "Tree")
+  PLUGININFORMATION("OrthoTree", "Romain Bourqui", "20/02/2012", "Orthogonal Tree", "1.1", "Tree")
 
   OrthoTree(const tlp::PluginContext *context);
 
@@ -82,11 +83,6 @@ void OrthoTree::computeLayout(const node n, NodeVectorProperty<double> &vertical
 
     prev += verticalSize[u] + nodeSpacing;
     result->setNodeValue(u, c);
-
-    Coord bend = {cn[0], c[1]};
-    vector<Coord> bends(1);
-    bends[0] = bend;
-    result->setEdgeValue(e, bends);
     computeLayout(u, verticalSize);
   }
 }
@@ -116,6 +112,17 @@ bool OrthoTree::run() {
   result->setAllEdgeValue(vector<Coord>(0));
   computeLayout(root, verticalSize);
 
+  // each edge bends at the abscissa of its parent node and the ordinate of its child,
+  // the bends are computed in parallel then set all at once
+  vector<vector<Coord>> bends(tree->numberOfEdges());
+
+  TLP_PARALLEL_MAP_EDGES_AND_INDICES(tree, [&](const edge &e, uint i) {
+    const auto &[src, tgt] = tree->ends(e);
+    bends[i] = {Coord(result->getNodeValue(src)[0], result->getNodeValue(tgt)[1])};
+  });
+
+  result->setEdgeValues(tree->edges(), bends);
+
   TreeTest::cleanComputedTree(graph, tree);
 
   return true;
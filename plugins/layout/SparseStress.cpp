@@ -0,0 +1,487 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <random>
+
+#include <talipot/ConnectedTest.h>
+#include <talipot/GraphMeasure.h>
+#include <talipot/ParallelTools.h>
+#include <talipot/TlpTools.h>
+#include <talipot/VectorProperty.h>
+
+#include "SparseStress.h"
+
+PLUGIN(SparseStress)
+
+using namespace std;
+using namespace tlp;
+
+static constexpr std::string_view paramHelp[] = {
+    // 3D
+    "If true, the layout is in 3D else it is computed in 2D.",
+
+    // edge length
+    "This metric is used to compute the length of edges. If none is given, all the edges have "
+    "the same length.",
+
+    // pivots
+    "The number of pivot nodes the distances are computed from. The memory used by the algorithm "
+    "grows linearly with it.",
+
+    // initial layout
+    "The layout property used to compute the initial position of the nodes. If none is given, the "
+    "initial positions are computed by Pivot MDS.",
+
+    // max iterations
+    "The maximum number of iterations of the stress majorization.",
+
+    // tolerance
+    "The stress majorization stops when the relative decrease of the stress during an iteration "
+    "is lower than this tolerance."};
+
+// the length of the edges when no edge length metric is given
+static const double EDGE_LENGTH = 10;
+// the maximum number of power iterations used to compute the Pivot MDS layout
+static const uint MDS_ITERATIONS = 200;
+// the nodes are processed by blocks of fixed size in the parallel reductions,
+// so their results do not depend on the number of threads
+static const uint BLOCK_SIZE = 4096;
+
+//====================================================
+SparseStress::SparseStress(const tlp::PluginContext *context) : LayoutAlgorithm(context) {
+  addInParameter<bool>("3D layout", paramHelp[0].data(), "false");
+  addInParameter<NumericProperty *>("edge length", paramHelp[1].data(), "", false);
+  addInParameter<uint>("pivots", paramHelp[2].data(), "100");
+  addInParameter<LayoutProperty>("initial layout", paramHelp[3].data(), "", false);
+  addInParameter<uint>("max iterations", paramHelp[4].data(), "200");
+  addInParameter<double>("tolerance", paramHelp[5].data(), "1e-4");
+  addDependency("Connected Component Packing", "1.0");
+}
+//====================================================
+SparseStress::~SparseStress() = default;
+//====================================================
+bool SparseStress::check(string &errorMsg) {
+  NumericProperty *edgeLength = nullptr;
+
+  if (dataSet != nullptr && dataSet->get("edge length", edgeLength) && edgeLength != nullptr &&
+      graph->numberOfEdges() > 0 && edgeLength->getEdgeDoubleMin(graph) <= 0) {
+    errorMsg = "The edge lengths must be positive.";
+    return false;
+  }
+
+  return true;
+}
+//====================================================
+// sums the values computed for each block of [0, size)
+template <typename BlockFunction>
+static double sumByBlocks(uint size, const BlockFunction &blockFunction) {
+  uint nbBlocks = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  vector<double> sums(nbBlocks, 0);
+  TLP_PARALLEL_MAP_INDICES(nbBlocks, [&](uint block) {
+    sums[block] = blockFunction(block * BLOCK_SIZE, min(size, (block + 1) * BLOCK_SIZE));
+  });
+  double sum = 0;
+
+  for (double s : sums) {
+    sum += s;
+  }
+
+  return sum;
+}
+//====================================================
+// computes the Pivot MDS layout (U. Brandes and C. Pich, Eigensolver methods for progressive
+// multidimensional scaling of large data, 2007) from the distances to the pivots:
+// the coordinates are the projections of the double centered matrix C of the squared distances
+// on the main eigenvectors of C^T.C, which are computed by power iterations
+static void pivotMDS(const vector<float> &distances, uint nbNodes, uint nbPivots, uint dim,
+                     vector<Coord> &coords) {
+  vector<double> rowMeans(nbNodes, 0);
+  vector<double> colMeans(nbPivots, 0);
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+    double sum = 0;
+
+    for (uint p = 0; p < nbPivots; ++p) {
+      double d = distances[size_t(i) * nbPivots + p];
+      sum += d * d;
+    }
+
+    rowMeans[i] = sum / nbPivots;
+  });
+
+  double mean = 0;
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    for (uint p = 0; p < nbPivots; ++p) {
+      double d = distances[size_t(i) * nbPivots + p];
+      colMeans[p] += d * d;
+    }
+
+    mean += rowMeans[i];
+  }
+
+  for (auto &colMean : colMeans) {
+    colMean /= nbNodes;
+  }
+
+  mean /= nbNodes;
+
+  auto centered = [&](uint i, uint p) {
+    double d = distances[size_t(i) * nbPivots + p];
+    return -0.5 * (d * d - rowMeans[i] - colMeans[p] + mean);
+  };
+
+  uint nbBlocks = (nbNodes + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  vector<vector<double>> eigenVectors;
+  vector<double> projection(nbNodes);
+  vector<vector<double>> blockSums(nbBlocks, vector<double>(nbPivots));
+  coords.assign(nbNodes, Coord(0, 0, 0));
+
+  for (uint d = 0; d < dim; ++d) {
+    vector<double> v(nbPivots);
+
+    for (uint p = 0; p < nbPivots; ++p) {
+      v[p] = cos(double(p + 1) * (d + 1));
+    }
+
+    for (uint iter = 0; iter < MDS_ITERATIONS; ++iter) {
+      // projection = C.v then w = C^T.projection
+      TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+        double sum = 0;
+
+        for (uint p = 0; p < nbPivots; ++p) {
+          sum += centered(i, p) * v[p];
+        }
+
+        projection[i] = sum;
+      });
+      TLP_PARALLEL_MAP_INDICES(nbBlocks, [&](uint block) {
+        vector<double> &sums = blockSums[block];
+        sums.assign(nbPivots, 0);
+
+        for (uint i = block * BLOCK_SIZE; i < min(nbNodes, (block + 1) * BLOCK_SIZE); ++i) {
+          for (uint p = 0; p < nbPivots; ++p) {
+            sums[p] += centered(i, p) * projection[i];
+          }
+        }
+      });
+      vector<double> w(nbPivots, 0);
+
+      for (const auto &sums : blockSums) {
+        for (uint p = 0; p < nbPivots; ++p) {
+          w[p] += sums[p];
+        }
+      }
+
+      // w is made orthogonal to the previous eigenvectors then normalized
+      for (const auto &u : eigenVectors) {
+        double dot = 0;
+
+        for (uint p = 0; p < nbPivots; ++p) {
+          dot += w[p] * u[p];
+        }
+
+        for (uint p = 0; p < nbPivots; ++p) {
+          w[p] -= dot * u[p];
+        }
+      }
+
+      double norm = 0;
+
+      for (double x : w) {
+        norm += x * x;
+      }
+
+      norm = sqrt(norm);
+
+      if (norm < DBL_EPSILON) {
+        break;
+      }
+
+      double change = 0;
+
+      for (uint p = 0; p < nbPivots; ++p) {
+        w[p] /= norm;
+        change += (w[p] - v[p]) * (w[p] - v[p]);
+      }
+
+      v.swap(w);
+
+      if (change < 1e-12) {
+        break;
+      }
+    }
+
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+      double sum = 0;
+
+      for (uint p = 0; p < nbPivots; ++p) {
+        sum += centered(i, p) * v[p];
+      }
+
+      coords[i][d] = float(sum);
+    });
+    eigenVectors.push_back(std::move(v));
+  }
+}
+//====================================================
+bool SparseStress::run() {
+  if (!ConnectedTest::isConnected(graph)) {
+    return layoutConnectedComponents(true);
+  }
+
+  bool is3D = false;
+  NumericProperty *edgeLength = nullptr;
+  uint nbPivots = 100;
+  LayoutProperty *initialLayout = nullptr;
+  uint maxIterations = 200;
+  double tolerance = 1e-4;
+
+  if (dataSet != nullptr) {
+    dataSet->get("3D layout", is3D);
+    dataSet->get("edge length", edgeLength);
+    dataSet->get("pivots", nbPivots);
+    dataSet->get("initial layout", initialLayout);
+    dataSet->get("max iterations", maxIterations);
+    dataSet->get("tolerance", tolerance);
+  }
+
+  // no bends
+  result->setAllEdgeValue(vector<Coord>(0));
+
+  const vector<node> &nodes = graph->nodes();
+  uint nbNodes = nodes.size();
+
+  if (nbNodes < 2) {
+    result->setAllNodeValue(Coord(0, 0, 0));
+    return true;
+  }
+
+  uint dim = is3D ? 3 : 2;
+  nbPivots = max(1u, min(nbPivots, nbNodes));
+
+  // the pivots are randomly sampled,
+  // using our own generator as the connected components are laid out concurrently
+  mt19937 random;
+
+  if (getSeedOfRandomSequence() == UINT_MAX) {
+    random.seed(random_device()());
+  } else {
+    random.seed(getSeedOfRandomSequence());
+  }
+
+  vector<uint> pivots(nbNodes);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    pivots[i] = i;
+  }
+
+  for (uint p = 0; p < nbPivots; ++p) {
+    uniform_int_distribution<uint> dist(p, nbNodes - 1);
+    swap(pivots[p], pivots[dist(random)]);
+  }
+
+  pivots.resize(nbPivots);
+  sort(pivots.begin(), pivots.end());
+
+  // the distances from the pivots are stored by node
+  double unit = edgeLength != nullptr ? 1 : EDGE_LENGTH;
+  vector<float> distances(size_t(nbNodes) * nbPivots);
+  TLP_PARALLEL_MAP_INDICES(nbPivots, [&](uint p) {
+    NodeVectorProperty<double> distance(graph);
+    maxDistance(graph, pivots[p], distance, edgeLength);
+
+    for (uint i = 0; i < nbNodes; ++i) {
+      distances[size_t(i) * nbPivots + p] = float(unit * distance[i]);
+    }
+  });
+
+  // when stopped, the result is the initial layout computed below
+  if (pluginProgress->progress(1, maxIterations + 2) == TLP_CANCEL) {
+    return false;
+  }
+
+  // each node belongs to the region of its closest pivot, the weight of the
+  // distance between a node and a pivot is the number of nodes of the region
+  // closer to the pivot than half that distance, divided by the squared distance
+  vector<uint> regions(nbNodes);
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+    const float *d = &distances[size_t(i) * nbPivots];
+    regions[i] = uint(min_element(d, d + nbPivots) - d);
+  });
+  vector<vector<float>> regionDistances(nbPivots);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    regionDistances[regions[i]].push_back(distances[size_t(i) * nbPivots + regions[i]]);
+  }
+
+  TLP_PARALLEL_MAP_INDICES(nbPivots, [&](uint p) {
+    sort(regionDistances[p].begin(), regionDistances[p].end());
+  });
+  vector<float> weights(size_t(nbNodes) * nbPivots);
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+    for (uint p = 0; p < nbPivots; ++p) {
+      float d = distances[size_t(i) * nbPivots + p];
+      float w = 0;
+
+      if (d > 0) {
+        const vector<float> &region = regionDistances[p];
+        w = float(upper_bound(region.begin(), region.end(), d / 2) - region.begin()) / (d * d);
+      }
+
+      weights[size_t(i) * nbPivots + p] = w;
+    }
+  });
+  regionDistances.clear();
+
+  // the edges terms of the stress
+  vector<uint> adjacencyStarts(nbNodes + 1, 0);
+  vector<uint> adjacentNodes;
+  vector<float> edgesLengths;
+  adjacentNodes.reserve(2 * graph->numberOfEdges());
+  edgesLengths.reserve(2 * graph->numberOfEdges());
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    for (auto e : graph->getInOutEdges(nodes[i])) {
+      node n = graph->opposite(e, nodes[i]);
+
+      if (n != nodes[i]) {
+        adjacentNodes.push_back(graph->nodePos(n));
+        edgesLengths.push_back(
+            float(edgeLength != nullptr ? edgeLength->getEdgeDoubleValue(e) : EDGE_LENGTH));
+      }
+    }
+
+    adjacencyStarts[i + 1] = adjacentNodes.size();
+  }
+
+  // calls f(j, d, w) for each term of the stress of node i
+  auto forEachTerm = [&](uint i, const auto &f) {
+    for (uint k = adjacencyStarts[i]; k < adjacencyStarts[i + 1]; ++k) {
+      float d = edgesLengths[k];
+      f(adjacentNodes[k], d, 1 / (d * d));
+    }
+
+    for (uint p = 0; p < nbPivots; ++p) {
+      float w = weights[size_t(i) * nbPivots + p];
+
+      if (w > 0) {
+        f(pivots[p], distances[size_t(i) * nbPivots + p], w);
+      }
+    }
+  };
+
+  vector<Coord> coords(nbNodes);
+
+  if (initialLayout != nullptr) {
+    for (uint i = 0; i < nbNodes; ++i) {
+      coords[i] = initialLayout->getNodeValue(nodes[i]);
+
+      if (!is3D) {
+        coords[i][2] = 0;
+      }
+    }
+  } else {
+    pivotMDS(distances, nbNodes, nbPivots, dim, coords);
+    // the Pivot MDS layout is scaled to minimize the stress
+    double num = sumByBlocks(nbNodes, [&](uint begin, uint end) {
+      double sum = 0;
+
+      for (uint i = begin; i < end; ++i) {
+        forEachTerm(i, [&](uint j, float d, float w) { sum += w * d * coords[i].dist(coords[j]); });
+      }
+
+      return sum;
+    });
+    double den = sumByBlocks(nbNodes, [&](uint begin, uint end) {
+      double sum = 0;
+
+      for (uint i = begin; i < end; ++i) {
+        forEachTerm(i, [&](uint j, float, float w) {
+          double dist = coords[i].dist(coords[j]);
+          sum += w * dist * dist;
+        });
+      }
+
+      return sum;
+    });
+
+    if (den > 0) {
+      for (auto &c : coords) {
+        c *= float(num / den);
+      }
+    }
+  }
+
+  // localized stress majorization: each node is moved to the weighted mean
+  // of the positions where its terms would be satisfied, the nodes are updated
+  // in parallel from the positions of the previous iteration
+  vector<Coord> newCoords(nbNodes);
+  vector<double> nodeStress(nbNodes);
+  double previousStress = DBL_MAX;
+
+  for (uint iter = 0; pluginProgress->state() == TLP_CONTINUE && iter < maxIterations; ++iter) {
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+      const Coord &c = coords[i];
+      Coord sum(0, 0, 0);
+      double sumWeights = 0;
+      double stress = 0;
+
+      forEachTerm(i, [&](uint j, float d, float w) {
+        Coord v = c - coords[j];
+        float dist = v.norm();
+
+        if (dist > FLT_EPSILON) {
+          sum += (coords[j] + v * (d / dist)) * w;
+        } else {
+          // the coincident nodes are pushed apart in an arbitrary direction
+          double angle = 2.39996 * (i + 1);
+          sum += (coords[j] + Coord(cos(angle), sin(angle), 0) * d) * w;
+        }
+
+        sumWeights += w;
+        stress += w * (dist - d) * (dist - d);
+      });
+
+      newCoords[i] = sumWeights > 0 ? Coord(sum / float(sumWeights)) : c;
+      nodeStress[i] = stress;
+    });
+
+    coords.swap(newCoords);
+    double stress = 0;
+
+    for (double s : nodeStress) {
+      stress += s;
+    }
+
+    if (previousStress - stress < tolerance * previousStress) {
+      break;
+    }
+
+    previousStress = stress;
+
+    if (pluginProgress->progress(iter + 2, maxIterations + 2) != TLP_CONTINUE) {
+      break;
+    }
+  }
+
+  if (pluginProgress->state() == TLP_CANCEL) {
+    return false;
+  }
+
+  result->setNodeValues(nodes, coords);
+  return true;
+}
@@ -0,0 +1,48 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef SPARSE_STRESS_H
+#define SPARSE_STRESS_H
+
+#include <talipot/PluginHeaders.h>
+
+/** This plugin is an implementation of the sparse stress model first published as:
+ *
+ *  M. Ortmann, M. Klimenta and U. Brandes,
+ *  "A Sparse Stress Model",
+ *  Graph Drawing and Network Visualization 2016,
+ *  Volume 9801 of Lecture Notes in Computer Science, Springer, 2016.
+ *
+ *  Instead of the distances between all the pairs of nodes, the stress only involves
+ *  the edges and the distances to a sample of pivot nodes, weighted by the size of
+ *  the regions of the graph they stand for. The memory used is then O(n.k) for k pivots.
+ *  The initial layout is computed by Pivot MDS from the same distances,
+ *  then it is refined by localized stress majorization.
+ *  The shortest path computations and the position updates are done in parallel.
+ */
+class SparseStress : public tlp::LayoutAlgorithm {
+public:
+  PLUGININFORMATION("Sparse Stress", "Talipot Team", "18/10/2021",
+                    "Implements the sparse stress model first published as:<br/>"
+                    "<b>A Sparse Stress Model</b>, M. Ortmann, M. Klimenta and U. Brandes, "
+                    "Graph Drawing and Network Visualization 2016, Volume 9801 of Lecture Notes "
+                    "in Computer Science (2016).",
+                    "1.0", "Force Directed")
+  SparseStress(const tlp::PluginContext *context);
+  ~SparseStress() override;
+
+  bool check(std::string &errorMsg) override;
+  bool run() override;
+};
+
+#endif // SPARSE_STRESS_H
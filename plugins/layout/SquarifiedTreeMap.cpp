@@ -11,6 +11,9 @@
  *
  */
 
+#include <algorithm>
+
+#include <talipot/ParallelTools.h>
 #include <talipot/ViewSettings.h>
 
 #include "SquarifiedTreeMap.h"
@@ -38,6 +41,11 @@ static constexpr std::string_view paramHelp[] = {
     "This parameter indicates to use normal Treemaps (B. Shneiderman) or Squarified Treemaps (J. "
     "J. van Wijk)",
 
+    // Depth Limit
+    "This parameter defines the depth of the deepest nodes laid out, 0 meaning no limit. "
+    "The descendants of these nodes get a null size at the center of their rectangle, "
+    "they can be laid out later by applying the algorithm on their subtree.",
+
     // Node Size
     "This parameter defines the property used as node sizes.",
 
@@ -50,10 +58,10 @@ SquarifiedTreeMap::SquarifiedTreeMap(const tlp::PluginContext *context) : Layout
   addInParameter<NumericProperty *>("metric", paramHelp[0].data(), "viewMetric", false);
   addInParameter<double>("Aspect Ratio", paramHelp[1].data(), "1.");
   addInParameter<bool>("Treemap Type", paramHelp[2].data(), "false");
-  addOutParameter<SizeProperty>("Node Size", paramHelp[3].data(), "viewSize");
-  addOutParameter<IntegerProperty>("Node Shape", paramHelp[4].data(), "viewShape");
+  addInParameter<uint>("Depth Limit", paramHelp[3].data(), "0");
+  addOutParameter<SizeProperty>("Node Size", paramHelp[4].data(), "viewSize");
+  addOutParameter<IntegerProperty>("Node Shape", paramHelp[5].data(), "viewShape");
 }
-
 //====================================================================
 SquarifiedTreeMap::~SquarifiedTreeMap() = default;
 
@@ -92,12 +100,14 @@ bool SquarifiedTreeMap::check(std::string &errorMsg) {
 bool SquarifiedTreeMap::run() {
   double aspectRatio = DEFAULT_RATIO;
   shneidermanTreeMap = false;
+  depthLimit = 0;
   sizeResult = nullptr;
   glyphResult = nullptr;
 
   if (dataSet != nullptr) {
     dataSet->get("Aspect Ratio", aspectRatio);
     dataSet->get("Treemap Type", shneidermanTreeMap);
+    dataSet->get("Depth Limit", depthLimit);
     dataSet->get("Node Size", sizeResult);
     dataSet->get("Node Shape", glyphResult);
   }
@@ -124,17 +134,48 @@ bool SquarifiedTreeMap::run() {
   node root = graph->getSource();
   computeNodesSize(root);
 
-  Vec2d center = initialSpace.center();
-  result->setNodeValue(root, Coord(float(center[0]), float(center[1]), 0));
-  Size initialSpaceSize = {float(initialSpace.width()), float(initialSpace.height())};
-  sizeResult->setNodeValue(root, initialSpaceSize);
-  vector<node> toTreat(orderedChildren(root));
+  uint nbNodes = nodesPos.size();
+  nodesRect.resize(nbNodes);
+  nodesRect[0] = initialSpace;
+  vector<Coord> coords(nbNodes);
+  vector<Size> sizes(nbNodes);
+
+  // the nodes of a same depth are consecutive and their subtrees are independent,
+  // so the children of all the nodes of a depth are laid out in parallel
+  uint begin = 0, end = 1;
+
+  for (uint depth = 0; begin < end; ++depth) {
+    bool collapse = depthLimit != 0 && depth >= depthLimit;
+
+    TLP_PARALLEL_MAP_INDICES(end - begin, [&](uint i) {
+      uint n = begin + i;
+      const Rectd &rect = nodesRect[n];
+      Vec2d center = rect.center();
+      coords[nodesPos[n]] =
+          Coord(float(center[0]), float(center[1]), float(depth * SEPARATION_Z));
+      sizes[nodesPos[n]] = Size(float(rect.width()), float(rect.height()), 0);
+
+      if (firstChild[n] == firstChild[n + 1]) {
+        return;
+      }
+
+      if (collapse) {
+        for (uint child = firstChild[n]; child < firstChild[n + 1]; ++child) {
+          nodesRect[child] = Rectd(center, center);
+        }
+      } else {
+        squarify(firstChild[n], firstChild[n + 1], adjustRectangle(rect));
+      }
+    });
 
-  if (!toTreat.empty()) {
-    Rectd tmp = adjustRectangle(initialSpace);
-    squarify(toTreat, tmp, 1);
+    begin = firstChild[begin];
+    end = firstChild[end];
   }
 
+  sizes[nodesPos[0]] = Size(float(initialSpace.width()), float(initialSpace.height()));
+  result->setNodeValues(graph->nodes(), coords);
+  sizeResult->setNodeValues(graph->nodes(), sizes);
+
   return true;
 }
 //====================================================================
@@ -154,85 +195,46 @@ tlp::Rectd SquarifiedTreeMap::adjustRectangle(const tlp::Rectd &r) const {
   return result;
 }
 //====================================================================
-void SquarifiedTreeMap::layoutRow(const std::vector<tlp::node> &row, const int depth,
-                                  const tlp::Rectd &rectArea) {
+void SquarifiedTreeMap::layoutRow(uint first, uint last, const tlp::Rectd &rectArea) {
   assert(rectArea.isValid());
-  assert(!row.empty());
+  assert(first < last);
   double rowArea = 0;
 
-  for (auto n : row) {
-    rowArea += nodesSize.get(n.id);
+  for (uint n = first; n < last; ++n) {
+    rowArea += nodesSize[n];
   }
 
   double sum = 0;
   Vec2d dist = rectArea[1] - rectArea[0];
 
-  for (auto n : row) {
+  for (uint n = first; n < last; ++n) {
     Rectd layoutRec(rectArea);
 
     if (rectArea.width() > rectArea.height()) {
       layoutRec[0][0] = rectArea[0][0] + (sum / rowArea) * dist[0];
-      layoutRec[1][0] = layoutRec[0][0] + (nodesSize.get(n.id) / rowArea) * dist[0];
+      layoutRec[1][0] = layoutRec[0][0] + (nodesSize[n] / rowArea) * dist[0];
     } else {
       layoutRec[0][1] = rectArea[0][1] + (sum / rowArea) * dist[1];
-      layoutRec[1][1] = layoutRec[0][1] + (nodesSize.get(n.id) / rowArea) * dist[1];
+      layoutRec[1][1] = layoutRec[0][1] + (nodesSize[n] / rowArea) * dist[1];
     }
 
     assert(layoutRec.isValid());
-    sum += nodesSize.get(n.id);
-    Vec2d center = layoutRec.center();
-    result->setNodeValue(n, Coord(float(center[0]), float(center[1]), float(depth * SEPARATION_Z)));
-    sizeResult->setNodeValue(n, Size(float(layoutRec.width()), float(layoutRec.height()), 0));
-
-    if (graph->outdeg(n) > 0) {
-      vector<node> toTreat(orderedChildren(n));
-      Rectd newRec(adjustRectangle(layoutRec));
-      squarify(toTreat, newRec, depth + 1);
-    }
-  }
-}
-//==================================================================
-class IsGreater {
-public:
-  IsGreater(const tlp::MutableContainer<double> &measure) : measure(measure) {}
-  bool operator()(const node a, const node b) const {
-    return measure.get(a.id) > measure.get(b.id);
-  }
-  const tlp::MutableContainer<double> &measure;
-};
-//======================================
-vector<node> SquarifiedTreeMap::orderedChildren(const tlp::node n) const {
-  // sort children of n and store it in result
-  //======================================
-  vector<node> result(graph->outdeg(n));
-  // build a list of pair <node, size>
-  size_t i = 0;
-  for (auto child : graph->getOutNodes(n)) {
-    result[i++] = child;
+    sum += nodesSize[n];
+    nodesRect[n] = layoutRec;
   }
-  IsGreater sortFunctor(nodesSize);
-  sort(result.begin(), result.end(), sortFunctor);
-  return result;
 }
 //==========================================================
-/*
-class Row {
-    const std::vector<tlp::node> &row;
-    double sumOfNodesSurface;
+double SquarifiedTreeMap::evaluateRow(uint first, uint last, double width, double length,
+                                      double surface) const {
 
-};
-*/
-double SquarifiedTreeMap::evaluateRow(const std::vector<tlp::node> &row, tlp::node n, double width,
-                                      double length, double surface) {
+  double sumOfNodesSurface = nodesSize[last];
 
-  double sumOfNodesSurface = nodesSize.get(n.id);
-
-  for (auto nr : row) {
-    sumOfNodesSurface += nodesSize.get(nr.id);
+  for (uint nr = first; nr < last; ++nr) {
+    sumOfNodesSurface += nodesSize[nr];
   }
 
   //====================
-  double size = nodesSize.get(n.id);
+  double size = nodesSize[last];
   // ratio is the aspect ratio of rectangle of the considered elements
   double nodeRectangleWidth = length * sumOfNodesSurface / surface;
   double nodeRectangleHeight = width * size / sumOfNodesSurface;
@@ -242,8 +244,8 @@ double SquarifiedTreeMap::evaluateRow(const std::vector<tlp::node> &row, tlp::no
   double maxratio = ratio;
   double sumratio = ratio;
 
-  for (auto nr : row) {
-    double size = nodesSize.get(nr.id);
+  for (uint nr = first; nr < last; ++nr) {
+    double size = nodesSize[nr];
     double nodeRectangleWidth = length * sumOfNodesSurface / surface;
     double nodeRectangleHeight = width * size / sumOfNodesSurface;
     double ratio = std::min(nodeRectangleHeight, nodeRectangleWidth) /
@@ -256,105 +258,128 @@ double SquarifiedTreeMap::evaluateRow(const std::vector<tlp::node> &row, tlp::no
   // The paper formula does not give the best result
   // return std::max(surface*surface*maxratio/(sumOfNodesSurface*sumOfNodesSurface),
   //                sumOfNodesSurface*sumOfNodesSurface / (surface*surface*minratio));
-  return sumratio / (row.size() + 1);
+  return sumratio / (last - first + 1);
 }
 
 //====================================================================
-void SquarifiedTreeMap::squarify(const std::vector<tlp::node> &toTreat, const tlp::Rectd &rectArea,
-                                 const int depth) {
-  assert(rectArea.isValid());
-  assert(!toTreat.empty());
-
-  vector<node> rowNodes;
-  vector<node> unTreated;
-  double unTreatedSurface = 0;
+void SquarifiedTreeMap::squarify(uint first, uint last, tlp::Rectd rectArea) {
+  assert(first < last);
 
   double surface = 0;
 
-  for (auto n : toTreat) {
-    surface += nodesSize.get(n.id);
+  for (uint n = first; n < last; ++n) {
+    surface += nodesSize[n];
   }
 
-  auto it = toTreat.begin();
-  double length = std::max(rectArea.width(), rectArea.height());
-  double width = std::min(rectArea.width(), rectArea.height());
-  double ratio = evaluateRow(rowNodes, *it, width, length, surface);
-  rowNodes.push_back(*it);
-  ++it;
-
-  // build the new row
-  while (it != toTreat.end()) { // add node in the current row while condition is ok
-    if (shneidermanTreeMap) {
-      rowNodes.push_back(*it);
-    } else {
-      double newRatio = evaluateRow(rowNodes, *it, width, length, surface);
+  // each row is laid out in one side of the rectangle,
+  // the remaining nodes are then laid out in the rest of it
+  while (first < last) {
+    assert(rectArea.isValid());
+    double length = std::max(rectArea.width(), rectArea.height());
+    double width = std::min(rectArea.width(), rectArea.height());
+    double ratio = evaluateRow(first, first, width, length, surface);
+    uint rowEnd = first + 1;
 
-      if (newRatio < ratio) { // we finish to build that row
-        break;
-        /*unTreated.push_back(*it);
-        unTreatedSurface += nodesSize.get(it->id);*/
-      } else {
-        ratio = newRatio;
-        rowNodes.push_back(*it); // add the node to the current row
-      }
-    }
+    // build the new row
+    while (rowEnd < last) { // add node in the current row while condition is ok
+      if (!shneidermanTreeMap) {
+        double newRatio = evaluateRow(first, rowEnd, width, length, surface);
 
-    ++it;
-  }
+        if (newRatio < ratio) { // we finish to build that row
+          break;
+        }
 
-  // Compute measure on unTreated nodes to do a recursive call
-  while (it != toTreat.end()) {
-    unTreated.push_back(*it);
-    unTreatedSurface += nodesSize.get(it->id);
-    ++it;
-  }
+        ratio = newRatio;
+      }
 
-  assert(unTreated.size() + rowNodes.size() == toTreat.size());
+      ++rowEnd;
+    }
 
-  Vec2d dist = rectArea[1] - rectArea[0];
-  assert(!rowNodes.empty());
+    // Compute measure on unTreated nodes
+    double unTreatedSurface = 0;
 
-  Rectd rowRec(rectArea); // The rectangle for that row
+    for (uint n = rowEnd; n < last; ++n) {
+      unTreatedSurface += nodesSize[n];
+    }
 
-  if (rectArea.width() > rectArea.height()) {
-    rowRec[1][0] -= (unTreatedSurface / surface) * dist[0];
-  } else {
-    rowRec[0][1] += (unTreatedSurface / surface) * dist[1];
-  }
+    Vec2d dist = rectArea[1] - rectArea[0];
+    Rectd rowRec(rectArea); // The rectangle for that row
 
-  assert(rowRec.isValid());
+    if (rectArea.width() > rectArea.height()) {
+      rowRec[1][0] -= (unTreatedSurface / surface) * dist[0];
+    } else {
+      rowRec[0][1] += (unTreatedSurface / surface) * dist[1];
+    }
 
-  layoutRow(rowNodes, depth, rowRec);
+    assert(rowRec.isValid());
 
-  if (!unTreated.empty()) {
-    Rectd subRec(rectArea); // the rectangle of unTreated nodes
+    layoutRow(first, rowEnd, rowRec);
 
+    // the rectangle of unTreated nodes
     if (rectArea.width() > rectArea.height()) {
-      subRec[0][0] = rowRec[1][0];
+      rectArea[0][0] = rowRec[1][0];
     } else {
-      subRec[1][1] = rowRec[0][1];
+      rectArea[1][1] = rowRec[0][1];
     }
 
-    assert(subRec.isValid());
-    squarify(unTreated, subRec, depth);
+    first = rowEnd;
+    surface = unTreatedSurface;
   }
 }
 //====================================================================
-void SquarifiedTreeMap::computeNodesSize(const tlp::node n) {
+void SquarifiedTreeMap::computeNodesSize(const tlp::node root) {
+  const vector<node> &nodes = graph->nodes();
+  uint nbNodes = nodes.size();
+  // a first breadth first traversal numbers the nodes,
+  // the children of order[i] being order[first[i]] to order[first[i + 1] - 1]
+  vector<uint> order(1, graph->nodePos(root));
+  vector<uint> first(nbNodes + 1, nbNodes);
+  order.reserve(nbNodes);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    first[i] = order.size();
+
+    for (auto child : graph->getOutNodes(nodes[order[i]])) {
+      order.push_back(graph->nodePos(child));
+    }
+  }
 
-  if (graph->outdeg(n) == 0) { // the node is a leaf of the tree
-    double leafValue = metric ? metric->getNodeDoubleValue(n) : 1.;
+  // the sizes are computed bottom-up
+  vector<double> sizes(nbNodes, 0.);
 
-    nodesSize.set(n.id, (leafValue > 0) ? leafValue : 1.);
-    return;
+  for (uint i = nbNodes; i-- > 0;) {
+    if (first[i] == first[i + 1]) { // the node is a leaf of the tree
+      double leafValue = metric ? metric->getNodeDoubleValue(nodes[order[i]]) : 1.;
+      sizes[i] = (leafValue > 0) ? leafValue : 1.;
+    } else {
+      for (uint child = first[i]; child < first[i + 1]; ++child) {
+        sizes[i] += sizes[child];
+      }
+    }
   }
 
-  double internalNodeValue = 0.;
-  for (auto child : graph->getOutNodes(n)) {
-    computeNodesSize(child);
-    internalNodeValue += nodesSize.get(child.id);
+  // the nodes are numbered again with the children of each node
+  // in decreasing order of their size
+  vector<uint> renumbering(1, 0);
+  renumbering.reserve(nbNodes);
+  nodesPos.resize(nbNodes);
+  nodesSize.resize(nbNodes);
+  firstChild.resize(nbNodes + 1);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    uint n = renumbering[i];
+    nodesPos[i] = order[n];
+    nodesSize[i] = sizes[n];
+    firstChild[i] = renumbering.size();
+
+    for (uint child = first[n]; child < first[n + 1]; ++child) {
+      renumbering.push_back(child);
+    }
+
+    stable_sort(renumbering.begin() + firstChild[i], renumbering.end(),
+                [&sizes](uint a, uint b) { return sizes[a] > sizes[b]; });
   }
 
-  nodesSize.set(n.id, internalNodeValue);
+  firstChild[nbNodes] = nbNodes;
 }
 //====================================================================
@@ -40,6 +40,11 @@ typedef std::vector<PairNodeF> PairVector;
  *
  *  \note This algorithm only works on tree.
  *
+ *  The sizes of the subtrees are computed once, bottom-up, in arrays indexed
+ *  in breadth first order, then the children of the nodes of a same depth
+ *  are laid out in parallel. A depth limit can be given to leave the deepest
+ *  subtrees to a later run of the algorithm on them.
+ *
  *  @version 1.0.0 complete rewrite, merge treemap and squarified in the same algorithm
  *  simplify implementation. The algorithm can be tune to go 2 or 3 time faster however, since the
  * algorithm
@@ -63,7 +68,7 @@ public:
                     " For Squarified Treemaps see:<br/> Bruls, M., Huizing, K., & van Wijk, J. J."
                     " Proc. of Joint Eurographics and IEEE TCVG Symp. on Visualization (TCVG 2000) "
                     "IEEE Press, pp. 33-42.",
-                    "2.0", "Tree")
+                    "2.1", "Tree")
   SquarifiedTreeMap(const tlp::PluginContext *context);
   ~SquarifiedTreeMap() override;
 
@@ -74,30 +79,39 @@ private:
   tlp::SizeProperty *sizeResult;
   tlp::NumericProperty *metric;
   tlp::IntegerProperty *glyphResult;
-  tlp::MutableContainer<double> nodesSize;
   bool shneidermanTreeMap;
   double aspectRatio;
+  uint depthLimit;
+  // the nodes are numbered in breadth first order from the root,
+  // the children of each node having consecutive numbers in decreasing order of their size.
+  // the graph position of each node
+  std::vector<uint> nodesPos;
+  // the children of node i are the nodes from firstChild[i] to firstChild[i + 1] - 1
+  std::vector<uint> firstChild;
+  // the size of each node: the sum of the sizes of all the leaves descendant of a node
+  std::vector<double> nodesSize;
+  // the rectangle allocated to each node
+  std::vector<tlp::Rectd> nodesRect;
   /**
-   * return a measure quality of row in which one wants to add n
+   * return a measure quality of the row of the nodes from first to last - 1
+   * in which one wants to add the node last.
    * width is the width of the rectangle in which we create the row
    * length is the height of the rectangle in which on creates the row
    * surface is sum of size of elements what belongs to the rectangle
    */
-  double evaluateRow(const std::vector<tlp::node> &row, tlp::node n, double width, double length,
-                     double surface);
-  void layoutRow(const std::vector<tlp::node> &row, const int depth, const tlp::Rectd &rectArea);
-  void squarify(const std::vector<tlp::node> &toTreat, const tlp::Rectd &rectArea, const int depth);
+  double evaluateRow(uint first, uint last, double width, double length, double surface) const;
+  void layoutRow(uint first, uint last, const tlp::Rectd &rectArea);
+  // lays out the nodes from first to last - 1 in rectArea
+  void squarify(uint first, uint last, tlp::Rectd rectArea);
   // change the rectangle to take into account space reserved for the drawing of borders and headers
   // the function currently fix adjust the size for the 2D windwows glyph.
   tlp::Rectd adjustRectangle(const tlp::Rectd &r) const;
-  // return a vector containing children of n ordered in decreasing order of their size.
-  std::vector<tlp::node> orderedChildren(const tlp::node n) const;
   /**
-   * compute the size of each node in the tree
+   * number the nodes of the tree and compute their size once, bottom-up,
    * the size is the sum of all the size of all leaves descendant of a node
    * in the tree.
    */
-  void computeNodesSize(tlp::node n);
+  void computeNodesSize(tlp::node root);
 };
 
 #endif // SQUARIFIED_TREE_MAP_H
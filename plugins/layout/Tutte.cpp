@@ -11,15 +11,30 @@
  *
  */
 
+#include <climits>
+
+#include <talipot/SparseMatrix.h>
 #include <talipot/TriconnectedTest.h>
+#include <talipot/VectorProperty.h>
 #include "Tutte.h"
 
 PLUGIN(Tutte)
 
 using namespace std;
 using namespace tlp;
+
+static constexpr std::string_view paramHelp[] = {
+    // tolerance
+    "The positions of the inner nodes are computed by solving a sparse linear system. "
+    "The solver stops when its relative residual is lower than this tolerance.",
+
+    // max iterations
+    "The maximum number of iterations of the linear solver."};
 //====================================================
-Tutte::Tutte(const tlp::PluginContext *context) : LayoutAlgorithm(context) {}
+Tutte::Tutte(const tlp::PluginContext *context) : LayoutAlgorithm(context) {
+  addInParameter<double>("tolerance", paramHelp[0].data(), "1e-6");
+  addInParameter<uint>("max iterations", paramHelp[1].data(), "10000");
+}
 //====================================================
 Tutte::~Tutte() = default;
 //====================================================
@@ -98,60 +113,90 @@ bool Tutte::run() {
     pluginProgress->showStops(false);
   }
 
+  double tolerance = 1e-6;
+  uint maxIterations = 10000;
+
+  if (dataSet != nullptr) {
+    dataSet->get("tolerance", tolerance);
+    dataSet->get("max iterations", maxIterations);
+  }
+
   result->setAllEdgeValue(vector<Coord>(0));
   std::list<node> tmp;
   tmp = findCycle(graph);
   // We place the nodes on the outer face
-  Coord tmpCoord, tmpCoord2, baseCoord;
   float gamma;
   int i = 0;
   int rayon = 100;
   gamma = 2 * M_PI / tmp.size();
+  NodeVectorProperty<Coord> coords(graph);
+  // the index of each inner node in the linear system, UINT_MAX for the outer face nodes
+  NodeVectorProperty<uint> index(graph);
+  index.setAll(0);
 
   for (auto n : tmp) {
-    result->setNodeValue(
-        n, Coord(rayon * cos(gamma * i) + rayon * 2, rayon * sin(gamma * i) + rayon * 2, 0));
+    coords[n] = Coord(rayon * cos(gamma * i) + rayon * 2, rayon * sin(gamma * i) + rayon * 2, 0);
+    index[n] = UINT_MAX;
     i++;
   }
 
-  std::list<node> toMove;
+  std::vector<node> toMove;
 
   for (auto n : graph->nodes()) {
-    toMove.push_front(n);
-  }
-
-  for (auto n : tmp) {
-    toMove.remove(n);
+    if (index[n] != UINT_MAX) {
+      index[n] = toMove.size();
+      toMove.push_back(n);
+    }
   }
 
-  bool ok = true;
-
-  while (ok) {
-    ok = false;
+  // each inner node is at the barycenter of its neighbours,
+  // deg(n).pos(n) - sum(pos(inner neighbours)) = sum(pos(outer face neighbours)),
+  // the matrix of this system is a symmetric positive definite submatrix of the Laplacian
+  uint nbInner = toMove.size();
+  SparseMatrix laplacian(nbInner);
+  vector<double> bx(nbInner, 0), by(nbInner, 0);
 
-    for (auto n : toMove) {
-      tmpCoord.set(0, 0, 0);
-      Coord baseCoord = result->getNodeValue(n);
-      int i = 0;
+  for (uint row = 0; row < nbInner; ++row) {
+    for (auto nn : graph->getInOutNodes(toMove[row])) {
+      laplacian.addEntry(row, row, 1);
 
-      for (auto nn : graph->getInOutNodes(n)) {
-        const Coord &tmpCoord2 = result->getNodeValue(nn);
-        tmpCoord.set(tmpCoord.getX() + tmpCoord2.getX(), tmpCoord.getY() + tmpCoord2.getY(), 0);
-        ++i;
+      if (index[nn] == UINT_MAX) {
+        bx[row] += coords[nn][0];
+        by[row] += coords[nn][1];
+      } else {
+        laplacian.addEntry(row, index[nn], -1);
       }
+    }
+  }
 
-      result->setNodeValue(n, Coord(tmpCoord.getX() / i, tmpCoord.getY() / i, 0));
+  laplacian.compress();
 
-      if (fabs(baseCoord.getX() - tmpCoord.getX() / i) > 0.02) {
-        ok = true;
-      }
+  // solve the X and Y systems in parallel, starting from the center of the outer face
+  vector<double> x(nbInner, rayon * 2), y(nbInner, rayon * 2);
+  bool converged[2];
+  TLP_PARALLEL_MAP_INDICES(2, [&](uint dim) {
+    if (dim == 0) {
+      converged[dim] = solveConjugateGradient(laplacian, bx, x, tolerance, maxIterations);
+    } else {
+      converged[dim] = solveConjugateGradient(laplacian, by, y, tolerance, maxIterations);
+    }
+  });
 
-      if (fabs(baseCoord.getY() - tmpCoord.getY() / i) > 0.02) {
-        ok = true;
-      }
+  if (!converged[0] || !converged[1]) {
+    if (pluginProgress) {
+      pluginProgress->setError("The solver did not reach the tolerance within the maximum number "
+                               "of iterations, try to increase 'max iterations' or 'tolerance'.");
     }
+
+    return false;
   }
 
+  for (uint row = 0; row < nbInner; ++row) {
+    coords[toMove[row]] = Coord(x[row], y[row], 0);
+  }
+
+  coords.copyToProperty(result);
+
   return true;
 }
 //====================================================
@@ -32,7 +32,7 @@ public:
       "3-Connected (Tutte)", "David Auber", "06/11/2002",
       "Implements the Tutte layout for 3-Connected graph algorithm first published as:<br/>"
       "<b>How to Draw a Graph</b>, W.T. Tutte, Proc. London Math. Soc. pages 743--768 (1963).",
-      "1.0", "Planar")
+      "1.1", "Planar")
   Tutte(const tlp::PluginContext *context);
   ~Tutte() override;
 
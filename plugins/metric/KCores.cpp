@@ -11,6 +11,9 @@
  *
  */
 
+#include <atomic>
+#include <queue>
+
 #include <talipot/DoubleProperty.h>
 #include <talipot/StringCollection.h>
 #include <talipot/GraphMeasure.h>
@@ -41,6 +44,18 @@ using namespace tlp;
  * Mining (ASONAM)",\n
  * "2011"
  *
+ * The decomposition is computed in O(m) using the bucket based algorithm described in:
+ *
+ * V. Batagelj, M. Zaversnik, "An O(m) Algorithm for Cores Decomposition of Networks",
+ * arXiv:cs/0310049, 2003
+ *
+ * and the weighted one in O(m log(n)) using a priority queue.
+ * The unweighted decomposition can also be computed by a level synchronous parallel peeling
+ * as described in:
+ *
+ * K. Pechlivanidou, D. Katsaros, L. Tassiulas, "PKC: Parallel k-core decomposition",
+ * Journal of Parallel and Distributed Computing 110:33-45, 2017
+ *
  * \note Use the default parameters to compute simple K-Cores (undirected and unweighted)
  *
  *  <b>HISTORY</b>
@@ -50,6 +65,7 @@ using namespace tlp;
  *  - 2011 Version 2.0: Add In/Out and Weighted computation features
  *  by François Queyroi, LaBRI, University Bordeaux I, France
  *  - 2015 Performance optimization by Patrick Mary
+ *  - 2021 Version 2.1: Bucket based and parallel computations
  *
  *
  */
@@ -63,11 +79,27 @@ public:
                     "visualization of social networks.<br>"
                     "<b>Note</b>: use the default parameters to compute simple K-Cores (undirected "
                     "and unweighted).",
-                    "2.0", "Graph")
+                    "2.1", "Graph")
 
   KCores(const tlp::PluginContext *context);
   ~KCores() override;
   bool run() override;
+
+private:
+  // compute for each node the positions of the nodes whose degree
+  // decreases when it is removed, and the corresponding weights
+  void computeDependents(EDGE_TYPE degree_type, NumericProperty *metric);
+  // Batagelj-Zaversnik bucket based peeling
+  void computeCores(NodeVectorProperty<double> &nodeK);
+  // peeling in increasing order of weighted degrees
+  void computeWeightedCores(NodeVectorProperty<double> &nodeK);
+  // level synchronous parallel peeling
+  void computeCoresInParallel(NodeVectorProperty<double> &nodeK);
+
+  // compressed adjacency of the dependents of each node
+  vector<uint> offsets;
+  vector<uint> dependents;
+  vector<double> weights;
 };
 
 //========================================================================================
@@ -76,7 +108,11 @@ static constexpr std::string_view paramHelp[] = {
     "This parameter indicates the direction used to compute K-Cores values.",
 
     // metric
-    "An existing edge metric property, used to specify the weights of edges."};
+    "An existing edge metric property, used to specify the weights of edges.",
+
+    // parallel
+    "If true, the unweighted K-Cores values are computed by several threads peeling "
+    "the nodes of a same core concurrently. It only speeds up the computation on large graphs."};
 #define DEGREE_TYPE "type"
 #define DEGREE_TYPES "InOut;In;Out;"
 #define INOUT 0
@@ -87,106 +123,317 @@ KCores::KCores(const PluginContext *context) : DoubleAlgorithm(context) {
   addInParameter<StringCollection>(DEGREE_TYPE, paramHelp[0].data(), DEGREE_TYPES, true,
                                    "<b>InOut</b> <br> <b>In</b> <br> <b>Out</b>");
   addInParameter<NumericProperty *>("metric", paramHelp[1].data(), "", false);
+  addInParameter<bool>("parallel", paramHelp[2].data(), "false", false);
 }
 //========================================================================================
 KCores::~KCores() = default;
 //========================================================================================
-bool KCores::run() {
-  NumericProperty *metric = nullptr;
-  StringCollection degreeTypes(DEGREE_TYPES);
-  degreeTypes.setCurrent(0);
+void KCores::computeDependents(EDGE_TYPE degree_type, NumericProperty *metric) {
+  uint nbNodes = graph->numberOfNodes();
 
-  if (dataSet != nullptr) {
-    dataSet->get(DEGREE_TYPE, degreeTypes);
-    dataSet->get("metric", metric);
+  // the dependents of n are the nodes m whose degree takes into account
+  // an edge linking n to m
+  auto dependent = [&](node n, edge e, node &m) {
+    const auto &[src, tgt] = graph->ends(e);
+
+    switch (degree_type) {
+    case IN_EDGE:
+      return (m = tgt) != n;
+
+    case OUT_EDGE:
+      return (m = src) != n;
+
+    default:
+      m = (src == n) ? tgt : src;
+      return true;
+    }
+  };
+
+  offsets.assign(nbNodes + 1, 0);
+  TLP_PARALLEL_MAP_NODES_AND_INDICES(graph, [&](const node n, uint i) {
+    uint nbDependents = 0;
+    node m;
+
+    for (auto e : graph->incidence(n)) {
+      nbDependents += dependent(n, e, m);
+    }
+
+    offsets[i + 1] = nbDependents;
+  });
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    offsets[i + 1] += offsets[i];
   }
 
-  auto degree_type = static_cast<EDGE_TYPE>(degreeTypes.getCurrent());
+  dependents.resize(offsets[nbNodes]);
 
-  // the famous k
-  double k = DBL_MAX;
-  // use two NodeVectorProperty to hold the nodes infos
-  // because the more k increase the more nodes are "deleted"
-  NodeVectorProperty<bool> nodeDeleted(graph);
-  NodeVectorProperty<double> nodeK(graph);
-  degree(graph, nodeK, degree_type, metric, false);
-  const std::vector<node> &nodes = graph->nodes();
-  // the number of non deleted nodes
-  uint nbNodes = nodes.size();
+  if (metric) {
+    weights.resize(offsets[nbNodes]);
+  }
+
+  TLP_PARALLEL_MAP_NODES_AND_INDICES(graph, [&](const node n, uint i) {
+    uint j = offsets[i];
+    node m;
+
+    for (auto e : graph->incidence(n)) {
+      if (dependent(n, e, m)) {
+        if (metric) {
+          weights[j] = metric->getEdgeDoubleValue(e);
+        }
+
+        dependents[j++] = graph->nodePos(m);
+      }
+    }
+  });
+}
+//========================================================================================
+void KCores::computeCores(NodeVectorProperty<double> &nodeK) {
+  uint nbNodes = graph->numberOfNodes();
+  vector<uint> deg(nbNodes);
+  uint maxDeg = 0;
 
   for (uint i = 0; i < nbNodes; ++i) {
-    k = std::min(k, nodeK[i]);
-    nodeDeleted[i] = false;
+    deg[i] = uint(nodeK[i]);
+    maxDeg = std::max(maxDeg, deg[i]);
   }
 
-  // loop on remaining nodes
-  while (nbNodes) {
-    bool modify = true;
-    double next_k = DBL_MAX;
+  // sort the nodes in increasing order of degree;
+  // bin[d] is the position of the first node of degree d
+  vector<uint> bin(maxDeg + 1, 0);
 
-    while (modify) {
-      modify = false;
+  for (auto d : deg) {
+    ++bin[d];
+  }
 
-      // finally set the values
-      for (uint i = 0; i < nodes.size(); ++i) {
-        // nothing to do if the node
-        // is already deleted
-        if (nodeDeleted[i]) {
-          continue;
+  uint start = 0;
+
+  for (uint d = 0; d <= maxDeg; ++d) {
+    uint nb = bin[d];
+    bin[d] = start;
+    start += nb;
+  }
+
+  vector<uint> vert(nbNodes), pos(nbNodes);
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    pos[i] = bin[deg[i]]++;
+    vert[pos[i]] = i;
+  }
+
+  for (uint d = maxDeg; d > 0; --d) {
+    bin[d] = bin[d - 1];
+  }
+
+  bin[0] = 0;
+
+  // the degree of a node is its core number when it is removed
+  for (uint i = 0; i < nbNodes; ++i) {
+    uint v = vert[i];
+
+    for (uint j = offsets[v]; j < offsets[v + 1]; ++j) {
+      uint u = dependents[j];
+
+      if (deg[u] > deg[v]) {
+        // move u at the beginning of its bin
+        // before decreasing its degree
+        uint du = deg[u];
+        uint pu = pos[u];
+        uint pw = bin[du];
+        uint w = vert[pw];
+
+        if (u != w) {
+          pos[u] = pw;
+          vert[pu] = w;
+          pos[w] = pu;
+          vert[pw] = u;
         }
 
-        double &nK = nodeK[i];
-        double current_k = nK;
-        node n = nodes[i];
+        ++bin[du];
+        --deg[u];
+      }
+    }
+  }
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    nodeK[i] = deg[i];
+  }
+}
+//========================================================================================
+void KCores::computeWeightedCores(NodeVectorProperty<double> &nodeK) {
+  uint nbNodes = graph->numberOfNodes();
+  // the current weighted degree of each node
+  vector<double> deg(nbNodes);
+  vector<bool> nodeDeleted(nbNodes, false);
+  // the nodes ordered by their weighted degree; when the degree of a node
+  // decreases it is pushed again and its previous entry is ignored
+  priority_queue<pair<double, uint>, vector<pair<double, uint>>, greater<pair<double, uint>>> queue;
+
+  for (uint i = 0; i < nbNodes; ++i) {
+    deg[i] = nodeK[i];
+    queue.emplace(deg[i], i);
+  }
 
-        if (current_k <= k) {
-          nK = k;
-          // decrease neighbours weighted degree
-          for (auto e : graph->incidence(n)) {
+  // the famous k
+  double k = -DBL_MAX;
 
-            const auto &[src, tgt] = graph->ends(e);
-            node m;
+  while (!queue.empty()) {
+    auto [d, v] = queue.top();
+    queue.pop();
 
-            switch (degree_type) {
-            case IN_EDGE:
-              if ((m = tgt) == n) {
-                continue;
-              }
+    if (nodeDeleted[v] || d != deg[v]) {
+      continue;
+    }
 
-              break;
+    k = std::max(k, d);
+    nodeK[v] = k;
+    nodeDeleted[v] = true;
 
-            case OUT_EDGE:
-              if ((m = src) == n) {
-                continue;
-              }
+    // decrease neighbours weighted degree
+    for (uint j = offsets[v]; j < offsets[v + 1]; ++j) {
+      uint u = dependents[j];
+
+      if (!nodeDeleted[u]) {
+        deg[u] -= weights[j];
+        queue.emplace(deg[u], u);
+      }
+    }
+  }
+}
+//========================================================================================
+void KCores::computeCoresInParallel(NodeVectorProperty<double> &nodeK) {
+  uint nbNodes = graph->numberOfNodes();
+  vector<atomic<uint>> deg(nbNodes);
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) { deg[i] = uint(nodeK[i]); });
 
-              break;
+  // the nodes not yet removed, compacted from time to time
+  vector<uint> remaining(nbNodes);
+  TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) { remaining[i] = i; });
+  uint nbRemoved = 0, nbRemovedSinceCompaction = 0;
 
-            default:
-              m = (src == n) ? tgt : src;
-            }
+  // per thread buffers
+  uint nbThreads = ThreadManager::getNumberOfThreads();
+  vector<vector<uint>> frontiers(nbThreads);
+  vector<uint> minDegrees(nbThreads);
+  vector<uint> frontier;
 
-            uint mPos = graph->nodePos(m);
+  // as threads synchronization has a cost the nodes are processed by ranges
+  auto parallelRanges = [nbThreads](uint size, const auto &f) {
+    uint nbRanges = std::min(size, 8 * nbThreads);
+    TLP_PARALLEL_MAP_INDICES(nbRanges, [&](uint r) {
+      f(uint(size_t(size) * r / nbRanges), uint(size_t(size) * (r + 1) / nbRanges),
+        ThreadManager::getThreadNumber());
+    });
+  };
 
-            if (nodeDeleted[mPos]) {
-              continue;
-            }
+  // the current level; the degree of a removed node is its core number
+  // so the remaining nodes are those whose degree is not lower than k
+  uint k = 0;
 
-            nodeK[mPos] -= metric ? metric->getEdgeDoubleValue(e) : 1;
-          }
+  while (nbRemoved < nbNodes) {
+    // the next level is the minimum degree of the remaining nodes,
+    // each thread collects the nodes of its own minimum degree
+    std::fill(minDegrees.begin(), minDegrees.end(), UINT_MAX);
+    parallelRanges(remaining.size(), [&](uint begin, uint end, uint thread) {
+      for (uint i = begin; i < end; ++i) {
+        uint v = remaining[i];
+        uint d = deg[v];
 
-          // mark node as deleted
-          nodeDeleted[i] = true;
-          --nbNodes;
-          modify = true;
-        } else if (current_k < next_k) {
-          // update next k value
-          next_k = current_k;
+        if (d < k || d > minDegrees[thread]) {
+          continue;
+        }
+
+        if (d < minDegrees[thread]) {
+          minDegrees[thread] = d;
+          frontiers[thread].clear();
         }
+
+        frontiers[thread].push_back(v);
       }
+    });
+
+    k = *std::min_element(minDegrees.begin(), minDegrees.end());
+    frontier.clear();
+
+    for (uint thread = 0; thread < nbThreads; ++thread) {
+      if (minDegrees[thread] == k) {
+        frontier.insert(frontier.end(), frontiers[thread].begin(), frontiers[thread].end());
+      }
+
+      frontiers[thread].clear();
     }
 
-    k = next_k;
+    // remove the nodes of the level; the degree of a neighbour is decreased
+    // only if it is greater than k and it joins the level when it becomes equal to k
+    while (!frontier.empty()) {
+      nbRemoved += frontier.size();
+      nbRemovedSinceCompaction += frontier.size();
+      parallelRanges(frontier.size(), [&](uint begin, uint end, uint thread) {
+        for (uint i = begin; i < end; ++i) {
+          uint v = frontier[i];
+          nodeK[v] = k;
+
+          for (uint j = offsets[v]; j < offsets[v + 1]; ++j) {
+            uint u = dependents[j];
+
+            if (deg[u] > k) {
+              uint du = deg[u]--;
+
+              if (du == k + 1) {
+                frontiers[thread].push_back(u);
+              } else if (du <= k) {
+                // another thread decreased it meanwhile
+                ++deg[u];
+              }
+            }
+          }
+        }
+      });
+
+      frontier.clear();
+
+      for (auto &threadFrontier : frontiers) {
+        frontier.insert(frontier.end(), threadFrontier.begin(), threadFrontier.end());
+        threadFrontier.clear();
+      }
+    }
+
+    ++k;
+
+    // the removed nodes are filtered out once they are numerous enough
+    if (2 * nbRemovedSinceCompaction > remaining.size()) {
+      remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                     [&](uint v) { return deg[v] < k; }),
+                      remaining.end());
+      nbRemovedSinceCompaction = 0;
+    }
+  }
+}
+//========================================================================================
+bool KCores::run() {
+  NumericProperty *metric = nullptr;
+  StringCollection degreeTypes(DEGREE_TYPES);
+  degreeTypes.setCurrent(0);
+  bool parallel = false;
+
+  if (dataSet != nullptr) {
+    dataSet->get(DEGREE_TYPE, degreeTypes);
+    dataSet->get("metric", metric);
+    dataSet->get("parallel", parallel);
+  }
+
+  auto degree_type = static_cast<EDGE_TYPE>(degreeTypes.getCurrent());
+
+  // the degree of each node is replaced by its K-Cores value
+  NodeVectorProperty<double> nodeK(graph);
+  degree(graph, nodeK, degree_type, metric, false);
+  computeDependents(degree_type, metric);
+
+  if (metric) {
+    computeWeightedCores(nodeK);
+  } else if (parallel && ThreadManager::getNumberOfThreads() > 1) {
+    computeCoresInParallel(nodeK);
+  } else {
+    computeCores(nodeK);
   }
 
   // finally set the result values
@@ -12,6 +12,7 @@
  */
 
 #include <talipot/DoubleProperty.h>
+#include <talipot/ParallelTools.h>
 #include <talipot/PropertyAlgorithm.h>
 #include <talipot/VectorProperty.h>
 
@@ -29,6 +30,20 @@ using namespace tlp;
  * "Journal of Statistical Mechanics: Theory and Experiment, P10008",\n
  * 2008. \n
  *
+ * The local moving phase is parallelized as in:
+ *
+ * Lu, H. and Halappanavar, M. and Kalyanaraman, A., \n
+ * "Parallel heuristics for scalable community detection", \n
+ * "Parallel Computing, 47", \n
+ * 2015. \n
+ *
+ * and the optional refinement of the communities is the one of the Leiden algorithm:
+ *
+ * Traag, V.A. and Waltman, L. and van Eck, N.J., \n
+ * "From Louvain to Leiden: guaranteeing well-connected communities", \n
+ * "Scientific Reports, 9", \n
+ * 2019. \n
+ *
  * <b> HISTORY</b>
  *
  * - 25/02/2011 Version 1.0: Initial release (François Queyroi)
@@ -36,6 +51,8 @@ using namespace tlp;
  *DoubleAlgorithm, code cleaning and fix some memory leaks.
  * - 09/06/2015 Version 2.1 (Patrick Mary) full rewrite according the updated version of the
  *original source code available at  https://sites.google.com/site/findcommunities/
+ * - 2021 Version 2.2: parallel local moving phase on a coloring of the nodes,
+ *quotient graphs stored in flat arrays, resolution parameter and optional Leiden refinement.
  *
  * \note A threshold for modularity improvement is used here, its value is 0.000001
  *
@@ -43,6 +60,118 @@ using namespace tlp;
  *
  *
  **/
+
+namespace {
+
+// a weighted undirected graph stored in compressed sparse row format,
+// the weights of self loops are stored apart
+struct CSRGraph {
+  // the neighbours of node i are stored between offsets[i] and offsets[i + 1]
+  vector<uint> offsets;
+  vector<uint> neighbours;
+  vector<double> weights;
+  // weight of the self loop of each node, counted once
+  vector<double> selfLoops;
+  // weighted degree of each node (self loop counted once)
+  vector<double> degrees;
+  // sum of the weighted degrees
+  double totalWeight = 0;
+
+  uint numberOfNodes() const {
+    return selfLoops.size();
+  }
+
+  void computeDegrees() {
+    uint nbNodes = numberOfNodes();
+    degrees.resize(nbNodes);
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+      double degree = selfLoops[i];
+
+      for (uint j = offsets[i]; j < offsets[i + 1]; ++j) {
+        degree += weights[j];
+      }
+
+      degrees[i] = degree;
+    });
+
+    totalWeight = 0;
+
+    for (auto degree : degrees) {
+      totalWeight += degree;
+    }
+  }
+};
+
+// accumulates the weights of the links from a node
+// to its neighbouring communities
+struct NeighbourCommunities {
+  // weight of the links to each community, -1 if it is not a neighbour
+  vector<double> weights;
+  vector<uint> communities;
+
+  void init(uint nbCommunities) {
+    weights.assign(nbCommunities, -1);
+    communities.clear();
+  }
+
+  void add(uint comm, double weight) {
+    if (weights[comm] == -1) {
+      weights[comm] = 0;
+      communities.push_back(comm);
+    }
+
+    weights[comm] += weight;
+  }
+
+  void clear() {
+    for (auto comm : communities) {
+      weights[comm] = -1;
+    }
+
+    communities.clear();
+  }
+};
+
+// calls f(begin, end, buffer) on consecutive ranges of [0, size[ in parallel,
+// buffer being a per thread object
+template <typename BUFFER, typename F>
+void parallelRanges(uint size, vector<BUFFER> &buffers, const F &f) {
+  // not worth the threads synchronization cost
+  if (size < 1024) {
+    f(0, size, buffers[ThreadManager::getThreadNumber()]);
+    return;
+  }
+
+  uint nbRanges = min(size, 8 * ThreadManager::getNumberOfThreads());
+  TLP_PARALLEL_MAP_INDICES(nbRanges, [&](uint r) {
+    f(uint(size_t(size) * r / nbRanges), uint(size_t(size) * (r + 1) / nbRanges),
+      buffers[ThreadManager::getThreadNumber()]);
+  });
+}
+
+// renumbers the parts of a partition of [0, size[ according
+// to their increasing ids and returns the number of parts
+uint renumber(vector<uint> &partition) {
+  uint size = partition.size();
+  vector<uint> ids(size, UINT_MAX);
+
+  for (auto part : partition) {
+    ids[part] = 0;
+  }
+
+  uint nbParts = 0;
+
+  for (auto &id : ids) {
+    if (id != UINT_MAX) {
+      id = nbParts++;
+    }
+  }
+
+  TLP_PARALLEL_MAP_INDICES(size, [&](uint i) { partition[i] = ids[partition[i]]; });
+  return nbParts;
+}
+}
+
 class LouvainClustering : public tlp::DoubleAlgorithm {
 public:
   PLUGININFORMATION(
@@ -51,247 +180,272 @@ public:
       "This is an implementation of the Louvain clustering algorithm first published as:<br/>"
       "<b>Fast unfolding of communities in large networks</b>, Blondel, V.D. and Guillaume, J.L. "
       "and Lambiotte, R. and Lefebvre, E., Journal of Statistical Mechanics: Theory and "
-      "Experiment, P10008 (2008).",
-      "2.1", "Clustering")
+      "Experiment, P10008 (2008).<br/>"
+      "The communities can optionally be refined as in the Leiden algorithm published as:<br/>"
+      "<b>From Louvain to Leiden: guaranteeing well-connected communities</b>, Traag, V.A. and "
+      "Waltman, L. and van Eck, N.J., Scientific Reports, 9 (2019).",
+      "2.2", "Clustering")
   LouvainClustering(const tlp::PluginContext *);
   bool run() override;
 
 private:
-  // the number of nodes of the original graph
-  uint nb_nodes;
+  // the current quotient graph, initially the graph itself
+  CSRGraph quotient;
 
-  // a quotient graph of the original graph
-  Graph *quotient;
-  // number of nodes in the quotient graph and size of all vectors
-  uint nb_qnodes;
+  // community to which each node of the quotient graph belongs
+  vector<uint> n2c;
+  // sum of the weighted degrees of the nodes of each community
+  vector<double> tot;
 
   // the mapping between the nodes of the original graph
   // and the quotient nodes
-  NodeVectorProperty<int> *clusters;
-
-  // quotient graph edge weights
-  EdgeVectorProperty<double> *weights;
-  // total weight (sum of edge weights for the quotient graph)
-  double total_weight;
-  // 1./total_weight
-  double ootw;
-
-  std::vector<double> neigh_weight;
-  std::vector<uint> neigh_pos;
-  uint neigh_last;
-
-  // community to which each node belongs
-  std::vector<uint> n2c;
-  // used to renumber the communities
-  std::vector<int> renumber;
-  // used to compute the modularity participation of each community
-  std::vector<double> in, tot;
+  vector<uint> clusters;
 
   // a new pass is computed if the last one has generated an increase
   // greater than min_modularity
   // if 0. even a minor increase is enough to go for one more pass
   double min_modularity;
+  double resolution;
+  bool refinement;
   double new_mod;
 
-  // return the weighted degree and selfloops of a node
-  // of the current quotient graph
-  void get_weighted_degree_and_selfloops(uint n, double &wdg, double &nsl) {
-    wdg = nsl = 0;
-    const std::vector<edge> &edges = quotient->incidence(node(n));
-
-    for (uint i = 0; i < edges.size(); ++i) {
-      edge e = edges[i];
-      double weight = (*weights)[e];
-      wdg += weight;
-      // self loop must be counted only once
-      const auto &[src, tgt] = quotient->ends(e);
-
-      if (src == tgt) {
-        nsl = weight;
-        ++i;
-      }
-    }
-  }
+  // per thread buffers
+  vector<NeighbourCommunities> buffers;
 
-  // compute the gain of modularity if node where inserted in comm
-  // given that node has dnodecomm links to comm.  The formula is:
-  // [(In(comm)+2d(node,comm))/2m - ((tot(comm)+deg(node))/2m)^2]-
-  // [In(comm)/2m - (tot(comm)/2m)^2 - (deg(node)/2m)^2]
-  // where In(comm)    = number of half-links strictly inside comm
-  //       Tot(comm)   = number of half-links inside or outside comm (sum(degrees))
-  //       d(node,com) = number of links from node to comm
-  //       deg(node)   = node degree
-  //       m           = number of links
-  inline double modularity_gain(uint /*node*/, uint comm, double dnode_comm, double w_degree) {
-    return (dnode_comm - tot[comm] * w_degree * ootw);
-  }
+  // build the weighted graph of the first level from the graph
+  void initQuotient(NumericProperty *metric) {
+    uint nbNodes = graph->numberOfNodes();
+    const vector<node> &nodes = graph->nodes();
+    quotient.offsets.assign(nbNodes + 1, 0);
+    quotient.selfLoops.assign(nbNodes, 0);
 
-  // compute the modularity of the current partition
-  double modularity() {
-    double q = 0.;
+    auto edgeWeight = [&](edge e) { return metric ? metric->getEdgeDoubleValue(e) : 1; };
+
+    // count the neighbours and sum the self loops weights,
+    // a self loop appears twice in the incidence of its node
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+      uint nbNeighbours = 0;
 
-    for (uint i = 0; i < nb_qnodes; i++) {
-      if (tot[i] > 0) {
-        q += ootw * (in[i] - tot[i] * tot[i] * ootw);
+      for (auto e : graph->incidence(nodes[i])) {
+        const auto &[src, tgt] = graph->ends(e);
+
+        if (src == tgt) {
+          quotient.selfLoops[i] += edgeWeight(e) / 2;
+        } else {
+          ++nbNeighbours;
+        }
       }
-    }
 
-    return q;
-  }
+      quotient.offsets[i + 1] = nbNeighbours;
+    });
 
-  // compute the set of neighboring communities of node
-  // for each community, gives the number of links from node to comm
-  void neigh_comm(uint n) {
-    for (uint i = 0; i < neigh_last; i++) {
-      neigh_weight[neigh_pos[i]] = -1;
+    for (uint i = 0; i < nbNodes; ++i) {
+      quotient.offsets[i + 1] += quotient.offsets[i];
     }
 
-    neigh_last = 0;
+    quotient.neighbours.resize(quotient.offsets[nbNodes]);
+    quotient.weights.resize(quotient.offsets[nbNodes]);
 
-    neigh_pos[0] = n2c[n];
-    neigh_weight[neigh_pos[0]] = 0;
-    neigh_last = 1;
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+      uint j = quotient.offsets[i];
 
-    for (auto e : quotient->incidence(node(n))) {
-      const auto &[src, tgt] = quotient->ends(e);
-      uint neigh = (src == node(n)) ? tgt : src;
-      uint neigh_comm = n2c[neigh];
-      double neigh_w = (*weights)[e];
+      for (auto e : graph->incidence(nodes[i])) {
+        const auto &[src, tgt] = graph->ends(e);
 
-      if (neigh != n) {
-        if (neigh_weight[neigh_comm] == -1) {
-          neigh_weight[neigh_comm] = 0.;
-          neigh_pos[neigh_last++] = neigh_comm;
+        if (src != tgt) {
+          quotient.neighbours[j] = graph->nodePos(src == nodes[i] ? tgt : src);
+          quotient.weights[j++] = edgeWeight(e);
         }
-
-        neigh_weight[neigh_comm] += neigh_w;
       }
+    });
+
+    quotient.computeDegrees();
+  }
+
+  // compute the total degrees of the current communities
+  void computeTot() {
+    uint nbNodes = quotient.numberOfNodes();
+    tot.assign(nbNodes, 0);
+
+    for (uint i = 0; i < nbNodes; ++i) {
+      tot[n2c[i]] += quotient.degrees[i];
     }
   }
 
-  // generates the quotient graph of communities as computed by one_level
-  void partitionToQuotient(Graph *new_quotient, EdgeVectorProperty<double> *new_weights) {
-    // Renumber communities
-    vector<int> renumber(nb_qnodes, -1);
+  // initialize the communities data for the current quotient graph
+  void initLevel() {
+    computeTot();
 
-    for (uint n = 0; n < nb_qnodes; n++) {
-      renumber[n2c[n]] = 0;
+    for (auto &buffer : buffers) {
+      buffer.init(quotient.numberOfNodes());
     }
+  }
 
-    int final = 0;
+  // compute the modularity of the current partition
+  double modularity() {
+    uint nbNodes = quotient.numberOfNodes();
+    vector<double> in(nbNodes);
+
+    // weight of the links inside the community of each node
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+      double w = quotient.selfLoops[i];
 
-    for (uint i = 0; i < nb_qnodes; i++) {
-      if (renumber[i] != -1) {
-        renumber[i] = final++;
+      for (uint j = quotient.offsets[i]; j < quotient.offsets[i + 1]; ++j) {
+        if (n2c[quotient.neighbours[j]] == n2c[i]) {
+          w += quotient.weights[j];
+        }
       }
+
+      in[i] = w;
+    });
+
+    double q = 0.;
+    double ootw = 1. / quotient.totalWeight;
+
+    for (uint i = 0; i < nbNodes; ++i) {
+      q += ootw * (in[i] - resolution * tot[i] * tot[i] * ootw);
     }
 
-    // update clustering
-    TLP_PARALLEL_MAP_INDICES(nb_nodes,
-                             [&](uint i) { (*clusters)[i] = renumber[n2c[(*clusters)[i]]]; });
-
-    // Compute weighted graph
-    new_quotient->addNodes(final);
-
-    total_weight = 0;
-    for (auto e : quotient->edges()) {
-      auto [src, tgt] = quotient->ends(e);
-      auto ends = quotient->ends(e);
-
-      uint src_comm = renumber[n2c[src]];
-      uint tgt_comm = renumber[n2c[tgt]];
-      double weight = (*weights)[e];
-      edge e_comm = new_quotient->existEdge(node(src_comm), node(tgt_comm), false);
-      total_weight += weight;
-      double *weight_comm = nullptr;
-
-      if (!e_comm.isValid()) {
-        ends = pair(node(src_comm), node(tgt_comm));
-        e_comm = new_quotient->addEdge(ends.first, ends.second);
-        weight_comm = &((*new_weights)[e_comm]);
-        *weight_comm = weight;
-      } else {
-        ends = new_quotient->ends(e_comm);
-        weight_comm = &((*new_weights)[e_comm]);
-
-        if (ends.second == node(tgt_comm)) {
-          *weight_comm += weight;
+    return q;
+  }
+
+  // compute a greedy coloring of the quotient graph nodes taken in a random order
+  // and returns them grouped by colors. Nodes with the same color are not adjacent
+  // so they can be moved concurrently.
+  void colorNodes(vector<uint> &coloredNodes, vector<uint> &colorsOffsets) {
+    uint nbNodes = quotient.numberOfNodes();
+    vector<uint> randomOrder(nbNodes);
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) { randomOrder[i] = i; });
+    shuffle(randomOrder.begin(), randomOrder.end(), getRandomNumberGenerator());
+
+    vector<uint> colors(nbNodes, UINT_MAX);
+    // forbidden[c] == n if color c is used by a neighbour of n
+    vector<uint> forbidden;
+    uint nbColors = 0;
+
+    for (auto n : randomOrder) {
+      for (uint j = quotient.offsets[n]; j < quotient.offsets[n + 1]; ++j) {
+        uint color = colors[quotient.neighbours[j]];
+
+        if (color != UINT_MAX) {
+          forbidden[color] = n;
         }
       }
 
-      // self loop are counted only once
-      if (src != tgt) {
-        total_weight += weight;
+      uint color = 0;
 
-        if (ends.first == node(tgt_comm)) {
-          *weight_comm += weight;
-        }
+      while (color < nbColors && forbidden[color] == n) {
+        ++color;
+      }
+
+      if (color == nbColors) {
+        forbidden.push_back(UINT_MAX);
+        ++nbColors;
       }
+
+      colors[n] = color;
+    }
+
+    // group the nodes by colors, keeping the random order
+    colorsOffsets.assign(nbColors + 1, 0);
+
+    for (auto color : colors) {
+      ++colorsOffsets[color + 1];
+    }
+
+    for (uint c = 0; c < nbColors; ++c) {
+      colorsOffsets[c + 1] += colorsOffsets[c];
     }
 
-    ootw = 1. / total_weight;
+    vector<uint> pos(colorsOffsets.begin(), colorsOffsets.end() - 1);
+    coloredNodes.resize(nbNodes);
+
+    for (auto n : randomOrder) {
+      coloredNodes[pos[colors[n]]++] = n;
+    }
   }
 
-  // compute communities of the graph for one level
-  // return true if some nodes have been moved
-  bool one_level() {
+  // compute communities of the quotient graph for one level.
+  // The nodes of a same color are moved concurrently to their best neighbouring community
+  // according to the communities total degrees at the beginning of the color processing,
+  // then these total degrees are updated.
+  // Return true if some nodes have been moved
+  bool moveNodes() {
+    uint nbNodes = quotient.numberOfNodes();
+    double ootw = 1. / quotient.totalWeight;
     bool improvement = false;
     new_mod = modularity();
     double cur_mod = new_mod;
 
-    vector<uint> random_order(nb_qnodes);
-    TLP_PARALLEL_MAP_INDICES(nb_qnodes, [&](uint i) { random_order[i] = i; });
+    vector<uint> coloredNodes, colorsOffsets;
+    colorNodes(coloredNodes, colorsOffsets);
+    uint nbColors = colorsOffsets.size() - 1;
 
-    shuffle(random_order.begin(), random_order.end(), getRandomNumberGenerator());
+    vector<uint> bestComms(nbNodes);
 
     // repeat while
     // there is an improvement of modularity
     // or there is an improvement of modularity greater than a given epsilon
     do {
       cur_mod = new_mod;
-      int nb_moves = 0;
-
-      // for each node:
-      // remove the node from its community
-      // and insert it in the best community
-      for (auto n : random_order) {
-        uint n_comm = n2c[n];
-        double n_wdg;
-        double n_nsl;
-        get_weighted_degree_and_selfloops(n, n_wdg, n_nsl);
-
-        // computation of all neighboring communities of current node
-        neigh_comm(n);
-
-        // remove node from its current community
-        tot[n_comm] -= n_wdg;
-        in[n_comm] -= 2 * neigh_weight[n_comm] + n_nsl;
-
-        // compute the nearest community for node
-        // default choice for future insertion is the former community
-        uint best_comm = n_comm;
-        double best_nblinks = 0.;
-        double best_increase = 0.;
-
-        for (uint i = 0; i < neigh_last; i++) {
-          double increase = modularity_gain(n, neigh_pos[i], neigh_weight[neigh_pos[i]], n_wdg);
-
-          if (increase > best_increase ||
-              // keep the best cluster with the minimum id
-              (increase == best_increase && neigh_pos[i] > best_comm)) {
-            best_nblinks = neigh_weight[neigh_pos[i]];
-            best_increase = increase;
-            best_comm = neigh_pos[i];
+      uint nb_moves = 0;
+
+      for (uint color = 0; color < nbColors; ++color) {
+        uint begin = colorsOffsets[color];
+        uint nbColorNodes = colorsOffsets[color + 1] - begin;
+
+        parallelRanges(nbColorNodes, buffers, [&](uint rBegin, uint rEnd,
+                                                  NeighbourCommunities &neighComms) {
+          for (uint k = rBegin; k < rEnd; ++k) {
+            uint n = coloredNodes[begin + k];
+            uint n_comm = n2c[n];
+            double n_wdg = quotient.degrees[n];
+
+            // computation of all neighboring communities of current node
+            neighComms.add(n_comm, 0);
+
+            for (uint j = quotient.offsets[n]; j < quotient.offsets[n + 1]; ++j) {
+              neighComms.add(n2c[quotient.neighbours[j]], quotient.weights[j]);
+            }
+
+            // compute the nearest community for node
+            // default choice for future insertion is the former community.
+            // The gain of modularity if node were inserted in comm
+            // given that node has dnodecomm links to comm is proportional to
+            // dnodecomm - resolution * tot(comm) * deg(node) / 2m
+            // where the node is first removed from its current community
+            uint best_comm = n_comm;
+            double best_increase =
+                neighComms.weights[n_comm] - resolution * (tot[n_comm] - n_wdg) * n_wdg * ootw;
+
+            for (auto comm : neighComms.communities) {
+              double increase =
+                  neighComms.weights[comm] - resolution * tot[comm] * n_wdg * ootw;
+
+              if (comm != n_comm &&
+                  (increase > best_increase ||
+                   // keep the best cluster with the minimum id
+                   (increase == best_increase && comm < best_comm && best_comm != n_comm))) {
+                best_increase = increase;
+                best_comm = comm;
+              }
+            }
+
+            neighComms.clear();
+            bestComms[n] = best_comm;
           }
-        }
+        });
 
-        // insert node in the nearest community
-        tot[best_comm] += n_wdg;
-        in[best_comm] += 2 * best_nblinks + n_nsl;
-        n2c[n] = best_comm;
+        // insert the moved nodes in their nearest community
+        for (uint k = begin; k < begin + nbColorNodes; ++k) {
+          uint n = coloredNodes[k];
 
-        if (best_comm != n_comm) {
-          nb_moves++;
+          if (bestComms[n] != n2c[n]) {
+            tot[n2c[n]] -= quotient.degrees[n];
+            tot[bestComms[n]] += quotient.degrees[n];
+            n2c[n] = bestComms[n];
+            ++nb_moves;
+          }
         }
       }
 
@@ -306,23 +460,209 @@ private:
     return improvement;
   }
 
-  void init_level() {
-    nb_qnodes = quotient->numberOfNodes();
-    neigh_weight.resize(nb_qnodes, -1);
-    neigh_pos.resize(nb_qnodes);
-    neigh_last = 0;
-
-    n2c.resize(nb_qnodes);
-    in.resize(nb_qnodes);
-    tot.resize(nb_qnodes);
-
-    TLP_PARALLEL_MAP_INDICES(nb_qnodes, [&](uint i) {
-      n2c[i] = i;
-      double wdg, nsl;
-      get_weighted_degree_and_selfloops(i, wdg, nsl);
-      in[i] = nsl;
-      tot[i] = wdg;
+  // Leiden refinement of the current communities:
+  // each community is split into well connected sub communities,
+  // built by merging singletons nodes, which are returned as a partition
+  // of the quotient nodes
+  uint refine(vector<uint> &subs, uint nbComms) {
+    uint nbNodes = quotient.numberOfNodes();
+    double ootw = 1. / quotient.totalWeight;
+
+    // group the nodes by communities, keeping the random order
+    // of the nodes to visit them in that order
+    vector<uint> randomOrder(nbNodes);
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) { randomOrder[i] = i; });
+    shuffle(randomOrder.begin(), randomOrder.end(), getRandomNumberGenerator());
+
+    vector<uint> commsOffsets(nbComms + 1, 0);
+
+    for (auto comm : n2c) {
+      ++commsOffsets[comm + 1];
+    }
+
+    for (uint c = 0; c < nbComms; ++c) {
+      commsOffsets[c + 1] += commsOffsets[c];
+    }
+
+    vector<uint> members(nbNodes);
+    vector<uint> pos(commsOffsets.begin(), commsOffsets.end() - 1);
+
+    for (auto n : randomOrder) {
+      members[pos[n2c[n]]++] = n;
+    }
+
+    // initially each node is a singleton sub community whose id is its own,
+    // so sub communities data can be indexed by node
+    subs.resize(nbNodes);
+    // sum of the weighted degrees of the nodes of each sub community
+    vector<double> subsTot(quotient.degrees);
+    // weight of the links between each sub community
+    // and the rest of its community
+    vector<double> subsExt(nbNodes);
+    // vector<bool> is not used as it is concurrently updated
+    vector<char> singletons(nbNodes, true);
+
+    TLP_PARALLEL_MAP_INDICES(nbNodes, [&](uint i) {
+      subs[i] = i;
+      double ext = 0;
+
+      for (uint j = quotient.offsets[i]; j < quotient.offsets[i + 1]; ++j) {
+        if (n2c[quotient.neighbours[j]] == n2c[i]) {
+          ext += quotient.weights[j];
+        }
+      }
+
+      subsExt[i] = ext;
+    });
+
+    // communities are independent so they can be refined concurrently
+    parallelRanges(nbComms, buffers, [&](uint cBegin, uint cEnd,
+                                         NeighbourCommunities &neighSubs) {
+      for (uint c = cBegin; c < cEnd; ++c) {
+        double commTot = tot[c];
+
+        for (uint k = commsOffsets[c]; k < commsOffsets[c + 1]; ++k) {
+          uint n = members[k];
+          double n_wdg = quotient.degrees[n];
+
+          // only well connected singleton nodes can be merged
+          if (!singletons[n] || subsExt[n] < resolution * n_wdg * (commTot - n_wdg) * ootw) {
+            continue;
+          }
+
+          for (uint j = quotient.offsets[n]; j < quotient.offsets[n + 1]; ++j) {
+            uint neigh = quotient.neighbours[j];
+
+            if (n2c[neigh] == c) {
+              neighSubs.add(subs[neigh], quotient.weights[j]);
+            }
+          }
+
+          // find the best well connected sub community
+          uint best_sub = n;
+          double best_increase = 0;
+
+          for (auto sub : neighSubs.communities) {
+            if (sub == n ||
+                subsExt[sub] < resolution * subsTot[sub] * (commTot - subsTot[sub]) * ootw) {
+              continue;
+            }
+
+            double increase = neighSubs.weights[sub] - resolution * subsTot[sub] * n_wdg * ootw;
+
+            if (increase > best_increase) {
+              best_increase = increase;
+              best_sub = sub;
+            }
+          }
+
+          if (best_sub != n) {
+            subs[n] = best_sub;
+            subsTot[best_sub] += n_wdg;
+            // the links between the node and the sub community are now internal
+            subsExt[best_sub] += subsExt[n] - 2 * neighSubs.weights[best_sub];
+            singletons[n] = singletons[best_sub] = false;
+          }
+
+          neighSubs.clear();
+        }
+      }
+    });
+
+    return renumber(subs);
+  }
+
+  // generates the quotient graph of the given partition of the current quotient nodes
+  void aggregate(const vector<uint> &partition, uint nbParts) {
+    uint nbNodes = quotient.numberOfNodes();
+
+    // update clustering
+    TLP_PARALLEL_MAP_INDICES(clusters.size(),
+                             [&](uint i) { clusters[i] = partition[clusters[i]]; });
+
+    // group the nodes by parts
+    vector<uint> partsOffsets(nbParts + 1, 0);
+
+    for (auto part : partition) {
+      ++partsOffsets[part + 1];
+    }
+
+    for (uint p = 0; p < nbParts; ++p) {
+      partsOffsets[p + 1] += partsOffsets[p];
+    }
+
+    vector<uint> members(nbNodes);
+    vector<uint> pos(partsOffsets.begin(), partsOffsets.end() - 1);
+
+    for (uint n = 0; n < nbNodes; ++n) {
+      members[pos[partition[n]]++] = n;
+    }
+
+    // compute the neighbourhood of each part
+    CSRGraph newQuotient;
+    newQuotient.offsets.assign(nbParts + 1, 0);
+    newQuotient.selfLoops.assign(nbParts, 0);
+    vector<vector<pair<uint, double>>> partsNeighbours(nbParts);
+
+    for (auto &buffer : buffers) {
+      buffer.init(nbParts);
+    }
+
+    parallelRanges(nbParts, buffers, [&](uint pBegin, uint pEnd,
+                                         NeighbourCommunities &neighParts) {
+      for (uint p = pBegin; p < pEnd; ++p) {
+        double selfLoop = 0;
+
+        for (uint k = partsOffsets[p]; k < partsOffsets[p + 1]; ++k) {
+          uint n = members[k];
+          selfLoop += quotient.selfLoops[n];
+
+          for (uint j = quotient.offsets[n]; j < quotient.offsets[n + 1]; ++j) {
+            uint neighPart = partition[quotient.neighbours[j]];
+
+            // the links inside the part are counted twice
+            // as for the weighted degree
+            if (neighPart == p) {
+              selfLoop += quotient.weights[j];
+            } else {
+              neighParts.add(neighPart, quotient.weights[j]);
+            }
+          }
+        }
+
+        newQuotient.selfLoops[p] = selfLoop;
+        auto &neighbours = partsNeighbours[p];
+        neighbours.reserve(neighParts.communities.size());
+
+        for (auto neighPart : neighParts.communities) {
+          neighbours.emplace_back(neighPart, neighParts.weights[neighPart]);
+        }
+
+        newQuotient.offsets[p + 1] = neighbours.size();
+        neighParts.clear();
+      }
     });
+
+    for (uint p = 0; p < nbParts; ++p) {
+      newQuotient.offsets[p + 1] += newQuotient.offsets[p];
+    }
+
+    newQuotient.neighbours.resize(newQuotient.offsets[nbParts]);
+    newQuotient.weights.resize(newQuotient.offsets[nbParts]);
+
+    TLP_PARALLEL_MAP_INDICES(nbParts, [&](uint p) {
+      uint j = newQuotient.offsets[p];
+
+      for (const auto &[neighPart, weight] : partsNeighbours[p]) {
+        newQuotient.neighbours[j] = neighPart;
+        newQuotient.weights[j++] = weight;
+      }
+
+      vector<pair<uint, double>>().swap(partsNeighbours[p]);
+    });
+
+    newQuotient.computeDegrees();
+    quotient = std::move(newQuotient);
   }
 };
 
@@ -334,7 +674,15 @@ static constexpr std::string_view paramHelp[] = { // metric
     // precision
     "A given pass stops when the modularity is increased by less "
     "than precision. Default value is "
-    "<b>0.000001</b>"};
+    "<b>0.000001</b>",
+
+    // resolution
+    "The resolution parameter of the modularity. Values greater than 1.0 lead to "
+    "more and smaller communities, values lower than 1.0 to less and larger ones.",
+
+    // refinement
+    "If true, the communities are refined at each level as in the Leiden algorithm, "
+    "which guarantees that they are well connected."};
 //========================================================================================
 // same precision as the original code
 #define DEFAULT_PRECISION 0.000001
@@ -343,6 +691,8 @@ LouvainClustering::LouvainClustering(const tlp::PluginContext *context)
     : DoubleAlgorithm(context), new_mod(0.) {
   addInParameter<NumericProperty *>("metric", paramHelp[0].data(), "", false);
   addInParameter<double>("precision", paramHelp[1].data(), "0.000001", false);
+  addInParameter<double>("resolution", paramHelp[2].data(), "1.0", false);
+  addInParameter<bool>("refinement", paramHelp[3].data(), "false", false);
   addOutParameter<double>("modularity", "The computed modularity");
   addOutParameter<uint>("#communities", "The number of communities found");
 }
@@ -350,96 +700,91 @@ LouvainClustering::LouvainClustering(const tlp::PluginContext *context)
 bool LouvainClustering::run() {
   NumericProperty *metric = nullptr;
   min_modularity = DEFAULT_PRECISION;
+  resolution = 1.0;
+  refinement = false;
 
   if (dataSet != nullptr) {
     dataSet->get("metric", metric);
     dataSet->get("precision", min_modularity);
+    dataSet->get("resolution", resolution);
+    dataSet->get("refinement", refinement);
   }
 
   // initialize a random sequence according the given seed
   tlp::initRandomSequence();
 
-  nb_nodes = graph->numberOfNodes();
-
-  quotient = tlp::newGraph();
-  quotient->addNodes(nb_nodes);
-
-  clusters = new NodeVectorProperty<int>(graph);
-
-  TLP_PARALLEL_MAP_INDICES(nb_nodes, [&](uint i) { (*clusters)[i] = i; });
-
-  weights = new EdgeVectorProperty<double>(quotient);
-  // init total_weight, weights and quotient edges
-  for (auto e : graph->edges()) {
-    double weight = metric ? metric->getEdgeDoubleValue(e) : 1;
-    const auto &[src, tgt] = graph->ends(e);
-    node q_src((*clusters)[src.id]);
-    node q_tgt((*clusters)[tgt.id]);
-    // self loops are counted only once
-    total_weight += q_src != q_tgt ? 2 * weight : weight;
-    // create corresponding edge if needed
-    edge qe = quotient->existEdge(q_src, q_tgt, false);
-
-    if (!qe.isValid()) {
-      qe = quotient->addEdge(q_src, q_tgt);
-      (*weights)[qe] = weight;
-    } else {
-      // set current edge weight
-      (*weights)[qe] += weight;
+  uint nb_nodes = graph->numberOfNodes();
+
+  initQuotient(metric);
+
+  // without any weighted edge each node is a community
+  if (quotient.totalWeight <= 0) {
+    TLP_MAP_NODES_AND_INDICES(graph, [&](const node n, uint i) { result->setNodeValue(n, i); });
+
+    if (dataSet != nullptr) {
+      dataSet->set("modularity", 0.);
+      dataSet->set("#communities", nb_nodes);
     }
+
+    return true;
   }
-  ootw = 1. / total_weight;
 
-  // init other vectors
-  init_level();
-  int level = 0;
+  clusters.resize(nb_nodes);
+  TLP_PARALLEL_MAP_INDICES(nb_nodes, [&](uint i) { clusters[i] = i; });
 
-  while (one_level()) {
-    ++level;
+  n2c.resize(nb_nodes);
+  TLP_PARALLEL_MAP_INDICES(nb_nodes, [&](uint i) { n2c[i] = i; });
 
-    auto *new_quotient = tlp::newGraph();
-    auto *new_weights = new EdgeVectorProperty<double>(new_quotient);
+  buffers.resize(ThreadManager::getNumberOfThreads());
+  initLevel();
 
-    partitionToQuotient(new_quotient, new_weights);
-    delete quotient;
-    delete weights;
-    quotient = new_quotient;
-    weights = new_weights;
+  uint nbComms = nb_nodes;
 
-    init_level();
-  }
+  while (true) {
+    bool improvement = moveNodes();
+    nbComms = renumber(n2c);
+    computeTot();
 
-  // update measure
-  // Renumber communities
-  vector<int> renumber(nb_qnodes, -1);
+    // no more aggregation is possible
+    if (nbComms == quotient.numberOfNodes() || (!improvement && !refinement)) {
+      break;
+    }
 
-  for (uint n = 0; n < nb_qnodes; n++) {
-    renumber[n2c[n]] = 0;
-  }
+    if (refinement) {
+      vector<uint> subs;
+      uint nbSubs = refine(subs, nbComms);
 
-  int final = 0;
+      // the refined partition is used to build the next quotient graph
+      // whose nodes initially belong to the communities they are part of
+      if (nbSubs < quotient.numberOfNodes()) {
+        vector<uint> subsComm(nbSubs);
+
+        for (uint n = 0; n < quotient.numberOfNodes(); ++n) {
+          subsComm[subs[n]] = n2c[n];
+        }
 
-  for (uint i = 0; i < nb_qnodes; i++) {
-    if (renumber[i] != -1) {
-      renumber[i] = final++;
+        aggregate(subs, nbSubs);
+        n2c = std::move(subsComm);
+        initLevel();
+        continue;
+      }
     }
+
+    aggregate(n2c, nbComms);
+    n2c.resize(nbComms);
+    TLP_PARALLEL_MAP_INDICES(nbComms, [&](uint i) { n2c[i] = i; });
+    initLevel();
   }
 
-  // then set measure values
-  int maxVal = -1;
-  TLP_MAP_NODES_AND_INDICES(graph, [&](const node n, uint i) {
-    int val = renumber[n2c[(*clusters)[i]]];
-    result->setNodeValue(n, val);
-    maxVal = std::max(val, maxVal);
-  });
+  new_mod = modularity();
 
-  delete quotient;
-  delete weights;
-  delete clusters;
+  // then set measure values
+  TLP_MAP_NODES_AND_INDICES(graph,
+                            [&](const node n, uint i) { result->setNodeValue(n, n2c[clusters[i]]); });
 
   if (dataSet != nullptr) {
     dataSet->set("modularity", new_mod);
-    dataSet->set("#communities", uint(maxVal + 1));
+    dataSet->set("#communities", nbComms);
   }
 
   return true;
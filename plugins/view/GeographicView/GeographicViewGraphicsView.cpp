@@ -892,20 +892,28 @@ void GeographicViewGraphicsView::setGeoShape(IntegerProperty *property) {
 void GeographicViewGraphicsView::treatEvent(const Event &ev) {
   const auto *propEvt = dynamic_cast<const PropertyEvent *>(&ev);
 
-  if (propEvt && propEvt->getType() == PropertyEvent::TLP_AFTER_SET_NODE_VALUE &&
-      propEvt->getProperty() == geoLayout) {
-    // compute new node latitude / longitude from updated coordinates
-    node n = propEvt->getNode();
-    const Coord &p = geoLayout->getNodeValue(n);
-    pair<double, double> latLng = {mercatorToLatitude(p.y()), p.x() / 2};
-    nodeLatLng[n] = latLng;
-    if (latitudeProperty && longitudeProperty) {
-      latitudeProperty->setNodeValue(n, latLng.first);
-      longitudeProperty->setNodeValue(n, latLng.second);
+  if (propEvt && propEvt->getProperty() == geoLayout) {
+    if (propEvt->getType() == PropertyEvent::TLP_AFTER_SET_NODE_VALUE) {
+      updateNodeLatLng(propEvt->getNode());
+    } else if (propEvt->getType() == PropertyEvent::TLP_AFTER_SET_NODES_VALUES) {
+      for (auto n : propEvt->getNodes()) {
+        updateNodeLatLng(n);
+      }
     }
   }
 }
 
+void GeographicViewGraphicsView::updateNodeLatLng(node n) {
+  // compute new node latitude / longitude from updated coordinates
+  const Coord &p = geoLayout->getNodeValue(n);
+  pair<double, double> latLng = {mercatorToLatitude(p.y()), p.x() / 2};
+  nodeLatLng[n] = latLng;
+  if (latitudeProperty && longitudeProperty) {
+    latitudeProperty->setNodeValue(n, latLng.first);
+    longitudeProperty->setNodeValue(n, latLng.second);
+  }
+}
+
 void GeographicViewGraphicsView::switchViewType() {
   GeographicView::ViewType viewType = _geoView->viewType();
 
@@ -124,6 +124,8 @@ protected:
   void updateMapTexture();
 
 private:
+  void updateNodeLatLng(node n);
+
   GeographicView *_geoView;
   Graph *graph;
   LeafletMaps *leafletMaps;
@@ -977,6 +977,18 @@ void HistogramView::treatEvent(const Event &message) {
         afterSetEdgeValue(propertyEvent->getProperty(), propertyEvent->getEdge());
       }
 
+      if (propertyEvent->getType() == PropertyEvent::TLP_AFTER_SET_NODES_VALUES) {
+        for (auto n : propertyEvent->getNodes()) {
+          afterSetNodeValue(propertyEvent->getProperty(), n);
+        }
+      }
+
+      if (propertyEvent->getType() == PropertyEvent::TLP_AFTER_SET_EDGES_VALUES) {
+        for (auto e : propertyEvent->getEdges()) {
+          afterSetEdgeValue(propertyEvent->getProperty(), e);
+        }
+      }
+
       if (propertyEvent->getType() == PropertyEvent::TLP_AFTER_SET_ALL_NODE_VALUE) {
         afterSetAllNodeValue(propertyEvent->getProperty());
       }
@@ -224,6 +224,18 @@ void PropertyValuesDispatcher::treatEvent(const tlp::Event &evt) {
         afterSetEdgeValue(prop, propEvt->getEdge());
         return;
 
+      case PropertyEvent::TLP_AFTER_SET_NODES_VALUES:
+        for (auto n : propEvt->getNodes()) {
+          afterSetNodeValue(prop, n);
+        }
+        return;
+
+      case PropertyEvent::TLP_AFTER_SET_EDGES_VALUES:
+        for (auto e : propEvt->getEdges()) {
+          afterSetEdgeValue(prop, e);
+        }
+        return;
+
       default:
         return;
       }
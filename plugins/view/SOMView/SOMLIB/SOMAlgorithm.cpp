@@ -15,6 +15,8 @@
 #include "SOMMap.h"
 #include "InputSample.h"
 
+#include <deque>
+
 #include <talipot/DoubleProperty.h>
 
 using namespace tlp;
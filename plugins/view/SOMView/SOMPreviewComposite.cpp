@@ -13,6 +13,8 @@
 
 #include "SOMPreviewComposite.h"
 
+#include <deque>
+
 #include <talipot/ColorProperty.h>
 
 using namespace tlp;
@@ -239,8 +239,12 @@ void TableView::readSettings() {
        dynamic_cast<NodesGraphModel *>(_model) == nullptr) ||
       ((_ui->eltTypeCombo->currentIndex() == 1) &&
        dynamic_cast<EdgesGraphModel *>(_model) == nullptr)) {
+    QAbstractItemModel *oldSortModel = _ui->table->model();
     _ui->table->setModel(nullptr);
 
+    // the proxy model observes the properties of the model it sorts
+    // so it must not outlive it
+    delete oldSortModel;
     delete _model;
 
     if (_ui->eltTypeCombo->currentIndex() == 0)
@@ -0,0 +1,272 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <algorithm>
+#include <climits>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+
+#include <talipot/Graph.h>
+#include <talipot/ParallelTools.h>
+#include <talipot/PluginLibraryLoader.h>
+#include <talipot/TlpTools.h>
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace tlp;
+
+static double cpuTimeNow() {
+  return double(clock()) / CLOCKS_PER_SEC;
+}
+
+bool BenchmarkState::running() {
+  if (_iteration == 0) {
+    resumeTiming();
+  }
+
+  if (_iteration++ < _iterations) {
+    return true;
+  }
+
+  pauseTiming();
+  return false;
+}
+
+void BenchmarkState::pauseTiming() {
+  if (_timing) {
+    _realTime += chrono::duration<double>(chrono::steady_clock::now() - _realStart).count();
+    _cpuTime += cpuTimeNow() - _cpuStart;
+    _timing = false;
+  }
+}
+
+void BenchmarkState::resumeTiming() {
+  if (!_timing) {
+    _realStart = chrono::steady_clock::now();
+    _cpuStart = cpuTimeNow();
+    _timing = true;
+  }
+}
+
+struct Benchmark {
+  string name;
+  uint size;
+  function<void(BenchmarkState &)> run;
+};
+
+static vector<Benchmark> &registeredBenchmarks() {
+  static vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+BenchmarkRegistration::BenchmarkRegistration(const string &name, const vector<uint> &sizes,
+                                             function<void(BenchmarkState &)> run) {
+  for (auto size : sizes) {
+    registeredBenchmarks().push_back({name + "/" + to_string(size), size, run});
+  }
+}
+
+static volatile uint64_t keptValue = 0;
+
+void keepValue(uint64_t value) {
+  keptValue = value;
+}
+
+Graph *generateRandomGraph(uint nbNodes, uint nbEdges) {
+  setSeedOfRandomSequence(nbNodes + nbEdges);
+  initRandomSequence();
+  Graph *graph = newGraph();
+  graph->addNodes(nbNodes);
+  const vector<node> &nodes = graph->nodes();
+  vector<pair<node, node>> ends(nbEdges);
+
+  for (auto &[src, tgt] : ends) {
+    src = nodes[randomUnsignedInteger(nbNodes - 1)];
+    tgt = nodes[randomUnsignedInteger(nbNodes - 1)];
+  }
+
+  graph->addEdges(ends);
+  return graph;
+}
+
+struct BenchmarkResult {
+  string name;
+  uint size;
+  uint64_t iterations;
+  // times per iteration in nanoseconds
+  double realTime;
+  double cpuTime;
+  double itemsPerSecond;
+  map<string, double> counters;
+};
+
+static BenchmarkResult runBenchmark(const Benchmark &benchmark, double minTime) {
+  uint64_t iterations = 1;
+
+  while (true) {
+    BenchmarkState state(benchmark.size, iterations);
+    benchmark.run(state);
+
+    // increase the number of iterations until the measure lasts long enough
+    if (state.realTime() >= minTime || iterations >= 1000000000) {
+      double seconds = max(state.realTime(), 1e-12);
+      return {benchmark.name,
+              benchmark.size,
+              iterations,
+              state.realTime() * 1e9 / iterations,
+              state.cpuTime() * 1e9 / iterations,
+              state.itemsProcessed() / seconds,
+              state.counters()};
+    }
+
+    double ratio = state.realTime() > 0 ? 1.4 * minTime / state.realTime() : 10;
+    iterations = max(iterations + 1, uint64_t(iterations * min(ratio, 10.0)));
+  }
+}
+
+static void writeJSON(ostream &os, const vector<BenchmarkResult> &results) {
+  time_t now = time(nullptr);
+  char date[32];
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+  os << "{" << endl;
+  os << "  \"context\": {" << endl;
+  os << "    \"date\": \"" << date << "\"," << endl;
+  os << "    \"talipot_version\": \"" << getTalipotVersion() << "\"," << endl;
+  os << "    \"num_threads\": " << ThreadManager::getNumberOfThreads() << "," << endl;
+#ifdef NDEBUG
+  os << "    \"library_build_type\": \"release\"" << endl;
+#else
+  os << "    \"library_build_type\": \"debug\"" << endl;
+#endif
+  os << "  }," << endl;
+  os << "  \"benchmarks\": [" << endl;
+
+  for (size_t i = 0; i < results.size(); ++i) {
+    const BenchmarkResult &result = results[i];
+    os << "    {" << endl;
+    os << "      \"name\": \"" << result.name << "\"," << endl;
+    os << "      \"size\": " << result.size << "," << endl;
+    os << "      \"iterations\": " << result.iterations << "," << endl;
+    os << "      \"real_time\": " << result.realTime << "," << endl;
+    os << "      \"cpu_time\": " << result.cpuTime << "," << endl;
+    os << "      \"time_unit\": \"ns\"," << endl;
+    os << "      \"items_per_second\": " << result.itemsPerSecond;
+
+    for (const auto &[name, value] : result.counters) {
+      os << "," << endl << "      \"" << name << "\": " << value;
+    }
+
+    os << endl;
+    os << "    }" << (i + 1 < results.size() ? "," : "") << endl;
+  }
+
+  os << "  ]" << endl;
+  os << "}" << endl;
+}
+
+static void printResult(const BenchmarkResult &result) {
+  cout << left << setw(48) << result.name << right << setw(16) << fixed << setprecision(0)
+       << result.realTime << " ns" << setw(16) << result.cpuTime << " ns" << setw(12)
+       << result.iterations;
+
+  if (result.itemsPerSecond > 0) {
+    cout << setw(14) << setprecision(3) << result.itemsPerSecond / 1e6 << " M items/s";
+  }
+
+  for (const auto &[name, value] : result.counters) {
+    cout << "  " << name << "=" << setprecision(4) << value;
+  }
+
+  cout << endl;
+}
+
+static void usage(const char *program) {
+  cout << "Usage: " << program << " [options]" << endl
+       << "  --filter=REGEX      only run the benchmarks whose name matches REGEX" << endl
+       << "  --max-size=N        only run the benchmarks whose size is lower or equal to N"
+       << endl
+       << "  --min-time=SECONDS  minimum measure time of each benchmark (default 0.5)" << endl
+       << "  --json=FILE         write the results in FILE using the JSON format" << endl
+       << "  --list              list the benchmarks" << endl;
+}
+
+int main(int argc, char **argv) {
+  regex filter(".*");
+  uint maxSize = UINT_MAX;
+  double minTime = 0.5;
+  string jsonFile;
+  bool list = false;
+
+  for (int i = 1; i < argc; ++i) {
+    string arg = argv[i];
+    auto value = [&arg]() { return arg.substr(arg.find('=') + 1); };
+
+    if (arg.rfind("--filter=", 0) == 0) {
+      filter = regex(value());
+    } else if (arg.rfind("--max-size=", 0) == 0) {
+      maxSize = stoul(value());
+    } else if (arg.rfind("--min-time=", 0) == 0) {
+      minTime = stod(value());
+    } else if (arg.rfind("--json=", 0) == 0) {
+      jsonFile = value();
+    } else if (arg == "--list") {
+      list = true;
+    } else {
+      usage(argv[0]);
+      return arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+  }
+
+  initTalipotLib();
+
+  string talipotBuildDir = TALIPOT_BUILD_DIR;
+  vector<string> pluginDirs = {"clustering", "import", "layout", "metric"};
+
+  for (const auto &pluginDir : pluginDirs) {
+    PluginLibraryLoader::loadPluginsFromDir(talipotBuildDir + "/plugins/" + pluginDir);
+  }
+
+  vector<BenchmarkResult> results;
+
+  for (const auto &benchmark : registeredBenchmarks()) {
+    if (benchmark.size > maxSize || !regex_search(benchmark.name, filter)) {
+      continue;
+    }
+
+    if (list) {
+      cout << benchmark.name << endl;
+      continue;
+    }
+
+    results.push_back(runBenchmark(benchmark, minTime));
+    printResult(results.back());
+  }
+
+  if (!jsonFile.empty()) {
+    ofstream os(jsonFile);
+
+    if (!os) {
+      cerr << "Unable to write " << jsonFile << endl;
+      return EXIT_FAILURE;
+    }
+
+    writeJSON(os, results);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,164 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#ifndef TALIPOT_BENCHMARK_H
+#define TALIPOT_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <talipot/config.h>
+
+namespace tlp {
+class Graph;
+}
+
+/**
+ * @brief The state of a running benchmark.
+ *
+ * The code to measure is run inside a loop on running(), the number of iterations
+ * is chosen by the runner so that the measure lasts long enough to be significant.
+ * The setup of an iteration can be excluded from the measure with pauseTiming()
+ * and resumeTiming().
+ *
+ * @code
+ * void addNodes(BenchmarkState &state) {
+ *   while (state.running()) {
+ *     state.pauseTiming();
+ *     tlp::Graph *graph = tlp::newGraph();
+ *     state.resumeTiming();
+ *     graph->addNodes(state.size());
+ *     state.pauseTiming();
+ *     delete graph;
+ *     state.resumeTiming();
+ *   }
+ *   state.setItemsProcessed(state.iterations() * state.size());
+ * }
+ * @endcode
+ */
+class BenchmarkState {
+public:
+  BenchmarkState(uint size, uint64_t iterations) : _size(size), _iterations(iterations) {}
+
+  /**
+   * @brief The size of the problem (e.g. the number of nodes of the graph).
+   */
+  uint size() const {
+    return _size;
+  }
+
+  /**
+   * @brief The number of iterations of the measured code.
+   */
+  uint64_t iterations() const {
+    return _iterations;
+  }
+
+  /**
+   * @brief Returns true while the measured code must be run again.
+   */
+  bool running();
+
+  void pauseTiming();
+  void resumeTiming();
+
+  /**
+   * @brief Sets the number of processed items (e.g. the number of added nodes)
+   * to report a throughput.
+   */
+  void setItemsProcessed(uint64_t items) {
+    _items = items;
+  }
+
+  uint64_t itemsProcessed() const {
+    return _items;
+  }
+
+  /**
+   * @brief Sets a named measure of the result (e.g. the quality of a layout)
+   * to report along with the times.
+   */
+  void setCounter(const std::string &name, double value) {
+    _counters[name] = value;
+  }
+
+  const std::map<std::string, double> &counters() const {
+    return _counters;
+  }
+
+  /**
+   * @brief The measured real time in seconds.
+   */
+  double realTime() const {
+    return _realTime;
+  }
+
+  /**
+   * @brief The measured process cpu time in seconds.
+   */
+  double cpuTime() const {
+    return _cpuTime;
+  }
+
+private:
+  uint _size;
+  uint64_t _iterations;
+  uint64_t _iteration = 0;
+  uint64_t _items = 0;
+  std::map<std::string, double> _counters;
+  bool _timing = false;
+  std::chrono::steady_clock::time_point _realStart;
+  double _cpuStart = 0;
+  double _realTime = 0;
+  double _cpuTime = 0;
+};
+
+/**
+ * @brief Registers a benchmark run for each of the given sizes.
+ */
+struct BenchmarkRegistration {
+  BenchmarkRegistration(const std::string &name, const std::vector<uint> &sizes,
+                        std::function<void(BenchmarkState &)> run);
+};
+
+#define TLP_BENCHMARK_CONCAT(A, B) A##B
+#define TLP_BENCHMARK_NAME(A, B) TLP_BENCHMARK_CONCAT(A, B)
+
+/**
+ * @brief Registers the function func as the benchmark NAME.
+ * The following arguments are the problem sizes it is run with.
+ */
+#define TLP_BENCHMARK(NAME, FUNC, ...)                                                    \
+  static BenchmarkRegistration TLP_BENCHMARK_NAME(benchmarkRegistration, __LINE__)(       \
+      NAME, {__VA_ARGS__}, FUNC)
+
+// the graph sizes used by the benchmarks
+#define TLP_BENCHMARK_SMALL_SIZES 1000, 10000, 100000
+#define TLP_BENCHMARK_SIZES 1000, 10000, 100000, 1000000
+
+/**
+ * @brief Prevents the compiler from optimizing away the computation of value.
+ */
+void keepValue(uint64_t value);
+
+/**
+ * @brief Generates a random graph with a fixed seed,
+ * so the benchmarks are run on the same graphs.
+ */
+tlp::Graph *generateRandomGraph(uint nbNodes, uint nbEdges);
+
+#endif // TALIPOT_BENCHMARK_H
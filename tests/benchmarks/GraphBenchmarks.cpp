@@ -0,0 +1,274 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/Graph.h>
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace tlp;
+
+// the benchmarks graphs have an average degree of 8
+static const uint EDGES_PER_NODE = 4;
+
+static void addNodes(BenchmarkState &state) {
+  while (state.running()) {
+    state.pauseTiming();
+    Graph *graph = newGraph();
+    state.resumeTiming();
+
+    for (uint i = 0; i < state.size(); ++i) {
+      graph->addNode();
+    }
+
+    state.pauseTiming();
+    delete graph;
+    state.resumeTiming();
+  }
+
+  state.setItemsProcessed(state.iterations() * state.size());
+}
+TLP_BENCHMARK("Graph/AddNodes", addNodes, TLP_BENCHMARK_SIZES);
+
+static void addNodesBulk(BenchmarkState &state) {
+  while (state.running()) {
+    state.pauseTiming();
+    Graph *graph = newGraph();
+    state.resumeTiming();
+
+    graph->addNodes(state.size());
+
+    state.pauseTiming();
+    delete graph;
+    state.resumeTiming();
+  }
+
+  state.setItemsProcessed(state.iterations() * state.size());
+}
+TLP_BENCHMARK("Graph/AddNodesBulk", addNodesBulk, TLP_BENCHMARK_SIZES);
+
+static void addEdges(BenchmarkState &state) {
+  uint nbEdges = EDGES_PER_NODE * state.size();
+
+  while (state.running()) {
+    state.pauseTiming();
+    Graph *graph = newGraph();
+    graph->addNodes(state.size());
+    const vector<node> &nodes = graph->nodes();
+    state.resumeTiming();
+
+    for (uint i = 0; i < nbEdges; ++i) {
+      graph->addEdge(nodes[i % state.size()], nodes[(i * 7919) % state.size()]);
+    }
+
+    state.pauseTiming();
+    delete graph;
+    state.resumeTiming();
+  }
+
+  state.setItemsProcessed(state.iterations() * nbEdges);
+}
+TLP_BENCHMARK("Graph/AddEdges", addEdges, TLP_BENCHMARK_SIZES);
+
+static void delNodes(BenchmarkState &state) {
+  while (state.running()) {
+    state.pauseTiming();
+    Graph *graph = generateRandomGraph(state.size(), EDGES_PER_NODE * state.size());
+    vector<node> nodes = graph->nodes();
+    state.resumeTiming();
+
+    for (auto n : nodes) {
+      graph->delNode(n);
+    }
+
+    state.pauseTiming();
+    delete graph;
+    state.resumeTiming();
+  }
+
+  state.setItemsProcessed(state.iterations() * state.size());
+}
+TLP_BENCHMARK("Graph/DelNodes", delNodes, TLP_BENCHMARK_SMALL_SIZES);
+
+static void delEdges(BenchmarkState &state) {
+  uint nbEdges = EDGES_PER_NODE * state.size();
+
+  while (state.running()) {
+    state.pauseTiming();
+    Graph *graph = generateRandomGraph(state.size(), nbEdges);
+    vector<edge> edges = graph->edges();
+    state.resumeTiming();
+
+    for (auto e : edges) {
+      graph->delEdge(e);
+    }
+
+    state.pauseTiming();
+    delete graph;
+    state.resumeTiming();
+  }
+
+  state.setItemsProcessed(state.iterations() * nbEdges);
+}
+TLP_BENCHMARK("Graph/DelEdges", delEdges, TLP_BENCHMARK_SMALL_SIZES);
+
+static void inducedSubGraph(BenchmarkState &state) {
+  Graph *graph = generateRandomGraph(state.size(), EDGES_PER_NODE * state.size());
+  // half of the nodes
+  vector<node> nodes;
+
+  for (auto n : graph->nodes()) {
+    if (n.id % 2) {
+      nodes.push_back(n);
+    }
+  }
+
+  while (state.running()) {
+    Graph *sg = graph->inducedSubGraph(nodes);
+
+    state.pauseTiming();
+    graph->delSubGraph(sg);
+    state.resumeTiming();
+  }
+
+  state.setItemsProcessed(state.iterations() * nodes.size());
+  delete graph;
+}
+TLP_BENCHMARK("Graph/InducedSubGraph", inducedSubGraph, TLP_BENCHMARK_SIZES);
+
+static void subGraphAddNodes(BenchmarkState &state) {
+  Graph *graph = generateRandomGraph(state.size(), EDGES_PER_NODE * state.size());
+
+  while (state.running()) {
+    state.pauseTiming();
+    Graph *sg = graph->addSubGraph();
+    state.resumeTiming();
+
+    for (auto n : graph->nodes()) {
+      sg->addNode(n);
+    }
+
+    state.pauseTiming();
+    graph->delSubGraph(sg);
+    state.resumeTiming();
+  }
+
+  state.setItemsProcessed(state.iterations() * state.size());
+  delete graph;
+}
+TLP_BENCHMARK("Graph/SubGraphAddNodes", subGraphAddNodes, TLP_BENCHMARK_SIZES);
+
+static void iterateNodesVector(BenchmarkState &state) {
+  Graph *graph = generateRandomGraph(state.size(), 0);
+  uint sum = 0;
+
+  while (state.running()) {
+    for (auto n : graph->nodes()) {
+      sum += n.id;
+    }
+  }
+
+  keepValue(sum);
+  state.setItemsProcessed(state.iterations() * state.size());
+  delete graph;
+}
+TLP_BENCHMARK("Graph/IterateNodesVector", iterateNodesVector, TLP_BENCHMARK_SIZES);
+
+static void iterateNodesIterator(BenchmarkState &state) {
+  Graph *graph = generateRandomGraph(state.size(), 0);
+  uint sum = 0;
+
+  while (state.running()) {
+    for (auto n : graph->getNodes()) {
+      sum += n.id;
+    }
+  }
+
+  keepValue(sum);
+  state.setItemsProcessed(state.iterations() * state.size());
+  delete graph;
+}
+TLP_BENCHMARK("Graph/IterateNodesIterator", iterateNodesIterator, TLP_BENCHMARK_SIZES);
+
+static void iterateSubGraphNodes(BenchmarkState &state) {
+  Graph *graph = generateRandomGraph(state.size(), 0);
+  Graph *sg = graph->addCloneSubGraph();
+  uint sum = 0;
+
+  while (state.running()) {
+    for (auto n : sg->getNodes()) {
+      sum += n.id;
+    }
+  }
+
+  keepValue(sum);
+  state.setItemsProcessed(state.iterations() * state.size());
+  delete graph;
+}
+TLP_BENCHMARK("Graph/IterateSubGraphNodes", iterateSubGraphNodes, TLP_BENCHMARK_SIZES);
+
+static void iterateIncidence(BenchmarkState &state) {
+  uint nbEdges = EDGES_PER_NODE * state.size();
+  Graph *graph = generateRandomGraph(state.size(), nbEdges);
+  uint sum = 0;
+
+  while (state.running()) {
+    for (auto n : graph->nodes()) {
+      for (auto e : graph->incidence(n)) {
+        sum += e.id;
+      }
+    }
+  }
+
+  keepValue(sum);
+  state.setItemsProcessed(state.iterations() * 2 * nbEdges);
+  delete graph;
+}
+TLP_BENCHMARK("Graph/IterateIncidence", iterateIncidence, TLP_BENCHMARK_SIZES);
+
+static void iterateInOutEdges(BenchmarkState &state) {
+  uint nbEdges = EDGES_PER_NODE * state.size();
+  Graph *graph = generateRandomGraph(state.size(), nbEdges);
+  uint sum = 0;
+
+  while (state.running()) {
+    for (auto n : graph->nodes()) {
+      for (auto e : graph->getInOutEdges(n)) {
+        sum += e.id;
+      }
+    }
+  }
+
+  keepValue(sum);
+  state.setItemsProcessed(state.iterations() * 2 * nbEdges);
+  delete graph;
+}
+TLP_BENCHMARK("Graph/IterateInOutEdges", iterateInOutEdges, TLP_BENCHMARK_SIZES);
+
+static void existEdge(BenchmarkState &state) {
+  uint nbEdges = EDGES_PER_NODE * state.size();
+  Graph *graph = generateRandomGraph(state.size(), nbEdges);
+  const vector<node> &nodes = graph->nodes();
+  uint found = 0;
+
+  while (state.running()) {
+    for (uint i = 0; i < state.size(); ++i) {
+      found += graph->existEdge(nodes[i], nodes[(i * 7919) % state.size()], false).isValid();
+    }
+  }
+
+  keepValue(found);
+  state.setItemsProcessed(state.iterations() * state.size());
+  delete graph;
+}
+TLP_BENCHMARK("Graph/ExistEdge", existEdge, TLP_BENCHMARK_SMALL_SIZES);
@@ -0,0 +1,108 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <cstdio>
+#include <filesystem>
+
+#include <talipot/DoubleProperty.h>
+#include <talipot/Graph.h>
+#include <talipot/LayoutProperty.h>
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace tlp;
+
+// generates a graph with some properties to save
+static Graph *generateGraphToSave(uint nbNodes) {
+  Graph *graph = generateRandomGraph(nbNodes, 4 * nbNodes);
+  LayoutProperty *layout = graph->getLayoutProperty("viewLayout");
+  DoubleProperty *metric = graph->getDoubleProperty("viewMetric");
+
+  for (auto n : graph->nodes()) {
+    layout->setNodeValue(n, Coord(n.id % 1000, n.id / 1000.f, 0));
+    metric->setNodeValue(n, n.id / 7.);
+  }
+
+  for (auto e : graph->edges()) {
+    metric->setEdgeValue(e, e.id / 3.);
+  }
+
+  return graph;
+}
+
+static string benchmarkFile(const string &extension) {
+  return (filesystem::temp_directory_path() / ("talipot_benchmark." + extension)).string();
+}
+
+static void benchmarkExport(BenchmarkState &state, const string &extension) {
+  Graph *graph = generateGraphToSave(state.size());
+  string file = benchmarkFile(extension);
+
+  while (state.running()) {
+    saveGraph(graph, file);
+  }
+
+  state.setItemsProcessed(state.iterations() * (graph->numberOfNodes() + graph->numberOfEdges()));
+  remove(file.c_str());
+  delete graph;
+}
+
+static void benchmarkImport(BenchmarkState &state, const string &extension) {
+  Graph *graph = generateGraphToSave(state.size());
+  uint nbElements = graph->numberOfNodes() + graph->numberOfEdges();
+  string file = benchmarkFile(extension);
+  saveGraph(graph, file);
+  delete graph;
+
+  while (state.running()) {
+    graph = loadGraph(file);
+
+    state.pauseTiming();
+    delete graph;
+    state.resumeTiming();
+  }
+
+  state.setItemsProcessed(state.iterations() * nbElements);
+  remove(file.c_str());
+}
+
+static void exportTLP(BenchmarkState &state) {
+  benchmarkExport(state, "tlp");
+}
+TLP_BENCHMARK("ImportExport/ExportTLP", exportTLP, TLP_BENCHMARK_SMALL_SIZES);
+
+static void importTLP(BenchmarkState &state) {
+  benchmarkImport(state, "tlp");
+}
+TLP_BENCHMARK("ImportExport/ImportTLP", importTLP, TLP_BENCHMARK_SMALL_SIZES);
+
+static void exportTLPZ(BenchmarkState &state) {
+  benchmarkExport(state, "tlpz");
+}
+TLP_BENCHMARK("ImportExport/ExportTLPZ", exportTLPZ, TLP_BENCHMARK_SMALL_SIZES);
+
+static void importTLPZ(BenchmarkState &state) {
+  benchmarkImport(state, "tlpz");
+}
+TLP_BENCHMARK("ImportExport/ImportTLPZ", importTLPZ, TLP_BENCHMARK_SMALL_SIZES);
+
+static void exportTLPB(BenchmarkState &state) {
+  benchmarkExport(state, "tlpb");
+}
+TLP_BENCHMARK("ImportExport/ExportTLPB", exportTLPB, TLP_BENCHMARK_SIZES);
+
+static void importTLPB(BenchmarkState &state) {
+  benchmarkImport(state, "tlpb");
+}
+TLP_BENCHMARK("ImportExport/ImportTLPB", importTLPB, TLP_BENCHMARK_SIZES);
@@ -0,0 +1,158 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <climits>
+#include <iostream>
+
+#include <talipot/DoubleProperty.h>
+#include <talipot/Graph.h>
+#include <talipot/GraphMeasure.h>
+#include <talipot/LayoutProperty.h>
+#include <talipot/PluginsManager.h>
+#include <talipot/StringCollection.h>
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace tlp;
+
+template <typename PropertyType>
+static void applyPropertyAlgorithm(BenchmarkState &state, const string &algorithm,
+                                   uint edgesPerNode) {
+  if (!PluginsManager::pluginExists(algorithm)) {
+    cerr << "No plugin named " << algorithm << endl;
+    return;
+  }
+
+  Graph *graph = generateRandomGraph(state.size(), edgesPerNode * state.size());
+  PropertyType result(graph);
+  string errorMessage;
+
+  while (state.running()) {
+    DataSet dataSet;
+    PluginsManager::getPluginParameters(algorithm).buildDefaultDataSet(dataSet, graph);
+
+    if (!graph->applyPropertyAlgorithm(algorithm, &result, errorMessage, &dataSet)) {
+      cerr << algorithm << ": " << errorMessage << endl;
+    }
+  }
+
+  state.setItemsProcessed(state.iterations() * (graph->numberOfNodes() + graph->numberOfEdges()));
+  delete graph;
+}
+
+// the normalized stress of a layout, once optimally scaled, between a sample of nodes
+// and the nodes of their connected component, using the graph distances
+static double layoutStress(const Graph *graph, const LayoutProperty *layout) {
+  const vector<node> &nodes = graph->nodes();
+  uint nbNodes = nodes.size();
+  uint nbSources = min(nbNodes, 64u);
+  NodeVectorProperty<uint> distance(graph);
+  double sumRatios = 0, sumSquaredRatios = 0;
+  uint64_t nbPairs = 0;
+
+  for (uint i = 0; i < nbSources; ++i) {
+    uint source = uint(uint64_t(i) * nbNodes / nbSources);
+    maxDistance(graph, source, distance);
+    const Coord &coord = layout->getNodeValue(nodes[source]);
+
+    for (uint j = 0; j < nbNodes; ++j) {
+      if (j != source && distance[j] != UINT_MAX) {
+        double ratio = coord.dist(layout->getNodeValue(nodes[j])) / distance[j];
+        sumRatios += ratio;
+        sumSquaredRatios += ratio * ratio;
+        ++nbPairs;
+      }
+    }
+  }
+
+  if (nbPairs == 0 || sumSquaredRatios == 0) {
+    return 0;
+  }
+
+  // the sum over the pairs of ((s * dist(u, v) - d(u, v)) / d(u, v))^2
+  // is minimal for s = sumRatios / sumSquaredRatios
+  return 1 - sumRatios * sumRatios / (sumSquaredRatios * nbPairs);
+}
+
+// lays out a random graph using the multilevel scheme of a force directed plugin
+static void multilevelLayout(BenchmarkState &state, const string &algorithm,
+                             const string &coarsening, uint edgesPerNode) {
+  if (!PluginsManager::pluginExists(algorithm)) {
+    cerr << "No plugin named " << algorithm << endl;
+    return;
+  }
+
+  Graph *graph = generateRandomGraph(state.size(), edgesPerNode * state.size());
+  LayoutProperty result(graph);
+  string errorMessage;
+
+  while (state.running()) {
+    DataSet dataSet;
+    PluginsManager::getPluginParameters(algorithm).buildDefaultDataSet(dataSet, graph);
+    StringCollection coarsenings;
+    dataSet.get("multilevel", coarsenings);
+    coarsenings.setCurrent(coarsening);
+    dataSet.set("multilevel", coarsenings);
+
+    if (!graph->applyPropertyAlgorithm(algorithm, &result, errorMessage, &dataSet)) {
+      cerr << algorithm << ": " << errorMessage << endl;
+    }
+  }
+
+  state.setItemsProcessed(state.iterations() * (graph->numberOfNodes() + graph->numberOfEdges()));
+  state.setCounter("stress", layoutStress(graph, &result));
+  delete graph;
+}
+
+#define METRIC_BENCHMARK(NAME, ALGORITHM, EDGES_PER_NODE, ...)                            \
+  static void NAME(BenchmarkState &state) {                                               \
+    applyPropertyAlgorithm<DoubleProperty>(state, ALGORITHM, EDGES_PER_NODE);             \
+  }                                                                                       \
+  TLP_BENCHMARK("Metric/" #NAME, NAME, __VA_ARGS__)
+
+#define LAYOUT_BENCHMARK(NAME, ALGORITHM, EDGES_PER_NODE, ...)                            \
+  static void NAME(BenchmarkState &state) {                                               \
+    applyPropertyAlgorithm<LayoutProperty>(state, ALGORITHM, EDGES_PER_NODE);             \
+  }                                                                                       \
+  TLP_BENCHMARK("Layout/" #NAME, NAME, __VA_ARGS__)
+
+#define MULTILEVEL_LAYOUT_BENCHMARK(NAME, ALGORITHM, COARSENING, EDGES_PER_NODE, ...)     \
+  static void NAME(BenchmarkState &state) {                                               \
+    multilevelLayout(state, ALGORITHM, COARSENING, EDGES_PER_NODE);                       \
+  }                                                                                       \
+  TLP_BENCHMARK("Multilevel/" #NAME, NAME, __VA_ARGS__)
+
+METRIC_BENCHMARK(Degree, "Degree", 4, TLP_BENCHMARK_SIZES);
+METRIC_BENCHMARK(KCores, "K-Cores", 4, TLP_BENCHMARK_SIZES);
+METRIC_BENCHMARK(PageRank, "Page Rank", 4, TLP_BENCHMARK_SIZES);
+METRIC_BENCHMARK(ConnectedComponent, "Connected Component", 1, TLP_BENCHMARK_SIZES);
+METRIC_BENCHMARK(Louvain, "Louvain", 4, TLP_BENCHMARK_SMALL_SIZES);
+METRIC_BENCHMARK(BetweennessCentrality, "Betweenness Centrality", 4, 1000, 10000);
+METRIC_BENCHMARK(Eccentricity, "Eccentricity", 4, 1000, 10000);
+
+LAYOUT_BENCHMARK(Random, "Random layout", 4, TLP_BENCHMARK_SIZES);
+LAYOUT_BENCHMARK(Circular, "Circular", 4, TLP_BENCHMARK_SMALL_SIZES);
+LAYOUT_BENCHMARK(ConnectedComponentPacking, "Connected Component Packing", 1,
+                 TLP_BENCHMARK_SMALL_SIZES);
+LAYOUT_BENCHMARK(GEM, "GEM (Frick)", 2, 1000, 10000);
+LAYOUT_BENCHMARK(LinLog, "LinLog", 2, 1000, 10000);
+LAYOUT_BENCHMARK(GRIP, "GRIP", 2, 1000, 10000);
+LAYOUT_BENCHMARK(SparseStress, "Sparse Stress", 2, TLP_BENCHMARK_SMALL_SIZES);
+
+MULTILEVEL_LAYOUT_BENCHMARK(GEMNone, "GEM (Frick)", "none", 2, 1000, 10000);
+MULTILEVEL_LAYOUT_BENCHMARK(GEMMatching, "GEM (Frick)", "matching", 2, 1000, 10000);
+MULTILEVEL_LAYOUT_BENCHMARK(GEMIndependentSet, "GEM (Frick)", "independent set", 2, 1000, 10000);
+MULTILEVEL_LAYOUT_BENCHMARK(LinLogNone, "LinLog", "none", 2, 1000, 10000);
+MULTILEVEL_LAYOUT_BENCHMARK(LinLogMatching, "LinLog", "matching", 2, 1000, 10000);
+MULTILEVEL_LAYOUT_BENCHMARK(LinLogIndependentSet, "LinLog", "independent set", 2, 1000, 10000);
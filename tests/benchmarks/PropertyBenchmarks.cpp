@@ -0,0 +1,204 @@
+/**
+ *
+ * Copyright (C) 2021  The Talipot developers
+ *
+ * Talipot is a fork of Tulip, created by David Auber
+ * and the Tulip development Team from LaBRI, University of Bordeaux
+ *
+ * See the AUTHORS file at the top-level directory of this distribution
+ * License: GNU General Public License version 3, or any later version
+ * See top-level LICENSE file for more information
+ *
+ */
+
+#include <talipot/DoubleProperty.h>
+#include <talipot/Graph.h>
+#include <talipot/LayoutProperty.h>
+#include <talipot/StringProperty.h>
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace tlp;
+
+// The MutableContainer storing the values of a property switches between a vector
+// and a hash map according to the ratio of non default values, so the get/set
+// benchmarks are run with all the values set (vector storage), with one value
+// out of SPARSE_RATIO set (hash storage) and with only default values.
+static const uint SPARSE_RATIO = 100;
+
+static void setNodeValues(BenchmarkState &state, uint step) {
+  Graph *graph = generateRandomGraph(state.size(), 0);
+  const vector<node> &nodes = graph->nodes();
+  uint nbValues = 0;
+
+  while (state.running()) {
+    state.pauseTiming();
+    DoubleProperty metric(graph);
+    state.resumeTiming();
+
+    for (uint i = 0; i < nodes.size(); i += step) {
+      metric.setNodeValue(nodes[i], i);
+    }
+
+    nbValues = (nodes.size() + step - 1) / step;
+  }
+
+  state.setItemsProcessed(state.iterations() * nbValues);
+  delete graph;
+}
+
+static void setNodeValuesDense(BenchmarkState &state) {
+  setNodeValues(state, 1);
+}
+TLP_BENCHMARK("Property/SetNodeValuesDense", setNodeValuesDense, TLP_BENCHMARK_SIZES);
+
+static void setNodeValuesSparse(BenchmarkState &state) {
+  setNodeValues(state, SPARSE_RATIO);
+}
+TLP_BENCHMARK("Property/SetNodeValuesSparse", setNodeValuesSparse, TLP_BENCHMARK_SIZES);
+
+static void getNodeValues(BenchmarkState &state, uint step) {
+  Graph *graph = generateRandomGraph(state.size(), 0);
+  const vector<node> &nodes = graph->nodes();
+  DoubleProperty metric(graph);
+
+  for (uint i = 0; step && i < nodes.size(); i += step) {
+    metric.setNodeValue(nodes[i], i);
+  }
+
+  double sum = 0;
+
+  while (state.running()) {
+    for (auto n : nodes) {
+      sum += metric.getNodeValue(n);
+    }
+  }
+
+  keepValue(uint64_t(sum));
+  state.setItemsProcessed(state.iterations() * state.size());
+  delete graph;
+}
+
+static void getNodeValuesDense(BenchmarkState &state) {
+  getNodeValues(state, 1);
+}
+TLP_BENCHMARK("Property/GetNodeValuesDense", getNodeValuesDense, TLP_BENCHMARK_SIZES);
+
+static void getNodeValuesSparse(BenchmarkState &state) {
+  getNodeValues(state, SPARSE_RATIO);
+}
+TLP_BENCHMARK("Property/GetNodeValuesSparse", getNodeValuesSparse, TLP_BENCHMARK_SIZES);
+
+static void getNodeValuesDefault(BenchmarkState &state) {
+  getNodeValues(state, 0);
+}
+TLP_BENCHMARK("Property/GetNodeValuesDefault", getNodeValuesDefault, TLP_BENCHMARK_SIZES);
+
+static void setAllNodeValue(BenchmarkState &state) {
+  Graph *graph = generateRandomGraph(state.size(), 0);
+  DoubleProperty metric(graph);
+  double value = 0;
+
+  while (state.running()) {
+    metric.setAllNodeValue(++value);
+  }
+
+  state.setItemsProcessed(state.iterations() * state.size());
+  delete graph;
+}
+TLP_BENCHMARK("Property/SetAllNodeValue", setAllNodeValue, TLP_BENCHMARK_SIZES);
+
+static void setSubGraphAllNodeValue(BenchmarkState &state) {
+  Graph *graph = generateRandomGraph(state.size(), 0);
+  Graph *sg = graph->addSubGraph();
+
+  for (auto n : graph->nodes()) {
+    if (n.id % 2) {
+      sg->addNode(n);
+    }
+  }
+
+  DoubleProperty metric(graph);
+  double value = 0;
+
+  while (state.running()) {
+    metric.setAllNodeValue(++value, sg);
+  }
+
+  state.setItemsProcessed(state.iterations() * sg->numberOfNodes());
+  delete graph;
+}
+TLP_BENCHMARK("Property/SetSubGraphAllNodeValue", setSubGraphAllNodeValue, TLP_BENCHMARK_SIZES);
+
+static void setStringNodeValues(BenchmarkState &state) {
+  Graph *graph = generateRandomGraph(state.size(), 0);
+  const vector<node> &nodes = graph->nodes();
+  vector<string> labels(nodes.size());
+
+  for (uint i = 0; i < nodes.size(); ++i) {
+    labels[i] = "node " + to_string(i % 1000);
+  }
+
+  while (state.running()) {
+    state.pauseTiming();
+    StringProperty label(graph);
+    state.resumeTiming();
+
+    for (uint i = 0; i < nodes.size(); ++i) {
+      label.setNodeValue(nodes[i], labels[i]);
+    }
+  }
+
+  state.setItemsProcessed(state.iterations() * state.size());
+  delete graph;
+}
+TLP_BENCHMARK("Property/SetStringNodeValues", setStringNodeValues, TLP_BENCHMARK_SIZES);
+
+static void layoutBoundingBox(BenchmarkState &state) {
+  Graph *graph = generateRandomGraph(state.size(), 0);
+  LayoutProperty layout(graph);
+
+  for (auto n : graph->nodes()) {
+    layout.setNodeValue(n, Coord(n.id % 1000, n.id / 1000.f, 0));
+  }
+
+  double sum = 0;
+
+  while (state.running()) {
+    // the min and max are cached so the layout must be modified
+    state.pauseTiming();
+    layout.setNodeValue(graph->nodes()[0], Coord(sum, -sum, 0));
+    state.resumeTiming();
+    sum += layout.getMax()[0] - layout.getMin()[0];
+  }
+
+  keepValue(uint64_t(sum));
+  state.setItemsProcessed(state.iterations() * state.size());
+  delete graph;
+}
+TLP_BENCHMARK("Property/LayoutBoundingBox", layoutBoundingBox, TLP_BENCHMARK_SIZES);
+
+static void copyProperty(BenchmarkState &state) {
+  Graph *graph = generateRandomGraph(state.size(), 4 * state.size());
+  DoubleProperty metric(graph);
+
+  for (auto n : graph->nodes()) {
+    metric.setNodeValue(n, n.id);
+  }
+
+  for (auto e : graph->edges()) {
+    metric.setEdgeValue(e, e.id);
+  }
+
+  while (state.running()) {
+    state.pauseTiming();
+    DoubleProperty copy(graph);
+    state.resumeTiming();
+    copy = metric;
+  }
+
+  state.setItemsProcessed(state.iterations() * (graph->numberOfNodes() + graph->numberOfEdges()));
+  delete graph;
+}
+TLP_BENCHMARK("Property/Copy", copyProperty, TLP_BENCHMARK_SIZES);
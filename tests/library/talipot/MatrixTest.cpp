@@ -215,3 +215,59 @@ void MatrixTest::testInternalOperation() {
   mat1 *= mat1;
   CPPUNIT_ASSERT_EQUAL(mat2, mat1);
 }
+//==========================================================
+void MatrixTest::testSparseMatrix() {
+  SparseMatrix mat(3);
+  mat.addEntry(2, 0, 1);
+  mat.addEntry(0, 0, 2);
+  mat.addEntry(1, 1, 3);
+  mat.addEntry(0, 0, 2);
+  mat.addEntry(0, 2, 1);
+  mat.compress();
+  CPPUNIT_ASSERT_EQUAL(4u, mat.numberOfEntries());
+  CPPUNIT_ASSERT_EQUAL(4.0, mat.diagonal(0));
+  CPPUNIT_ASSERT_EQUAL(1.0, mat.get(0, 2));
+  CPPUNIT_ASSERT_EQUAL(0.0, mat.get(0, 1));
+  CPPUNIT_ASSERT_EQUAL(0.0, mat.diagonal(2));
+
+  vector<double> y;
+  mat.multiply({1, 2, 3}, y);
+  CPPUNIT_ASSERT_EQUAL(7.0, y[0]);
+  CPPUNIT_ASSERT_EQUAL(6.0, y[1]);
+  CPPUNIT_ASSERT_EQUAL(1.0, y[2]);
+}
+//==========================================================
+void MatrixTest::testConjugateGradient() {
+  // the 1D Laplacian with fixed ends, the solution of A.x = 1 is x[i] = (i + 1) * (n - i) / 2
+  // the size is larger than the blocks processed in parallel
+  const uint n = 5000;
+  SparseMatrix mat(n);
+
+  for (uint i = 0; i < n; ++i) {
+    mat.addEntry(i, i, 2);
+
+    if (i > 0) {
+      mat.addEntry(i, i - 1, -1);
+      mat.addEntry(i - 1, i, -1);
+    }
+  }
+
+  mat.compress();
+  vector<double> b(n, 1), x;
+  uint nbIterations = 0;
+  CPPUNIT_ASSERT(solveConjugateGradient(mat, b, x, 1e-10, n, &nbIterations));
+  CPPUNIT_ASSERT(nbIterations > 0 && nbIterations <= n);
+
+  for (uint i = 0; i < n; ++i) {
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(double(i + 1) * (n - i) / 2, x[i], 1e-4 * x[i]);
+  }
+
+  // the initial guess is the solution
+  CPPUNIT_ASSERT(solveConjugateGradient(mat, b, x, 1e-6, n, &nbIterations));
+  CPPUNIT_ASSERT_EQUAL(0u, nbIterations);
+
+  // the iterations are bounded
+  x.clear();
+  CPPUNIT_ASSERT(!solveConjugateGradient(mat, b, x, 1e-10, 10, &nbIterations));
+  CPPUNIT_ASSERT_EQUAL(10u, nbIterations);
+}
@@ -17,6 +17,7 @@
 #include <string>
 #include <talipot/Graph.h>
 #include <talipot/Matrix.h>
+#include <talipot/SparseMatrix.h>
 
 #include "CppUnitIncludes.h"
 
@@ -24,6 +25,8 @@ class MatrixTest : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(MatrixTest);
   CPPUNIT_TEST(testExternalOperation);
   CPPUNIT_TEST(testInternalOperation);
+  CPPUNIT_TEST(testSparseMatrix);
+  CPPUNIT_TEST(testConjugateGradient);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -31,6 +34,8 @@ public:
   void tearDown() override {}
   void testExternalOperation();
   void testInternalOperation();
+  void testSparseMatrix();
+  void testConjugateGradient();
 };
 
 #endif // MATRIX_TEST_H
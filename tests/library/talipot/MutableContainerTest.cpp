@@ -13,6 +13,8 @@
 
 #include "MutableContainerTest.h"
 
+#include <talipot/StringPool.h>
+
 using namespace std;
 using namespace tlp;
 
@@ -96,6 +98,122 @@ void MutableContainerTest::testCompression() {
   }
 }
 //==========================================================
+void MutableContainerTest::testVectStorage() {
+  mutBool->setAll(false);
+  mutDouble->setAll(-1.0);
+  mutString->setAll("");
+
+  // set the values in decreasing order of index to grow the storage
+  // at its front over several chunks
+  const uint nbValues = 5000;
+
+  for (uint i = nbValues; i > 0; --i) {
+    mutBool->set(i, i % 3 == 0);
+    mutDouble->set(i, i);
+    mutString->set(i, to_string(i));
+  }
+
+  CPPUNIT_ASSERT_EQUAL(MutableContainer<bool>::VECT, mutBool->state);
+  CPPUNIT_ASSERT_EQUAL(MutableContainer<double>::VECT, mutDouble->state);
+  CPPUNIT_ASSERT_EQUAL(MutableContainer<string>::VECT, mutString->state);
+  CPPUNIT_ASSERT_EQUAL(nbValues / 3, mutBool->numberOfNonDefaultValues());
+
+  // then grow it at its back
+  for (uint i = nbValues + 1; i <= 2 * nbValues; ++i) {
+    mutBool->set(i, i % 3 == 0);
+    mutDouble->set(i, i);
+    mutString->set(i, to_string(i));
+  }
+
+  for (uint i = 1; i <= 2 * nbValues; ++i) {
+    CPPUNIT_ASSERT_EQUAL(i % 3 == 0, mutBool->get(i));
+    CPPUNIT_ASSERT_EQUAL(double(i), mutDouble->get(i));
+    CPPUNIT_ASSERT_EQUAL(to_string(i), mutString->get(i));
+  }
+
+  CPPUNIT_ASSERT(!mutBool->get(0));
+  CPPUNIT_ASSERT_EQUAL(-1.0, mutDouble->get(2 * nbValues + 1));
+
+  uint nbFound = 0;
+  for (uint i : mutBool->findAll(true)) {
+    CPPUNIT_ASSERT_EQUAL(0u, i % 3);
+    ++nbFound;
+  }
+  CPPUNIT_ASSERT_EQUAL(2 * nbValues / 3, nbFound);
+
+  for (uint i = 1; i <= 2 * nbValues; ++i) {
+    mutBool->invertBooleanValue(i);
+  }
+  CPPUNIT_ASSERT_EQUAL(2 * nbValues - 2 * nbValues / 3, mutBool->numberOfNonDefaultValues());
+  CPPUNIT_ASSERT(mutBool->get(1));
+  CPPUNIT_ASSERT(!mutBool->get(3));
+
+  for (uint i = 1; i <= 2 * nbValues; ++i) {
+    mutDouble->add(i, 1.0);
+  }
+  CPPUNIT_ASSERT_EQUAL(2.0, mutDouble->get(1));
+  CPPUNIT_ASSERT_EQUAL(2.0 * nbValues + 1, mutDouble->get(2 * nbValues));
+
+  // resetting a value to the default one
+  mutString->set(10, "");
+  CPPUNIT_ASSERT(!mutString->hasNonDefaultValue(10));
+  CPPUNIT_ASSERT_EQUAL(2 * nbValues - 1, mutString->numberOfNonDefaultValues());
+}
+//==========================================================
+void MutableContainerTest::testMemoryUsage() {
+  MutableContainer<double> doubles;
+  MutableContainer<bool> bools;
+  const uint nbValues = 100000;
+
+  CPPUNIT_ASSERT_EQUAL(size_t(0), doubles.memoryUsage());
+  CPPUNIT_ASSERT_EQUAL(size_t(0), bools.memoryUsage());
+
+  for (uint i = 0; i < nbValues; ++i) {
+    doubles.set(i, 1.0);
+    bools.set(i, true);
+  }
+
+  CPPUNIT_ASSERT_EQUAL(MutableContainer<double>::VECT, doubles.state);
+  CPPUNIT_ASSERT(doubles.memoryUsage() >= nbValues * sizeof(double));
+  // the last chunk is the only one which may be partially used
+  CPPUNIT_ASSERT(doubles.memoryUsage() < (nbValues + 2048) * sizeof(double));
+
+  // the booleans are packed
+  CPPUNIT_ASSERT_EQUAL(MutableContainer<bool>::VECT, bools.state);
+  CPPUNIT_ASSERT(bools.memoryUsage() >= nbValues / 8);
+  CPPUNIT_ASSERT(bools.memoryUsage() <= nbValues / 4);
+
+  // the memory allocated by the values stored by pointer is accounted
+  mutString->setAll("");
+  size_t emptyUsage = mutString->memoryUsage();
+  size_t poolUsage = StringPool::memoryUsage();
+  uint poolSize = StringPool::size();
+  mutString->set(0, string(1000, 'a'));
+  mutString->set(1, string(1000, 'a'));
+  CPPUNIT_ASSERT(mutString->memoryUsage() >= emptyUsage + 2000);
+  CPPUNIT_ASSERT_EQUAL(poolUsage, StringPool::memoryUsage());
+
+  // the interned strings are shared in the pool
+  mutString->setInternedValues(true);
+  CPPUNIT_ASSERT(mutString->memoryUsage() < emptyUsage + 1000);
+  CPPUNIT_ASSERT(StringPool::memoryUsage() >= poolUsage + 1000);
+  CPPUNIT_ASSERT(StringPool::memoryUsage() < poolUsage + 2000);
+  mutString->setInternedValues(false);
+  CPPUNIT_ASSERT(mutString->memoryUsage() >= emptyUsage + 2000);
+  CPPUNIT_ASSERT_EQUAL(poolSize, StringPool::size());
+
+  // the memory is released when resetting the values
+  doubles.setAll(0);
+  CPPUNIT_ASSERT_EQUAL(size_t(0), doubles.memoryUsage());
+
+  // sparse values are stored in a hash map
+  doubles.set(0, 1.0);
+  doubles.set(nbValues, 1.0);
+  CPPUNIT_ASSERT_EQUAL(MutableContainer<double>::HASH, doubles.state);
+  CPPUNIT_ASSERT(doubles.memoryUsage() > 0);
+  CPPUNIT_ASSERT(doubles.memoryUsage() < 1024);
+}
+//==========================================================
 void MutableContainerTest::testFindAll() {
   mutBool->setAll(false);
   mutDouble->setAll(10.0);
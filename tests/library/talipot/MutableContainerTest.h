@@ -28,6 +28,8 @@ class MutableContainerTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testSetGet);
   CPPUNIT_TEST(testFindAll);
   CPPUNIT_TEST(testCompression);
+  CPPUNIT_TEST(testVectStorage);
+  CPPUNIT_TEST(testMemoryUsage);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -43,6 +45,8 @@ public:
   void testSetGet();
   void testFindAll();
   void testCompression();
+  void testVectStorage();
+  void testMemoryUsage();
 };
 }
 #endif // MUTABLE_CONTAINER_TEST_H
@@ -72,11 +72,13 @@ public:
   std::set<PropertyInterface *> properties;
   node lastNode;
   edge lastEdge;
+  uint nbBulkEvents = 0;
 
   PropertyObserverTest() = default;
 
   void reset() {
     properties.clear();
+    nbBulkEvents = 0;
   }
 
   uint nbProperties() const {
@@ -136,6 +138,16 @@ public:
       case PropertyEvent::TLP_BEFORE_SET_ALL_EDGE_VALUE:
         beforeSetAllEdgeValue(prop);
         return;
+
+      case PropertyEvent::TLP_BEFORE_SET_NODES_VALUES:
+        ++nbBulkEvents;
+        beforeSetNodeValue(prop, propEvt->getNodes().back());
+        return;
+
+      case PropertyEvent::TLP_BEFORE_SET_EDGES_VALUES:
+        ++nbBulkEvents;
+        beforeSetEdgeValue(prop, propEvt->getEdges().back());
+        return;
       default:
         return;
       }
@@ -486,6 +498,71 @@ void ObservablePropertyTest::testNoPropertiesEventsAfterGraphClear() {
   CPPUNIT_ASSERT(pObserver->nbProperties() == 0);
 }
 
+//==========================================================
+void ObservablePropertyTest::testBulkSetValues() {
+  auto *prop = static_cast<DoubleProperty *>(props[DOUBLE_PROP]);
+  const vector<node> &nodes = graph->nodes();
+  vector<double> values;
+
+  for (uint i = 0; i < nodes.size(); ++i) {
+    values.push_back(i);
+  }
+
+  // compute the cached minimum and maximum
+  CPPUNIT_ASSERT_EQUAL(0.0, prop->getNodeMax());
+
+  observer->reset();
+  pObserver->reset();
+  prop->setNodeValues(nodes, values);
+  // only one event is received for all the nodes
+  CPPUNIT_ASSERT_EQUAL(1u, pObserver->nbBulkEvents);
+  CPPUNIT_ASSERT(pObserver->found(prop));
+  CPPUNIT_ASSERT(pObserver->getNode() == nodes.back());
+  CPPUNIT_ASSERT_EQUAL(1u, observer->nbObservables());
+  CPPUNIT_ASSERT(observer->found(prop));
+
+  for (uint i = 0; i < nodes.size(); ++i) {
+    CPPUNIT_ASSERT_EQUAL(double(i), prop->getNodeValue(nodes[i]));
+  }
+
+  // the cached maximum has been updated
+  CPPUNIT_ASSERT_EQUAL(double(NB_NODES - 1), prop->getNodeMax());
+
+  pObserver->reset();
+  prop->setEdgeValues(graph->edges(), 5.0);
+  CPPUNIT_ASSERT_EQUAL(1u, pObserver->nbBulkEvents);
+
+  for (auto e : graph->edges()) {
+    CPPUNIT_ASSERT_EQUAL(5.0, prop->getEdgeValue(e));
+  }
+
+  // no event is sent when there is no value to set
+  pObserver->reset();
+  prop->setNodeValues(vector<node>(), 1.0);
+  CPPUNIT_ASSERT_EQUAL(0u, pObserver->nbBulkEvents);
+
+  // copy the values of some nodes from another property
+  DoubleProperty other(graph);
+  other.setAllNodeValue(10.0);
+  pObserver->reset();
+  prop->copy(vector<node>(nodes.begin(), nodes.begin() + 2), &other);
+  CPPUNIT_ASSERT_EQUAL(1u, pObserver->nbBulkEvents);
+  CPPUNIT_ASSERT_EQUAL(10.0, prop->getNodeValue(nodes[0]));
+  CPPUNIT_ASSERT_EQUAL(10.0, prop->getNodeValue(nodes[1]));
+  CPPUNIT_ASSERT_EQUAL(2.0, prop->getNodeValue(nodes[2]));
+
+  // the bulk updates can be undone
+  graph->push();
+  prop->setNodeValues(nodes, -1.0);
+  prop->setEdgeValues(graph->edges(), -1.0);
+  CPPUNIT_ASSERT_EQUAL(-1.0, prop->getNodeMin());
+  graph->pop();
+  CPPUNIT_ASSERT_EQUAL(10.0, prop->getNodeValue(nodes[0]));
+  CPPUNIT_ASSERT_EQUAL(2.0, prop->getNodeValue(nodes[2]));
+  CPPUNIT_ASSERT_EQUAL(5.0, prop->getEdgeValue(graph->getOneEdge()));
+  CPPUNIT_ASSERT_EQUAL(2.0, prop->getNodeMin());
+}
+
 //==========================================================
 CppUnit::Test *ObservablePropertyTest::suite() {
   auto *suiteOfTests = new CppUnit::TestSuite("Talipot lib : Graph");
@@ -518,6 +595,8 @@ CppUnit::Test *ObservablePropertyTest::suite() {
   suiteOfTests->addTest(new CppUnit::TestCaller<ObservablePropertyTest>(
       "noPropertiesEventsAfterGraphClear",
       &ObservablePropertyTest::testNoPropertiesEventsAfterGraphClear));
+  suiteOfTests->addTest(new CppUnit::TestCaller<ObservablePropertyTest>(
+      "bulk setNodeValues/setEdgeValues", &ObservablePropertyTest::testBulkSetValues));
   return suiteOfTests;
 }
 //==========================================================
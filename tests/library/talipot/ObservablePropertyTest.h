@@ -43,6 +43,7 @@ public:
   void testRemoveObserver();
   void testObserverWhenRemoveObservable();
   void testNoPropertiesEventsAfterGraphClear();
+  void testBulkSetValues();
 
   void setNodeValue(tlp::PropertyInterface *, const char *, bool, bool, bool = true);
   void setEdgeValue(tlp::PropertyInterface *, const char *, bool, bool, bool = true);
@@ -11,11 +11,16 @@
  *
  */
 
+#include <sstream>
+
 #include "PluginsTest.h"
 
+#include <talipot/AlgorithmResultsCache.h>
 #include <talipot/BooleanProperty.h>
+#include <talipot/DoubleProperty.h>
 #include <talipot/PluginLibraryLoader.h>
 #include <talipot/PluginLoaderTxt.h>
+#include <talipot/PluginProfiler.h>
 #include <talipot/Plugin.h>
 
 using namespace std;
@@ -112,6 +117,125 @@ void PluginsTest::testAncestorGraph() {
   result = grandchild->applyPropertyAlgorithm(invalidAlgorithm, &sel, err);
   CPPUNIT_ASSERT_MESSAGE(err, !result);
 }
+//==========================================================
+void PluginsTest::testResultsCache() {
+  if (!PluginsManager::pluginExists("Test2")) {
+    PluginLibraryLoader::loadPluginLibrary("./testPlugin2." + suffix);
+  }
+
+  string algorithm = "Test2";
+  string err;
+  node n = graph->addNode();
+  BooleanProperty sel(graph);
+  DoubleProperty weight(graph);
+  DataSet params;
+  params.set("weight", &weight);
+  params.set("directed", true);
+
+  // the cache is disabled by default
+  CPPUNIT_ASSERT(!AlgorithmResultsCache::isEnabled());
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm(algorithm, &sel, err, &params));
+  CPPUNIT_ASSERT_EQUAL(0u, AlgorithmResultsCache::numberOfResults());
+
+  AlgorithmResultsCache::setEnabled(true);
+  AlgorithmResultsCache::resetStatistics();
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm(algorithm, &sel, err, &params));
+  CPPUNIT_ASSERT_EQUAL(uint64_t(0), AlgorithmResultsCache::numberOfHits());
+  CPPUNIT_ASSERT_EQUAL(uint64_t(1), AlgorithmResultsCache::numberOfMisses());
+  CPPUNIT_ASSERT_EQUAL(1u, AlgorithmResultsCache::numberOfResults());
+
+  // same call, the cached values are restored
+  sel.setNodeValue(n, true);
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm(algorithm, &sel, err, &params));
+  CPPUNIT_ASSERT_EQUAL(uint64_t(1), AlgorithmResultsCache::numberOfHits());
+  CPPUNIT_ASSERT(!sel.getNodeValue(n));
+
+  // different parameters
+  params.set("directed", false);
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm(algorithm, &sel, err, &params));
+  CPPUNIT_ASSERT_EQUAL(uint64_t(2), AlgorithmResultsCache::numberOfMisses());
+  CPPUNIT_ASSERT_EQUAL(2u, AlgorithmResultsCache::numberOfResults());
+
+  // a property parameter update invalidates the results depending on it
+  weight.setNodeValue(n, 1.0);
+  CPPUNIT_ASSERT_EQUAL(0u, AlgorithmResultsCache::numberOfResults());
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm(algorithm, &sel, err, &params));
+  CPPUNIT_ASSERT_EQUAL(uint64_t(3), AlgorithmResultsCache::numberOfMisses());
+
+  // as well as a graph update
+  graph->addNode();
+  CPPUNIT_ASSERT_EQUAL(0u, AlgorithmResultsCache::numberOfResults());
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm(algorithm, &sel, err, &params));
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm(algorithm, &sel, err, &params));
+  CPPUNIT_ASSERT_EQUAL(uint64_t(2), AlgorithmResultsCache::numberOfHits());
+  CPPUNIT_ASSERT_EQUAL(uint64_t(4), AlgorithmResultsCache::numberOfMisses());
+
+  // the out parameters are restored with the result
+  // and the undeclared parameters are not part of the key
+  uint runs = 0;
+  CPPUNIT_ASSERT(params.get("runs", runs));
+  params.set("runs", 0u);
+  params.set("undeclared", 1);
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm(algorithm, &sel, err, &params));
+  CPPUNIT_ASSERT_EQUAL(uint64_t(3), AlgorithmResultsCache::numberOfHits());
+  uint restoredRuns = 0;
+  CPPUNIT_ASSERT(params.get("runs", restoredRuns));
+  CPPUNIT_ASSERT_EQUAL(runs, restoredRuns);
+
+  // the calls reading the initial values of their result are not cached
+  AlgorithmResultsCache::addResultInputParameter(algorithm, "initial");
+  BooleanProperty initial(graph);
+  params.set("initial", &initial);
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm(algorithm, &sel, err, &params));
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm(algorithm, &sel, err, &params));
+  CPPUNIT_ASSERT_EQUAL(uint64_t(3), AlgorithmResultsCache::numberOfHits());
+  CPPUNIT_ASSERT_EQUAL(uint64_t(4), AlgorithmResultsCache::numberOfMisses());
+  CPPUNIT_ASSERT(params.get("runs", restoredRuns));
+  CPPUNIT_ASSERT_EQUAL(runs + 2, restoredRuns);
+
+  AlgorithmResultsCache::setEnabled(false);
+  CPPUNIT_ASSERT_EQUAL(0u, AlgorithmResultsCache::numberOfResults());
+}
+//==========================================================
+void PluginsTest::testProfiler() {
+  if (!PluginsManager::pluginExists("Test2")) {
+    PluginLibraryLoader::loadPluginLibrary("./testPlugin2." + suffix);
+  }
+
+  string err;
+  graph->addNode();
+  BooleanProperty sel(graph);
+
+  // the profiler is disabled by default
+  CPPUNIT_ASSERT(!PluginProfiler::isEnabled());
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("Test2", &sel, err));
+  CPPUNIT_ASSERT(PluginProfiler::profiles().empty());
+
+  PluginProfiler::setEnabled(true);
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("Test2", &sel, err));
+  vector<PluginProfile> profiles = PluginProfiler::profiles();
+  CPPUNIT_ASSERT_EQUAL(size_t(1), profiles.size());
+  CPPUNIT_ASSERT_EQUAL(string("Test2"), profiles[0].pluginName);
+  CPPUNIT_ASSERT_EQUAL(string("PropertyAlgorithm"), profiles[0].category);
+  CPPUNIT_ASSERT_EQUAL(graph->getId(), profiles[0].graphId);
+  CPPUNIT_ASSERT_EQUAL(0u, profiles[0].depth);
+  CPPUNIT_ASSERT(profiles[0].success);
+  CPPUNIT_ASSERT(profiles[0].wallTime >= 0);
+  // Test2 does not modify the graph nor its result
+  CPPUNIT_ASSERT_EQUAL(uint64_t(0), profiles[0].graphEvents);
+  CPPUNIT_ASSERT_EQUAL(uint64_t(0), profiles[0].valuesWritten);
+
+  stringstream trace;
+  PluginProfiler::writeTrace(trace);
+  CPPUNIT_ASSERT(trace.str().find("\"traceEvents\"") != string::npos);
+  CPPUNIT_ASSERT(trace.str().find("\"Test2\"") != string::npos);
+
+  PluginProfiler::clear();
+  CPPUNIT_ASSERT(PluginProfiler::profiles().empty());
+  PluginProfiler::setEnabled(false);
+  CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("Test2", &sel, err));
+  CPPUNIT_ASSERT(PluginProfiler::profiles().empty());
+}
 
 void PluginsTest::availablePlugins() {
   CPPUNIT_ASSERT_MESSAGE("The 'Test' plugin is not listed by the PluginsManager",
@@ -25,6 +25,8 @@ class PluginsTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testloadPlugin);
   CPPUNIT_TEST(testCircularPlugin);
   CPPUNIT_TEST(testAncestorGraph);
+  CPPUNIT_TEST(testResultsCache);
+  CPPUNIT_TEST(testProfiler);
   CPPUNIT_TEST(availablePlugins);
   CPPUNIT_TEST(pluginInformation);
   CPPUNIT_TEST_SUITE_END();
@@ -38,6 +40,8 @@ public:
   void testloadPlugin();
   void testCircularPlugin();
   void testAncestorGraph();
+  void testResultsCache();
+  void testProfiler();
   void availablePlugins();
   void pluginInformation();
 };
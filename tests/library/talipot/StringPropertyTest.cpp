@@ -13,6 +13,7 @@
 
 #include "StringPropertyTest.h"
 
+#include <talipot/StringPool.h>
 #include <talipot/StringProperty.h>
 
 using namespace std;
@@ -71,3 +72,90 @@ void StringPropertyTest::complexVectorTest() {
     CPPUNIT_ASSERT_EQUAL(tmp[i], value[i]);
   }
 }
+
+void StringPropertyTest::internedValuesTest() {
+  const string category = "StringPropertyTest category";
+  uint poolSize = StringPool::size();
+  auto *prop = new StringProperty(graph);
+  prop->setInternedValues(true);
+  prop->setAllNodeValue("");
+  vector<node> nodes = graph->addNodes(1000);
+
+  for (auto n : nodes) {
+    prop->setNodeValue(n, (n.id % 2) ? category : category + to_string(n.id % 10));
+  }
+
+  // the equal values share the same string
+  CPPUNIT_ASSERT_EQUAL(poolSize + 6, StringPool::size());
+  const string *categoryId = prop->getNodeValueId(nodes[1]);
+  CPPUNIT_ASSERT_EQUAL(category, *categoryId);
+  CPPUNIT_ASSERT_EQUAL(500u, StringPool::refCount(categoryId));
+  CPPUNIT_ASSERT(categoryId == prop->getNodeValueId(nodes[3]));
+  CPPUNIT_ASSERT(categoryId != prop->getNodeValueId(nodes[2]));
+  CPPUNIT_ASSERT(prop->getNodeValueId(nodes[2]) == prop->getNodeValueId(nodes[12]));
+  CPPUNIT_ASSERT_EQUAL(0, prop->compare(nodes[1], nodes[3]));
+  CPPUNIT_ASSERT(prop->compare(nodes[1], nodes[0]) < 0);
+
+  // the default values have their own identifier
+  node n = graph->addNode();
+  CPPUNIT_ASSERT(prop->getNodeValueId(n) == prop->getNodeValueId(graph->addNode()));
+  CPPUNIT_ASSERT(prop->getNodeValueId(n) != prop->getNodeValueId(nodes[0]));
+
+  // the values are shared between the properties
+  auto *copy = static_cast<StringProperty *>(prop->clonePrototype(graph, ""));
+  CPPUNIT_ASSERT(copy->hasInternedValues());
+  copy->copy(prop);
+  CPPUNIT_ASSERT(categoryId == copy->getNodeValueId(nodes[1]));
+  CPPUNIT_ASSERT_EQUAL(1000u, StringPool::refCount(categoryId));
+
+  // changing the default value keeps the values of the elements
+  prop->setNodeDefaultValue(category);
+  CPPUNIT_ASSERT_EQUAL(category, prop->getNodeValue(nodes[1]));
+  CPPUNIT_ASSERT_EQUAL(category + "0", prop->getNodeValue(nodes[0]));
+  CPPUNIT_ASSERT_EQUAL(string(""), prop->getNodeValue(n));
+  CPPUNIT_ASSERT_EQUAL(500u, StringPool::refCount(categoryId));
+  CPPUNIT_ASSERT(prop->getNodeValueId(nodes[1]) == prop->getNodeValueId(nodes[3]));
+  CPPUNIT_ASSERT_EQUAL(0, prop->compare(nodes[1], nodes[3]));
+
+  copy->setNodeValue(nodes[1], "");
+  CPPUNIT_ASSERT_EQUAL(499u, StringPool::refCount(categoryId));
+
+  // the strings are released with the properties
+  delete prop;
+  delete copy;
+  CPPUNIT_ASSERT_EQUAL(poolSize, StringPool::size());
+}
+
+void StringPropertyTest::uniqueValuesTest() {
+  uint poolSize = StringPool::size();
+  auto *prop = new StringProperty(graph);
+  CPPUNIT_ASSERT(!prop->hasInternedValues());
+  vector<node> nodes = graph->addNodes(1000);
+  size_t emptyUsage = prop->memoryUsage();
+
+  for (auto n : nodes) {
+    prop->setNodeValue(n, string(100, 'a') + to_string(n.id));
+  }
+
+  // the values are not interned by default,
+  // each one is only stored in the property
+  CPPUNIT_ASSERT_EQUAL(poolSize, StringPool::size());
+  size_t usage = prop->memoryUsage();
+  CPPUNIT_ASSERT(usage >= emptyUsage + 100 * nodes.size());
+  CPPUNIT_ASSERT(prop->getNodeValueId(nodes[0]) != prop->getNodeValueId(nodes[1]));
+  CPPUNIT_ASSERT(prop->compare(nodes[1], nodes[2]) < 0);
+
+  // interning the distinct values only adds the pool entries
+  size_t poolUsage = StringPool::memoryUsage();
+  prop->setInternedValues(true);
+  CPPUNIT_ASSERT_EQUAL(poolSize + 1000, StringPool::size());
+  CPPUNIT_ASSERT(prop->memoryUsage() + StringPool::memoryUsage() - poolUsage > usage);
+  CPPUNIT_ASSERT_EQUAL(string(100, 'a') + to_string(nodes[5].id), prop->getNodeValue(nodes[5]));
+
+  // and they are released when no longer interned
+  prop->setInternedValues(false);
+  CPPUNIT_ASSERT_EQUAL(poolSize, StringPool::size());
+  CPPUNIT_ASSERT_EQUAL(usage, prop->memoryUsage());
+  CPPUNIT_ASSERT_EQUAL(string(100, 'a') + to_string(nodes[5].id), prop->getNodeValue(nodes[5]));
+  delete prop;
+}
@@ -24,6 +24,8 @@ class StringPropertyTest : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(StringPropertyTest);
   CPPUNIT_TEST(simpleVectorTest);
   CPPUNIT_TEST(complexVectorTest);
+  CPPUNIT_TEST(internedValuesTest);
+  CPPUNIT_TEST(uniqueValuesTest);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -35,6 +37,8 @@ public:
 
   void simpleVectorTest();
   void complexVectorTest();
+  void internedValuesTest();
+  void uniqueValuesTest();
 };
 
 #endif // STRING_PROPERTY_TEST_H
@@ -211,6 +211,20 @@ void TestAlgorithmTest::testAcyclic() {
   CPPUNIT_ASSERT(AcyclicTest::isAcyclic(clone));
 }
 //==========================================================
+// queries the connected components of a graph while one of its edges is deleted
+class ConnectedQueryListener : public Observable {
+public:
+  uint nbComponents = 0;
+
+  void treatEvent(const Event &evt) override {
+    const auto *gEvt = dynamic_cast<const GraphEvent *>(&evt);
+
+    if (gEvt && gEvt->getType() == GraphEvent::TLP_DEL_EDGE) {
+      nbComponents = ConnectedTest::numberOfConnectedComponents(gEvt->getGraph());
+    }
+  }
+};
+
 void TestAlgorithmTest::testConnected() {
   graph->clear();
   node n1 = graph->addNode();
@@ -236,6 +250,40 @@ void TestAlgorithmTest::testConnected() {
   graph->addEdge(n3, n4);
   CPPUNIT_ASSERT(!ConnectedTest::isConnected(graph));
   CPPUNIT_ASSERT_EQUAL(2u, ConnectedTest::numberOfConnectedComponents(graph));
+  CPPUNIT_ASSERT(ConnectedTest::areConnected(graph, n1, n2));
+  CPPUNIT_ASSERT(!ConnectedTest::areConnected(graph, n2, n3));
+  CPPUNIT_ASSERT_EQUAL(ConnectedTest::componentId(graph, n3),
+                       ConnectedTest::componentId(graph, n4));
+
+  // components are incrementally updated when adding elements
+  vector<node> nodes = graph->addNodes(4);
+  CPPUNIT_ASSERT_EQUAL(6u, ConnectedTest::numberOfConnectedComponents(graph));
+  graph->addEdges({{nodes[0], nodes[1]}, {nodes[2], nodes[3]}, {nodes[1], n4}});
+  CPPUNIT_ASSERT_EQUAL(3u, ConnectedTest::numberOfConnectedComponents(graph));
+  CPPUNIT_ASSERT(ConnectedTest::areConnected(graph, nodes[0], n3));
+  CPPUNIT_ASSERT(!ConnectedTest::areConnected(graph, nodes[2], n3));
+  vector<vector<node>> components = ConnectedTest::computeConnectedComponents(graph);
+  CPPUNIT_ASSERT_EQUAL(size_t(3), components.size());
+  CPPUNIT_ASSERT_EQUAL(size_t(2), components[0].size());
+  CPPUNIT_ASSERT_EQUAL(size_t(4), components[1].size());
+  CPPUNIT_ASSERT_EQUAL(size_t(2), components[2].size());
+  graph->addEdge(n2, nodes[3]);
+  CPPUNIT_ASSERT_EQUAL(2u, ConnectedTest::numberOfConnectedComponents(graph));
+
+  // and recomputed after a deletion
+  graph->delNode(n2);
+  CPPUNIT_ASSERT_EQUAL(3u, ConnectedTest::numberOfConnectedComponents(graph));
+  CPPUNIT_ASSERT(!ConnectedTest::areConnected(graph, n1, nodes[3]));
+
+  // the components queried while an edge is being deleted are computed again afterwards
+  edge e2 = graph->addEdge(n1, nodes[3]);
+  CPPUNIT_ASSERT_EQUAL(2u, ConnectedTest::numberOfConnectedComponents(graph));
+  ConnectedQueryListener listener;
+  graph->addListener(&listener);
+  graph->delEdge(e2);
+  graph->removeListener(&listener);
+  CPPUNIT_ASSERT_EQUAL(2u, listener.nbComponents);
+  CPPUNIT_ASSERT_EQUAL(3u, ConnectedTest::numberOfConnectedComponents(graph));
 }
 //==========================================================
 const std::string GRAPHPATH = "./DATA/graphs/";
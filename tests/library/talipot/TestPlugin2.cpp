@@ -18,9 +18,21 @@ using namespace std;
 class Test2 : public tlp::BooleanAlgorithm {
 public:
   PLUGININFORMATION("Test2", "Jezequel", "03/11/2004", "0", "1.0", "")
-  Test2(tlp::PluginContext *context) : tlp::BooleanAlgorithm(context) {}
+  Test2(tlp::PluginContext *context) : tlp::BooleanAlgorithm(context) {
+    addInParameter<tlp::DoubleProperty>("weight", "", "", false);
+    addInParameter<bool>("directed", "", "false", false);
+    addInParameter<tlp::BooleanProperty>("initial", "", "", false);
+    addOutParameter<uint>("runs", "", "", false);
+  }
   ~Test2() override = default;
   bool run() override {
+    // the number of runs of the algorithm
+    static uint runs = 0;
+
+    if (dataSet != nullptr) {
+      dataSet->set("runs", ++runs);
+    }
+
     return true;
   }
 };
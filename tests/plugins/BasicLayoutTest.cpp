@@ -13,10 +13,14 @@
 
 #include "BasicLayoutTest.h"
 
+#include <set>
+
 #include <talipot/LayoutProperty.h>
 #include <talipot/SizeProperty.h>
 #include <talipot/BooleanProperty.h>
 #include <talipot/DoubleProperty.h>
+#include <talipot/StringCollection.h>
+#include <talipot/TlpTools.h>
 
 using namespace std;
 using namespace tlp;
@@ -97,8 +101,117 @@ void BasicLayoutTest::testGEMLayout() {
   CPPUNIT_ASSERT(g == graph);
   LayoutProperty prop(graph);
   string errorMsg;
+  setSeedOfRandomSequence(1);
   bool result = graph->applyPropertyAlgorithm("GEM (Frick)", &prop, errorMsg);
   CPPUNIT_ASSERT(result);
+  // the connected components are laid out in standalone graphs
+  CPPUNIT_ASSERT_EQUAL(0u, graph->numberOfSubGraphs());
+  // the result does not depend on the scheduling of the components
+  LayoutProperty prop2(graph);
+  setSeedOfRandomSequence(1);
+  result = graph->applyPropertyAlgorithm("GEM (Frick)", &prop2, errorMsg);
+  CPPUNIT_ASSERT(result);
+
+  for (auto n : graph->nodes()) {
+    CPPUNIT_ASSERT_EQUAL(prop.getNodeValue(n), prop2.getNodeValue(n));
+  }
+}
+//==========================================================
+void BasicLayoutTest::testMultilevelGEMLayout() {
+  // a grid large enough to be coarsened
+  const uint width = 16;
+  const vector<node> &nodes = graph->addNodes(width * width);
+
+  for (uint i = 0; i < width; ++i) {
+    for (uint j = 0; j < width; ++j) {
+      if (i + 1 < width) {
+        graph->addEdge(nodes[i * width + j], nodes[(i + 1) * width + j]);
+      }
+
+      if (j + 1 < width) {
+        graph->addEdge(nodes[i * width + j], nodes[i * width + j + 1]);
+      }
+    }
+  }
+
+  for (const string coarsening : {"matching", "independent set"}) {
+    DataSet ds;
+    StringCollection coarsenings("none;matching;independent set");
+    coarsenings.setCurrent(coarsening);
+    ds.set("multilevel", coarsenings);
+    LayoutProperty prop(graph);
+    string errorMsg;
+    setSeedOfRandomSequence(1);
+    bool result = graph->applyPropertyAlgorithm("GEM (Frick)", &prop, errorMsg, &ds);
+    CPPUNIT_ASSERT(result);
+    // the coarser levels are laid out in standalone graphs
+    CPPUNIT_ASSERT_EQUAL(0u, graph->numberOfSubGraphs());
+    set<Coord> coords;
+
+    for (auto n : graph->nodes()) {
+      coords.insert(prop.getNodeValue(n));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(size_t(graph->numberOfNodes()), coords.size());
+  }
+}
+//==========================================================
+void BasicLayoutTest::checkIncrementalLayout(const string &algorithm) {
+  const uint width = 16;
+  const vector<node> &nodes = graph->addNodes(width * width);
+  LayoutProperty layout(graph);
+
+  for (uint i = 0; i < width; ++i) {
+    for (uint j = 0; j < width; ++j) {
+      layout.setNodeValue(nodes[i * width + j], Coord(10 * i, 10 * j, 0));
+
+      if (i + 1 < width) {
+        graph->addEdge(nodes[i * width + j], nodes[(i + 1) * width + j]);
+      }
+
+      if (j + 1 < width) {
+        graph->addEdge(nodes[i * width + j], nodes[i * width + j + 1]);
+      }
+    }
+  }
+
+  // a node is added to a corner of the grid
+  node corner = nodes[0];
+  node far = nodes.back();
+  node added = graph->addNode();
+  graph->addEdge(corner, added);
+  BooleanProperty changedNodes(graph);
+  changedNodes.setNodeValue(added, true);
+
+  DataSet ds;
+  ds.set("initial layout", &layout);
+  ds.set("changed nodes", &changedNodes);
+  LayoutProperty prop(graph);
+  string errorMsg;
+  setSeedOfRandomSequence(1);
+  bool result = graph->applyPropertyAlgorithm(algorithm, &prop, errorMsg, &ds);
+  CPPUNIT_ASSERT_MESSAGE(errorMsg, result);
+  // the layout of the local graph does not modify the hierarchy of the graph
+  CPPUNIT_ASSERT_EQUAL(0u, graph->numberOfSubGraphs());
+  // the nodes far from the added one have not moved
+  CPPUNIT_ASSERT_EQUAL(layout.getNodeValue(far), prop.getNodeValue(far));
+  // the added node is placed near its neighbor
+  float dist = prop.getNodeValue(added).dist(prop.getNodeValue(corner));
+  CPPUNIT_ASSERT(dist > 0 && dist < 10 * width);
+}
+//==========================================================
+void BasicLayoutTest::testIncrementalGEMLayout() {
+  checkIncrementalLayout("GEM (Frick)");
+}
+//==========================================================
+void BasicLayoutTest::testIncrementalLinLogLayout() {
+  // the local graph is laid out by LinLog with its boundary given as "skip nodes"
+  checkIncrementalLayout("LinLog");
+}
+//==========================================================
+void BasicLayoutTest::testIncrementalFM3Layout() {
+  // the local graph is refined by a spring embedder
+  checkIncrementalLayout("FM^3 (OGDF)");
 }
 //==========================================================
 void BasicLayoutTest::testHierarchicalGraph() {
@@ -127,6 +240,30 @@ void BasicLayoutTest::testRandomLayout() {
   CPPUNIT_ASSERT(result);
 }
 //==========================================================
+void BasicLayoutTest::testSparseStress() {
+  bool result = computeProperty<LayoutProperty>("Sparse Stress");
+  CPPUNIT_ASSERT(result);
+  DoubleProperty edgeLength(graph);
+  edgeLength.setAllEdgeValue(0);
+  DataSet ds;
+  ds.set("edge length", static_cast<NumericProperty *>(&edgeLength));
+  LayoutProperty layout(graph);
+  string errorMsg;
+  // the edge lengths must be positive
+  result = graph->applyPropertyAlgorithm("Sparse Stress", &layout, errorMsg, &ds);
+  CPPUNIT_ASSERT(!result);
+  edgeLength.setAllEdgeValue(2);
+  result = graph->applyPropertyAlgorithm("Sparse Stress", &layout, errorMsg, &ds);
+  CPPUNIT_ASSERT(result);
+  set<Coord> coords;
+
+  for (auto n : graph->nodes()) {
+    coords.insert(layout.getNodeValue(n));
+  }
+
+  CPPUNIT_ASSERT_EQUAL(size_t(graph->numberOfNodes()), coords.size());
+}
+//==========================================================
 void BasicLayoutTest::testSquarifiedTreeMap() {
   initializeGraph("Random General Tree");
   DoubleProperty metric(graph);
@@ -139,6 +276,22 @@ void BasicLayoutTest::testSquarifiedTreeMap() {
   ds.set("metric", &metric);
   result = graph->applyPropertyAlgorithm("Squarified Tree Map", &layout, errorMsg, &ds);
   CPPUNIT_ASSERT(result);
+
+  // the nodes deeper than the depth limit are not laid out
+  SizeProperty size(graph);
+  ds.set("Node Size", &size);
+  ds.set("Depth Limit", 1u);
+  result = graph->applyPropertyAlgorithm("Squarified Tree Map", &layout, errorMsg, &ds);
+  CPPUNIT_ASSERT(result);
+  node root = graph->getSource();
+
+  for (auto n : graph->nodes()) {
+    if (n != root && graph->getInNode(n, 1) != root) {
+      CPPUNIT_ASSERT_EQUAL(Size(0, 0, 0), size.getNodeValue(n));
+    } else {
+      CPPUNIT_ASSERT(size.getNodeValue(n)[0] > 0);
+    }
+  }
 }
 //==========================================================
 void BasicLayoutTest::testTreeLeaf() {
@@ -183,7 +336,33 @@ void BasicLayoutTest::testFastOverlapRemoval() {
   DataSet ds;
   LayoutProperty layout(graph);
   ds.set("layout", &layout);
+  SizeProperty size(graph);
+  size.setAllNodeValue(Size(1, 1, 1));
+  ds.set("bounding box", &size);
   string errorMsg;
   bool result = graph->applyPropertyAlgorithm("Fast Overlap Removal", &layout, errorMsg, &ds);
   CPPUNIT_ASSERT(result);
+  // all the nodes were at the same position, none of them overlaps now
+  const vector<node> &nodes = graph->nodes();
+
+  for (uint i = 0; i < nodes.size(); ++i) {
+    for (uint j = i + 1; j < nodes.size(); ++j) {
+      Coord delta = layout.getNodeValue(nodes[i]) - layout.getNodeValue(nodes[j]);
+      CPPUNIT_ASSERT(fabs(delta.getX()) > 0.999 || fabs(delta.getY()) > 0.999);
+    }
+  }
+
+  // too many coincident rectangles to test all their pairs,
+  // the overlaps are removed at once
+  graph->addNodes(300);
+  layout.setAllNodeValue(Coord(0, 0, 0));
+  result = graph->applyPropertyAlgorithm("Fast Overlap Removal", &layout, errorMsg, &ds);
+  CPPUNIT_ASSERT(result);
+
+  for (uint i = 0; i < nodes.size(); ++i) {
+    for (uint j = i + 1; j < nodes.size(); ++j) {
+      Coord delta = layout.getNodeValue(nodes[i]) - layout.getNodeValue(nodes[j]);
+      CPPUNIT_ASSERT(fabs(delta.getX()) > 0.999 || fabs(delta.getY()) > 0.999);
+    }
+  }
 }
@@ -28,10 +28,15 @@ class BasicLayoutTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testConnectedComponentPacking);
   CPPUNIT_TEST(testDendrogram);
   CPPUNIT_TEST(testGEMLayout);
+  CPPUNIT_TEST(testMultilevelGEMLayout);
+  CPPUNIT_TEST(testIncrementalGEMLayout);
+  CPPUNIT_TEST(testIncrementalLinLogLayout);
+  CPPUNIT_TEST(testIncrementalFM3Layout);
   CPPUNIT_TEST(testHierarchicalGraph);
   CPPUNIT_TEST(testImprovedWalker);
   CPPUNIT_TEST(testMixedModel);
   CPPUNIT_TEST(testRandomLayout);
+  CPPUNIT_TEST(testSparseStress);
   CPPUNIT_TEST(testSquarifiedTreeMap);
   CPPUNIT_TEST(testTreeLeaf);
   CPPUNIT_TEST(testTreeMap);
@@ -48,6 +53,7 @@ private:
   template <typename PropType>
   bool computeProperty(const std::string &algorithm, const std::string &graphType = "Planar Graph",
                        PropType *prop = nullptr);
+  void checkIncrementalLayout(const std::string &algorithm);
 
 public:
   void setUp() override;
@@ -59,10 +65,15 @@ public:
   void testConnectedComponentPacking();
   void testDendrogram();
   void testGEMLayout();
+  void testMultilevelGEMLayout();
+  void testIncrementalGEMLayout();
+  void testIncrementalLinLogLayout();
+  void testIncrementalFM3Layout();
   void testHierarchicalGraph();
   void testImprovedWalker();
   void testMixedModel();
   void testRandomLayout();
+  void testSparseStress();
   void testSquarifiedTreeMap();
   void testTreeLeaf();
   void testTreeMap();
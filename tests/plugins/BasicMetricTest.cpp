@@ -102,6 +102,51 @@ void BasicMetricTest::testIdMetric() {
   CPPUNIT_ASSERT(result);
 }
 //==========================================================
+void BasicMetricTest::testKCores() {
+  bool result = computeProperty<DoubleProperty>("K-Cores");
+  CPPUNIT_ASSERT(result);
+
+  // a 4-clique, a node linked to two of its nodes,
+  // a pendant node and an isolated node
+  graph->clear();
+  vector<node> nodes = graph->addNodes(7);
+
+  for (uint i = 0; i < 4; ++i) {
+    for (uint j = i + 1; j < 4; ++j) {
+      graph->addEdge(nodes[i], nodes[j]);
+    }
+  }
+
+  graph->addEdge(nodes[0], nodes[4]);
+  graph->addEdge(nodes[1], nodes[4]);
+  graph->addEdge(nodes[4], nodes[5]);
+
+  DoubleProperty *weights = graph->getDoubleProperty("weights");
+  weights->setAllEdgeValue(2);
+
+  vector<double> expected = {3, 3, 3, 3, 2, 1, 0};
+
+  for (bool parallel : {false, true}) {
+    for (bool weighted : {false, true}) {
+      DoubleProperty metric(graph);
+      DataSet ds;
+      ds.set("parallel", parallel);
+
+      if (weighted) {
+        ds.set("metric", static_cast<NumericProperty *>(weights));
+      }
+
+      string errorMsg;
+      CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("K-Cores", &metric, errorMsg, &ds));
+
+      for (uint i = 0; i < nodes.size(); ++i) {
+        CPPUNIT_ASSERT_EQUAL(weighted ? 2 * expected[i] : expected[i],
+                             metric.getNodeValue(nodes[i]));
+      }
+    }
+  }
+}
+//==========================================================
 void BasicMetricTest::testLeafMetric() {
   bool result = computeProperty<DoubleProperty>("Leaf");
   CPPUNIT_ASSERT(result == false);
@@ -110,6 +155,43 @@ void BasicMetricTest::testLeafMetric() {
   CPPUNIT_ASSERT(result);
 }
 //==========================================================
+void BasicMetricTest::testLouvainClustering() {
+  bool result = computeProperty<DoubleProperty>("Louvain");
+  CPPUNIT_ASSERT(result);
+
+  // two cliques linked by a single edge
+  graph->clear();
+  vector<node> nodes = graph->addNodes(10);
+
+  for (uint i = 0; i < 5; ++i) {
+    for (uint j = i + 1; j < 5; ++j) {
+      graph->addEdge(nodes[i], nodes[j]);
+      graph->addEdge(nodes[i + 5], nodes[j + 5]);
+    }
+  }
+
+  graph->addEdge(nodes[0], nodes[5]);
+
+  for (bool refinement : {false, true}) {
+    DoubleProperty metric(graph);
+    DataSet ds;
+    ds.set("refinement", refinement);
+    string errorMsg;
+    CPPUNIT_ASSERT(graph->applyPropertyAlgorithm("Louvain", &metric, errorMsg, &ds));
+
+    uint nbCommunities = 0;
+    CPPUNIT_ASSERT(ds.get("#communities", nbCommunities));
+    CPPUNIT_ASSERT_EQUAL(2u, nbCommunities);
+
+    for (uint i = 1; i < 5; ++i) {
+      CPPUNIT_ASSERT_EQUAL(metric.getNodeValue(nodes[0]), metric.getNodeValue(nodes[i]));
+      CPPUNIT_ASSERT_EQUAL(metric.getNodeValue(nodes[5]), metric.getNodeValue(nodes[i + 5]));
+    }
+
+    CPPUNIT_ASSERT(metric.getNodeValue(nodes[0]) != metric.getNodeValue(nodes[5]));
+  }
+}
+//==========================================================
 void BasicMetricTest::testNodeMetric() {
   bool result = computeProperty<DoubleProperty>("Node");
   CPPUNIT_ASSERT(result == false);
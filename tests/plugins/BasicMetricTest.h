@@ -31,7 +31,9 @@ class BasicMetricTest : public CppUnit::TestFixture {
   CPPUNIT_TEST(testDepthMetric);
   CPPUNIT_TEST(testEccentricity);
   CPPUNIT_TEST(testIdMetric);
+  CPPUNIT_TEST(testKCores);
   CPPUNIT_TEST(testLeafMetric);
+  CPPUNIT_TEST(testLouvainClustering);
   CPPUNIT_TEST(testNodeMetric);
   CPPUNIT_TEST(testPathLengthMetric);
   CPPUNIT_TEST(testRandomMetric);
@@ -59,7 +61,9 @@ public:
   void testDepthMetric();
   void testEccentricity();
   void testIdMetric();
+  void testKCores();
   void testLeafMetric();
+  void testLouvainClustering();
   void testNodeMetric();
   void testPathLengthMetric();
   void testRandomMetric();
@@ -11,11 +11,15 @@
  *
  */
 
+#include <set>
+
 #include "BasicPluginsTest.h"
 #include <talipot/BooleanProperty.h>
 #include <talipot/ColorProperty.h>
 #include <talipot/DoubleProperty.h>
+#include <talipot/LayoutProperty.h>
 #include <talipot/SizeProperty.h>
+#include <talipot/StringProperty.h>
 #include <talipot/SimplePluginProgress.h>
 
 using namespace std;
@@ -381,6 +385,49 @@ void BasicPluginsTest::testEqualValueClustering() {
   result = graph->applyAlgorithm(algorithmName, errorMsg, &ds);
   CPPUNIT_ASSERT_MESSAGE(errorMsg, result);
 
+  // each value gives a subgraph induced by the nodes having it
+  set<double> values;
+
+  for (auto n : graph->nodes()) {
+    values.insert(metric->getNodeValue(n));
+  }
+
+  CPPUNIT_ASSERT_EQUAL(uint(values.size()), graph->numberOfSubGraphs());
+  uint nbNodes = 0;
+
+  for (Graph *sg : graph->subGraphs()) {
+    double value = metric->getNodeValue(sg->getOneNode());
+    nbNodes += sg->numberOfNodes();
+
+    for (auto n : sg->nodes()) {
+      CPPUNIT_ASSERT_EQUAL(value, metric->getNodeValue(n));
+    }
+
+    for (auto e : graph->edges()) {
+      const auto &[src, tgt] = graph->ends(e);
+      CPPUNIT_ASSERT_EQUAL(sg->isElement(src) && sg->isElement(tgt), sg->isElement(e));
+    }
+  }
+
+  CPPUNIT_ASSERT_EQUAL(NB_ADD, nbNodes);
+
+  // the same partition without the induced edges
+  vector<Graph *> subGraphs = graph->subGraphs();
+
+  for (Graph *sg : subGraphs) {
+    graph->delSubGraph(sg);
+  }
+
+  ds.set("Induced edges", false);
+  result = graph->applyAlgorithm(algorithmName, errorMsg, &ds);
+  CPPUNIT_ASSERT_MESSAGE(errorMsg, result);
+  CPPUNIT_ASSERT_EQUAL(uint(values.size()), graph->numberOfSubGraphs());
+
+  for (Graph *sg : graph->subGraphs()) {
+    CPPUNIT_ASSERT_EQUAL(0u, sg->numberOfEdges());
+  }
+
+  ds.set("Induced edges", true);
   graph->clear();
 
   PluginProgress *progress = new SimplePluginProgress();
@@ -465,4 +512,46 @@ void BasicPluginsTest::testImportGEXF() {
     files += 1;
   }
 }
+//==========================================================
+void BasicPluginsTest::testImportGraphML() {
+  DataSet ds;
+  ds.set("file::filename", string("data/basic.graphml"));
+  Graph *g = importGraph("GraphML", ds, nullptr, graph);
+  CPPUNIT_ASSERT(g == graph);
+  CPPUNIT_ASSERT_EQUAL(3u, graph->numberOfNodes());
+  CPPUNIT_ASSERT_EQUAL(3u, graph->numberOfEdges());
+
+  string description;
+  CPPUNIT_ASSERT(graph->getAttribute("description", description));
+  CPPUNIT_ASSERT_EQUAL(string("A basic GraphML graph"), description);
+
+  StringProperty *viewLabel = graph->getStringProperty("viewLabel");
+  DoubleProperty *weight = graph->getDoubleProperty("weight");
+  BooleanProperty *strong = graph->getBooleanProperty("strong");
+  LayoutProperty *viewLayout = graph->getLayoutProperty("viewLayout");
+  const vector<node> &nodes = graph->nodes();
+  // the nodes are created in the order of their first reference
+  CPPUNIT_ASSERT_EQUAL(string("third"), viewLabel->getNodeValue(nodes[0]));
+  CPPUNIT_ASSERT_EQUAL(string("first"), viewLabel->getNodeValue(nodes[1]));
+  CPPUNIT_ASSERT_EQUAL(string("n1"), viewLabel->getNodeValue(nodes[2]));
+  CPPUNIT_ASSERT_EQUAL(2.5, weight->getNodeValue(nodes[1]));
+  CPPUNIT_ASSERT_EQUAL(1.0, weight->getNodeValue(nodes[2]));
+  CPPUNIT_ASSERT_EQUAL(Coord(10, -5, 0), viewLayout->getNodeValue(nodes[1]));
+
+  const vector<edge> &edges = graph->edges();
+  CPPUNIT_ASSERT(graph->ends(edges[0]) == make_pair(nodes[0], nodes[1]));
+  CPPUNIT_ASSERT(strong->getEdgeValue(edges[0]));
+  CPPUNIT_ASSERT(!strong->getEdgeValue(edges[2]));
+
+  // the undeclared nodes are created on demand,
+  // the former name of the file parameter is still supported
+  Graph *g2 = newGraph();
+  ds = DataSet();
+  ds.set("filename", string("data/basic.graphml"));
+  ds.set("create undeclared nodes", true);
+  CPPUNIT_ASSERT(importGraph("GraphML", ds, nullptr, g2) == g2);
+  CPPUNIT_ASSERT_EQUAL(4u, g2->numberOfNodes());
+  CPPUNIT_ASSERT_EQUAL(4u, g2->numberOfEdges());
+  delete g2;
+}
 #endif
@@ -57,6 +57,7 @@ class BasicPluginsTest : public CppUnit::TestFixture {
 #ifndef TALIPOT_BUILD_CORE_ONLY
   CPPUNIT_TEST(testImportFileSystem);
   CPPUNIT_TEST(testImportGEXF);
+  CPPUNIT_TEST(testImportGraphML);
 #endif
   CPPUNIT_TEST_SUITE_END();
 
@@ -107,6 +108,7 @@ public:
 #ifndef TALIPOT_BUILD_CORE_ONLY
   void testImportFileSystem();
   void testImportGEXF();
+  void testImportGraphML();
 #endif
 };
 
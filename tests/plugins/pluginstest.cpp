@@ -47,6 +47,8 @@ int main() {
   PluginLibraryLoader::loadPluginsFromDir(talipotBuildDir + "/plugins/layout", pLoader);
   PluginLibraryLoader::loadPluginsFromDir(talipotBuildDir + "/plugins/layout/FastOverlapRemoval",
                                           pLoader);
+  PluginLibraryLoader::loadPluginsFromDir(talipotBuildDir + "/plugins/layout/LinLog", pLoader);
+  PluginLibraryLoader::loadPluginsFromDir(talipotBuildDir + "/plugins/layout/OGDF", pLoader);
   PluginLibraryLoader::loadPluginsFromDir(talipotBuildDir + "/plugins/metric", pLoader);
   PluginLibraryLoader::loadPluginsFromDir(talipotBuildDir + "/plugins/selection", pLoader);
   PluginLibraryLoader::loadPluginsFromDir(talipotBuildDir + "/plugins/sizes", pLoader);
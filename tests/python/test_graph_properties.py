@@ -242,6 +242,45 @@ class TestGraphProperties(unittest.TestCase):
             tlp.LayoutProperty, random_coord(), random_coord_list(),
             random_coord(), random_coord_list())
 
+    def test_double_property_bulk_values(self):
+        self.prop = self.graph.getDoubleProperty(self.prop_name)
+        for n in self.graph.getNodes():
+            self.prop[n] = n.id / 2
+        for e in self.graph.getEdges():
+            self.prop[e] = -e.id
+
+        node_values = self.prop.getNodeValues()
+        self.assertEqual(len(node_values), self.graph.numberOfNodes())
+        self.assertEqual(node_values.tolist(),
+                         [n.id / 2 for n in self.graph.nodes()])
+        edge_values = self.prop.getEdgeValues(self.sub_graph)
+        self.assertEqual(edge_values.tolist(),
+                         [-e.id for e in self.sub_graph.edges()])
+
+        for i in range(len(node_values)):
+            node_values[i] = 2 * i
+        self.prop.setNodeValues(node_values)
+        for i, n in enumerate(self.graph.nodes()):
+            self.assertEqual(self.prop[n], 2 * i)
+
+        with self.assertRaises(ValueError):
+            self.prop.setEdgeValues(edge_values)
+
+    def test_layout_property_bulk_values(self):
+        self.prop = self.graph.getLayoutProperty(self.prop_name)
+        for n in self.graph.getNodes():
+            self.prop[n] = tlp.Coord(n.id, -n.id, 1)
+
+        coords = self.prop.getNodeValues(self.sub_graph)
+        self.assertEqual(coords.tolist(),
+                         [[n.id, -n.id, 1] for n in self.sub_graph.nodes()])
+
+        for i in range(len(coords)):
+            coords[i, 2] = i
+        self.prop.setNodeValues(coords, self.sub_graph)
+        for i, n in enumerate(self.sub_graph.nodes()):
+            self.assertEqual(self.prop[n], tlp.Coord(n.id, -n.id, i))
+
     def test_layout_property_tuple(self):
         self.prop = self.graph.getLayoutProperty(self.prop_name)
         self.generic_property_test(
@@ -110,6 +110,24 @@ class TestGraphStructure(unittest.TestCase):
                 'Node with id %s does not belong to graph "%s" (id %s)' %
                 (NB_NODES, self.graph.getName(), self.graph.getId()))
 
+    def test_edges_ends_arrays(self):
+        ends = self.graph.getEdgesEnds()
+        self.assertEqual(len(ends), NB_EDGES)
+        self.assertEqual(
+            ends.tolist(),
+            [[self.graph.source(e).id, self.graph.target(e).id]
+             for e in self.graph.edges()])
+
+        new_edges = self.graph.addEdgesFromArray(ends)
+        self.assertEqual(len(new_edges), NB_EDGES)
+        self.assertEqual(self.graph.numberOfEdges(), 2 * NB_EDGES)
+        for e, new_e in zip(self.graph.edges(), new_edges.tolist()):
+            self.assertEqual(self.graph.ends(e),
+                             self.graph.ends(tlp.edge(new_e)))
+
+        with self.assertRaises(Exception):
+            self.graph.addEdgesFromArray([[0, NB_NODES]])
+
     def test_del_elements(self):
         with self.assertRaises(Exception) as cm:
             self.graph.delNode(tlp.node(NB_NODES))
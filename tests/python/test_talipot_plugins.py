@@ -7,7 +7,9 @@
 # License: GNU General Public License version 3, or any later version
 # See top-level LICENSE file for more information
 
+import json
 import os
+import tempfile
 import unittest
 
 from talipot import tlp
@@ -135,3 +137,39 @@ class TestTalipotPlugins(unittest.TestCase):
 
           for e in graph.edges():
               self.assertEqual(colorProp[e], edgeColorAfter)
+
+    def test_plugin_profiler(self):
+        self.assertFalse(tlp.PluginProfiler.isEnabled())
+        tlp.PluginProfiler.setEnabled(True)
+        try:
+            graph = tlp.importGraph('Grid')
+            params = tlp.getDefaultPluginParameters('Alpha Mapping', graph)
+            graph.applyColorAlgorithm('Alpha Mapping', params)
+            profiles = tlp.PluginProfiler.profiles()
+            self.assertEqual(len(profiles), 2)
+
+            self.assertEqual(profiles[0]['plugin'], 'Grid')
+            self.assertEqual(profiles[0]['category'], 'Import')
+            self.assertEqual(profiles[0]['graph_id'], graph.getId())
+            self.assertTrue(profiles[0]['success'])
+            self.assertGreater(profiles[0]['graph_events'], 0)
+
+            self.assertEqual(profiles[1]['plugin'], 'Alpha Mapping')
+            self.assertEqual(profiles[1]['category'], 'PropertyAlgorithm')
+            self.assertEqual(profiles[1]['depth'], 0)
+            self.assertGreaterEqual(profiles[1]['wall_time'], 0)
+            self.assertGreater(profiles[1]['values_written'], 0)
+
+            with tempfile.TemporaryDirectory() as tmpdir:
+                trace_file = os.path.join(tmpdir, 'trace.json')
+                self.assertTrue(tlp.PluginProfiler.writeTrace(trace_file))
+                with open(trace_file) as f:
+                    trace = json.load(f)
+            self.assertEqual([e['name'] for e in trace['traceEvents']],
+                             ['Grid', 'Alpha Mapping'])
+            self.assertEqual(trace['traceEvents'][1]['ph'], 'X')
+
+            tlp.PluginProfiler.clear()
+            self.assertEqual(tlp.PluginProfiler.profiles(), [])
+        finally:
+            tlp.PluginProfiler.setEnabled(False)
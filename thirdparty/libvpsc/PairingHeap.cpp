@@ -237,7 +237,7 @@ PairNode<T> *PairingHeap<T>::combineSiblings(PairNode<T> *firstSibling) const {
     return firstSibling;
 
   // Allocate the array
-  static vector<PairNode<T> *> treeArray(5);
+  static thread_local vector<PairNode<T> *> treeArray(5);
 
   // Store the subtrees in an array
   int numSiblings = 0;
@@ -30,7 +30,7 @@ using std::vector;
 
 namespace vpsc {
 
-long blockTimeCtr;
+thread_local long blockTimeCtr;
 
 Blocks::Blocks(const int n, Variable *const vs) : vs(vs), nvs(n) {
   blockTimeCtr = 0;
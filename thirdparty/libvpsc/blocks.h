@@ -50,6 +50,6 @@ private:
   int nvs;
 };
 
-extern long blockTimeCtr;
+extern thread_local long blockTimeCtr;
 } // namespace vpsc
 #endif // SEEN_REMOVEOVERLAP_BLOCKS_H